@@ -26,27 +26,163 @@
 
 #include <errno.h>
 #include <libgen.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(__linux__)
+#include <malloc.h>
+#endif
 
-long alloc_or_die_count = 0;
+
+#if defined(__GNUC__)
+#define thread_local_counts __thread
+#define atomic_add(value, delta) __atomic_add_fetch((value), (delta), __ATOMIC_RELAXED)
+#define atomic_load(value) __atomic_load_n((value), __ATOMIC_RELAXED)
+#define atomic_compare_exchange(value, expected, desired) \
+    __atomic_compare_exchange_n((value), (expected), (desired), true, \
+                                __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#else
+// single threaded
+#define thread_local_counts
+#define atomic_add(value, delta) (*(value) += (delta))
+#define atomic_load(value) (*(value))
+#define atomic_compare_exchange(value, expected, desired) \
+    (*(value) = (desired), true)
+#endif
+
+
+static long const flush_count_threshold = 256;
+static long long const flush_bytes_threshold = 64 * 1024;
+
+
+// Counts not yet added to the totals.  `base_bytes' is the total current
+// bytes as of the last flush.
+struct thread_counts {
+    long count;
+    long total_count;
+    long long bytes;
+    long long base_bytes;
+    long long peak_bytes;
+};
+
+
+static struct alloc_or_die_counts totals;
+static thread_local_counts struct thread_counts thread_counts;
+
+
+static size_t
+allocated_size(void const *memory)
+{
+#if defined(__APPLE__)
+    return malloc_size(memory);
+#elif defined(__linux__)
+    return malloc_usable_size((void *)memory);
+#else
+    return 0;
+#endif
+}
+
+
+static void
+flush_if_needed(struct thread_counts *counts)
+{
+    if (   counts->total_count >= flush_count_threshold
+        || counts->count <= -flush_count_threshold
+        || counts->bytes >= flush_bytes_threshold
+        || counts->bytes <= -flush_bytes_threshold)
+    {
+        alloc_or_die_flush_counts();
+    }
+}
 
 
 void
 alloc_count_is_zero_or_die(void)
 {
-    if (alloc_or_die_count) {
-        char const *plural = (1 == alloc_or_die_count) ? "" : "s";
+    long count = alloc_or_die_counts().count;
+    if (count) {
+        char const *plural = (1 == count) ? "" : "s";
         fprintf(stderr, "WARNING: %li memory allocation%s not freed.\n",
-                alloc_or_die_count, plural);
+                count, plural);
         exit(EXIT_FAILURE);
     }
 }
 
 
+struct alloc_or_die_counts
+alloc_or_die_counts(void)
+{
+    alloc_or_die_flush_counts();
+    return (struct alloc_or_die_counts){
+        .count=atomic_load(&totals.count),
+        .total_count=atomic_load(&totals.total_count),
+        .current_bytes=atomic_load(&totals.current_bytes),
+        .peak_bytes=atomic_load(&totals.peak_bytes),
+    };
+}
+
+
+void
+alloc_or_die_did_alloc(void const *memory)
+{
+    struct thread_counts *counts = &thread_counts;
+    ++counts->count;
+    ++counts->total_count;
+    counts->bytes += allocated_size(memory);
+    long long bytes_in_use = counts->base_bytes + counts->bytes;
+    if (bytes_in_use > counts->peak_bytes) counts->peak_bytes = bytes_in_use;
+    flush_if_needed(counts);
+}
+
+
+void
+alloc_or_die_flush_counts(void)
+{
+    struct thread_counts *counts = &thread_counts;
+    if (counts->count) atomic_add(&totals.count, counts->count);
+    if (counts->total_count) atomic_add(&totals.total_count, counts->total_count);
+    long long current_bytes = atomic_add(&totals.current_bytes, counts->bytes);
+    long long peak_bytes = atomic_load(&totals.peak_bytes);
+    while (   counts->peak_bytes > peak_bytes
+           && !atomic_compare_exchange(&totals.peak_bytes, &peak_bytes, counts->peak_bytes))
+    {
+        // `peak_bytes' now holds the latest total
+    }
+    counts->count = 0;
+    counts->total_count = 0;
+    counts->bytes = 0;
+    counts->base_bytes = current_bytes;
+    counts->peak_bytes = current_bytes;
+}
+
+
+void
+alloc_or_die_reset_peak_bytes(void)
+{
+    alloc_or_die_flush_counts();
+    long long current_bytes = atomic_load(&totals.current_bytes);
+    long long peak_bytes = atomic_load(&totals.peak_bytes);
+    while (!atomic_compare_exchange(&totals.peak_bytes, &peak_bytes, current_bytes)) {
+        // `peak_bytes' now holds the latest total
+    }
+}
+
+
+void
+alloc_or_die_will_free(void const *memory)
+{
+    struct thread_counts *counts = &thread_counts;
+    --counts->count;
+    counts->bytes -= allocated_size(memory);
+    flush_if_needed(counts);
+}
+
+
 size_t
 array_size_or_die(size_t count, size_t element_size)
 {
@@ -34,7 +34,46 @@
 #include <unistd.h>
 
 
-extern long alloc_or_die_count;
+// Allocation accounting.  Each thread keeps its own counts and adds them to
+// shared totals with relaxed atomic operations every few hundred allocations
+// or 64 KiB, when it calls alloc_or_die_flush_counts() and when it reads the
+// totals, so threads don't contend for one cache line on every allocation.
+// Byte counts use the allocator's usable size for each block where the
+// platform provides it and are zero elsewhere.
+struct alloc_or_die_counts {
+    // allocations not yet freed
+    long count;
+    // successful calls to the allocation wrappers, including reallocations
+    long total_count;
+    long long current_bytes;
+    // the most bytes in use at once, as seen by the threads that allocated
+    // them; exact for a single thread
+    long long peak_bytes;
+};
+
+
+// Flushes the calling thread's counts, then returns the totals.  Counts held
+// by other running threads since their last flush aren't included.
+struct alloc_or_die_counts
+alloc_or_die_counts(void);
+
+// Adds the calling thread's counts to the totals.  Threads other than the
+// main thread must call this before they exit.
+void
+alloc_or_die_flush_counts(void);
+
+// Flushes the calling thread's counts and sets the peak bytes to the current
+// bytes.
+void
+alloc_or_die_reset_peak_bytes(void);
+
+// Counts the allocation of `memory'.
+void
+alloc_or_die_did_alloc(void const *memory);
+
+// Counts the freeing of `memory'; call before freeing it.
+void
+alloc_or_die_will_free(void const *memory);
 
 
 ////////// Building Blocks //////////
@@ -51,14 +90,14 @@ print_error_and_die(void)
 }
 
 // Checks that the `memory' pointer is not null.  If `memory' is not NULL,
-// increments `alloc_or_die_count' and returns `memory'.  If `memory' is NULL,
+// increments the allocation count and returns `memory'.  If `memory' is NULL,
 // sets `errno' to ENOMEM if `errno' is zero, then prints the error message for
 // `errno' to `stderr' and exits the process with `errno' as the status code.
 inline void *
 not_null_or_die(void *memory)
 {
     if ( ! memory) print_error_and_die();
-    ++alloc_or_die_count;
+    alloc_or_die_did_alloc(memory);
     return memory;
 }
 
@@ -72,7 +111,7 @@ array_size_or_die(size_t count, size_t element_size);
 
 ////////// Core Allocation Wrappers //////////
 
-// Wrapper for calloc().  Increments `alloc_or_die_count' on success.  On
+// Wrapper for calloc().  Increments the allocation count on success.  On
 // failure, prints the error message for `errno' to `stderr' and exits the
 // process with `errno' as the status code.
 inline void *
@@ -81,7 +120,7 @@ calloc_or_die(size_t count, size_t element_size)
     return not_null_or_die(calloc(count, element_size));
 }
 
-// Wrapper for malloc().  Increments `alloc_or_die_count' on success.  On
+// Wrapper for malloc().  Increments the allocation count on success.  On
 // failure, prints the error message for `errno' to `stderr' and exits the
 // process with `errno' as the status code.
 inline void *
@@ -90,20 +129,21 @@ malloc_or_die(size_t size)
     return not_null_or_die(malloc(size));
 }
 
-// Wrapper for realloc().  Increments `alloc_or_die_count' on success.  On
+// Wrapper for realloc().  Increments the allocation count on success.  On
 // failure, prints the error message for `errno' to `stderr' and exits the
 // process with `errno' as the status code.
 inline void *
 realloc_or_die(void *memory, size_t size)
 {
+    if (memory) alloc_or_die_will_free(memory);
     void *new_memory = realloc(memory, size);
     if ( ! size && ! new_memory) new_memory = calloc(1, 1);
     if ( ! new_memory) print_error_and_die();
-    if ( ! memory) ++alloc_or_die_count;
+    alloc_or_die_did_alloc(new_memory);
     return new_memory;
 }
 
-// Reallocates an array.  Increments `alloc_or_die_count' on success.  If
+// Reallocates an array.  Increments the allocation count on success.  If
 // allocation fails or the requested size exceeds SIZE_MAX, prints the error
 // message for `errno' to `stderr' and exits the process with `errno' as the
 // status code.
@@ -117,7 +157,7 @@ reallocarray_or_die(void *memory, size_t count, size_t element_size)
 ////////// Duplication Functions //////////
 
 // Allocates a copy of `size' bytes of `memory'.  Increments
-// `alloc_or_die_count' and returns the copied memory on success.  On failure,
+// the allocation count and returns the copied memory on success.  On failure,
 // prints the error message for `errno' to `stderr' and exits the process with
 // `errno' as the status code.
 inline void *
@@ -127,7 +167,7 @@ memdup_or_die(void const *memory, size_t size)
 }
 
 // Allocates a copy of `count' elements of an array.  Increments
-// `alloc_or_die_count' and returns the copied array on success.  On failure,
+// the allocation count and returns the copied array on success.  On failure,
 // prints the error message for `errno' to `stderr' and exits the process with
 // `errno' as the status code.
 inline void *
@@ -137,7 +177,7 @@ arraydup_or_die(void const *memory, size_t count, size_t element_size)
 }
 
 // Allocates a copy of a zero-terminated string.  Increments
-// `alloc_or_die_count' and returns the copied string on success.  On failure,
+// the allocation count and returns the copied string on success.  On failure,
 // prints the error message for `errno' to `stderr' and exits the process with
 // `errno' as the status code.
 inline char *
@@ -150,7 +190,7 @@ strdup_or_die(char const *string)
 ////////// Formatting Functions //////////
 
 // Allocates a formatted string.  On success, sets `*string' contains a pointer
-// to the newly allocated, formatted string, increments `alloc_or_die_count',
+// to the newly allocated, formatted string, increments the allocation count,
 // and returns the number of characters in the formatted string (excluding the
 // terminating zero).  On failure, prints the error message for `errno' to
 // `stderr' and exits the process with `errno' as the status code.
@@ -158,7 +198,7 @@ int
 asprintf_or_die(char **string, char const *format, ...);
 
 // Allocates a formatted string.  On success, sets `*string' contains a pointer
-// to the newly allocated, formatted string, increments `alloc_or_die_count',
+// to the newly allocated, formatted string, increments the allocation count,
 // and returns the number of characters in the formatted string (excluding the
 // terminating zero).  On failure, prints the error message for `errno' to
 // `stderr' and exits the process with `errno' as the status code.
@@ -167,7 +207,7 @@ vasprintf_or_die(char **string, const char *format, va_list arguments)
 {
     int result = vasprintf(string, format, arguments);
     if (-1 == result) print_error_and_die();
-    ++alloc_or_die_count;
+    alloc_or_die_did_alloc(*string);
     return result;
 }
 
@@ -179,7 +219,7 @@ basename_or_die(char const *path);
 
 
 // Allocates a zero-terminated string containing the absolute pathname of the
-// current working directory.  Increments `alloc_or_die_count' and returns the
+// current working directory.  Increments the allocation count and returns the
 // string on success.  On failure, prints the error message for `errno' to
 // `stderr' and exits the process with `errno' as the status code.
 inline char *
@@ -191,16 +231,16 @@ getcwd_or_die(void)
 
 ////////// Allocation Counting //////////
 
-// Wrapper for free().  Frees `memory' and decrements `alloc_or_die_count' if
+// Wrapper for free().  Frees `memory' and decrements the allocation count if
 // `memory' is not NULL.
 inline void
 free_or_die(void *memory)
 {
+    if (memory) alloc_or_die_will_free(memory);
     free(memory);
-    if (memory) --alloc_or_die_count;
 }
 
-// Checks that `alloc_or_die_count' is zero.  If it is zero, does nothing.  If
+// Checks that the allocation count is zero.  If it is zero, does nothing.  If
 // it is not zero, prints a message to `stderr' and calls exit() with
 // EXIT_FAILURE as the status code.
 void
@@ -29,9 +29,67 @@ basename_or_die_test(void)
 }
 
 
+static void
+alloc_or_die_counts_test(void)
+{
+    struct alloc_or_die_counts start = alloc_or_die_counts();
+
+    char *memory = malloc_or_die(1000);
+    struct alloc_or_die_counts counts = alloc_or_die_counts();
+    assert(start.count + 1 == counts.count);
+    assert(start.total_count + 1 == counts.total_count);
+    assert(counts.current_bytes >= start.current_bytes);
+    assert(counts.peak_bytes >= counts.current_bytes);
+
+    memory = realloc_or_die(memory, 4000);
+    counts = alloc_or_die_counts();
+    assert(start.count + 1 == counts.count);
+    assert(start.total_count + 2 == counts.total_count);
+    long long peak_bytes = counts.peak_bytes;
+
+    free_or_die(memory);
+    counts = alloc_or_die_counts();
+    assert(start.count == counts.count);
+    assert(start.current_bytes == counts.current_bytes);
+    assert(peak_bytes == counts.peak_bytes);
+
+    alloc_or_die_reset_peak_bytes();
+    counts = alloc_or_die_counts();
+    assert(counts.current_bytes == counts.peak_bytes);
+}
+
+
+static void
+alloc_or_die_counts_many_test(void)
+{
+    struct alloc_or_die_counts start = alloc_or_die_counts();
+
+    // enough to flush the thread's counts several times
+    enum { memories_count = 2000 };
+    char *memories[memories_count];
+    for (int i = 0; i < memories_count; ++i) {
+        memories[i] = malloc_or_die(100);
+    }
+    struct alloc_or_die_counts counts = alloc_or_die_counts();
+    assert(start.count + memories_count == counts.count);
+    long long peak_bytes = counts.peak_bytes;
+    assert(peak_bytes >= counts.current_bytes);
+
+    for (int i = 0; i < memories_count; ++i) {
+        free_or_die(memories[i]);
+    }
+    counts = alloc_or_die_counts();
+    assert(start.count == counts.count);
+    assert(start.current_bytes == counts.current_bytes);
+    assert(peak_bytes == counts.peak_bytes);
+}
+
+
 void
 alloc_or_die_test(void)
 {
+    alloc_or_die_counts_test();
+    alloc_or_die_counts_many_test();
     basename_or_die_test();
 }
 
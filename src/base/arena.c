@@ -0,0 +1,137 @@
+#include "arena.h"
+
+#include <string.h>
+
+#include "alloc_or_die.h"
+#include "int.h"
+
+
+static size_t const initial_block_size = 4096;
+static size_t const max_block_size = 1024 * 1024;
+
+
+struct arena_block {
+    struct arena_block *next;
+};
+
+
+static size_t const block_header_size = (sizeof(struct arena_block) + arena_alignment - 1)
+                                      / arena_alignment * arena_alignment;
+
+
+static inline size_t
+round_up_size(size_t size)
+{
+    return (size + arena_alignment - 1) / arena_alignment * arena_alignment;
+}
+
+
+static inline int
+size_class_index(size_t size)
+{
+    return (int)(size / arena_alignment) - 1;
+}
+
+
+static char *
+alloc_block(struct arena *arena, size_t size)
+{
+    struct arena_block *block = malloc_or_die(block_header_size + size);
+    block->next = arena->blocks;
+    arena->blocks = block;
+    return (char *)block + block_header_size;
+}
+
+
+static void *
+bump(struct arena *arena, size_t size)
+{
+    if ((size_t)(arena->end - arena->next) < size) {
+        while (size > arena->block_size / 2 && arena->block_size < max_block_size) {
+            arena->block_size *= 2;
+        }
+        if (size > arena->block_size / 2) {
+            // very large allocations get a block of their own
+            return alloc_block(arena, size);
+        }
+        arena->next = alloc_block(arena, arena->block_size);
+        arena->end = arena->next + arena->block_size;
+        if (arena->block_size < max_block_size) arena->block_size *= 2;
+    }
+    void *memory = arena->next;
+    arena->next += size;
+    return memory;
+}
+
+
+struct arena *
+arena_alloc(void)
+{
+    struct arena *arena = calloc_or_die(1, sizeof(struct arena));
+    arena->block_size = initial_block_size;
+    return arena;
+}
+
+
+void *
+arena_calloc(struct arena *arena, size_t count, size_t element_size)
+{
+    size_t size = round_up_size(array_size_or_die(count, element_size));
+    if (!size) size = arena_alignment;
+    if (size <= arena_max_small_size) {
+        int index = size_class_index(size);
+        void *memory = arena->free_lists[index];
+        if (memory) {
+            memcpy(&arena->free_lists[index], memory, sizeof(void *));
+            return memset(memory, 0, size);
+        }
+    }
+    return memset(bump(arena, size), 0, size);
+}
+
+
+void
+arena_free(struct arena *arena)
+{
+    if (arena) {
+        struct arena_block *block = arena->blocks;
+        while (block) {
+            struct arena_block *next = block->next;
+            free_or_die(block);
+            block = next;
+        }
+        free_or_die(arena);
+    }
+}
+
+
+void *
+arena_grow_array(struct arena *arena,
+                 void *array,
+                 int count,
+                 int *capacity,
+                 size_t element_size)
+{
+    if (count <= *capacity) return array;
+    int new_capacity = max(count, max(4, *capacity * 2));
+    void *new_array = arena_calloc(arena, new_capacity, element_size);
+    if (array) {
+        memcpy(new_array, array, array_size_or_die(*capacity, element_size));
+        arena_release(arena, array, array_size_or_die(*capacity, element_size));
+    }
+    *capacity = new_capacity;
+    return new_array;
+}
+
+
+void
+arena_release(struct arena *arena, void *memory, size_t size)
+{
+    if (!memory) return;
+    size = round_up_size(size);
+    if (!size) size = arena_alignment;
+    if (size > arena_max_small_size) return;
+    int index = size_class_index(size);
+    memcpy(memory, &arena->free_lists[index], sizeof(void *));
+    arena->free_lists[index] = memory;
+}
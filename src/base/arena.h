@@ -0,0 +1,58 @@
+#ifndef FNF_BASE_ARENA_H_INCLUDED
+#define FNF_BASE_ARENA_H_INCLUDED
+
+
+#include <stddef.h>
+
+
+enum {
+    arena_alignment = 16,
+    arena_size_classes_count = 16,
+    arena_max_small_size = arena_alignment * arena_size_classes_count,
+};
+
+
+struct arena_block;
+
+
+// A region allocator.  Memory is carved out of blocks that grow geometrically
+// and is only returned to the system when the arena is freed.  Small objects
+// released with arena_release() are kept on a free list for their size class
+// and reused by later allocations of the same size.
+struct arena {
+    struct arena_block *blocks;
+    char *next;
+    char *end;
+    size_t block_size;
+    void *free_lists[arena_size_classes_count];
+};
+
+
+struct arena *
+arena_alloc(void);
+
+// Frees all memory allocated from the arena.
+void
+arena_free(struct arena *arena);
+
+// Returns zeroed memory for `count' elements.  Never returns NULL.
+void *
+arena_calloc(struct arena *arena, size_t count, size_t element_size);
+
+// Returns `array' if it can hold `count' elements, otherwise copies it into a
+// new array with at least double the capacity, releases the old array and
+// updates `*capacity'.
+void *
+arena_grow_array(struct arena *arena,
+                 void *array,
+                 int count,
+                 int *capacity,
+                 size_t element_size);
+
+// Makes `memory', which must have been allocated from `arena' with the given
+// size, available for reuse.  Does nothing if `memory' is NULL.
+void
+arena_release(struct arena *arena, void *memory, size_t size);
+
+
+#endif
@@ -0,0 +1,113 @@
+#include <assert.h>
+#include <stdint.h>
+#include <base/base.h>
+
+
+void
+arena_test(void);
+
+
+static void
+arena_alloc_test(void)
+{
+    long count = alloc_or_die_counts().count;
+    struct arena *arena = arena_alloc();
+
+    assert(!arena->blocks);
+    assert(count + 1 == alloc_or_die_counts().count);
+
+    arena_free(arena);
+    assert(count == alloc_or_die_counts().count);
+}
+
+
+static void
+arena_calloc_test(void)
+{
+    struct arena *arena = arena_alloc();
+
+    int *numbers = arena_calloc(arena, 10, sizeof(int));
+    assert(numbers);
+    assert(0 == (uintptr_t)numbers % arena_alignment);
+    for (int i = 0; i < 10; ++i) {
+        assert(0 == numbers[i]);
+        numbers[i] = i;
+    }
+
+    char *chars = arena_calloc(arena, 3, sizeof(char));
+    assert(chars);
+    assert(0 == (uintptr_t)chars % arena_alignment);
+    assert((char *)numbers + 48 == chars);
+
+    long count = alloc_or_die_counts().count;
+    for (int i = 0; i < 1000; ++i) {
+        arena_calloc(arena, 1, 100);
+    }
+    assert(alloc_or_die_counts().count - count < 10);
+
+    char *large = arena_calloc(arena, 1, 1024 * 1024 * 4);
+    assert(large);
+    assert(0 == large[1024 * 1024 * 4 - 1]);
+
+    for (int i = 0; i < 10; ++i) {
+        assert(i == numbers[i]);
+    }
+
+    arena_free(arena);
+}
+
+
+static void
+arena_release_test(void)
+{
+    struct arena *arena = arena_alloc();
+
+    int *numbers = arena_calloc(arena, 10, sizeof(int));
+    numbers[0] = 42;
+    arena_release(arena, numbers, 10 * sizeof(int));
+
+    int *reused = arena_calloc(arena, 12, sizeof(int));
+    assert(numbers == reused);
+    assert(0 == reused[0]);
+
+    char *other = arena_calloc(arena, 40, sizeof(char));
+    assert(other != (char *)numbers);
+
+    arena_release(arena, NULL, 16);
+
+    arena_free(arena);
+}
+
+
+static void
+arena_grow_array_test(void)
+{
+    struct arena *arena = arena_alloc();
+    int *numbers = NULL;
+    int capacity = 0;
+
+    for (int i = 0; i < 1000; ++i) {
+        numbers = arena_grow_array(arena, numbers, i + 1, &capacity, sizeof(int));
+        assert(capacity >= i + 1);
+        numbers[i] = i;
+    }
+    assert(capacity < 2000);
+    for (int i = 0; i < 1000; ++i) {
+        assert(i == numbers[i]);
+    }
+
+    int *same = arena_grow_array(arena, numbers, 10, &capacity, sizeof(int));
+    assert(same == numbers);
+
+    arena_free(arena);
+}
+
+
+void
+arena_test(void)
+{
+    arena_alloc_test();
+    arena_calloc_test();
+    arena_release_test();
+    arena_grow_array_test();
+}
@@ -2,7 +2,10 @@
 #define FNF_BASE_BASE_H_INCLUDED
 
 #include <base/alloc_or_die.h>
+#include <base/arena.h>
 #include <base/array.h>
+#include <base/binary_reader.h>
+#include <base/binary_writer.h>
 #include <base/fail.h>
 #include <base/int.h>
 #include <base/ptr_array.h>
@@ -5,6 +5,15 @@
 void
 alloc_or_die_test(void);
 
+void
+arena_test(void);
+
+void
+binary_reader_test(void);
+
+void
+binary_writer_test(void);
+
 void
 int_test(void);
 
@@ -28,6 +37,9 @@ int
 main(int argc, char *argv[])
 {
     alloc_or_die_test();
+    arena_test();
+    binary_reader_test();
+    binary_writer_test();
     int_test();
     ptr_array_test();
     result_test();
@@ -0,0 +1,183 @@
+#include "binary_reader.h"
+
+#include <limits.h>
+#include <string.h>
+#include <base/base.h>
+
+
+static void
+set_error(struct binary_reader *reader);
+
+
+static void
+set_error(struct binary_reader *reader)
+{
+    reader->has_error = true;
+    reader->offset = reader->length;
+}
+
+
+void
+binary_reader_initialize(struct binary_reader *reader,
+                         uint8_t const *bytes,
+                         size_t length)
+{
+    memset(reader, 0, sizeof(struct binary_reader));
+    reader->bytes = bytes;
+    reader->length = length;
+}
+
+
+void
+binary_reader_finalize(struct binary_reader *reader)
+{
+    free_or_die(reader->strings);
+}
+
+
+bool
+binary_reader_begin_nested(struct binary_reader *reader)
+{
+    if (reader->depth >= binary_reader_max_depth) {
+        set_error(reader);
+        return false;
+    }
+    ++reader->depth;
+    return true;
+}
+
+
+bool
+binary_reader_bool(struct binary_reader *reader)
+{
+    if (reader->offset >= reader->length) {
+        set_error(reader);
+        return false;
+    }
+    uint8_t value = reader->bytes[reader->offset];
+    if (value > 1) {
+        set_error(reader);
+        return false;
+    }
+    ++reader->offset;
+    return value;
+}
+
+
+int
+binary_reader_count(struct binary_reader *reader)
+{
+    unsigned count = binary_reader_uint(reader);
+    if (count > INT_MAX || count > reader->length - reader->offset) {
+        set_error(reader);
+        return 0;
+    }
+    return (int)count;
+}
+
+
+void
+binary_reader_end_nested(struct binary_reader *reader)
+{
+    --reader->depth;
+}
+
+
+uint32_t
+binary_reader_fixed32(struct binary_reader *reader)
+{
+    if (reader->length - reader->offset < 4) {
+        set_error(reader);
+        return 0;
+    }
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= (uint32_t)reader->bytes[reader->offset + i] << (8 * i);
+    }
+    reader->offset += 4;
+    return value;
+}
+
+
+int
+binary_reader_int(struct binary_reader *reader)
+{
+    unsigned zigzag = binary_reader_uint(reader);
+    unsigned magnitude = zigzag >> 1;
+    return (zigzag & 1) ? -(int)magnitude - 1 : (int)magnitude;
+}
+
+
+bool
+binary_reader_read_string_table(struct binary_reader *reader, size_t offset)
+{
+    if (reader->has_error) return false;
+    if (offset > reader->length) {
+        set_error(reader);
+        return false;
+    }
+
+    size_t saved_offset = reader->offset;
+    reader->offset = offset;
+    int count = binary_reader_count(reader);
+    free_or_die(reader->strings);
+    reader->strings = count ? calloc_or_die(count, sizeof(char const *)) : NULL;
+    reader->strings_count = count;
+    for (int i = 0; i < count; ++i) {
+        reader->strings[i] = binary_reader_string(reader);
+        if (!reader->strings[i]) set_error(reader);
+    }
+    if (reader->has_error) return false;
+    reader->offset = saved_offset;
+    return true;
+}
+
+
+char const *
+binary_reader_string(struct binary_reader *reader)
+{
+    unsigned length = binary_reader_uint(reader);
+    if (!length) return NULL;
+
+    --length;
+    if (reader->length - reader->offset <= length) {
+        set_error(reader);
+        return NULL;
+    }
+    char const *value = (char const *)reader->bytes + reader->offset;
+    if ('\0' != value[length] || memchr(value, '\0', length)) {
+        set_error(reader);
+        return NULL;
+    }
+    reader->offset += length + 1;
+    return value;
+}
+
+
+char const *
+binary_reader_string_ref(struct binary_reader *reader)
+{
+    unsigned index = binary_reader_uint(reader);
+    if (!index) return NULL;
+    if (index > (unsigned)reader->strings_count) {
+        set_error(reader);
+        return NULL;
+    }
+    return reader->strings[index - 1];
+}
+
+
+unsigned
+binary_reader_uint(struct binary_reader *reader)
+{
+    unsigned value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (reader->offset >= reader->length) break;
+        uint8_t byte = reader->bytes[reader->offset++];
+        if (28 == shift && byte > 0x0f) break;
+        value |= (unsigned)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    set_error(reader);
+    return 0;
+}
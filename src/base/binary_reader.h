@@ -0,0 +1,76 @@
+#ifndef FNF_BASE_BINARY_READER_H_INCLUDED
+#define FNF_BASE_BINARY_READER_H_INCLUDED
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+enum {
+    binary_reader_max_depth = 1000,
+};
+
+
+// Reads the encoding written by a binary_writer straight out of `bytes'
+// without copying it.  Strings are returned as pointers into `bytes', so
+// they are only valid as long as the buffer is.  Reading past the end or
+// reading a malformed value sets `has_error', after which every read
+// returns zero, false or NULL.
+struct binary_reader {
+    uint8_t const *bytes;
+    size_t length;
+    size_t offset;
+    bool has_error;
+    int depth;
+    char const **strings;
+    int strings_count;
+};
+
+
+void
+binary_reader_initialize(struct binary_reader *reader,
+                         uint8_t const *bytes,
+                         size_t length);
+
+void
+binary_reader_finalize(struct binary_reader *reader);
+
+// Call before reading a value that can contain values of the same kind.
+// Returns false and sets `has_error' when values nest too deep.
+bool
+binary_reader_begin_nested(struct binary_reader *reader);
+
+bool
+binary_reader_bool(struct binary_reader *reader);
+
+// Reads an element count, which can't be more than the bytes left since
+// every element takes at least one byte.
+int
+binary_reader_count(struct binary_reader *reader);
+
+void
+binary_reader_end_nested(struct binary_reader *reader);
+
+uint32_t
+binary_reader_fixed32(struct binary_reader *reader);
+
+int
+binary_reader_int(struct binary_reader *reader);
+
+// Reads a table written by binary_writer_string_table() at `offset' and
+// leaves the current offset where it was.
+bool
+binary_reader_read_string_table(struct binary_reader *reader, size_t offset);
+
+char const *
+binary_reader_string(struct binary_reader *reader);
+
+char const *
+binary_reader_string_ref(struct binary_reader *reader);
+
+unsigned
+binary_reader_uint(struct binary_reader *reader);
+
+
+#endif
@@ -0,0 +1,154 @@
+#include <assert.h>
+#include <limits.h>
+#include <base/base.h>
+
+
+void
+binary_reader_test(void);
+
+
+static void
+binary_reader_round_trip_test(void)
+{
+    struct binary_writer *writer = binary_writer_alloc();
+    binary_writer_uint(writer, 300);
+    binary_writer_int(writer, INT_MIN);
+    binary_writer_int(writer, INT_MAX);
+    binary_writer_int(writer, -7);
+    binary_writer_bool(writer, true);
+    binary_writer_fixed32(writer, 0xdeadbeef);
+    binary_writer_string(writer, "caf\xc3\xa9");
+    binary_writer_string(writer, NULL);
+    binary_writer_string_ref(writer, "ring");
+    binary_writer_string_ref(writer, NULL);
+    binary_writer_string_ref(writer, "ring");
+    size_t table_offset = writer->length;
+    binary_writer_string_table(writer);
+
+    struct binary_reader reader;
+    binary_reader_initialize(&reader, writer->bytes, writer->length);
+    assert(binary_reader_read_string_table(&reader, table_offset));
+    assert(0 == reader.offset);
+    assert(1 == reader.strings_count);
+
+    assert(300 == binary_reader_uint(&reader));
+    assert(INT_MIN == binary_reader_int(&reader));
+    assert(INT_MAX == binary_reader_int(&reader));
+    assert(-7 == binary_reader_int(&reader));
+    assert(binary_reader_bool(&reader));
+    assert(0xdeadbeef == binary_reader_fixed32(&reader));
+
+    char const *string = binary_reader_string(&reader);
+    assert(str_eq("caf\xc3\xa9", string));
+    assert((uint8_t const *)string > writer->bytes);
+    assert((uint8_t const *)string < writer->bytes + writer->length);
+    assert(NULL == binary_reader_string(&reader));
+
+    char const *ref = binary_reader_string_ref(&reader);
+    assert(str_eq("ring", ref));
+    assert(NULL == binary_reader_string_ref(&reader));
+    assert(ref == binary_reader_string_ref(&reader));
+
+    assert(table_offset == reader.offset);
+    assert( ! reader.has_error);
+
+    binary_reader_finalize(&reader);
+    binary_writer_free(writer);
+}
+
+
+static void
+binary_reader_begin_nested_test(void)
+{
+    struct binary_reader reader;
+    binary_reader_initialize(&reader, NULL, 0);
+    for (int i = 0; i < binary_reader_max_depth; ++i) {
+        assert(binary_reader_begin_nested(&reader));
+    }
+    assert( ! reader.has_error);
+    assert( ! binary_reader_begin_nested(&reader));
+    assert(reader.has_error);
+    binary_reader_end_nested(&reader);
+    assert(binary_reader_max_depth - 1 == reader.depth);
+    binary_reader_finalize(&reader);
+}
+
+
+static void
+binary_reader_truncated_test(void)
+{
+    uint8_t const bytes[] = { 0x80, 0x80 };
+    struct binary_reader reader;
+    binary_reader_initialize(&reader, bytes, sizeof bytes);
+    assert(0 == binary_reader_uint(&reader));
+    assert(reader.has_error);
+    assert( ! binary_reader_bool(&reader));
+    assert(0 == binary_reader_fixed32(&reader));
+    assert(NULL == binary_reader_string(&reader));
+    binary_reader_finalize(&reader);
+
+    uint8_t const string_bytes[] = { 0x05, 'r', 'i', 'n', 'g' };
+    binary_reader_initialize(&reader, string_bytes, sizeof string_bytes);
+    assert(NULL == binary_reader_string(&reader));
+    assert(reader.has_error);
+    binary_reader_finalize(&reader);
+}
+
+
+static void
+binary_reader_malformed_test(void)
+{
+    struct binary_reader reader;
+
+    uint8_t const too_long[] = { 0xff, 0xff, 0xff, 0xff, 0x1f };
+    binary_reader_initialize(&reader, too_long, sizeof too_long);
+    assert(0 == binary_reader_uint(&reader));
+    assert(reader.has_error);
+    binary_reader_finalize(&reader);
+
+    uint8_t const bad_bool[] = { 0x02 };
+    binary_reader_initialize(&reader, bad_bool, sizeof bad_bool);
+    assert( ! binary_reader_bool(&reader));
+    assert(reader.has_error);
+    binary_reader_finalize(&reader);
+
+    uint8_t const inner_nul[] = { 0x04, 'a', 0x00, 'b', 0x00 };
+    binary_reader_initialize(&reader, inner_nul, sizeof inner_nul);
+    assert(NULL == binary_reader_string(&reader));
+    assert(reader.has_error);
+    binary_reader_finalize(&reader);
+
+    uint8_t const missing_nul[] = { 0x02, 'a', 'b' };
+    binary_reader_initialize(&reader, missing_nul, sizeof missing_nul);
+    assert(NULL == binary_reader_string(&reader));
+    assert(reader.has_error);
+    binary_reader_finalize(&reader);
+
+    uint8_t const big_count[] = { 0x03, 0x00 };
+    binary_reader_initialize(&reader, big_count, sizeof big_count);
+    assert(0 == binary_reader_count(&reader));
+    assert(reader.has_error);
+    binary_reader_finalize(&reader);
+
+    uint8_t const bad_ref[] = { 0x02, 0x01, 0x02, 'a', 0x00 };
+    binary_reader_initialize(&reader, bad_ref, sizeof bad_ref);
+    assert(binary_reader_read_string_table(&reader, 1));
+    assert(NULL == binary_reader_string_ref(&reader));
+    assert(reader.has_error);
+    binary_reader_finalize(&reader);
+
+    uint8_t const bad_table[] = { 0x01, 0x00 };
+    binary_reader_initialize(&reader, bad_table, sizeof bad_table);
+    assert( ! binary_reader_read_string_table(&reader, 0));
+    binary_reader_finalize(&reader);
+}
+
+
+void
+binary_reader_test(void)
+{
+    binary_reader_round_trip_test();
+    binary_reader_begin_nested_test();
+    binary_reader_truncated_test();
+    binary_reader_malformed_test();
+}
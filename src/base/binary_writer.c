@@ -0,0 +1,218 @@
+#include "binary_writer.h"
+
+#include <assert.h>
+#include <string.h>
+#include <base/base.h>
+
+
+static size_t const initial_capacity = 256;
+static int const initial_string_slots_count = 64;
+
+
+static void
+add_string_slot(struct binary_writer *writer, int index);
+
+static uint32_t
+hash_string(char const *value);
+
+static uint8_t *
+reserve(struct binary_writer *writer, size_t count);
+
+
+static void
+add_string_slot(struct binary_writer *writer, int index)
+{
+    int mask = writer->string_slots_count - 1;
+    int slot = (int)(hash_string(writer->strings[index]) & (uint32_t)mask);
+    while (writer->string_slots[slot]) slot = (slot + 1) & mask;
+    writer->string_slots[slot] = index + 1;
+}
+
+
+static uint32_t
+hash_string(char const *value)
+{
+    uint32_t hash = 2166136261u;
+    for (unsigned char const *ch = (unsigned char const *)value; *ch; ++ch) {
+        hash = (hash ^ *ch) * 16777619u;
+    }
+    return hash;
+}
+
+
+static uint8_t *
+reserve(struct binary_writer *writer, size_t count)
+{
+    size_t needed = writer->length + count;
+    if (needed > writer->capacity) {
+        size_t capacity = writer->capacity * 2;
+        while (capacity < needed) capacity *= 2;
+        writer->bytes = realloc_or_die(writer->bytes, capacity);
+        writer->capacity = capacity;
+    }
+    return writer->bytes + writer->length;
+}
+
+
+struct binary_writer *
+binary_writer_alloc(void)
+{
+    struct binary_writer *writer = calloc_or_die(1, sizeof(struct binary_writer));
+    writer->bytes = calloc_or_die(initial_capacity, 1);
+    writer->capacity = initial_capacity;
+    writer->string_slots = calloc_or_die(initial_string_slots_count, sizeof(int));
+    writer->string_slots_count = initial_string_slots_count;
+    return writer;
+}
+
+
+void
+binary_writer_free(struct binary_writer *writer)
+{
+    if (writer) {
+        free_or_die(writer->bytes);
+        free_or_die(writer->strings);
+        free_or_die(writer->string_slots);
+        free_or_die(writer);
+    }
+}
+
+
+void
+binary_writer_bool(struct binary_writer *writer, bool value)
+{
+    uint8_t *end = reserve(writer, 1);
+    end[0] = value ? 1 : 0;
+    ++writer->length;
+}
+
+
+void
+binary_writer_bytes(struct binary_writer *writer,
+                    void const *bytes,
+                    size_t count)
+{
+    if (!count) return;
+    uint8_t *end = reserve(writer, count);
+    memcpy(end, bytes, count);
+    writer->length += count;
+}
+
+
+void
+binary_writer_clear(struct binary_writer *writer)
+{
+    writer->length = 0;
+    writer->strings_count = 0;
+    memset(writer->string_slots, 0, writer->string_slots_count * sizeof(int));
+}
+
+
+void
+binary_writer_fixed32(struct binary_writer *writer, uint32_t value)
+{
+    reserve(writer, 4);
+    writer->length += 4;
+    binary_writer_set_fixed32(writer, writer->length - 4, value);
+}
+
+
+void
+binary_writer_int(struct binary_writer *writer, int value)
+{
+    unsigned zigzag = ((unsigned)value << 1) ^ (value < 0 ? ~0u : 0u);
+    binary_writer_uint(writer, zigzag);
+}
+
+
+void
+binary_writer_set_fixed32(struct binary_writer *writer,
+                          size_t offset,
+                          uint32_t value)
+{
+    assert(offset + 4 <= writer->length);
+    for (int i = 0; i < 4; ++i) {
+        writer->bytes[offset + i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+
+void
+binary_writer_string(struct binary_writer *writer, char const *value)
+{
+    if (!value) {
+        binary_writer_uint(writer, 0);
+        return;
+    }
+    size_t length = strlen(value);
+    assert(length < UINT32_MAX);
+    binary_writer_uint(writer, (unsigned)length + 1);
+    binary_writer_bytes(writer, value, length + 1);
+}
+
+
+void
+binary_writer_string_ref(struct binary_writer *writer, char const *value)
+{
+    if (!value) {
+        binary_writer_uint(writer, 0);
+        return;
+    }
+
+    int mask = writer->string_slots_count - 1;
+    int slot = (int)(hash_string(value) & (uint32_t)mask);
+    while (writer->string_slots[slot]) {
+        int index = writer->string_slots[slot] - 1;
+        if (str_eq(value, writer->strings[index])) {
+            binary_writer_uint(writer, (unsigned)index + 1);
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if (writer->strings_count == writer->strings_capacity) {
+        writer->strings_capacity = writer->strings_capacity ? writer->strings_capacity * 2 : 16;
+        writer->strings = reallocarray_or_die(writer->strings,
+                                              writer->strings_capacity,
+                                              sizeof(char const *));
+    }
+    int index = writer->strings_count;
+    writer->strings[index] = value;
+    ++writer->strings_count;
+
+    if (2 * writer->strings_count > writer->string_slots_count) {
+        free_or_die(writer->string_slots);
+        writer->string_slots_count *= 2;
+        writer->string_slots = calloc_or_die(writer->string_slots_count, sizeof(int));
+        for (int i = 0; i < writer->strings_count; ++i) add_string_slot(writer, i);
+    } else {
+        writer->string_slots[slot] = index + 1;
+    }
+    binary_writer_uint(writer, (unsigned)index + 1);
+}
+
+
+void
+binary_writer_string_table(struct binary_writer *writer)
+{
+    binary_writer_uint(writer, (unsigned)writer->strings_count);
+    for (int i = 0; i < writer->strings_count; ++i) {
+        binary_writer_string(writer, writer->strings[i]);
+    }
+    writer->strings_count = 0;
+    memset(writer->string_slots, 0, writer->string_slots_count * sizeof(int));
+}
+
+
+void
+binary_writer_uint(struct binary_writer *writer, unsigned value)
+{
+    uint8_t *end = reserve(writer, 5);
+    int count = 0;
+    while (value >= 0x80) {
+        end[count++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    end[count++] = (uint8_t)value;
+    writer->length += count;
+}
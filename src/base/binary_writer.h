@@ -0,0 +1,77 @@
+#ifndef FNF_BASE_BINARY_WRITER_H_INCLUDED
+#define FNF_BASE_BINARY_WRITER_H_INCLUDED
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+// Writes a compact binary encoding into a growable buffer.  Integers are
+// LEB128 varints, signed ones zigzag encoded first.  Strings are written
+// inline as a varint of length + 1 (0 for NULL), the bytes and a NUL, so a
+// reader can hand out pointers into the buffer.  Repeated strings can
+// instead be written as references into a table that is appended with
+// binary_writer_string_table().
+struct binary_writer {
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+    char const **strings;
+    int strings_count;
+    int strings_capacity;
+    int *string_slots;
+    int string_slots_count;
+};
+
+
+struct binary_writer *
+binary_writer_alloc(void);
+
+void
+binary_writer_free(struct binary_writer *writer);
+
+void
+binary_writer_bool(struct binary_writer *writer, bool value);
+
+void
+binary_writer_bytes(struct binary_writer *writer,
+                    void const *bytes,
+                    size_t count);
+
+// Empties the buffer and the string table so the writer can be reused.
+void
+binary_writer_clear(struct binary_writer *writer);
+
+// Writes four bytes, least significant first.
+void
+binary_writer_fixed32(struct binary_writer *writer, uint32_t value);
+
+void
+binary_writer_int(struct binary_writer *writer, int value);
+
+// Overwrites four bytes written earlier by binary_writer_fixed32().
+void
+binary_writer_set_fixed32(struct binary_writer *writer,
+                          size_t offset,
+                          uint32_t value);
+
+void
+binary_writer_string(struct binary_writer *writer, char const *value);
+
+// Writes the position of `value' in the string table plus one, or 0 for
+// NULL.  The string is not copied and must stay valid until
+// binary_writer_string_table() is called.
+void
+binary_writer_string_ref(struct binary_writer *writer, char const *value);
+
+// Writes the count of strings referenced since the last table followed by
+// each string, then empties the table.
+void
+binary_writer_string_table(struct binary_writer *writer);
+
+void
+binary_writer_uint(struct binary_writer *writer, unsigned value);
+
+
+#endif
@@ -0,0 +1,171 @@
+#include <assert.h>
+#include <limits.h>
+#include <string.h>
+#include <base/base.h>
+
+
+void
+binary_writer_test(void);
+
+
+static void
+binary_writer_uint_test(void)
+{
+    struct binary_writer *writer = binary_writer_alloc();
+
+    binary_writer_uint(writer, 0);
+    binary_writer_uint(writer, 127);
+    binary_writer_uint(writer, 128);
+    binary_writer_uint(writer, 300);
+    binary_writer_uint(writer, UINT_MAX);
+
+    uint8_t const expected[] = {
+        0x00,
+        0x7f,
+        0x80, 0x01,
+        0xac, 0x02,
+        0xff, 0xff, 0xff, 0xff, 0x0f,
+    };
+    assert(sizeof expected == writer->length);
+    assert(0 == memcmp(expected, writer->bytes, sizeof expected));
+
+    binary_writer_free(writer);
+}
+
+
+static void
+binary_writer_int_test(void)
+{
+    struct binary_writer *writer = binary_writer_alloc();
+
+    binary_writer_int(writer, 0);
+    binary_writer_int(writer, -1);
+    binary_writer_int(writer, 1);
+    binary_writer_int(writer, -64);
+    binary_writer_int(writer, 64);
+    binary_writer_int(writer, INT_MIN);
+
+    uint8_t const expected[] = {
+        0x00,
+        0x01,
+        0x02,
+        0x7f,
+        0x80, 0x01,
+        0xff, 0xff, 0xff, 0xff, 0x0f,
+    };
+    assert(sizeof expected == writer->length);
+    assert(0 == memcmp(expected, writer->bytes, sizeof expected));
+
+    binary_writer_free(writer);
+}
+
+
+static void
+binary_writer_fixed32_test(void)
+{
+    struct binary_writer *writer = binary_writer_alloc();
+
+    binary_writer_bool(writer, true);
+    binary_writer_fixed32(writer, 0);
+    binary_writer_bool(writer, false);
+    binary_writer_set_fixed32(writer, 1, 0x12345678);
+
+    uint8_t const expected[] = { 0x01, 0x78, 0x56, 0x34, 0x12, 0x00 };
+    assert(sizeof expected == writer->length);
+    assert(0 == memcmp(expected, writer->bytes, sizeof expected));
+
+    binary_writer_free(writer);
+}
+
+
+static void
+binary_writer_string_test(void)
+{
+    struct binary_writer *writer = binary_writer_alloc();
+
+    binary_writer_string(writer, NULL);
+    binary_writer_string(writer, "");
+    binary_writer_string(writer, "gem");
+
+    uint8_t const expected[] = { 0x00, 0x01, 0x00, 0x04, 'g', 'e', 'm', 0x00 };
+    assert(sizeof expected == writer->length);
+    assert(0 == memcmp(expected, writer->bytes, sizeof expected));
+
+    binary_writer_free(writer);
+}
+
+
+static void
+binary_writer_string_ref_test(void)
+{
+    struct binary_writer *writer = binary_writer_alloc();
+
+    char copy[] = "ring";
+    binary_writer_string_ref(writer, "ring");
+    binary_writer_string_ref(writer, NULL);
+    binary_writer_string_ref(writer, "potion");
+    binary_writer_string_ref(writer, copy);
+    binary_writer_string_table(writer);
+
+    uint8_t const expected[] = {
+        0x01, 0x00, 0x02, 0x01,
+        0x02,
+        0x05, 'r', 'i', 'n', 'g', 0x00,
+        0x07, 'p', 'o', 't', 'i', 'o', 'n', 0x00,
+    };
+    assert(sizeof expected == writer->length);
+    assert(0 == memcmp(expected, writer->bytes, sizeof expected));
+    assert(0 == writer->strings_count);
+
+    binary_writer_string_ref(writer, "potion");
+    assert(1 == writer->bytes[writer->length - 1]);
+
+    binary_writer_clear(writer);
+    assert(0 == writer->length);
+    assert(0 == writer->strings_count);
+    binary_writer_string_ref(writer, "potion");
+    assert(1 == writer->length);
+    assert(1 == writer->bytes[0]);
+
+    binary_writer_free(writer);
+}
+
+
+static void
+binary_writer_string_ref_for_many_strings_test(void)
+{
+    struct binary_writer *writer = binary_writer_alloc();
+
+    char *strings[500];
+    for (int i = 0; i < 500; ++i) {
+        strings[i] = str_alloc_formatted("string %i", i);
+        binary_writer_string_ref(writer, strings[i]);
+    }
+    for (int i = 0; i < 500; ++i) {
+        binary_writer_string_ref(writer, strings[i]);
+    }
+    assert(500 == writer->strings_count);
+
+    struct binary_reader reader;
+    binary_reader_initialize(&reader, writer->bytes, writer->length);
+    for (int i = 0; i < 1000; ++i) {
+        assert((unsigned)(i % 500) + 1 == binary_reader_uint(&reader));
+    }
+    assert(writer->length == reader.offset);
+    binary_reader_finalize(&reader);
+
+    for (int i = 0; i < 500; ++i) free_or_die(strings[i]);
+    binary_writer_free(writer);
+}
+
+
+void
+binary_writer_test(void)
+{
+    binary_writer_uint_test();
+    binary_writer_int_test();
+    binary_writer_fixed32_test();
+    binary_writer_string_test();
+    binary_writer_string_ref_test();
+    binary_writer_string_ref_for_many_strings_test();
+}
@@ -7,6 +7,9 @@ fill(int *values, int count);
 extern inline void
 fill_shuffled(struct rnd *rnd, int *values, int count);
 
+extern inline int
+floor_to_multiple(int value, int multiple);
+
 extern inline int
 max(int i, int j);
 
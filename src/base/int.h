@@ -18,6 +18,15 @@ fill_shuffled(struct rnd *rnd, int *values, int count)
     rnd_shuffle(rnd, values, count, sizeof(int));
 }
 
+// Rounds down towards negative infinity; `multiple' must be positive.
+inline int
+floor_to_multiple(int value, int multiple)
+{
+    int remainder = value % multiple;
+    if (remainder < 0) remainder += multiple;
+    return value - remainder;
+}
+
 inline int
 max(int i, int j)
 {
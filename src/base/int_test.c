@@ -21,6 +21,18 @@ fill_test(void)
 }
 
 
+static void
+floor_to_multiple_test(void)
+{
+    assert(0 == floor_to_multiple(0, 16));
+    assert(0 == floor_to_multiple(15, 16));
+    assert(16 == floor_to_multiple(16, 16));
+    assert(-16 == floor_to_multiple(-1, 16));
+    assert(-16 == floor_to_multiple(-16, 16));
+    assert(-32 == floor_to_multiple(-17, 16));
+}
+
+
 static void
 fill_shuffled_test(void)
 {
@@ -90,6 +102,7 @@ int_test(void)
 {
     fill_test();
     fill_shuffled_test();
+    floor_to_multiple_test();
     max_test();
     min_test();
     swap_test();
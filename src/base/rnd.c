@@ -31,7 +31,14 @@
 #include "alloc_or_die.h"
 
 
-typedef uint32_t next_value_fn(void *user_data);
+static uint64_t const splitmix64_gamma = 0x9e3779b97f4a7c15;
+static uint64_t const substream_gamma = 0xd1b54a32d192ed03;
+
+
+struct splitmix64_state {
+    uint64_t seed;
+    uint64_t counter;
+};
 
 
 static uint32_t
@@ -44,6 +51,9 @@ struct rnd *const global_rnd = &((struct rnd){
     .user_data=NULL,
     .next_uniform_value_in_range=next_arc4random_uniform_value_in_range,
     .free_user_data=NULL,
+    .alloc_substream=NULL,
+    .jump=NULL,
+    .fill_values=NULL,
 });
 
 
@@ -83,41 +93,102 @@ next_arc4random_uniform_value_in_range(void *user_data,
 }
 
 
-static uint32_t
-next_uniform_value(next_value_fn next_value,
-                   void *user_data,
-                   uint32_t normalized_exclusive_upper_bound)
+static inline uint32_t
+next_cached_value(struct rnd *rnd)
+{
+    if (!rnd->values_remaining) {
+        rnd->fill_values(rnd->user_data, rnd->values, rnd_values_capacity);
+        rnd->values_remaining = rnd_values_capacity;
+    }
+    uint32_t value = rnd->values[rnd_values_capacity - rnd->values_remaining];
+    --rnd->values_remaining;
+    return value;
+}
+
+
+static inline uint32_t
+largest_multiple(uint32_t normalized_exclusive_upper_bound)
 {
     uint32_t modulo_bias = UINT32_MAX % normalized_exclusive_upper_bound;
-    uint32_t largest_multiple = UINT32_MAX - modulo_bias;
+    return UINT32_MAX - modulo_bias;
+}
+
+
+static inline uint32_t
+next_uniform_value_by_modulo(struct rnd *rnd,
+                             uint32_t normalized_exclusive_upper_bound,
+                             uint32_t largest_multiple)
+{
     uint32_t value;
     do {
-        value = next_value(user_data);
+        value = next_cached_value(rnd);
     } while (value > largest_multiple);
     return value % normalized_exclusive_upper_bound;
 }
 
 
-static uint32_t
-next_uniform_value_in_range(next_value_fn next_value,
-                            void *user_data,
+// Lemire's nearly divisionless method https://arxiv.org/abs/1805.10941
+static inline uint32_t
+next_uniform_value_by_multiplying(struct rnd *rnd,
+                                  uint32_t normalized_exclusive_upper_bound)
+{
+    uint64_t product = (uint64_t)next_cached_value(rnd)
+                     * normalized_exclusive_upper_bound;
+    uint32_t low_bits = (uint32_t)product;
+    if (low_bits < normalized_exclusive_upper_bound) {
+        uint32_t threshold = -normalized_exclusive_upper_bound
+                           % normalized_exclusive_upper_bound;
+        while (low_bits < threshold) {
+            product = (uint64_t)next_cached_value(rnd)
+                    * normalized_exclusive_upper_bound;
+            low_bits = (uint32_t)product;
+        }
+    }
+    return (uint32_t)(product >> 32);
+}
+
+
+static inline uint32_t
+next_uniform_value_in_range(struct rnd *rnd,
                             uint32_t inclusive_lower_bound,
                             uint32_t inclusive_upper_bound)
 {
+    if (!rnd->fill_values) {
+        return rnd->next_uniform_value_in_range(rnd->user_data,
+                                                inclusive_lower_bound,
+                                                inclusive_upper_bound);
+    }
     if (0 == inclusive_lower_bound && UINT32_MAX == inclusive_upper_bound) {
-        return next_value(user_data);
+        return next_cached_value(rnd);
+    }
+    uint32_t normalized_exclusive_upper_bound = inclusive_upper_bound
+                                              - inclusive_lower_bound
+                                              + 1;
+    if (rnd_sampling_multiply == rnd->sampling) {
+        return inclusive_lower_bound
+             + next_uniform_value_by_multiplying(rnd,
+                                                 normalized_exclusive_upper_bound);
     } else {
-        uint32_t normalized_exclusive_upper_bound = inclusive_upper_bound
-                                                    - inclusive_lower_bound
-                                                    + 1;
         return inclusive_lower_bound
-               + next_uniform_value(next_value,
-                                    user_data,
-                                    normalized_exclusive_upper_bound);
+             + next_uniform_value_by_modulo(rnd,
+                                            normalized_exclusive_upper_bound,
+                                            largest_multiple(normalized_exclusive_upper_bound));
     }
 }
 
 
+static struct rnd *
+alloc_with_fill_values(void (*fill_values)(void *, uint32_t [], int),
+                       enum rnd_sampling sampling,
+                       size_t user_data_size)
+{
+    struct rnd *rnd = alloc_with_user_data_size(user_data_size);
+    rnd->fill_values = fill_values;
+    rnd->sampling = sampling;
+    return rnd;
+}
+
+
 struct rnd *
 rnd_alloc(void)
 {
@@ -244,44 +315,68 @@ rnd_alloc_fake_min(void)
 }
 
 
-static uint32_t
-next_jrand48_value(void *user_data)
+static void
+fill_jrand48_values(void *user_data, uint32_t values[], int count)
 {
     unsigned short *state = user_data;
-    return (uint32_t)jrand48(state);
+    for (int i = 0; i < count; ++i) {
+        values[i] = (uint32_t)jrand48(state);
+    }
 }
 
 
-static uint32_t
-next_jrand48_uniform_value_in_range(void *user_data,
-                                    uint32_t inclusive_lower_bound,
-                                    uint32_t inclusive_upper_bound)
+static void
+fill_lcg_values(void *user_data, uint32_t values[], int count)
 {
-    return next_uniform_value_in_range(next_jrand48_value,
-                                       user_data,
-                                       inclusive_lower_bound,
-                                       inclusive_upper_bound);
+    uint32_t *state = user_data;
+    for (int i = 0; i < count; ++i) {
+        *state = *state * 1103515245 + 12345;
+        values[i] = *state / 65536 % 32768;
+    }
 }
 
 
-static uint32_t
-next_lcg_value(void *user_data)
+static uint64_t
+mix64(uint64_t value)
 {
-    uint32_t *state = user_data;
-    *state = *state * 1103515245 + 12345;
-    return *state / 65536 % 32768;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+    return value ^ (value >> 31);
 }
 
 
-static uint32_t
-next_lcg_uniform_value_in_range(void *user_data,
-                                uint32_t inclusive_lower_bound,
-                                uint32_t inclusive_upper_bound)
+static uint64_t
+substream_seed(uint64_t seed, uint64_t index)
 {
-    return next_uniform_value_in_range(next_lcg_value,
-                                       user_data,
-                                       inclusive_lower_bound,
-                                       inclusive_upper_bound);
+    return mix64(mix64(seed) + (index + 1) * substream_gamma);
+}
+
+
+static void
+fill_splitmix64_values(void *user_data, uint32_t values[], int count)
+{
+    struct splitmix64_state *state = user_data;
+    for (int i = 0; i < count; ++i) {
+        ++state->counter;
+        uint64_t value = mix64(state->seed + state->counter * splitmix64_gamma);
+        values[i] = (uint32_t)(value >> 32);
+    }
+}
+
+
+static struct rnd *
+alloc_splitmix64_substream(void const *user_data, uint64_t index)
+{
+    struct splitmix64_state const *state = user_data;
+    return rnd_alloc_splitmix64(substream_seed(state->seed, index));
+}
+
+
+static void
+jump_splitmix64(void *user_data, uint64_t count)
+{
+    struct splitmix64_state *state = user_data;
+    state->counter += count;
 }
 
 
@@ -290,11 +385,13 @@ rnd_alloc_jrand48(unsigned short const state[3])
 {
     size_t state_size = sizeof(unsigned short[3]);
     
-    struct rnd *rnd = alloc_with_user_data_size(state_size);
+    // modulo sampling keeps the values for existing seeds
+    struct rnd *rnd = alloc_with_fill_values(fill_jrand48_values,
+                                             rnd_sampling_modulo,
+                                             state_size);
     if (!rnd) return NULL;
     
     memcpy(rnd->user_data, state, state_size);
-    rnd->next_uniform_value_in_range = next_jrand48_uniform_value_in_range;
     
     return rnd;
 }
@@ -305,16 +402,46 @@ rnd_alloc_lcg(uint32_t state)
 {
     size_t state_size = sizeof state;
 
-    struct rnd *rnd = alloc_with_user_data_size(state_size);
+    struct rnd *rnd = alloc_with_fill_values(fill_lcg_values,
+                                             rnd_sampling_modulo,
+                                             state_size);
     if (!rnd) return NULL;
 
     memcpy(rnd->user_data, &state, state_size);
-    rnd->next_uniform_value_in_range = next_lcg_uniform_value_in_range;
 
     return rnd;
 }
 
 
+struct rnd *
+rnd_alloc_splitmix64(uint64_t seed)
+{
+    struct rnd *rnd = alloc_with_fill_values(fill_splitmix64_values,
+                                             rnd_sampling_multiply,
+                                             sizeof(struct splitmix64_state));
+    if (!rnd) return NULL;
+
+    struct splitmix64_state *state = rnd->user_data;
+    state->seed = seed;
+    rnd->alloc_substream = alloc_splitmix64_substream;
+    rnd->jump = jump_splitmix64;
+
+    return rnd;
+}
+
+
+struct rnd *
+rnd_alloc_substream(struct rnd *parent, uint64_t index)
+{
+    if (parent->alloc_substream) {
+        return parent->alloc_substream(parent->user_data, index);
+    }
+    uint64_t seed = (uint64_t)rnd_next_value(parent) << 32;
+    seed |= rnd_next_value(parent);
+    return rnd_alloc_splitmix64(substream_seed(seed, index));
+}
+
+
 void
 rnd_free(struct rnd *rnd)
 {
@@ -326,10 +453,76 @@ rnd_free(struct rnd *rnd)
 }
 
 
+void
+rnd_fill_uniform(struct rnd *rnd,
+                 uint32_t inclusive_lower_bound,
+                 uint32_t inclusive_upper_bound,
+                 uint32_t values[],
+                 uint32_t count)
+{
+    if (inclusive_upper_bound <= inclusive_lower_bound) {
+        for (uint32_t i = 0; i < count; ++i) {
+            values[i] = inclusive_lower_bound;
+        }
+        return;
+    }
+
+    if (!rnd->fill_values
+        || (0 == inclusive_lower_bound && UINT32_MAX == inclusive_upper_bound))
+    {
+        for (uint32_t i = 0; i < count; ++i) {
+            values[i] = next_uniform_value_in_range(rnd,
+                                                    inclusive_lower_bound,
+                                                    inclusive_upper_bound);
+        }
+        return;
+    }
+
+    uint32_t normalized_exclusive_upper_bound = inclusive_upper_bound
+                                              - inclusive_lower_bound
+                                              + 1;
+    if (rnd_sampling_multiply == rnd->sampling) {
+        for (uint32_t i = 0; i < count; ++i) {
+            values[i] = inclusive_lower_bound
+                      + next_uniform_value_by_multiplying(rnd,
+                                                          normalized_exclusive_upper_bound);
+        }
+    } else {
+        uint32_t multiple = largest_multiple(normalized_exclusive_upper_bound);
+        for (uint32_t i = 0; i < count; ++i) {
+            values[i] = inclusive_lower_bound
+                      + next_uniform_value_by_modulo(rnd,
+                                                     normalized_exclusive_upper_bound,
+                                                     multiple);
+        }
+    }
+}
+
+
+void
+rnd_jump(struct rnd *rnd, uint64_t count)
+{
+    if (rnd->jump) {
+        // cached values come first
+        if (count <= (uint64_t)rnd->values_remaining) {
+            rnd->values_remaining -= (int)count;
+            return;
+        }
+        count -= rnd->values_remaining;
+        rnd->values_remaining = 0;
+        rnd->jump(rnd->user_data, count);
+    } else {
+        for (uint64_t i = 0; i < count; ++i) {
+            rnd_next_value(rnd);
+        }
+    }
+}
+
+
 uint32_t
 rnd_next_value(struct rnd *rnd)
 {
-    return rnd->next_uniform_value_in_range(rnd->user_data, 0, UINT32_MAX);
+    return next_uniform_value_in_range(rnd, 0, UINT32_MAX);
 }
 
 
@@ -338,9 +531,7 @@ rnd_next_uniform_value(struct rnd *rnd,
                        uint32_t normalized_exclusive_upper_bound)
 {
     if (normalized_exclusive_upper_bound <= 1) return 0;
-    return rnd->next_uniform_value_in_range(rnd->user_data,
-                                            0,
-                                            normalized_exclusive_upper_bound - 1);
+    return next_uniform_value_in_range(rnd, 0, normalized_exclusive_upper_bound - 1);
 }
 
 
@@ -352,9 +543,9 @@ rnd_next_uniform_value_in_range(struct rnd *rnd,
     if (inclusive_upper_bound <= inclusive_lower_bound) {
         return inclusive_lower_bound;
     }
-    return rnd->next_uniform_value_in_range(rnd->user_data,
-                                            inclusive_lower_bound,
-                                            inclusive_upper_bound);
+    return next_uniform_value_in_range(rnd,
+                                       inclusive_lower_bound,
+                                       inclusive_upper_bound);
 }
 
 
@@ -372,7 +563,7 @@ rnd_shuffle(struct rnd *rnd,
     char temp[item_size];
     for (uint32_t i = 0; i < item_count - 1; ++i) {
         uint32_t exclusive_upper_bound = (uint32_t)item_count - i;
-        uint32_t j = rnd_next_uniform_value(rnd, exclusive_upper_bound);
+        uint32_t j = next_uniform_value_in_range(rnd, 0, exclusive_upper_bound - 1);
         void *item_i = items + (i * item_size);
         void *item_j = items + ((i + j) * item_size);
         memcpy(temp, item_i, item_size);
@@ -29,12 +29,37 @@
 #include <stdint.h>
 
 
+enum {
+    rnd_values_capacity = 64,
+};
+
+
+// How a generator that fills `values' maps them into a range.
+enum rnd_sampling {
+    rnd_sampling_none = 0,
+    // reject values above the largest multiple of the range and take the
+    // remainder of the rest
+    rnd_sampling_modulo,
+    // Lemire's nearly divisionless multiply and shift
+    rnd_sampling_multiply,
+};
+
+
+// Generators either produce values in a range directly through
+// `next_uniform_value_in_range' or produce raw 32-bit values in bulk through
+// `fill_values', which are cached in `values' and sampled in rnd.c.
 struct rnd {
     void *user_data;
     uint32_t (*next_uniform_value_in_range)(void *user_data,
                                             uint32_t inclusive_lower_bound,
                                             uint32_t inclusive_upper_bound);
     void (*free_user_data)(void *user_data);
+    struct rnd *(*alloc_substream)(void const *user_data, uint64_t index);
+    void (*jump)(void *user_data, uint64_t count);
+    void (*fill_values)(void *user_data, uint32_t values[], int count);
+    enum rnd_sampling sampling;
+    int values_remaining;
+    uint32_t values[rnd_values_capacity];
 };
 
 
@@ -69,9 +94,36 @@ rnd_alloc_jrand48(unsigned short const state[3]);
 struct rnd *
 rnd_alloc_lcg(uint32_t state);
 
+// A counter based generator.  The i-th value is the upper 32 bits of the
+// i-th SplitMix64 output for `seed', so it's the same on every platform and
+// can jump ahead or split into substreams without generating values.
+// https://prng.di.unimi.it/splitmix64.c
+struct rnd *
+rnd_alloc_splitmix64(uint64_t seed);
+
+// Allocates the stream numbered `index' derived from `parent'.  For splitmix64
+// generators, the substream depends only on the parent's seed and `index' and
+// the parent isn't changed, so substreams can be allocated on any thread in
+// any order.  Other generators seed the substream from their next values.
+struct rnd *
+rnd_alloc_substream(struct rnd *parent, uint64_t index);
+
+// Fills `values' with `count' values in the range.  The values are the same
+// as from `count' calls to rnd_next_uniform_value_in_range().
+void
+rnd_fill_uniform(struct rnd *rnd,
+                 uint32_t inclusive_lower_bound,
+                 uint32_t inclusive_upper_bound,
+                 uint32_t values[],
+                 uint32_t count);
+
 void
 rnd_free(struct rnd *rnd);
 
+// Skips the next `count' raw values.
+void
+rnd_jump(struct rnd *rnd, uint64_t count);
+
 uint32_t
 rnd_next_value(struct rnd *rnd);
 
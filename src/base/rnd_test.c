@@ -244,6 +244,186 @@ rnd_alloc_lcg_range_test(void)
 }
 
 
+static void
+rnd_alloc_splitmix64_test(void)
+{
+    struct rnd *rnd = rnd_alloc_splitmix64(0);
+
+    uint32_t value = rnd_next_value(rnd);
+    assert(3793791033 == value);
+
+    value = rnd_next_value(rnd);
+    assert(1853398634 == value);
+
+    value = rnd_next_value(rnd);
+    assert(113532184 == value);
+
+    rnd_free(rnd);
+}
+
+
+static void
+rnd_alloc_splitmix64_range_test(void)
+{
+    struct rnd *rnd = rnd_alloc_splitmix64(0);
+
+    // (3793791033 * 4) >> 32 is 3, plus the lower bound
+    uint32_t value = rnd_next_uniform_value_in_range(rnd, 2, 5);
+    assert(5 == value);
+
+    value = rnd_next_uniform_value_in_range(rnd, 2, 5);
+    assert(3 == value);
+
+    value = rnd_next_uniform_value_in_range(rnd, 2, 5);
+    assert(2 == value);
+
+    for (int i = 0; i < 1000; ++i) {
+        value = rnd_next_uniform_value_in_range(rnd, 2, 5);
+        assert(value >= 2 && value <= 5);
+    }
+
+    rnd_free(rnd);
+}
+
+
+static void
+rnd_alloc_substream_test(void)
+{
+    struct rnd *parent = rnd_alloc_splitmix64(12345);
+    struct rnd *substream_1 = rnd_alloc_substream(parent, 1);
+    struct rnd *substream_2 = rnd_alloc_substream(parent, 2);
+
+    // allocating substreams doesn't change the parent
+    assert(571572824 == rnd_next_value(parent));
+
+    // substreams depend only on the parent's seed and the index
+    struct rnd *again = rnd_alloc_substream(parent, 1);
+    for (int i = 0; i < 100; ++i) {
+        assert(rnd_next_value(substream_1) == rnd_next_value(again));
+    }
+
+    bool all_equal = true;
+    for (int i = 0; i < 100; ++i) {
+        if (rnd_next_value(substream_1) != rnd_next_value(substream_2)) {
+            all_equal = false;
+        }
+    }
+    assert(!all_equal);
+
+    rnd_free(again);
+    rnd_free(substream_2);
+    rnd_free(substream_1);
+    rnd_free(parent);
+}
+
+
+static void
+rnd_alloc_substream_of_jrand48_test(void)
+{
+    struct rnd *parent = rnd_alloc_jrand48((unsigned short[]){ 2, 3, 5 });
+    struct rnd *substream = rnd_alloc_substream(parent, 0);
+
+    // the substream is seeded from the parent's next two values
+    uint32_t value = rnd_next_value(parent);
+    assert(3263372418 == value);
+
+    struct rnd *other_parent = rnd_alloc_jrand48((unsigned short[]){ 2, 3, 5 });
+    struct rnd *same = rnd_alloc_substream(other_parent, 0);
+    for (int i = 0; i < 100; ++i) {
+        assert(rnd_next_value(substream) == rnd_next_value(same));
+    }
+
+    rnd_free(same);
+    rnd_free(other_parent);
+    rnd_free(substream);
+    rnd_free(parent);
+}
+
+
+static void
+assert_fill_uniform_matches_next_values(struct rnd *rnd1, struct rnd *rnd2)
+{
+    uint32_t values[200];
+    rnd_fill_uniform(rnd1, 1, 6, values, 200);
+    for (int i = 0; i < 200; ++i) {
+        assert(values[i] == rnd_next_uniform_value_in_range(rnd2, 1, 6));
+    }
+
+    rnd_fill_uniform(rnd1, 10, 10, values, 3);
+    assert(10 == values[0] && 10 == values[1] && 10 == values[2]);
+
+    rnd_fill_uniform(rnd1, 0, UINT32_MAX, values, 100);
+    for (int i = 0; i < 100; ++i) {
+        assert(values[i] == rnd_next_value(rnd2));
+    }
+}
+
+
+static void
+rnd_fill_uniform_test(void)
+{
+    struct rnd *rnd1 = rnd_alloc_jrand48((unsigned short[]){ 2, 3, 5 });
+    struct rnd *rnd2 = rnd_alloc_jrand48((unsigned short[]){ 2, 3, 5 });
+    assert_fill_uniform_matches_next_values(rnd1, rnd2);
+    rnd_free(rnd2);
+    rnd_free(rnd1);
+
+    rnd1 = rnd_alloc_splitmix64(12345);
+    rnd2 = rnd_alloc_splitmix64(12345);
+    assert_fill_uniform_matches_next_values(rnd1, rnd2);
+    rnd_free(rnd2);
+    rnd_free(rnd1);
+
+    rnd1 = rnd_alloc_fake_ascending(3);
+    rnd2 = rnd_alloc_fake_ascending(3);
+    assert_fill_uniform_matches_next_values(rnd1, rnd2);
+    rnd_free(rnd2);
+    rnd_free(rnd1);
+}
+
+
+static void
+rnd_jump_test(void)
+{
+    struct rnd *rnd = rnd_alloc_splitmix64(12345);
+    struct rnd *expected = rnd_alloc_splitmix64(12345);
+
+    rnd_jump(rnd, 1000);
+    for (int i = 0; i < 1000; ++i) {
+        rnd_next_value(expected);
+    }
+    for (int i = 0; i < 100; ++i) {
+        assert(rnd_next_value(expected) == rnd_next_value(rnd));
+    }
+
+    // jumps within and past the cached values
+    rnd_jump(rnd, 3);
+    rnd_jump(rnd, rnd_values_capacity);
+    for (int i = 0; i < 3 + rnd_values_capacity; ++i) {
+        rnd_next_value(expected);
+    }
+    for (int i = 0; i < 100; ++i) {
+        assert(rnd_next_value(expected) == rnd_next_value(rnd));
+    }
+
+    rnd_free(expected);
+    rnd_free(rnd);
+}
+
+
+static void
+rnd_jump_ascending_test(void)
+{
+    struct rnd *rnd = rnd_alloc_fake_ascending(3);
+
+    rnd_jump(rnd, 4);
+    uint32_t value = rnd_next_value(rnd);
+    assert(7 == value);
+
+    rnd_free(rnd);
+}
+
+
 static void
 rnd_next_uniform_value_test(void)
 {
@@ -340,6 +520,13 @@ rnd_test(void)
     rnd_alloc_jrand48_range_test();
     rnd_alloc_lcg_test();
     rnd_alloc_lcg_range_test();
+    rnd_alloc_splitmix64_test();
+    rnd_alloc_splitmix64_range_test();
+    rnd_alloc_substream_test();
+    rnd_alloc_substream_of_jrand48_test();
+    rnd_fill_uniform_test();
+    rnd_jump_test();
+    rnd_jump_ascending_test();
     rnd_next_uniform_value_test();
     rnd_next_uniform_value_in_range_test();
     rnd_shuffle_test();
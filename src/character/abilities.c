@@ -2,17 +2,42 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <base/base.h>
 #include <mechanics/mechanics.h>
 
 
+enum {
+    abilities_count = 6,
+    batch_chunk_count = 64,
+};
+
+
+static void
+adjust_die_scores(int die_scores[], int const adjusted_scores[], int count);
+
+static int
+dice_per_character(enum ability_score_generation_method method);
+
+static int
+highest_score(int const scores[], int scores_count);
+
+static void
+sort_descending(int scores[], int scores_count);
+
 static int
 special_NPC_roll(struct rnd *rnd,
                  enum ability_flag flags,
                  enum ability_flag flag);
 
+static void
+sum_three_dice(int const die_scores[],
+               int stride,
+               int count,
+               int scores[]);
+
 
 struct abilities *
 abilities_alloc(struct rnd *rnd)
@@ -46,43 +71,18 @@ abilities_alloc_general_NPC(struct rnd *rnd)
 struct abilities *
 abilities_alloc_method_3(struct rnd *rnd)
 {
+    // each ability is the best of six rolls of 3d6
+    struct dice threeD6 = dice_make(3, 6);
+    int scores[6][6];
+    dice_roll_keep_batch(threeD6, rnd, threeD6.count, 0, &scores[0][0], 6 * 6);
+
     struct abilities *abilities = calloc_or_die(1, sizeof(struct abilities));
-    for (int i = 0; i < 6; ++i) {
-        int ability = roll("3d6", rnd);
-        if (ability > abilities->strength) {
-            abilities->strength = ability;
-        }
-    }
-    for (int i = 0; i < 6; ++i) {
-        int ability = roll("3d6", rnd);
-        if (ability > abilities->intelligence) {
-            abilities->intelligence = ability;
-        }
-    }
-    for (int i = 0; i < 6; ++i) {
-        int ability = roll("3d6", rnd);
-        if (ability > abilities->wisdom) {
-            abilities->wisdom = ability;
-        }
-    }
-    for (int i = 0; i < 6; ++i) {
-        int ability = roll("3d6", rnd);
-        if (ability > abilities->dexterity) {
-            abilities->dexterity = ability;
-        }
-    }
-    for (int i = 0; i < 6; ++i) {
-        int ability = roll("3d6", rnd);
-        if (ability > abilities->constitution) {
-            abilities->constitution = ability;
-        }
-    }
-    for (int i = 0; i < 6; ++i) {
-        int ability = roll("3d6", rnd);
-        if (ability > abilities->charisma) {
-            abilities->charisma = ability;
-        }
-    }
+    abilities->strength = highest_score(scores[0], 6);
+    abilities->intelligence = highest_score(scores[1], 6);
+    abilities->wisdom = highest_score(scores[2], 6);
+    abilities->dexterity = highest_score(scores[3], 6);
+    abilities->constitution = highest_score(scores[4], 6);
+    abilities->charisma = highest_score(scores[5], 6);
     return abilities;
 }
 
@@ -102,6 +102,33 @@ abilities_alloc_special_NPC(struct rnd *rnd,
 }
 
 
+struct abilities_batch *
+abilities_batch_alloc(int capacity)
+{
+    assert(capacity > 0);
+    struct abilities_batch *batch = calloc_or_die(1, sizeof(struct abilities_batch));
+    int *values = calloc_or_die(capacity, abilities_count * sizeof(int));
+    batch->capacity = capacity;
+    batch->strength = values;
+    batch->intelligence = values + capacity;
+    batch->wisdom = values + 2 * capacity;
+    batch->dexterity = values + 3 * capacity;
+    batch->constitution = values + 4 * capacity;
+    batch->charisma = values + 5 * capacity;
+    return batch;
+}
+
+
+void
+abilities_batch_free(struct abilities_batch *batch)
+{
+    if (batch) {
+        free_or_die(batch->strength);
+        free_or_die(batch);
+    }
+}
+
+
 int
 abilities_compare(struct abilities const *first,
                   struct abilities const *second)
@@ -118,6 +145,131 @@ abilities_free(struct abilities *abilities)
 }
 
 
+void
+abilities_generate_batch(enum ability_score_generation_method method,
+                         enum ability_flag special_abilities,
+                         struct rnd *rnd,
+                         int count,
+                         struct abilities_batch *batch)
+{
+    assert(count >= 0 && count <= batch->capacity);
+
+    static int const average_die_scores[] = { 0, 3, 2, 3, 4, 5, 4 };
+    static int const upward_die_scores[] = { 0, 2, 3, 4, 5, 6, 6 };
+    static enum ability_flag const flags[abilities_count] = {
+        ability_flag_strength,
+        ability_flag_intelligence,
+        ability_flag_wisdom,
+        ability_flag_dexterity,
+        ability_flag_constitution,
+        ability_flag_charisma,
+    };
+
+    int const dice_count = dice_per_character(method);
+    int const stride = dice_count;
+    uint32_t *values = calloc_or_die(batch_chunk_count * dice_count, sizeof(uint32_t));
+    int *die_scores = calloc_or_die(batch_chunk_count * dice_count, sizeof(int));
+
+    for (int first = 0; first < count; first += batch_chunk_count) {
+        int chunk_count = min(count - first, batch_chunk_count);
+        int values_count = chunk_count * dice_count;
+        rnd_fill_uniform(rnd, 1, 6, values, (uint32_t)values_count);
+        for (int i = 0; i < values_count; ++i) {
+            die_scores[i] = (int)values[i];
+        }
+
+        int *abilities[abilities_count] = {
+            batch->strength + first,
+            batch->intelligence + first,
+            batch->wisdom + first,
+            batch->dexterity + first,
+            batch->constitution + first,
+            batch->charisma + first,
+        };
+        switch (method) {
+            case ability_score_generation_method_general_NPC:
+                adjust_die_scores(die_scores, average_die_scores, values_count);
+                for (int j = 0; j < abilities_count; ++j) {
+                    sum_three_dice(die_scores + 3 * j, stride, chunk_count, abilities[j]);
+                }
+                break;
+            case ability_score_generation_method_special_NPC:
+                for (int j = 0; j < abilities_count; ++j) {
+                    if (special_abilities & flags[j]) {
+                        for (int i = 0; i < chunk_count; ++i) {
+                            adjust_die_scores(die_scores + i * stride + 3 * j,
+                                              upward_die_scores, 3);
+                        }
+                    }
+                    sum_three_dice(die_scores + 3 * j, stride, chunk_count, abilities[j]);
+                }
+                break;
+            case ability_score_generation_method_1:
+                for (int i = 0; i < chunk_count; ++i) {
+                    int scores[abilities_count];
+                    for (int j = 0; j < abilities_count; ++j) {
+                        int const *dice = die_scores + i * stride + 4 * j;
+                        int lowest = min(min(dice[0], dice[1]), min(dice[2], dice[3]));
+                        scores[j] = dice[0] + dice[1] + dice[2] + dice[3] - lowest;
+                    }
+                    sort_descending(scores, abilities_count);
+                    for (int j = 0; j < abilities_count; ++j) {
+                        abilities[j][i] = scores[j];
+                    }
+                }
+                break;
+            case ability_score_generation_method_2:
+                for (int i = 0; i < chunk_count; ++i) {
+                    int scores[2 * abilities_count];
+                    sum_three_dice(die_scores + i * stride, 3, 2 * abilities_count, scores);
+                    sort_descending(scores, 2 * abilities_count);
+                    for (int j = 0; j < abilities_count; ++j) {
+                        abilities[j][i] = scores[j];
+                    }
+                }
+                break;
+            case ability_score_generation_method_3:
+                for (int i = 0; i < chunk_count; ++i) {
+                    for (int j = 0; j < abilities_count; ++j) {
+                        int scores[6];
+                        sum_three_dice(die_scores + i * stride + 18 * j, 3, 6, scores);
+                        abilities[j][i] = highest_score(scores, 6);
+                    }
+                }
+                break;
+            case ability_score_generation_method_4:
+                for (int i = 0; i < chunk_count; ++i) {
+                    int scores[12][abilities_count];
+                    sum_three_dice(die_scores + i * stride, 3, 12 * abilities_count, &scores[0][0]);
+                    int best = 0;
+                    int best_total = 0;
+                    for (int k = 0; k < 12; ++k) {
+                        int total = 0;
+                        for (int j = 0; j < abilities_count; ++j) total += scores[k][j];
+                        if (total > best_total) {
+                            best = k;
+                            best_total = total;
+                        }
+                    }
+                    for (int j = 0; j < abilities_count; ++j) {
+                        abilities[j][i] = scores[best][j];
+                    }
+                }
+                break;
+            default:
+                for (int j = 0; j < abilities_count; ++j) {
+                    sum_three_dice(die_scores + 3 * j, stride, chunk_count, abilities[j]);
+                }
+                break;
+        }
+    }
+
+    batch->count = count;
+    free_or_die(die_scores);
+    free_or_die(values);
+}
+
+
 int
 abilities_total(struct abilities const *abilities)
 {
@@ -130,6 +282,53 @@ abilities_total(struct abilities const *abilities)
 }
 
 
+static void
+adjust_die_scores(int die_scores[], int const adjusted_scores[], int count)
+{
+    for (int i = 0; i < count; ++i) {
+        die_scores[i] = adjusted_scores[die_scores[i]];
+    }
+}
+
+
+static int
+dice_per_character(enum ability_score_generation_method method)
+{
+    switch (method) {
+        case ability_score_generation_method_1: return 6 * 4;
+        case ability_score_generation_method_2: return 12 * 3;
+        case ability_score_generation_method_3: return 6 * 6 * 3;
+        case ability_score_generation_method_4: return 12 * 6 * 3;
+        default: return 6 * 3;
+    }
+}
+
+
+static int
+highest_score(int const scores[], int scores_count)
+{
+    int highest = scores[0];
+    for (int i = 1; i < scores_count; ++i) {
+        highest = max(highest, scores[i]);
+    }
+    return highest;
+}
+
+
+static void
+sort_descending(int scores[], int scores_count)
+{
+    for (int i = 1; i < scores_count; ++i) {
+        int score = scores[i];
+        int j = i;
+        for (; j > 0 && scores[j - 1] < score; --j) {
+            scores[j] = scores[j - 1];
+        }
+        scores[j] = score;
+    }
+}
+
+
 static int
 special_NPC_roll(struct rnd *rnd,
                  enum ability_flag flags,
@@ -139,3 +338,17 @@ special_NPC_roll(struct rnd *rnd,
     return flag & flags ? dice_roll_and_adjust_upwards(threeD6, rnd)
                         : dice_roll(threeD6, rnd, NULL);
 }
+
+
+// Sums dice in threes, starting every `stride' die scores.
+static void
+sum_three_dice(int const die_scores[],
+               int stride,
+               int count,
+               int scores[])
+{
+    for (int i = 0; i < count; ++i) {
+        int const *dice = die_scores + i * stride;
+        scores[i] = dice[0] + dice[1] + dice[2];
+    }
+}
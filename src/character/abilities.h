@@ -3,6 +3,7 @@
 
 
 #include <character/ability_flag.h>
+#include <character/ability_score_generation_method.h>
 
 
 struct rnd;
@@ -18,6 +19,19 @@ struct abilities {
 };
 
 
+// Abilities for many characters, one array per ability.
+struct abilities_batch {
+    int capacity;
+    int count;
+    int *strength;
+    int *intelligence;
+    int *wisdom;
+    int *dexterity;
+    int *constitution;
+    int *charisma;
+};
+
+
 struct abilities *
 abilities_alloc(struct rnd *rnd);
 
@@ -31,6 +45,12 @@ struct abilities *
 abilities_alloc_special_NPC(struct rnd *rnd,
                             enum ability_flag flags);
 
+struct abilities_batch *
+abilities_batch_alloc(int capacity);
+
+void
+abilities_batch_free(struct abilities_batch *batch);
+
 int
 abilities_compare(struct abilities const *first,
                   struct abilities const *second);
@@ -38,6 +58,17 @@ abilities_compare(struct abilities const *first,
 void
 abilities_free(struct abilities *abilities);
 
+// Fills `batch' with abilities for `count' characters, rolling dice in the
+// same order as the single character functions.  Where the player would
+// assign scores, they're assigned in order from highest to lowest; where the
+// player would choose a set, the set with the highest total is chosen.
+void
+abilities_generate_batch(enum ability_score_generation_method method,
+                         enum ability_flag special_abilities,
+                         struct rnd *rnd,
+                         int count,
+                         struct abilities_batch *batch);
+
 int
 abilities_total(struct abilities const *abilities);
 
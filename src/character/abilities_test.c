@@ -119,6 +119,122 @@ abilities_alloc_method_special_NPC_with_dexterity_and_constitution_flags_test(vo
 }
 
 
+static void
+abilities_batch_alloc_test(void)
+{
+    struct abilities_batch *batch = abilities_batch_alloc(10);
+
+    assert(10 == batch->capacity);
+    assert(0 == batch->count);
+    assert(batch->intelligence == batch->strength + 10);
+    assert(batch->charisma == batch->strength + 50);
+
+    abilities_batch_free(batch);
+}
+
+
+static void
+assert_batch_abilities_equal(struct abilities_batch const *batch,
+                             int index,
+                             struct abilities const *abilities)
+{
+    assert(abilities->strength == batch->strength[index]);
+    assert(abilities->intelligence == batch->intelligence[index]);
+    assert(abilities->wisdom == batch->wisdom[index]);
+    assert(abilities->dexterity == batch->dexterity[index]);
+    assert(abilities->constitution == batch->constitution[index]);
+    assert(abilities->charisma == batch->charisma[index]);
+}
+
+
+static void
+abilities_generate_batch_test(void)
+{
+    int const count = 100;
+    struct abilities_batch *batch = abilities_batch_alloc(count);
+    struct rnd *batch_rnd = rnd_alloc_splitmix64(7);
+    struct rnd *rnd = rnd_alloc_splitmix64(7);
+
+    abilities_generate_batch(ability_score_generation_method_simple,
+                             ability_flag_none, batch_rnd, count, batch);
+    assert(count == batch->count);
+    for (int i = 0; i < count; ++i) {
+        struct abilities *abilities = abilities_alloc(rnd);
+        assert_batch_abilities_equal(batch, i, abilities);
+        abilities_free(abilities);
+    }
+
+    abilities_generate_batch(ability_score_generation_method_general_NPC,
+                             ability_flag_none, batch_rnd, count, batch);
+    for (int i = 0; i < count; ++i) {
+        struct abilities *abilities = abilities_alloc_general_NPC(rnd);
+        assert_batch_abilities_equal(batch, i, abilities);
+        abilities_free(abilities);
+    }
+
+    enum ability_flag flags = ability_flag_wisdom | ability_flag_charisma;
+    abilities_generate_batch(ability_score_generation_method_special_NPC,
+                             flags, batch_rnd, count, batch);
+    for (int i = 0; i < count; ++i) {
+        struct abilities *abilities = abilities_alloc_special_NPC(rnd, flags);
+        assert_batch_abilities_equal(batch, i, abilities);
+        abilities_free(abilities);
+    }
+
+    abilities_generate_batch(ability_score_generation_method_3,
+                             ability_flag_none, batch_rnd, count, batch);
+    for (int i = 0; i < count; ++i) {
+        struct abilities *abilities = abilities_alloc_method_3(rnd);
+        assert_batch_abilities_equal(batch, i, abilities);
+        abilities_free(abilities);
+    }
+
+    abilities_generate_batch(ability_score_generation_method_1,
+                             ability_flag_none, batch_rnd, count, batch);
+    for (int i = 0; i < count; ++i) {
+        struct ability_scores *scores = ability_scores_alloc_method_1(rnd);
+        struct abilities abilities = {
+            .strength=scores->values[0],
+            .intelligence=scores->values[1],
+            .wisdom=scores->values[2],
+            .dexterity=scores->values[3],
+            .constitution=scores->values[4],
+            .charisma=scores->values[5],
+        };
+        assert_batch_abilities_equal(batch, i, &abilities);
+        ability_scores_free(scores);
+    }
+
+    abilities_generate_batch(ability_score_generation_method_2,
+                             ability_flag_none, batch_rnd, count, batch);
+    for (int i = 0; i < count; ++i) {
+        struct ability_scores *scores = ability_scores_alloc_method_2(rnd);
+        struct abilities abilities = {
+            .strength=scores->values[0],
+            .intelligence=scores->values[1],
+            .wisdom=scores->values[2],
+            .dexterity=scores->values[3],
+            .constitution=scores->values[4],
+            .charisma=scores->values[5],
+        };
+        assert_batch_abilities_equal(batch, i, &abilities);
+        ability_scores_free(scores);
+    }
+
+    abilities_generate_batch(ability_score_generation_method_4,
+                             ability_flag_none, batch_rnd, count, batch);
+    for (int i = 0; i < count; ++i) {
+        struct ability_sets *sets = ability_sets_alloc_method_4(rnd);
+        assert_batch_abilities_equal(batch, i, &sets->values[0]);
+        ability_sets_free(sets);
+    }
+
+    rnd_free(batch_rnd);
+    rnd_free(rnd);
+    abilities_batch_free(batch);
+}
+
+
 static void
 abilities_compare_test(void)
 {
@@ -196,6 +312,8 @@ abilities_test(void)
     abilities_alloc_method_special_NPC_test();
     abilities_alloc_method_special_NPC_with_strength_flag_test();
     abilities_alloc_method_special_NPC_with_dexterity_and_constitution_flags_test();
+    abilities_batch_alloc_test();
     abilities_compare_test();
+    abilities_generate_batch_test();
     abilities_total_test();
 }
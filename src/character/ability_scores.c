@@ -14,9 +14,7 @@ ability_scores_alloc_method_1(struct rnd *rnd)
     struct ability_scores *scores = calloc_or_die(1, sizeof(struct ability_scores));
     size_t count = sizeof scores->values / sizeof scores->values[0];
     struct dice dice = dice_make(4, 6);
-    for (size_t i = 0; i < count; ++i) {
-        scores->values[i] = dice_roll_and_drop_lowest(dice, rnd);
-    }
+    dice_roll_keep_batch(dice, rnd, 3, 0, scores->values, (int)count);
     qsort(scores->values, count, sizeof scores->values[0],
           compare_ability_scores);
     return scores;
@@ -6,6 +6,11 @@
 #include "tile.h"
 
 
+static void
+print_and_free_description_list(char const *title,
+                                struct ptr_array *descriptions,
+                                FILE *out);
+
 static void
 realloc_append_level_description(char **s, int level);
 
@@ -33,6 +38,20 @@ area_alloc(enum area_type area_type,
 }
 
 
+struct area *
+area_alloc_from_arena(struct arena *arena,
+                      enum area_type area_type,
+                      enum direction direction,
+                      struct box box)
+{
+    struct area *area = arena_calloc(arena, 1, sizeof(struct area));
+    area->box = box;
+    area->direction = direction;
+    area->type = area_type;
+    return area;
+}
+
+
 char *
 area_alloc_description(struct area const *area)
 {
@@ -93,6 +112,18 @@ area_alloc_description(struct area const *area)
 }
 
 
+char *
+area_alloc_located_description(struct area const *area)
+{
+    char *location = point_alloc_xy(area_center_point(area));
+    char *area_description = area_alloc_description(area);
+    char *description = str_alloc_formatted("%-12s %s", location, area_description);
+    free_or_die(location);
+    free_or_die(area_description);
+    return description;
+}
+
+
 struct point
 area_center_point(struct area const *area)
 {
@@ -110,6 +141,24 @@ area_free(struct area *area)
 }
 
 
+void
+area_free_to_arena(struct arena *arena, struct area *area)
+{
+    arena_release(arena, area, sizeof(struct area));
+}
+
+
+void
+area_print_and_free_descriptions(struct ptr_array *entrances_and_exits,
+                                 struct ptr_array *chambers_and_rooms,
+                                 FILE *out)
+{
+    print_and_free_description_list("Entrances and Exits", entrances_and_exits, out);
+    fprintf(out, "\n");
+    print_and_free_description_list("Chambers and Rooms", chambers_and_rooms, out);
+}
+
+
 bool
 area_is_chamber_or_room(struct area const *area)
 {
@@ -137,6 +186,20 @@ area_is_level_transition(struct area const *area)
 }
 
 
+static void
+print_and_free_description_list(char const *title,
+                                struct ptr_array *descriptions,
+                                FILE *out)
+{
+    fprintf(out, "  %s:\n", title);
+    for (int i = 0; i < descriptions->count; ++i) {
+        fprintf(out, "    %s\n", (char const *)descriptions->elements[i]);
+    }
+    ptr_array_clear(descriptions, free_or_die);
+    ptr_array_free(descriptions);
+}
+
+
 static void
 realloc_append_level_description(char **s, int level)
 {
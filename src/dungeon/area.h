@@ -3,6 +3,7 @@
 
 
 #include <stdbool.h>
+#include <stdio.h>
 #include <background/background.h>
 
 #include <dungeon/area_features.h>
@@ -11,6 +12,8 @@
 #include <dungeon/tile_type.h>
 
 
+struct arena;
+struct ptr_array;
 struct tile;
 
 
@@ -30,9 +33,29 @@ area_alloc(enum area_type area_type,
 void
 area_free(struct area *area);
 
+struct area *
+area_alloc_from_arena(struct arena *arena,
+                      enum area_type area_type,
+                      enum direction direction,
+                      struct box box);
+
+void
+area_free_to_arena(struct arena *arena, struct area *area);
+
 char *
 area_alloc_description(struct area const *area);
 
+// The area's center point followed by its description, as listed on maps.
+char *
+area_alloc_located_description(struct area const *area);
+
+// Prints a level's entrances and exits and its chambers and rooms as listed
+// below its map, then frees both arrays of descriptions.
+void
+area_print_and_free_descriptions(struct ptr_array *entrances_and_exits,
+                                 struct ptr_array *chambers_and_rooms,
+                                 FILE *out);
+
 bool
 area_is_chamber_or_room(struct area const *area);
 
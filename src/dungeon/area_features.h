@@ -8,6 +8,7 @@ enum area_features {
     area_features_chimney_down  =0x0002,
     area_features_chute_entrance=0x0004,
     area_features_chute_exit    =0x0008,
+    area_features_all           =0x000f,
 };
 
 
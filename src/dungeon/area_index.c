@@ -0,0 +1,241 @@
+#include "area_index.h"
+
+#include <stdint.h>
+#include <base/base.h>
+
+#include "area.h"
+#include "level_array.h"
+
+
+static int const initial_cells_capacity = 16;
+static int const initial_index_capacity = 32;
+
+
+static inline struct point
+cell_origin_for_point(struct point point)
+{
+    return point_make(floor_to_multiple(point.x, area_index_cell_width),
+                      floor_to_multiple(point.y, area_index_cell_length),
+                      point.z);
+}
+
+
+static inline uint32_t
+hash_cell_origin(struct point origin)
+{
+    uint32_t hash = (uint32_t)origin.x * 0x9e3779b1u
+                  ^ (uint32_t)origin.y * 0x85ebca77u
+                  ^ (uint32_t)origin.z * 0xc2b2ae3du;
+    return hash ^ (hash >> 15);
+}
+
+
+static void
+insert_into_index(struct area_cell **index,
+                  int index_capacity,
+                  struct area_cell *cell)
+{
+    uint32_t mask = (uint32_t)index_capacity - 1;
+    uint32_t slot = hash_cell_origin(cell->origin) & mask;
+    while (index[slot]) slot = (slot + 1) & mask;
+    index[slot] = cell;
+}
+
+
+static void
+grow_index(struct area_index *area_index)
+{
+    int new_capacity = area_index->index_capacity * 2;
+    struct area_cell **new_index = calloc_or_die(new_capacity,
+                                                 sizeof(struct area_cell *));
+    for (int i = 0; i < area_index->cells_count; ++i) {
+        insert_into_index(new_index, new_capacity, area_index->cells[i]);
+    }
+    free_or_die(area_index->index);
+    area_index->index = new_index;
+    area_index->index_capacity = new_capacity;
+}
+
+
+static struct area_cell *
+find_cell(struct area_index const *area_index, struct point origin)
+{
+    uint32_t mask = (uint32_t)area_index->index_capacity - 1;
+    uint32_t slot = hash_cell_origin(origin) & mask;
+    while (area_index->index[slot]) {
+        struct area_cell *cell = area_index->index[slot];
+        if (point_equals(origin, cell->origin)) return cell;
+        slot = (slot + 1) & mask;
+    }
+    return NULL;
+}
+
+
+static struct area_cell *
+include_cell(struct area_index *area_index, struct point origin)
+{
+    struct area_cell *cell = find_cell(area_index, origin);
+    if (cell) return cell;
+
+    cell = arena_calloc(area_index->arena, 1, sizeof(struct area_cell));
+    cell->origin = origin;
+    if (area_index->cells_count == area_index->cells_capacity) {
+        area_index->cells_capacity *= 2;
+        area_index->cells = reallocarray_or_die(area_index->cells,
+                                                area_index->cells_capacity,
+                                                sizeof(struct area_cell *));
+    }
+    if ((area_index->cells_count + 1) * 2 > area_index->index_capacity) {
+        grow_index(area_index);
+    }
+    area_index->cells[area_index->cells_count] = cell;
+    ++area_index->cells_count;
+    insert_into_index(area_index->index, area_index->index_capacity, cell);
+    return cell;
+}
+
+
+static struct area_bucket *
+include_bucket(struct area_index *area_index, int level)
+{
+    area_index->buckets = level_array_include(area_index->buckets,
+                                              &area_index->buckets_count,
+                                              &area_index->min_level,
+                                              level,
+                                              sizeof(struct area_bucket));
+    return &area_index->buckets[level - area_index->min_level];
+}
+
+
+static void
+add_area_to_array(struct arena *arena,
+                  struct area ***areas,
+                  int *areas_count,
+                  int *areas_capacity,
+                  struct area *area)
+{
+    int index = *areas_count;
+    ++*areas_count;
+    *areas = arena_grow_array(arena, *areas, *areas_count, areas_capacity,
+                              sizeof(struct area *));
+    (*areas)[index] = area;
+}
+
+
+void
+area_index_add(struct area_index *area_index, struct area *area)
+{
+    struct area_bucket *bucket = include_bucket(area_index, area->box.origin.z);
+    add_area_to_array(area_index->arena,
+                      &bucket->areas,
+                      &bucket->areas_count,
+                      &bucket->areas_capacity,
+                      area);
+
+    struct box box = area->box;
+    struct point end = box_end_point(box);
+    int last_x = max(box.origin.x, end.x - 1);
+    int last_y = max(box.origin.y, end.y - 1);
+    int last_z = max(box.origin.z, end.z - 1);
+    for (int k = box.origin.z; k <= last_z; ++k) {
+        for (int j = floor_to_multiple(box.origin.y, area_index_cell_length);
+             j <= last_y;
+             j += area_index_cell_length)
+        {
+            for (int i = floor_to_multiple(box.origin.x, area_index_cell_width);
+                 i <= last_x;
+                 i += area_index_cell_width)
+            {
+                struct area_cell *cell = include_cell(area_index, point_make(i, j, k));
+                add_area_to_array(area_index->arena,
+                                  &cell->areas,
+                                  &cell->areas_count,
+                                  &cell->areas_capacity,
+                                  area);
+            }
+        }
+    }
+}
+
+
+struct area_index *
+area_index_alloc(void)
+{
+    struct area_index *area_index = calloc_or_die(1, sizeof(struct area_index));
+    area_index->arena = arena_alloc();
+    area_index->cells = calloc_or_die(initial_cells_capacity,
+                                      sizeof(struct area_cell *));
+    area_index->cells_capacity = initial_cells_capacity;
+    area_index->index = calloc_or_die(initial_index_capacity,
+                                      sizeof(struct area_cell *));
+    area_index->index_capacity = initial_index_capacity;
+    return area_index;
+}
+
+
+struct area *const *
+area_index_areas_for_level(struct area_index const *area_index,
+                           int level,
+                           int *count_out)
+{
+    int index = level_array_index(area_index->buckets_count, area_index->min_level, level);
+    if (index < 0) {
+        *count_out = 0;
+        return NULL;
+    }
+    *count_out = area_index->buckets[index].areas_count;
+    return area_index->buckets[index].areas;
+}
+
+
+int
+area_index_areas_in_box(struct area_index const *area_index,
+                        struct box box,
+                        struct area **areas,
+                        int areas_count)
+{
+    if (!size_has_volume(box.size)) return 0;
+    box = box_normalize(box);
+    struct point end = box_end_point(box);
+    int count = 0;
+    for (int k = box.origin.z; k < end.z; ++k) {
+        for (int j = floor_to_multiple(box.origin.y, area_index_cell_length);
+             j < end.y;
+             j += area_index_cell_length)
+        {
+            for (int i = floor_to_multiple(box.origin.x, area_index_cell_width);
+                 i < end.x;
+                 i += area_index_cell_width)
+            {
+                struct area_cell *cell = find_cell(area_index, point_make(i, j, k));
+                if (!cell) continue;
+                for (int n = 0; n < cell->areas_count; ++n) {
+                    struct area *area = cell->areas[n];
+                    if (!box_intersects(area->box, box)) continue;
+                    // an area that spans several cells is reported from the
+                    // one holding the first point it shares with `box'
+                    struct point first = point_make(max(area->box.origin.x, box.origin.x),
+                                                    max(area->box.origin.y, box.origin.y),
+                                                    max(area->box.origin.z, box.origin.z));
+                    if (!point_equals(cell->origin, cell_origin_for_point(first))) continue;
+                    if (areas && count < areas_count) areas[count] = area;
+                    ++count;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+
+void
+area_index_free(struct area_index *area_index)
+{
+    if (area_index) {
+        arena_free(area_index->arena);
+        free_or_die(area_index->buckets);
+        free_or_die(area_index->cells);
+        free_or_die(area_index->index);
+        free_or_die(area_index);
+    }
+}
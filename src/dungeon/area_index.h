@@ -0,0 +1,78 @@
+#ifndef FNF_DUNGEON_AREA_INDEX_H_INCLUDED
+#define FNF_DUNGEON_AREA_INDEX_H_INCLUDED
+
+
+#include <dungeon/box.h>
+#include <dungeon/point.h>
+
+
+struct arena;
+struct area;
+
+
+enum {
+    area_index_cell_width = 16,
+    area_index_cell_length = 16,
+};
+
+
+// The areas that overlap a square cell of a single level.  `origin' is
+// always a multiple of the cell width and length.
+struct area_cell {
+    struct point origin;
+    struct area **areas;
+    int areas_count;
+    int areas_capacity;
+};
+
+
+// The areas whose boxes start on one level, in the order they were added.
+struct area_bucket {
+    struct area **areas;
+    int areas_count;
+    int areas_capacity;
+};
+
+
+// Areas bucketed by level and indexed by a uniform grid of cells.
+// `buckets[i]' holds the areas for level `min_level + i'.  Cells are only
+// allocated where areas are and are found through an open addressing
+// `index'.
+struct area_index {
+    struct arena *arena;
+    struct area_bucket *buckets;
+    int buckets_count;
+    int min_level;
+    struct area_cell **cells;
+    int cells_count;
+    int cells_capacity;
+    struct area_cell **index;
+    int index_capacity;
+};
+
+
+struct area_index *
+area_index_alloc(void);
+
+void
+area_index_free(struct area_index *area_index);
+
+void
+area_index_add(struct area_index *area_index, struct area *area);
+
+// Sets `*count_out' to the number of areas on the level.
+struct area *const *
+area_index_areas_for_level(struct area_index const *area_index,
+                           int level,
+                           int *count_out);
+
+// Returns the number of areas whose boxes intersect `box' and copies up to
+// `areas_count' of them into `areas', in no particular order.
+int
+area_index_areas_in_box(struct area_index const *area_index,
+                        struct box box,
+                        struct area **areas,
+                        int areas_count);
+
+
+#endif
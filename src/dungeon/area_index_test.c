@@ -0,0 +1,130 @@
+#include <assert.h>
+#include <base/base.h>
+#include "area.h"
+#include "area_index.h"
+
+
+void
+area_index_test(void);
+
+
+static bool
+contains_area(struct area **areas, int areas_count, struct area *area)
+{
+    for (int i = 0; i < areas_count; ++i) {
+        if (area == areas[i]) return true;
+    }
+    return false;
+}
+
+
+static void
+area_index_alloc_test(void)
+{
+    struct area_index *area_index = area_index_alloc();
+
+    int count = -1;
+    assert(!area_index_areas_for_level(area_index, 1, &count));
+    assert(0 == count);
+    struct box box = box_make(point_make(-100, -100, -5), size_make(200, 200, 10));
+    assert(0 == area_index_areas_in_box(area_index, box, NULL, 0));
+
+    area_index_free(area_index);
+}
+
+
+static void
+area_index_areas_for_level_test(void)
+{
+    struct area_index *area_index = area_index_alloc();
+    struct area *room = area_alloc(area_type_room, direction_north,
+                                   box_make(point_make(0, 0, 1), size_make(3, 3, 1)));
+    struct area *passage = area_alloc(area_type_passage, direction_north,
+                                      box_make(point_make(1, 3, 1), size_make(1, 5, 1)));
+    struct area *chamber = area_alloc(area_type_chamber, direction_north,
+                                      box_make(point_make(-40, 7, 3), size_make(4, 4, 1)));
+
+    area_index_add(area_index, room);
+    area_index_add(area_index, chamber);
+    area_index_add(area_index, passage);
+
+    int count;
+    struct area *const *areas = area_index_areas_for_level(area_index, 1, &count);
+    assert(2 == count);
+    assert(room == areas[0]);
+    assert(passage == areas[1]);
+
+    areas = area_index_areas_for_level(area_index, 2, &count);
+    assert(0 == count);
+
+    areas = area_index_areas_for_level(area_index, 3, &count);
+    assert(1 == count);
+    assert(chamber == areas[0]);
+
+    area_index_areas_for_level(area_index, 0, &count);
+    assert(0 == count);
+    area_index_areas_for_level(area_index, 4, &count);
+    assert(0 == count);
+
+    area_index_free(area_index);
+    area_free(room);
+    area_free(passage);
+    area_free(chamber);
+}
+
+
+static void
+area_index_areas_in_box_test(void)
+{
+    struct area_index *area_index = area_index_alloc();
+    // spans four cells
+    struct area *big = area_alloc(area_type_chamber, direction_north,
+                                  box_make(point_make(10, 10, 1), size_make(20, 20, 1)));
+    struct area *small = area_alloc(area_type_room, direction_north,
+                                    box_make(point_make(-3, -3, 1), size_make(2, 2, 1)));
+    struct area *other_level = area_alloc(area_type_room, direction_north,
+                                          box_make(point_make(10, 10, 2), size_make(2, 2, 1)));
+    area_index_add(area_index, big);
+    area_index_add(area_index, small);
+    area_index_add(area_index, other_level);
+
+    struct area *areas[4];
+    struct box box = box_make(point_make(-100, -100, 1), size_make(200, 200, 1));
+    int count = area_index_areas_in_box(area_index, box, areas, 4);
+    assert(2 == count);
+    assert(contains_area(areas, count, big));
+    assert(contains_area(areas, count, small));
+
+    box = box_make(point_make(20, 20, 1), size_make(1, 1, 1));
+    count = area_index_areas_in_box(area_index, box, areas, 4);
+    assert(1 == count);
+    assert(big == areas[0]);
+
+    box = box_make(point_make(8, 0, 1), size_make(32, 32, 2));
+    count = area_index_areas_in_box(area_index, box, areas, 4);
+    assert(2 == count);
+    assert(contains_area(areas, count, big));
+    assert(contains_area(areas, count, other_level));
+
+    box = box_make(point_make(-1, -1, 1), size_make(11, 11, 1));
+    assert(0 == area_index_areas_in_box(area_index, box, areas, 4));
+
+    box = box_make(point_make(-2, -2, 1), size_make(40, 40, 1));
+    assert(2 == area_index_areas_in_box(area_index, box, NULL, 0));
+    count = area_index_areas_in_box(area_index, box, areas, 1);
+    assert(2 == count);
+
+    area_index_free(area_index);
+    area_free(big);
+    area_free(small);
+    area_free(other_level);
+}
+
+
+void
+area_index_test(void)
+{
+    area_index_alloc_test();
+    area_index_areas_for_level_test();
+    area_index_areas_in_box_test();
+}
@@ -11,7 +11,7 @@ digger_alloc(struct generator *generator,
              struct point point,
              enum direction direction)
 {
-    struct digger *digger = calloc_or_die(1, sizeof(struct digger));
+    struct digger *digger = arena_calloc(generator->arena, 1, sizeof(struct digger));
     digger->generator = generator;
     digger->point = point;
     digger->direction = direction;
@@ -22,6 +22,7 @@ digger_alloc(struct generator *generator,
 void
 digger_ascend(struct digger *digger, int levels)
 {
+    generator_will_change_digger(digger->generator, digger);
     digger->point.z -= levels;
 }
 
@@ -29,6 +30,7 @@ digger_ascend(struct digger *digger, int levels)
 void
 digger_descend(struct digger *digger, int levels)
 {
+    generator_will_change_digger(digger->generator, digger);
     digger->point.z += levels;
 }
 
@@ -74,30 +76,11 @@ digger_dig_area(struct digger *digger,
                                            box_to_dig,
                                            tile_type);
     
-    struct tile *entrance_tile;
-    switch (digger->direction) {
-        case direction_north:
-            entrance_tile = generator_tile_at(digger->generator, digger->point);
-            entrance_tile->walls.south = entrance_type;
-            break;
-        case direction_south:
-            entrance_tile = generator_tile_at(digger->generator,
-                                              point_north(digger->point));
-            entrance_tile->walls.south = entrance_type;
-            break;
-        case direction_east:
-            entrance_tile = generator_tile_at(digger->generator, digger->point);
-            entrance_tile->walls.west = entrance_type;
-            break;
-        case direction_west:
-            entrance_tile = generator_tile_at(digger->generator,
-                                              point_east(digger->point));
-            entrance_tile->walls.west = entrance_type;
-            break;
-        default:
-            fail("Unrecognized direction %i", digger->direction);
-            break;
-    }
+    // the entrance is the wall behind the digger
+    generator_set_wall(digger->generator,
+                       digger->point,
+                       direction_opposite(digger->direction),
+                       entrance_type);
     
     return area;
 }
@@ -279,13 +262,16 @@ digger_dig_stairs_up(struct digger *digger,
 void
 digger_free(struct digger *digger)
 {
-    free_or_die(digger);
+    if (digger) {
+        arena_release(digger->generator->arena, digger, sizeof(struct digger));
+    }
 }
 
 
 void
 digger_move(struct digger *digger, int steps, enum direction direction)
 {
+    generator_will_change_digger(digger->generator, digger);
     digger->point = point_move(digger->point, steps, direction);
 }
 
@@ -321,6 +307,7 @@ digger_move_right(struct digger *digger, int steps)
 void
 digger_spin_180_degrees(struct digger *digger)
 {
+    generator_will_change_digger(digger->generator, digger);
     digger->direction = direction_opposite(digger->direction);
 }
 
@@ -328,6 +315,7 @@ digger_spin_180_degrees(struct digger *digger)
 void
 digger_spin_90_degrees_left(struct digger *digger)
 {
+    generator_will_change_digger(digger->generator, digger);
     digger->direction = direction_90_degrees_left(digger->direction);
 }
 
@@ -335,6 +323,7 @@ digger_spin_90_degrees_left(struct digger *digger)
 void
 digger_spin_90_degrees_right(struct digger *digger)
 {
+    generator_will_change_digger(digger->generator, digger);
     digger->direction = direction_90_degrees_right(digger->direction);
 }
 
@@ -342,6 +331,7 @@ digger_spin_90_degrees_right(struct digger *digger)
 void
 digger_turn_90_degrees_left(struct digger *digger)
 {
+    generator_will_change_digger(digger->generator, digger);
     digger->point = point_rotate_90_degrees_left(digger->point, digger->direction);
     digger->direction = direction_90_degrees_left(digger->direction);
 }
@@ -350,6 +340,7 @@ digger_turn_90_degrees_left(struct digger *digger)
 void
 digger_turn_90_degrees_right(struct digger *digger)
 {
+    generator_will_change_digger(digger->generator, digger);
     digger->point = point_rotate_90_degrees_right(digger->point, digger->direction);
     digger->direction = direction_90_degrees_right(digger->direction);
 }
@@ -4,6 +4,7 @@
 #include <base/base.h>
 #include "dungeon.h"
 #include "generator.h"
+#include "tile_journal.h"
 #include "tiles_thumbnail.h"
 
 
@@ -415,7 +416,7 @@ digger_dig_starting_stairs_test(void)
     assert(box_equals(expected_box, generator->areas[0]->box));
     assert(point_equals(point_make(-2, 0, 1), digger->point));
 
-    assert(11 == generator->tiles_count);
+    assert(11 == generator->tile_journal->tiles_count);
     char *thumbnail;
 
     char const *expected_directions =
@@ -423,7 +424,7 @@ digger_dig_starting_stairs_test(void)
             " 1  n  n  n  n \n"
             " 0  n  e  e  n \n"
             "-1     n  n  n \n";
-    thumbnail = tiles_thumbnail_directions_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_directions_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_directions, thumbnail));
     free_or_die(thumbnail);
 
@@ -432,7 +433,7 @@ digger_dig_starting_stairs_test(void)
             " 1  0  0  0  0 \n"
             " 0  0  0  0  0 \n"
             "-1     0  0  0 \n";
-    thumbnail = tiles_thumbnail_features_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_features_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_features, thumbnail));
     free_or_die(thumbnail);
 
@@ -441,7 +442,7 @@ digger_dig_starting_stairs_test(void)
             " 1  :  :  :  : \n"
             " 0  :  ^  ^  : \n"
             "-1     :  :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -450,7 +451,7 @@ digger_dig_starting_stairs_test(void)
             " 1 .. ._ ._ .. \n"
             " 0 .. ._ ._ |. \n"
             "-1    .. .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -481,7 +482,7 @@ digger_dig_area_test_for_10x10_chamber_north(void)
     assert(box_equals(expected_box, area->box));
     assert(point_equals(point_make(0, 0, 1), digger->point));
 
-    assert(8 == generator->tiles_count);
+    assert(8 == generator->tile_journal->tiles_count);
     char *thumbnail;
 
     char const *expected_directions =
@@ -489,7 +490,7 @@ digger_dig_area_test_for_10x10_chamber_north(void)
             " 1  n  n  n \n"
             " 0  n  n  n \n"
             "-1     n  n \n";
-    thumbnail = tiles_thumbnail_directions_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_directions_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_directions, thumbnail));
     free_or_die(thumbnail);
 
@@ -498,7 +499,7 @@ digger_dig_area_test_for_10x10_chamber_north(void)
             " 1  0  0  0 \n"
             " 0  0  0  0 \n"
             "-1     0  0 \n";
-    thumbnail = tiles_thumbnail_features_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_features_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_features, thumbnail));
     free_or_die(thumbnail);
 
@@ -507,7 +508,7 @@ digger_dig_area_test_for_10x10_chamber_north(void)
             " 1  :  :  : \n"
             " 0  :  .  : \n"
             "-1     :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -516,7 +517,7 @@ digger_dig_area_test_for_10x10_chamber_north(void)
             " 1 .. ._ .. \n"
             " 0 .. |= |. \n"
             "-1    .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -547,7 +548,7 @@ digger_dig_area_test_for_10x10_chamber_south(void)
     assert(box_equals(expected_box, area->box));
     assert(point_equals(point_make(0, 0, 1), digger->point));
 
-    assert(8 == generator->tiles_count);
+    assert(8 == generator->tile_journal->tiles_count);
     char *thumbnail;
 
     char const *expected_directions =
@@ -555,7 +556,7 @@ digger_dig_area_test_for_10x10_chamber_south(void)
             " 1  n  n  n \n"
             " 0  n  s  n \n"
             "-1     n  n \n";
-    thumbnail = tiles_thumbnail_directions_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_directions_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_directions, thumbnail));
     free_or_die(thumbnail);
 
@@ -564,7 +565,7 @@ digger_dig_area_test_for_10x10_chamber_south(void)
             " 1  0  0  0 \n"
             " 0  0  0  0 \n"
             "-1     0  0 \n";
-    thumbnail = tiles_thumbnail_features_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_features_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_features, thumbnail));
     free_or_die(thumbnail);
 
@@ -573,7 +574,7 @@ digger_dig_area_test_for_10x10_chamber_south(void)
             " 1  :  :  : \n"
             " 0  :  .  : \n"
             "-1     :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -582,7 +583,7 @@ digger_dig_area_test_for_10x10_chamber_south(void)
             " 1 .. .= .. \n"
             " 0 .. |_ |. \n"
             "-1    .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -613,7 +614,7 @@ digger_dig_area_test_for_10x10_chamber_east(void)
     assert(box_equals(expected_box, area->box));
     assert(point_equals(point_make(0, 0, 1), digger->point));
 
-    assert(8 == generator->tiles_count);
+    assert(8 == generator->tile_journal->tiles_count);
     char *thumbnail;
 
     char const *expected_directions =
@@ -621,7 +622,7 @@ digger_dig_area_test_for_10x10_chamber_east(void)
             " 1  n  n  n \n"
             " 0  n  e  n \n"
             "-1     n  n \n";
-    thumbnail = tiles_thumbnail_directions_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_directions_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_directions, thumbnail));
     free_or_die(thumbnail);
 
@@ -630,7 +631,7 @@ digger_dig_area_test_for_10x10_chamber_east(void)
             " 1  0  0  0 \n"
             " 0  0  0  0 \n"
             "-1     0  0 \n";
-    thumbnail = tiles_thumbnail_features_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_features_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_features, thumbnail));
     free_or_die(thumbnail);
 
@@ -639,7 +640,7 @@ digger_dig_area_test_for_10x10_chamber_east(void)
             " 1  :  :  : \n"
             " 0  :  .  : \n"
             "-1     :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -648,7 +649,7 @@ digger_dig_area_test_for_10x10_chamber_east(void)
             " 1 .. ._ .. \n"
             " 0 .. ]_ |. \n"
             "-1    .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -679,7 +680,7 @@ digger_dig_area_test_for_10x10_chamber_west(void)
     assert(box_equals(expected_box, area->box));
     assert(point_equals(point_make(0, 0, 1), digger->point));
 
-    assert(8 == generator->tiles_count);
+    assert(8 == generator->tile_journal->tiles_count);
     char *thumbnail;
 
     char const *expected_directions =
@@ -687,7 +688,7 @@ digger_dig_area_test_for_10x10_chamber_west(void)
             " 1  n  n  n \n"
             " 0  n  w  n \n"
             "-1     n  n \n";
-    thumbnail = tiles_thumbnail_directions_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_directions_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_directions, thumbnail));
     free_or_die(thumbnail);
 
@@ -696,7 +697,7 @@ digger_dig_area_test_for_10x10_chamber_west(void)
             " 1  0  0  0 \n"
             " 0  0  0  0 \n"
             "-1     0  0 \n";
-    thumbnail = tiles_thumbnail_features_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_features_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_features, thumbnail));
     free_or_die(thumbnail);
 
@@ -705,7 +706,7 @@ digger_dig_area_test_for_10x10_chamber_west(void)
             " 1  :  :  : \n"
             " 0  :  .  : \n"
             "-1     :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -714,7 +715,7 @@ digger_dig_area_test_for_10x10_chamber_west(void)
             " 1 .. ._ .. \n"
             " 0 .. |_ ]. \n"
             "-1    .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -745,7 +746,7 @@ digger_dig_area_test_for_30x20_room(void)
     assert(box_equals(expected_box, area->box));
     assert(point_equals(point_make(0, 0, 1), digger->point));
 
-    assert(19 == generator->tiles_count);
+    assert(19 == generator->tile_journal->tiles_count);
     char *thumbnail;
 
     char const *expected_directions =
@@ -754,7 +755,7 @@ digger_dig_area_test_for_30x20_room(void)
             " 0  n  s  s  s  n \n"
             "-1  n  s  s  s  n \n"
             "-2     n  n  n  n \n";
-    thumbnail = tiles_thumbnail_directions_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_directions_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_directions, thumbnail));
     free_or_die(thumbnail);
 
@@ -764,7 +765,7 @@ digger_dig_area_test_for_30x20_room(void)
             " 0  0  0  0  0  0 \n"
             "-1  0  0  0  0  0 \n"
             "-2     0  0  0  0 \n";
-    thumbnail = tiles_thumbnail_features_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_features_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_features, thumbnail));
     free_or_die(thumbnail);
 
@@ -774,7 +775,7 @@ digger_dig_area_test_for_30x20_room(void)
             " 0  :  .  .  .  : \n"
             "-1  :  .  .  .  : \n"
             "-2     :  :  :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -784,7 +785,7 @@ digger_dig_area_test_for_30x20_room(void)
             " 0 .. |. .. .. |. \n"
             "-1 .. |_ ._ ._ |. \n"
             "-2    .. .. .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -815,7 +816,7 @@ digger_dig_area_test_for_30x20_room_with_left_offset(void)
     assert(box_equals(expected_box, area->box));
     assert(point_equals(point_make(0, 0, 1), digger->point));
 
-    assert(19 == generator->tiles_count);
+    assert(19 == generator->tile_journal->tiles_count);
     char *thumbnail;
 
     char const *expected_walls =
@@ -824,7 +825,7 @@ digger_dig_area_test_for_30x20_room_with_left_offset(void)
             " 1 .. |. .. .. |. \n"
             " 0 .. |_ ._ .= |. \n"
             "-1    .. .. .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -855,7 +856,7 @@ digger_dig_area_test_for_60_passage(void)
     assert(box_equals(expected_box, area->box));
     assert(point_equals(point_make(-3, 0, 1), digger->point));
 
-    assert(23 == generator->tiles_count);
+    assert(23 == generator->tile_journal->tiles_count);
     char *thumbnail;
 
     char const *expected_directions =
@@ -863,7 +864,7 @@ digger_dig_area_test_for_60_passage(void)
             " 1  n  n  n  n  n  n  n  n \n"
             " 0  n  e  e  e  e  e  e  n \n"
             "-1     n  n  n  n  n  n  n \n";
-    thumbnail = tiles_thumbnail_directions_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_directions_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_directions, thumbnail));
     free_or_die(thumbnail);
 
@@ -872,7 +873,7 @@ digger_dig_area_test_for_60_passage(void)
             " 1  0  0  0  0  0  0  0  0 \n"
             " 0  0  0  0  0  0  0  0  0 \n"
             "-1     0  0  0  0  0  0  0 \n";
-    thumbnail = tiles_thumbnail_features_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_features_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_features, thumbnail));
     free_or_die(thumbnail);
 
@@ -881,7 +882,7 @@ digger_dig_area_test_for_60_passage(void)
             " 1  :  :  :  :  :  :  :  : \n"
             " 0  :  .  .  .  .  .  .  : \n"
             "-1     :  :  :  :  :  :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -890,7 +891,7 @@ digger_dig_area_test_for_60_passage(void)
             " 1 .. ._ ._ ._ ._ ._ ._ .. \n"
             " 0 .. ._ ._ ._ ._ ._ ._ |. \n"
             "-1    .. .. .. .. .. .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -921,7 +922,7 @@ digger_dig_area_test_for_stairs_up(void)
     assert(box_equals(expected_box, area->box));
     assert(point_equals(point_make(0, 0, 1), digger->point));
 
-    assert(11 == generator->tiles_count);
+    assert(11 == generator->tile_journal->tiles_count);
     char *thumbnail;
 
     char const *expected_directions =
@@ -929,7 +930,7 @@ digger_dig_area_test_for_stairs_up(void)
             " 1  n  n  n  n \n"
             " 0  n  e  e  n \n"
             "-1     n  n  n \n";
-    thumbnail = tiles_thumbnail_directions_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_directions_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_directions, thumbnail));
     free_or_die(thumbnail);
 
@@ -938,7 +939,7 @@ digger_dig_area_test_for_stairs_up(void)
             " 1  0  0  0  0 \n"
             " 0  0  0  0  0 \n"
             "-1     0  0  0 \n";
-    thumbnail = tiles_thumbnail_features_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_features_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_features, thumbnail));
     free_or_die(thumbnail);
 
@@ -947,7 +948,7 @@ digger_dig_area_test_for_stairs_up(void)
             " 1  :  :  :  : \n"
             " 0  :  ^  ^  : \n"
             "-1     :  :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -956,7 +957,7 @@ digger_dig_area_test_for_stairs_up(void)
             " 1 .. ._ ._ .. \n"
             " 0 .. ._ ._ |. \n"
             "-1    .. .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -987,7 +988,7 @@ digger_dig_area_test_for_stairs_down(void)
     assert(box_equals(expected_box, area->box));
     assert(point_equals(point_make(0, 0, 1), digger->point));
 
-    assert(11 == generator->tiles_count);
+    assert(11 == generator->tile_journal->tiles_count);
     char *thumbnail;
 
     char const *expected_directions =
@@ -995,7 +996,7 @@ digger_dig_area_test_for_stairs_down(void)
             " 1  n  n  n  n \n"
             " 0  n  e  e  n \n"
             "-1     n  n  n \n";
-    thumbnail = tiles_thumbnail_directions_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_directions_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_directions, thumbnail));
     free_or_die(thumbnail);
 
@@ -1004,7 +1005,7 @@ digger_dig_area_test_for_stairs_down(void)
             " 1  0  0  0  0 \n"
             " 0  0  0  0  0 \n"
             "-1     0  0  0 \n";
-    thumbnail = tiles_thumbnail_features_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_features_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_features, thumbnail));
     free_or_die(thumbnail);
 
@@ -1013,7 +1014,7 @@ digger_dig_area_test_for_stairs_down(void)
             " 1  :  :  :  : \n"
             " 0  :  v  v  : \n"
             "-1     :  :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -1022,7 +1023,7 @@ digger_dig_area_test_for_stairs_down(void)
             " 1 .. ._ ._ .. \n"
             " 0 .. ._ ._ |. \n"
             "-1    .. .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -1161,7 +1162,7 @@ digger_dig_chamber_test(void)
             " 1 .. |. .. |. \n"
             " 0 .. |. ._ |. \n"
             "-1    .. .. .. \n";
-    char *thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    char *thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -1221,7 +1222,7 @@ digger_dig_intersection_test(void)
             " 1  :  :  : \n"
             " 0  :  .  : \n"
             "-1     :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -1230,7 +1231,7 @@ digger_dig_intersection_test(void)
             " 1 .. ._ .. \n"
             " 0 .. |. |. \n"
             "-1    .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -1291,7 +1292,7 @@ digger_dig_passage_test(void)
             " 1  :  .  : \n"
             " 0  :  .  : \n"
             "-1     :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -1302,7 +1303,7 @@ digger_dig_passage_test(void)
             " 1 .. |. |. \n"
             " 0 .. |= |. \n"
             "-1    .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -1363,7 +1364,7 @@ digger_dig_room_test(void)
             " 1 .. |. .. |. \n"
             " 0 .. |~ ._ |. \n"
             "-1    .. .. .. \n";
-    char *thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    char *thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -1424,7 +1425,7 @@ digger_dig_stairs_down_test(void)
             " 1  :  v  : \n"
             " 0  :  v  : \n"
             "-1     :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -1434,7 +1435,7 @@ digger_dig_stairs_down_test(void)
             " 1 .. |. |. \n"
             " 0 .. |= |. \n"
             "-1    .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
@@ -1495,7 +1496,7 @@ digger_dig_stairs_up_test(void)
             " 1  :  ^  : \n"
             " 0  :  ^  : \n"
             "-1     :  : \n";
-    thumbnail = tiles_thumbnail_types_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_types_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_types, thumbnail));
     free_or_die(thumbnail);
 
@@ -1505,7 +1506,7 @@ digger_dig_stairs_up_test(void)
             " 1 .. |. |. \n"
             " 0 .. |= |. \n"
             "-1    .. .. \n";
-    thumbnail = tiles_thumbnail_walls_alloc(generator->tiles, generator->tiles_count);
+    thumbnail = tiles_thumbnail_walls_alloc(generator->tile_journal->tiles, generator->tile_journal->points, generator->tile_journal->tiles_count);
     assert(str_eq(expected_walls, thumbnail));
     free_or_die(thumbnail);
 
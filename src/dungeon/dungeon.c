@@ -3,11 +3,21 @@
 #include <base/base.h>
 
 #include "area.h"
+#include "area_index.h"
 #include "dungeon_options.h"
+#include "edge_grid.h"
+#include "frozen_dungeon.h"
 #include "generator.h"
+#include "level_boxes.h"
 #include "level_map.h"
+#include "mapped_dungeon.h"
+#include "occupancy_map.h"
 #include "text_rectangle.h"
 #include "tile.h"
+#include "tile_grid.h"
+
+
+static struct tile const blank_tile;
 
 
 void
@@ -15,10 +25,13 @@ dungeon_add_area(struct dungeon *dungeon, struct area *area)
 {
     int index = dungeon->areas_count;
     ++dungeon->areas_count;
-    dungeon->areas = reallocarray_or_die(dungeon->areas,
-                                         dungeon->areas_count,
-                                         sizeof(struct area *));
+    dungeon->areas = arena_grow_array(dungeon->arena,
+                                      dungeon->areas,
+                                      dungeon->areas_count,
+                                      &dungeon->areas_capacity,
+                                      sizeof(struct area *));
     dungeon->areas[index] = area;
+    area_index_add(dungeon->area_index, area);
 }
 
 
@@ -26,24 +39,40 @@ struct dungeon *
 dungeon_alloc(void)
 {
     struct dungeon *dungeon = calloc_or_die(1, sizeof(struct dungeon));
-    dungeon->areas = calloc_or_die(1, sizeof(struct area *));
-    dungeon->tiles = calloc_or_die(1, sizeof(struct tile *));
+    dungeon->arena = arena_alloc();
+    dungeon->areas = arena_grow_array(dungeon->arena, NULL, 1,
+                                      &dungeon->areas_capacity,
+                                      sizeof(struct area *));
+    dungeon->area_index = area_index_alloc();
+    dungeon->tile_grid = tile_grid_alloc();
+    dungeon->level_boxes = level_boxes_alloc();
+    dungeon->occupancy_map = occupancy_map_alloc();
+    dungeon->edge_grid = edge_grid_alloc();
     return dungeon;
 }
 
 
-struct tile **
+struct tile const **
 dungeon_alloc_tiles_for_box(struct dungeon *dungeon, struct box box)
 {
     int count = box_volume(box);
-    struct tile **tiles = calloc_or_die(count, sizeof(struct tile *));
+    struct tile const **tiles = calloc_or_die(count, sizeof(struct tile const *));
     struct point end = box_end_point(box);
     for (int k = box.origin.z; k < end.z; ++k) {
         for (int j = box.origin.y; j < end.y; ++j) {
-            for (int i = box.origin.x; i < end.x; ++i) {
+            int i = box.origin.x;
+            while (i < end.x) {
                 struct point point = point_make(i, j, k);
                 int index = box_index_for_point(box, point);
-                tiles[index] = dungeon_tile_at(dungeon, point);
+                int run_count;
+                struct tile *run = tile_grid_tile_run_at(dungeon->tile_grid,
+                                                         point,
+                                                         &run_count);
+                run_count = min(run_count, end.x - i);
+                for (int n = 0; n < run_count; ++n) {
+                    tiles[index + n] = &run[n];
+                }
+                i += run_count;
             }
         }
     }
@@ -51,31 +80,41 @@ dungeon_alloc_tiles_for_box(struct dungeon *dungeon, struct box box)
 }
 
 
-struct box
-dungeon_box_for_level(struct dungeon *dungeon, int level)
+static void
+recalculate_level_boxes(struct dungeon *dungeon)
 {
-    struct box box = box_make(point_make(0, 0, level), size_make(0, 0, 1));
-    for (size_t i = 0; i < dungeon->tiles_count; ++i) {
-        struct tile *tile = dungeon->tiles[i];
-        if (tile->point.z < level) continue;
-        if (tile->point.z > level) break;
-        if (tile_is_unescavated(tile)) continue;
-        box = box_extend_to_include_point(box, tile->point);
+    level_boxes_clear(dungeon->level_boxes);
+    for (int i = 0; i < dungeon->tile_grid->chunks_count; ++i) {
+        struct tile_chunk *chunk = dungeon->tile_grid->chunks[i];
+        for (int j = 0; j < tile_chunk_tiles_count; ++j) {
+            struct tile *tile = &chunk->tiles[j];
+            if (tile_is_unescavated(tile)) continue;
+            level_boxes_extend_to_include_point(dungeon->level_boxes,
+                                                tile_chunk_point_at(chunk, j));
+        }
     }
-    return box;
+}
+
+
+struct box
+dungeon_box_for_level(struct dungeon const *dungeon, int level)
+{
+    return level_boxes_box_for_level(dungeon->level_boxes, level);
 }
 
 
 int
 dungeon_ending_level(struct dungeon const *dungeon)
 {
-    if (!dungeon->tiles_count) return 0;
-    
-    int level = dungeon->tiles[0]->point.z;
-    for (int i = 0; i < dungeon->tiles_count; ++i) {
-        level = max(level, dungeon->tiles[i]->point.z);
+    int starting_level;
+    int ending_level;
+    if (!level_boxes_level_range(dungeon->level_boxes,
+                                 &starting_level,
+                                 &ending_level))
+    {
+        return 0;
     }
-    return level;
+    return ending_level;
 }
 
 
@@ -83,19 +122,31 @@ void
 dungeon_free(struct dungeon *dungeon)
 {
     if (dungeon) {
-        for (int i = 0; i < dungeon->areas_count; ++i) {
-            area_free(dungeon->areas[i]);
-        }
-        free_or_die(dungeon->areas);
-        for (int i = 0; i < dungeon->tiles_count; ++i) {
-            tile_free(dungeon->tiles[i]);
-        }
-        free_or_die(dungeon->tiles);
+        arena_free(dungeon->arena);
+        area_index_free(dungeon->area_index);
+        tile_grid_free(dungeon->tile_grid);
+        level_boxes_free(dungeon->level_boxes);
+        occupancy_map_free(dungeon->occupancy_map);
+        edge_grid_free(dungeon->edge_grid);
         free_or_die(dungeon);
     }
 }
 
 
+struct frozen_dungeon *
+dungeon_freeze(struct dungeon const *dungeon)
+{
+    return frozen_dungeon_alloc(dungeon);
+}
+
+
+struct frozen_dungeon *
+dungeon_freeze_compressed(struct dungeon const *dungeon)
+{
+    return frozen_dungeon_alloc_compressed(dungeon);
+}
+
+
 void
 dungeon_generate(struct dungeon *dungeon,
                  struct rnd *rnd,
@@ -131,26 +182,29 @@ dungeon_generate_small(struct dungeon *dungeon)
 bool
 dungeon_is_box_excavated(struct dungeon *dungeon, struct box box)
 {
-    for (int i = 0; i < box.size.width; ++i) {
-        for (int j = 0; j < box.size.length; ++j) {
-            for (int k = 0; k < box.size.height; ++k) {
-                struct point point = point_make(box.origin.x + i,
-                                                box.origin.y + j,
-                                                box.origin.z + k);
-                struct tile *tile = dungeon_tile_at(dungeon, point);
-                if (tile_is_escavated(tile)) return true;
-            }
-        }
-    }
-    return false;
+    return occupancy_map_is_box_occupied(dungeon->occupancy_map, box);
 }
 
 
 int
 dungeon_level_count(struct dungeon const *dungeon)
 {
-    if (!dungeon->tiles_count) return 0;
-    return dungeon_ending_level(dungeon) - dungeon_starting_level(dungeon) + 1;
+    int starting_level;
+    int ending_level;
+    if (!level_boxes_level_range(dungeon->level_boxes,
+                                 &starting_level,
+                                 &ending_level))
+    {
+        return 0;
+    }
+    return ending_level - starting_level + 1;
+}
+
+
+struct result
+dungeon_open_mapped(char const *path, struct mapped_dungeon **mapped_dungeon_out)
+{
+    return mapped_dungeon_open(path, mapped_dungeon_out);
 }
 
 
@@ -158,16 +212,14 @@ struct ptr_array *
 dungeon_alloc_descriptions_of_entrances_and_exits_for_level(struct dungeon *dungeon, int level)
 {
     struct ptr_array *descriptions = ptr_array_alloc();
-    for (int i = 0; i < dungeon->areas_count; ++i) {
-        struct area *area = dungeon->areas[i];
-        if (level != area->box.origin.z) continue;
+    int areas_count;
+    struct area *const *areas = area_index_areas_for_level(dungeon->area_index,
+                                                           level,
+                                                           &areas_count);
+    for (int i = 0; i < areas_count; ++i) {
+        struct area *area = areas[i];
         if (area_is_level_transition(area)) {
-            char *location = point_alloc_xy(area_center_point(area));
-            char *area_description = area_alloc_description(area);
-            char *description = str_alloc_formatted("%-12s %s", location, area_description);
-            ptr_array_add(descriptions, description);
-            free_or_die(location);
-            free_or_die(area_description);
+            ptr_array_add(descriptions, area_alloc_located_description(area));
         }
     }
     return descriptions;
@@ -178,41 +230,34 @@ struct ptr_array *
 dungeon_alloc_descriptions_of_chambers_and_rooms_for_level(struct dungeon *dungeon, int level)
 {
     struct ptr_array *descriptions = ptr_array_alloc();
-    for (int i = 0; i < dungeon->areas_count; ++i) {
-        struct area *area = dungeon->areas[i];
-        if (level != area->box.origin.z) continue;
+    int areas_count;
+    struct area *const *areas = area_index_areas_for_level(dungeon->area_index,
+                                                           level,
+                                                           &areas_count);
+    for (int i = 0; i < areas_count; ++i) {
+        struct area *area = areas[i];
         if (area_is_chamber_or_room(area)) {
-            char *location = point_alloc_xy(area_center_point(area));
-            char *area_description = area_alloc_description(area);
-            char *description = str_alloc_formatted("%-12s %s", location, area_description);
-            ptr_array_add(descriptions, description);
-            free_or_die(location);
-            free_or_die(area_description);
+            ptr_array_add(descriptions, area_alloc_located_description(area));
         }
     }
     return descriptions;
 }
 
 
+struct tile const *
+dungeon_get_tile(struct dungeon const *dungeon, struct point point)
+{
+    struct tile const *tile = tile_grid_find_tile(dungeon->tile_grid, point);
+    return tile ? tile : &blank_tile;
+}
+
+
 void
 dungeon_print_areas_for_level(struct dungeon *dungeon, int level, FILE *out)
 {
-    fprintf(out, "  Entrances and Exits:\n");
-    struct ptr_array *descriptions = dungeon_alloc_descriptions_of_entrances_and_exits_for_level(dungeon, level);
-    for (int i = 0; i < descriptions->count; ++i) {
-        fprintf(out, "    %s\n", descriptions->elements[i]);
-    }
-    ptr_array_clear(descriptions, free_or_die);
-    ptr_array_free(descriptions);
-    
-    fprintf(out, "\n");
-    fprintf(out, "  Chambers and Rooms:\n");
-    descriptions = dungeon_alloc_descriptions_of_chambers_and_rooms_for_level(dungeon, level);
-    for (int i = 0; i < descriptions->count; ++i) {
-        fprintf(out, "    %s\n", descriptions->elements[i]);
-    }
-    ptr_array_clear(descriptions, free_or_die);
-    ptr_array_free(descriptions);
+    area_print_and_free_descriptions(dungeon_alloc_descriptions_of_entrances_and_exits_for_level(dungeon, level),
+                                     dungeon_alloc_descriptions_of_chambers_and_rooms_for_level(dungeon, level),
+                                     out);
 }
 
 
@@ -238,32 +283,61 @@ dungeon_print_map_for_level(struct dungeon *dungeon, int level, FILE *out)
 }
 
 
+struct result
+dungeon_save(struct dungeon const *dungeon, char const *path)
+{
+    struct frozen_dungeon *frozen_dungeon = dungeon_freeze(dungeon);
+    struct result result = mapped_dungeon_save(frozen_dungeon, path);
+    frozen_dungeon_free(frozen_dungeon);
+    return result;
+}
+
+
 int
 dungeon_starting_level(struct dungeon const *dungeon)
 {
-    if (!dungeon->tiles_count) return 0;
-    
-    int level = dungeon->tiles[0]->point.z;
-    for (int i = 0; i < dungeon->tiles_count; ++i) {
-        level = min(level, dungeon->tiles[i]->point.z);
+    int starting_level;
+    int ending_level;
+    if (!level_boxes_level_range(dungeon->level_boxes,
+                                 &starting_level,
+                                 &ending_level))
+    {
+        return 0;
     }
-    return level;
+    return starting_level;
 }
 
 
-struct tile *
-dungeon_tile_at(struct dungeon *dungeon, struct point point)
+void
+dungeon_store_tile(struct dungeon *dungeon,
+                   struct point point,
+                   struct tile const *tile)
 {
-    struct tile **tile = tile_find_in_array_sorted_by_point(dungeon->tiles,
-                                                            dungeon->tiles_count,
-                                                            point);
-    if (tile) {
-        return *tile;
-    } else {
-        struct tile *default_tile = tile_alloc(point, tile_type_filled);
-        dungeon->tiles = tile_add_to_array_sorted_by_point(dungeon->tiles,
-                                                           &dungeon->tiles_count,
-                                                           default_tile);
-        return default_tile;
+    struct tile *stored = tile_grid_tile_at(dungeon->tile_grid, point);
+    bool was_escavated = tile_is_escavated(stored);
+    *stored = *tile;
+    occupancy_map_set(dungeon->occupancy_map, point, tile_is_escavated(tile));
+    edge_grid_set_south_wall(dungeon->edge_grid, point, tile_get_south_wall(tile));
+    edge_grid_set_west_wall(dungeon->edge_grid, point, tile_get_west_wall(tile));
+    if (tile_is_escavated(tile)) {
+        level_boxes_extend_to_include_point(dungeon->level_boxes, point);
+    } else if (was_escavated) {
+        recalculate_level_boxes(dungeon);
+    }
+}
+
+
+void
+dungeon_update_level_boxes(struct dungeon *dungeon,
+                           struct level_boxes const *excavated,
+                           bool did_fill)
+{
+    if (did_fill) {
+        recalculate_level_boxes(dungeon);
+        return;
+    }
+    for (int i = 0; i < excavated->boxes_count; ++i) {
+        level_boxes_extend_to_include_box(dungeon->level_boxes,
+                                          excavated->boxes[i]);
     }
 }
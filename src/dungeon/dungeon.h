@@ -3,43 +3,67 @@
 
 
 #include <stdio.h>
+#include <base/result.h>
 
 #include <dungeon/area.h>
 #include <dungeon/area_features.h>
+#include <dungeon/area_index.h>
 #include <dungeon/area_type.h>
 #include <dungeon/box.h>
 #include <dungeon/digger.h>
 #include <dungeon/dungeon_options.h>
+#include <dungeon/edge_grid.h>
 #include <dungeon/exit.h>
+#include <dungeon/frozen_dungeon.h>
 #include <dungeon/generator.h>
+#include <dungeon/level_boxes.h>
 #include <dungeon/level_map.h>
+#include <dungeon/mapped_dungeon.h>
+#include <dungeon/occupancy_map.h>
 #include <dungeon/periodic_check.h>
 #include <dungeon/point.h>
 #include <dungeon/size.h>
 #include <dungeon/text_rectangle.h>
 #include <dungeon/tile.h>
 #include <dungeon/tile_features.h>
+#include <dungeon/tile_grid.h>
+#include <dungeon/tile_spans.h>
 #include <dungeon/tile_type.h>
 #include <dungeon/wall_type.h>
 
 
 struct area;
+struct area_index;
+struct arena;
 struct dungeon_options;
+struct edge_grid;
+struct frozen_dungeon;
 struct generator;
+struct level_boxes;
+struct mapped_dungeon;
+struct occupancy_map;
 struct ptr_array;
 struct rnd;
 struct text_rectangle;
 struct tile;
+struct tile_grid;
 
 
 typedef void (dungeon_progress_callback)(struct generator *generator, void *user_data);
 
 
+// Areas added to a dungeon must be allocated from the dungeon's arena.
+// `area_index' holds the same areas bucketed by level and location.
 struct dungeon {
+    struct arena *arena;
     struct area **areas;
     int areas_count;
-    struct tile **tiles;
-    int tiles_count;
+    int areas_capacity;
+    struct area_index *area_index;
+    struct tile_grid *tile_grid;
+    struct level_boxes *level_boxes;
+    struct occupancy_map *occupancy_map;
+    struct edge_grid *edge_grid;
 };
 
 
@@ -59,9 +83,29 @@ dungeon_generate(struct dungeon *dungeon,
 void
 dungeon_generate_small(struct dungeon *dungeon);
 
+// Copies the dungeon into a read-only form that can be rendered from many
+// threads at once.  Later changes to the dungeon don't affect the copy.
+struct frozen_dungeon *
+dungeon_freeze(struct dungeon const *dungeon);
+
+// Like dungeon_freeze(), but the copy stores only the spans of each row
+// that aren't solid rock, so its size grows with the excavated tiles rather
+// than with the levels' boxes.
+struct frozen_dungeon *
+dungeon_freeze_compressed(struct dungeon const *dungeon);
+
 int
 dungeon_level_count(struct dungeon const *dungeon);
 
+// Maps a file written by dungeon_save() into memory without reading its
+// tiles; see mapped_dungeon_open().
+struct result
+dungeon_open_mapped(char const *path, struct mapped_dungeon **mapped_dungeon_out);
+
+// Writes a frozen copy of the dungeon to `path'.
+struct result
+dungeon_save(struct dungeon const *dungeon, char const *path);
+
 int
 dungeon_starting_level(struct dungeon const *dungeon);
 
@@ -90,13 +134,28 @@ bool
 dungeon_is_box_excavated(struct dungeon *dungeon, struct box box);
 
 struct box
-dungeon_box_for_level(struct dungeon *dungeon, int level);
+dungeon_box_for_level(struct dungeon const *dungeon, int level);
 
-struct tile **
+struct tile const **
 dungeon_alloc_tiles_for_box(struct dungeon *dungeon, struct box box);
 
-struct tile *
-dungeon_tile_at(struct dungeon *dungeon, struct point point);
+// Returns a filled tile for points that were never stored.  Doesn't allocate
+// tiles.  Use dungeon_store_tile() to change tiles.
+struct tile const *
+dungeon_get_tile(struct dungeon const *dungeon, struct point point);
+
+void
+dungeon_store_tile(struct dungeon *dungeon,
+                   struct point point,
+                   struct tile const *tile);
+
+// Updates the level boxes after tiles in the tile grid were changed in place.
+// `excavated' holds the boxes of the newly excavated tiles; set `did_fill' if
+// any excavated tiles were filled.
+void
+dungeon_update_level_boxes(struct dungeon *dungeon,
+                           struct level_boxes const *excavated,
+                           bool did_fill);
 
 
 #endif
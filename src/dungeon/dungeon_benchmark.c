@@ -0,0 +1,102 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <base/base.h>
+#include <dungeon/dungeon.h>
+
+
+static struct size const sizes[] = {
+    { .width=25, .length=25, .height=5 },
+    { .width=50, .length=50, .height=5 },
+    { .width=50, .length=50, .height=10 },
+    { .width=100, .length=100, .height=10 },
+    { .width=100, .length=100, .height=20 },
+    { .width=200, .length=200, .height=20 },
+};
+static int const sizes_count = ARRAY_COUNT(sizes);
+
+
+static int
+excavated_tiles_count(struct dungeon *dungeon)
+{
+    int count = 0;
+    for (int i = 0; i < dungeon->tile_grid->chunks_count; ++i) {
+        struct tile_chunk *chunk = dungeon->tile_grid->chunks[i];
+        for (int j = 0; j < tile_chunk_tiles_count; ++j) {
+            if (tile_is_escavated(&chunk->tiles[j])) ++count;
+        }
+    }
+    return count;
+}
+
+
+static void
+frozen_sizes(struct dungeon *dungeon, long long *dense_bytes_out, long long *spans_bytes_out)
+{
+    struct frozen_dungeon *frozen_dungeon = dungeon_freeze_compressed(dungeon);
+    *dense_bytes_out = 0;
+    *spans_bytes_out = 0;
+    for (int i = 0; i < frozen_dungeon->levels_count; ++i) {
+        struct frozen_level const *level = &frozen_dungeon->levels[i];
+        *dense_bytes_out += (long long)box_volume(level->box) * sizeof(struct tile);
+        *spans_bytes_out += tile_spans_size(level->tile_spans);
+    }
+    frozen_dungeon_free(frozen_dungeon);
+}
+
+
+static void
+generate(struct size max_size, int max_iteration_count, FILE *out)
+{
+    unsigned short seed[3] = { 0x1234, 0x5678, 0x9abc };
+    struct rnd *rnd = rnd_alloc_jrand48(seed);
+    struct dungeon_options *dungeon_options = dungeon_options_alloc(max_iteration_count,
+                                                                    max_size,
+                                                                    1);
+    struct dungeon *dungeon = dungeon_alloc();
+
+    alloc_or_die_reset_peak_bytes();
+    struct alloc_or_die_counts start_counts = alloc_or_die_counts();
+    clock_t start = clock();
+    dungeon_generate(dungeon, rnd, dungeon_options, NULL, NULL);
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    struct alloc_or_die_counts end_counts = alloc_or_die_counts();
+    long alloc_count = end_counts.total_count - start_counts.total_count;
+    long long peak_kib = (end_counts.peak_bytes - start_counts.current_bytes) / 1024;
+
+    int volume = max_size.width * max_size.length * max_size.height;
+    int tiles_count = excavated_tiles_count(dungeon);
+    double microseconds_per_tile = tiles_count ? seconds * 1e6 / tiles_count : 0.0;
+    double allocs_per_tile = tiles_count ? (double)alloc_count / tiles_count : 0.0;
+    long long dense_bytes;
+    long long spans_bytes;
+    frozen_sizes(dungeon, &dense_bytes, &spans_bytes);
+    fprintf(out, "%4i x %4i x %3i  %9i  %9i  %9i  %9.3f  %9.2f  %11.3f  %9lli  %10lli  %9lli\n",
+            max_size.width, max_size.length, max_size.height,
+            volume, dungeon->areas_count, tiles_count,
+            seconds, microseconds_per_tile, allocs_per_tile, peak_kib,
+            dense_bytes / 1024, spans_bytes / 1024);
+
+    dungeon_free(dungeon);
+    dungeon_options_free(dungeon_options);
+    rnd_free(rnd);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    int count = sizes_count;
+    if (argc > 1) count = min(sizes_count, max(1, atoi(argv[1])));
+    int const max_iteration_count = 10000;
+
+    FILE *out = stdout;
+    fprintf(out, "Dungeon generation (max %i iterations)\n", max_iteration_count);
+    fprintf(out, "      max size        volume      areas      tiles    seconds    us/tile  allocs/tile   peak KiB  frozen KiB  spans KiB\n");
+    for (int i = 0; i < count; ++i) {
+        generate(sizes[i], max_iteration_count, out);
+    }
+
+    alloc_count_is_zero_or_die();
+    return EXIT_SUCCESS;
+}
@@ -9,6 +9,15 @@ void
 dungeon_test(void);
 
 
+static void
+store_tile_type(struct dungeon *dungeon, struct point point, enum tile_type type)
+{
+    struct tile tile = *dungeon_get_tile(dungeon, point);
+    tile_set_type(&tile, type);
+    dungeon_store_tile(dungeon, point, &tile);
+}
+
+
 static void
 dungeon_alloc_test(void)
 {
@@ -16,8 +25,8 @@ dungeon_alloc_test(void)
 
     assert(dungeon->areas);
     assert(0 == dungeon->areas_count);
-    assert(dungeon->tiles);
-    assert(0 == dungeon->tiles_count);
+    assert(dungeon->tile_grid);
+    assert(0 == dungeon->tile_grid->tiles_count);
 
     dungeon_free(dungeon);
 }
@@ -32,21 +41,21 @@ dungeon_generate_small_test(void)
     struct box box = dungeon_box_for_level(dungeon, 1);
     assert(box_equals(box, box_make(point_make(-7, 0, 1), size_make(16, 15, 1))));
     
-    struct tile *tile = dungeon_tile_at(dungeon, point_make(0, 0, 1));
+    struct tile const *tile = dungeon_get_tile(dungeon, point_make(0, 0, 1));
     assert(tile);
-    assert(tile_type_stairs_up == tile->type);
+    assert(tile_type_stairs_up == tile_get_type(tile));
     
-    tile = dungeon_tile_at(dungeon, point_make(0, 1, 1));
+    tile = dungeon_get_tile(dungeon, point_make(0, 1, 1));
     assert(tile);
-    assert(tile_type_stairs_up == tile->type);
+    assert(tile_type_stairs_up == tile_get_type(tile));
     
-    tile = dungeon_tile_at(dungeon, point_make(0, 2, 1));
+    tile = dungeon_get_tile(dungeon, point_make(0, 2, 1));
     assert(tile);
-    assert(tile_type_empty == tile->type);
+    assert(tile_type_empty == tile_get_type(tile));
     
-    tile = dungeon_tile_at(dungeon, point_make(-1, -8, 1));
+    tile = dungeon_get_tile(dungeon, point_make(-1, -8, 1));
     assert(tile);
-    assert(tile_type_filled == tile->type);
+    assert(tile_type_filled == tile_get_type(tile));
     
     dungeon_free(dungeon);
 }
@@ -56,24 +65,19 @@ static void
 dungeon_level_count_test(void)
 {
     struct dungeon *dungeon = dungeon_alloc();
-    struct tile *tile;
 
     assert(0 == dungeon_level_count(dungeon));
 
-    tile = dungeon_tile_at(dungeon, point_make(0, 0, 3));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(0, 0, 3), tile_type_empty);
     assert(1 == dungeon_level_count(dungeon));
 
-    tile = dungeon_tile_at(dungeon, point_make(10, 10, 5));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(10, 10, 5), tile_type_empty);
     assert(3 == dungeon_level_count(dungeon));
 
-    tile = dungeon_tile_at(dungeon, point_make(-5, -5, 4));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(-5, -5, 4), tile_type_empty);
     assert(3 == dungeon_level_count(dungeon));
 
-    tile = dungeon_tile_at(dungeon, point_make(5, 5, 2));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(5, 5, 2), tile_type_empty);
     assert(4 == dungeon_level_count(dungeon));
 
     // TODO: test behavior with other tile types
@@ -86,20 +90,16 @@ static void
 dungeon_starting_level_test(void)
 {
     struct dungeon *dungeon = dungeon_alloc();
-    struct tile *tile;
 
     assert(0 == dungeon_starting_level(dungeon));
 
-    tile = dungeon_tile_at(dungeon, point_make(0, 0, 3));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(0, 0, 3), tile_type_empty);
     assert(3 == dungeon_starting_level(dungeon));
 
-    tile = dungeon_tile_at(dungeon, point_make(-5, -5, 4));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(-5, -5, 4), tile_type_empty);
     assert(3 == dungeon_starting_level(dungeon));
 
-    tile = dungeon_tile_at(dungeon, point_make(5, 5, 2));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(5, 5, 2), tile_type_empty);
     assert(2 == dungeon_starting_level(dungeon));
 
     // TODO: test behavior with other tile types
@@ -112,20 +112,16 @@ static void
 dungeon_ending_level_test(void)
 {
     struct dungeon *dungeon = dungeon_alloc();
-    struct tile *tile;
 
     assert(0 == dungeon_ending_level(dungeon));
 
-    tile = dungeon_tile_at(dungeon, point_make(0, 0, 3));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(0, 0, 3), tile_type_empty);
     assert(3 == dungeon_ending_level(dungeon));
 
-    tile = dungeon_tile_at(dungeon, point_make(-5, -5, 4));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(-5, -5, 4), tile_type_empty);
     assert(4 == dungeon_ending_level(dungeon));
 
-    tile = dungeon_tile_at(dungeon, point_make(5, 5, 7));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(5, 5, 7), tile_type_empty);
     assert(7 == dungeon_ending_level(dungeon));
 
     // TODO: test behavior with other tile types
@@ -138,31 +134,28 @@ static void
 dungeon_box_for_level_test(void)
 {
     struct dungeon *dungeon = dungeon_alloc();
-    struct tile *tile;
     struct box box, expected;
 
     expected = box_make(point_make(0, 0, 2), size_make(0, 0, 1));
     box = dungeon_box_for_level(dungeon, 2);
     assert(box_equals(expected, box));
 
-    tile = dungeon_tile_at(dungeon, point_make(5, 5, 2));
+    store_tile_type(dungeon, point_make(5, 5, 2), tile_type_filled);
     expected = box_make(point_make(0, 0, 2), size_make(0, 0, 1));
     box = dungeon_box_for_level(dungeon, 2);
     assert(box_equals(expected, box));
 
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(5, 5, 2), tile_type_empty);
     expected = box_make(point_make(5, 5, 2), size_make(1, 1, 1));
     box = dungeon_box_for_level(dungeon, 2);
     assert(box_equals(expected, box));
 
-    tile = dungeon_tile_at(dungeon, point_make(10, 5, 2));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(10, 5, 2), tile_type_empty);
     expected = box_make(point_make(5, 5, 2), size_make(6, 1, 1));
     box = dungeon_box_for_level(dungeon, 2);
     assert(box_equals(expected, box));
 
-    tile = dungeon_tile_at(dungeon, point_make(10, 2, 2));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(10, 2, 2), tile_type_empty);
     expected = box_make(point_make(5, 2, 2), size_make(6, 4, 1));
     box = dungeon_box_for_level(dungeon, 2);
     assert(box_equals(expected, box));
@@ -171,6 +164,32 @@ dungeon_box_for_level_test(void)
 }
 
 
+static void
+dungeon_store_tile_test(void)
+{
+    struct dungeon *dungeon = dungeon_alloc();
+    struct tile *tile = tile_alloc(tile_type_empty);
+    struct box expected;
+
+    dungeon_store_tile(dungeon, point_make(5, 5, 2), tile);
+    assert(tile_type_empty == tile_get_type(dungeon_get_tile(dungeon, point_make(5, 5, 2))));
+    expected = box_make(point_make(5, 5, 2), size_make(1, 1, 1));
+    assert(box_equals(expected, dungeon_box_for_level(dungeon, 2)));
+
+    dungeon_store_tile(dungeon, point_make(8, 3, 2), tile);
+    expected = box_make(point_make(5, 3, 2), size_make(4, 3, 1));
+    assert(box_equals(expected, dungeon_box_for_level(dungeon, 2)));
+
+    tile_set_type(tile, tile_type_filled);
+    dungeon_store_tile(dungeon, point_make(8, 3, 2), tile);
+    expected = box_make(point_make(5, 5, 2), size_make(1, 1, 1));
+    assert(box_equals(expected, dungeon_box_for_level(dungeon, 2)));
+
+    tile_free(tile);
+    dungeon_free(dungeon);
+}
+
+
 static void
 dungeon_add_area_test(void)
 {
@@ -181,14 +200,14 @@ dungeon_add_area_test(void)
     assert(0 == dungeon->areas_count);
 
     box = box_make(point_make(0, 0, 1), size_make(3, 4, 1));
-    area = area_alloc(area_type_chamber, direction_north, box);
+    area = area_alloc_from_arena(dungeon->arena, area_type_chamber, direction_north, box);
     dungeon_add_area(dungeon, area);
 
     assert(1 == dungeon->areas_count);
     assert(area == dungeon->areas[0]);
 
     box = box_make(point_make(10, 10, 1), size_make(1, 6, 1));
-    area = area_alloc(area_type_passage, direction_north, box);
+    area = area_alloc_from_arena(dungeon->arena, area_type_passage, direction_north, box);
     dungeon_add_area(dungeon, area);
 
     assert(2 == dungeon->areas_count);
@@ -204,30 +223,26 @@ dungeon_is_box_excavated_test(void)
 {
     struct dungeon *dungeon = dungeon_alloc();
     struct box box;
-    struct tile *tile;
 
     box = box_make(point_make(0, 0, 1), size_make(3, 4, 1));
     assert(!dungeon_is_box_excavated(dungeon, box));
 
-    tile = dungeon_tile_at(dungeon, point_make(3, 0, 1));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(3, 0, 1), tile_type_empty);
     assert(!dungeon_is_box_excavated(dungeon, box));
 
-    tile = dungeon_tile_at(dungeon, point_make(2, 0, 1));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(2, 0, 1), tile_type_empty);
     assert(dungeon_is_box_excavated(dungeon, box));
 
-    tile->type = tile_type_filled;
+    store_tile_type(dungeon, point_make(2, 0, 1), tile_type_filled);
     assert(!dungeon_is_box_excavated(dungeon, box));
 
-    tile = dungeon_tile_at(dungeon, point_make(1, 1, 1));
-    tile->type = tile_type_stairs_down;
+    store_tile_type(dungeon, point_make(1, 1, 1), tile_type_stairs_down);
     assert(dungeon_is_box_excavated(dungeon, box));
 
-    tile->type = tile_type_stairs_up;
+    store_tile_type(dungeon, point_make(1, 1, 1), tile_type_stairs_up);
     assert(dungeon_is_box_excavated(dungeon, box));
 
-    tile->type = tile_type_filled;
+    store_tile_type(dungeon, point_make(1, 1, 1), tile_type_filled);
     assert(!dungeon_is_box_excavated(dungeon, box));
 
     dungeon_free(dungeon);
@@ -239,30 +254,30 @@ dungeon_alloc_tiles_for_box_test(void)
 {
     struct dungeon *dungeon = dungeon_alloc();
     struct box box;
-    struct tile **tiles;
+    struct tile const **tiles;
 
     box = box_make(point_make(0, 0, 1), size_make(2, 3, 1));
     tiles = dungeon_alloc_tiles_for_box(dungeon, box);
 
     assert(tiles);
-    assert(point_equals(point_make(0, 0, 1), tiles[0]->point));
-    assert(point_equals(point_make(1, 0, 1), tiles[1]->point));
-    assert(point_equals(point_make(0, 1, 1), tiles[2]->point));
-    assert(point_equals(point_make(1, 1, 1), tiles[3]->point));
-    assert(point_equals(point_make(0, 2, 1), tiles[4]->point));
-    assert(point_equals(point_make(1, 2, 1), tiles[5]->point));
+    assert(tiles[0] == dungeon_get_tile(dungeon, point_make(0, 0, 1)));
+    assert(tiles[1] == dungeon_get_tile(dungeon, point_make(1, 0, 1)));
+    assert(tiles[2] == dungeon_get_tile(dungeon, point_make(0, 1, 1)));
+    assert(tiles[3] == dungeon_get_tile(dungeon, point_make(1, 1, 1)));
+    assert(tiles[4] == dungeon_get_tile(dungeon, point_make(0, 2, 1)));
+    assert(tiles[5] == dungeon_get_tile(dungeon, point_make(1, 2, 1)));
     free_or_die(tiles);
 
     box = box_make(point_make(0, 0, 1), size_make(2, 1, 3));
     tiles = dungeon_alloc_tiles_for_box(dungeon, box);
 
     assert(tiles);
-    assert(point_equals(point_make(0, 0, 1), tiles[0]->point));
-    assert(point_equals(point_make(1, 0, 1), tiles[1]->point));
-    assert(point_equals(point_make(0, 0, 2), tiles[2]->point));
-    assert(point_equals(point_make(1, 0, 2), tiles[3]->point));
-    assert(point_equals(point_make(0, 0, 3), tiles[4]->point));
-    assert(point_equals(point_make(1, 0, 3), tiles[5]->point));
+    assert(tiles[0] == dungeon_get_tile(dungeon, point_make(0, 0, 1)));
+    assert(tiles[1] == dungeon_get_tile(dungeon, point_make(1, 0, 1)));
+    assert(tiles[2] == dungeon_get_tile(dungeon, point_make(0, 0, 2)));
+    assert(tiles[3] == dungeon_get_tile(dungeon, point_make(1, 0, 2)));
+    assert(tiles[4] == dungeon_get_tile(dungeon, point_make(0, 0, 3)));
+    assert(tiles[5] == dungeon_get_tile(dungeon, point_make(1, 0, 3)));
     free_or_die(tiles);
 
     dungeon_free(dungeon);
@@ -270,32 +285,35 @@ dungeon_alloc_tiles_for_box_test(void)
 
 
 static void
-dungeon_tile_at_test(void)
+dungeon_get_tile_test(void)
 {
     struct dungeon *dungeon = dungeon_alloc();
-    struct tile *tile;
-
-    tile = dungeon_tile_at(dungeon, point_make(0, 0, 1));
-    assert(tile);
-    assert(tile_type_filled == tile->type);
-    assert(tile_features_none == tile->features);
-    assert(direction_north == tile->direction);
-    assert(wall_type_none == tile->walls.south);
-    assert(wall_type_none == tile->walls.west);
-    assert(point_equals(point_make(0, 0, 1), tile->point));
-    tile->type = tile_type_empty;
-    tile->walls.south = wall_type_solid;
-    tile->walls.west = wall_type_solid;
-
-    tile = dungeon_tile_at(dungeon, point_make(0, 0, 1));
-    assert(tile);
-    assert(tile_type_empty == tile->type);
-    assert(tile_features_none == tile->features);
-    assert(direction_north == tile->direction);
-    assert(wall_type_solid == tile->walls.south);
-    assert(wall_type_solid == tile->walls.west);
-    assert(point_equals(point_make(0, 0, 1), tile->point));
-
+    struct tile *tile = tile_alloc(tile_type_empty);
+    dungeon_store_tile(dungeon, point_make(0, 0, 1), tile);
+
+    struct tile const *stored = dungeon_get_tile(dungeon, point_make(0, 0, 1));
+    assert(tile_type_empty == tile_get_type(stored));
+    assert(stored == tile_grid_find_tile(dungeon->tile_grid, point_make(0, 0, 1)));
+
+    tile_set_south_wall(tile, wall_type_solid);
+    tile_set_west_wall(tile, wall_type_door);
+    dungeon_store_tile(dungeon, point_make(0, 0, 1), tile);
+    stored = dungeon_get_tile(dungeon, point_make(0, 0, 1));
+    assert(tile_type_empty == tile_get_type(stored));
+    assert(wall_type_solid == tile_get_south_wall(stored));
+    assert(wall_type_door == tile_get_west_wall(stored));
+
+    int chunks_count = dungeon->tile_grid->chunks_count;
+    struct tile const *blank = dungeon_get_tile(dungeon, point_make(100, 100, 3));
+    assert(tile_type_filled == tile_get_type(blank));
+    assert(tile_features_none == tile_get_features(blank));
+    assert(direction_north == tile_get_direction(blank));
+    assert(wall_type_none == tile_get_south_wall(blank));
+    assert(wall_type_none == tile_get_west_wall(blank));
+    assert(tile_is_blank(blank));
+    assert(chunks_count == dungeon->tile_grid->chunks_count);
+
+    tile_free(tile);
     dungeon_free(dungeon);
 }
 
@@ -304,8 +322,7 @@ static void
 dungeon_alloc_text_rectangle_for_level_test(void)
 {
     struct dungeon *dungeon = dungeon_alloc();
-    struct tile *tile = dungeon_tile_at(dungeon, point_make(0, 0, 1));
-    tile->type = tile_type_empty;
+    store_tile_type(dungeon, point_make(0, 0, 1), tile_type_empty);
 
     struct text_rectangle *text_rectangle = dungeon_alloc_text_rectangle_for_level(dungeon, 1);
     assert(text_rectangle);
@@ -342,7 +359,7 @@ dungeon_alloc_descriptions_of_entrances_and_exits_for_level_test(void)
     ptr_array_free(descriptions);
 
     box = box_make(point_make(4, 4, 1), size_make(2, 2, 1));
-    area = area_alloc(area_type_chamber, direction_north, box);
+    area = area_alloc_from_arena(dungeon->arena, area_type_chamber, direction_north, box);
     dungeon_add_area(dungeon, area);
 
     descriptions = dungeon_alloc_descriptions_of_entrances_and_exits_for_level(dungeon, 1);
@@ -351,7 +368,7 @@ dungeon_alloc_descriptions_of_entrances_and_exits_for_level_test(void)
     ptr_array_free(descriptions);
 
     box = box_make(point_make(0, 0, 1), size_make(1, 2, 1));
-    area = area_alloc(area_type_stairs_down, direction_north, box);
+    area = area_alloc_from_arena(dungeon->arena, area_type_stairs_down, direction_north, box);
     dungeon_add_area(dungeon, area);
 
     descriptions = dungeon_alloc_descriptions_of_entrances_and_exits_for_level(dungeon, 1);
@@ -362,7 +379,7 @@ dungeon_alloc_descriptions_of_entrances_and_exits_for_level_test(void)
     ptr_array_free(descriptions);
 
     box = box_make(point_make(10, 10, 1), size_make(3, 3, 1));
-    area = area_alloc(area_type_room, direction_north, box);
+    area = area_alloc_from_arena(dungeon->arena, area_type_room, direction_north, box);
     area->features = area_features_chimney_up;
     dungeon_add_area(dungeon, area);
 
@@ -392,7 +409,7 @@ dungeon_alloc_descriptions_of_chambers_and_rooms_for_level_test(void)
     ptr_array_free(descriptions);
 
     box = box_make(point_make(0, 0, 1), size_make(1, 2, 1));
-    area = area_alloc(area_type_stairs_down, direction_north, box);
+    area = area_alloc_from_arena(dungeon->arena, area_type_stairs_down, direction_north, box);
     dungeon_add_area(dungeon, area);
 
     descriptions = dungeon_alloc_descriptions_of_chambers_and_rooms_for_level(dungeon, 1);
@@ -401,7 +418,7 @@ dungeon_alloc_descriptions_of_chambers_and_rooms_for_level_test(void)
     ptr_array_free(descriptions);
 
     box = box_make(point_make(4, 4, 1), size_make(2, 2, 1));
-    area = area_alloc(area_type_chamber, direction_north, box);
+    area = area_alloc_from_arena(dungeon->arena, area_type_chamber, direction_north, box);
     dungeon_add_area(dungeon, area);
 
     descriptions = dungeon_alloc_descriptions_of_chambers_and_rooms_for_level(dungeon, 1);
@@ -412,7 +429,7 @@ dungeon_alloc_descriptions_of_chambers_and_rooms_for_level_test(void)
     ptr_array_free(descriptions);
 
     box = box_make(point_make(10, 10, 1), size_make(3, 3, 1));
-    area = area_alloc(area_type_room, direction_north, box);
+    area = area_alloc_from_arena(dungeon->arena, area_type_room, direction_north, box);
     area->features = area_features_chimney_up;
     dungeon_add_area(dungeon, area);
 
@@ -437,10 +454,11 @@ dungeon_test(void)
     dungeon_starting_level_test();
     dungeon_ending_level_test();
     dungeon_box_for_level_test();
+    dungeon_store_tile_test();
     dungeon_add_area_test();
     dungeon_is_box_excavated_test();
     dungeon_alloc_tiles_for_box_test();
-    dungeon_tile_at_test();
+    dungeon_get_tile_test();
     dungeon_alloc_text_rectangle_for_level_test();
     dungeon_alloc_descriptions_of_entrances_and_exits_for_level_test();
     dungeon_alloc_descriptions_of_chambers_and_rooms_for_level_test();
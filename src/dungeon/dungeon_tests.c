@@ -2,6 +2,9 @@
 #include <base/base.h>
 
 
+void
+area_index_test(void);
+
 void
 area_test(void);
 
@@ -14,12 +17,30 @@ digger_test(void);
 void
 dungeon_test(void);
 
+void
+edge_grid_test(void);
+
+void
+frozen_dungeon_test(void);
+
 void
 generator_test(void);
 
+void
+level_array_test(void);
+
+void
+level_boxes_test(void);
+
 void
 level_map_test(void);
 
+void
+mapped_dungeon_test(void);
+
+void
+occupancy_map_test(void);
+
 void
 point_test(void);
 
@@ -29,6 +50,15 @@ size_test(void);
 void
 text_rectangle_test(void);
 
+void
+tile_grid_test(void);
+
+void
+tile_journal_test(void);
+
+void
+tile_spans_test(void);
+
 void
 tile_test(void);
 
@@ -39,15 +69,25 @@ tiles_thumbnail_test(void);
 int
 main(int argc, char *argv[])
 {
+    area_index_test();
     area_test();
     box_test();
     digger_test();
     dungeon_test();
+    edge_grid_test();
+    frozen_dungeon_test();
     generator_test();
+    level_array_test();
+    level_boxes_test();
     level_map_test();
+    mapped_dungeon_test();
+    occupancy_map_test();
     point_test();
     size_test();
     text_rectangle_test();
+    tile_grid_test();
+    tile_journal_test();
+    tile_spans_test();
     tile_test();
     tiles_thumbnail_test();
     alloc_count_is_zero_or_die();
@@ -0,0 +1,260 @@
+#include "edge_grid.h"
+
+#include <assert.h>
+#include <base/base.h>
+
+#include "level_array.h"
+
+
+extern inline uint32_t
+edge_grid_exits_mask(uint64_t walls);
+
+extern inline enum wall_type
+edge_grid_wall_at(uint64_t walls, int index);
+
+
+static int const min_grow_lines_count = 16;
+static int const min_grow_words_count = 1;
+
+
+static inline int
+plane_end_line(struct edge_plane const *plane)
+{
+    return plane->origin_line + plane->lines_count;
+}
+
+
+static inline int
+plane_end_offset(struct edge_plane const *plane)
+{
+    return plane->origin_offset + plane->words_per_line * edge_grid_edges_per_word;
+}
+
+
+static inline bool
+plane_contains(struct edge_plane const *plane, int line, int offset)
+{
+    return plane->words
+        && line >= plane->origin_line && line < plane_end_line(plane)
+        && offset >= plane->origin_offset && offset < plane_end_offset(plane);
+}
+
+
+static inline uint64_t *
+plane_word(struct edge_plane const *plane, int line, int offset)
+{
+    int index = (offset - plane->origin_offset) / edge_grid_edges_per_word;
+    return &plane->words[(line - plane->origin_line) * plane->words_per_line + index];
+}
+
+
+static inline int
+plane_shift(struct edge_plane const *plane, int offset)
+{
+    return ((offset - plane->origin_offset) % edge_grid_edges_per_word) * edge_grid_edge_bits;
+}
+
+
+// Grows the plane to include the edge at (`line', `offset'), with some slack
+// in the direction it grows.
+static void
+include_edge(struct edge_plane *plane, int line, int offset)
+{
+    if (plane_contains(plane, line, offset)) return;
+
+    int origin_offset = floor_to_multiple(offset, edge_grid_edges_per_word);
+    int end_offset = origin_offset + edge_grid_edges_per_word;
+    int origin_line = line;
+    int end_line = line + 1;
+    if (plane->words) {
+        int grow_words_count = max(min_grow_words_count, plane->words_per_line / 2);
+        int grow_lines_count = max(min_grow_lines_count, plane->lines_count / 2);
+        int grow_offset = grow_words_count * edge_grid_edges_per_word;
+        origin_offset = (origin_offset < plane->origin_offset)
+                      ? min(origin_offset, plane->origin_offset - grow_offset)
+                      : plane->origin_offset;
+        end_offset = (end_offset > plane_end_offset(plane))
+                   ? max(end_offset, plane_end_offset(plane) + grow_offset)
+                   : plane_end_offset(plane);
+        origin_line = (origin_line < plane->origin_line)
+                    ? min(origin_line, plane->origin_line - grow_lines_count)
+                    : plane->origin_line;
+        end_line = (end_line > plane_end_line(plane))
+                 ? max(end_line, plane_end_line(plane) + grow_lines_count)
+                 : plane_end_line(plane);
+    }
+
+    int words_per_line = (end_offset - origin_offset) / edge_grid_edges_per_word;
+    int lines_count = end_line - origin_line;
+    uint64_t *words = calloc_or_die((size_t)words_per_line * lines_count,
+                                    sizeof(uint64_t));
+    if (plane->words) {
+        int word_offset = (plane->origin_offset - origin_offset) / edge_grid_edges_per_word;
+        int line_offset = plane->origin_line - origin_line;
+        for (int i = 0; i < plane->lines_count; ++i) {
+            memcpy(&words[(i + line_offset) * words_per_line + word_offset],
+                   &plane->words[i * plane->words_per_line],
+                   plane->words_per_line * sizeof(uint64_t));
+        }
+        free_or_die(plane->words);
+    }
+    plane->origin_line = origin_line;
+    plane->origin_offset = origin_offset;
+    plane->words_per_line = words_per_line;
+    plane->lines_count = lines_count;
+    plane->words = words;
+}
+
+
+static enum wall_type
+plane_wall(struct edge_plane const *plane, int line, int offset)
+{
+    if (!plane_contains(plane, line, offset)) return wall_type_none;
+    return edge_grid_wall_at(*plane_word(plane, line, offset) >> plane_shift(plane, offset), 0);
+}
+
+
+static uint64_t
+plane_walls(struct edge_plane const *plane, int line, int offset, int count)
+{
+    assert(count >= 0 && count <= edge_grid_edges_per_word);
+    if (!count || !plane->words) return 0;
+    if (line < plane->origin_line || line >= plane_end_line(plane)) return 0;
+
+    int first = max(offset, plane->origin_offset);
+    int end = min(offset + count, plane_end_offset(plane));
+    if (first >= end) return 0;
+
+    // the run spans at most two words; read them as one 128-bit window
+    uint64_t const *word = plane_word(plane, line, first);
+    int shift = plane_shift(plane, first);
+    uint64_t walls = word[0] >> shift;
+    int word_index = (first - plane->origin_offset) / edge_grid_edges_per_word;
+    if (shift && word_index + 1 < plane->words_per_line) {
+        walls |= word[1] << (64 - shift);
+    }
+    int read_count = end - first;
+    if (read_count < edge_grid_edges_per_word) {
+        walls &= (UINT64_C(1) << (read_count * edge_grid_edge_bits)) - 1;
+    }
+    return walls << ((first - offset) * edge_grid_edge_bits);
+}
+
+
+static void
+set_plane_wall(struct edge_plane *plane, int line, int offset, enum wall_type wall_type)
+{
+    if (wall_type_none == wall_type) {
+        if (!plane_contains(plane, line, offset)) return;
+    } else {
+        include_edge(plane, line, offset);
+    }
+    uint64_t *word = plane_word(plane, line, offset);
+    int shift = plane_shift(plane, offset);
+    *word = (*word & ~(UINT64_C(0x3) << shift)) | ((uint64_t)wall_type << shift);
+}
+
+
+static struct edge_level *
+find_level(struct edge_grid const *edge_grid, int z)
+{
+    int index = level_array_index(edge_grid->levels_count, edge_grid->min_level, z);
+    return index < 0 ? NULL : &edge_grid->levels[index];
+}
+
+
+static struct edge_level *
+include_level(struct edge_grid *edge_grid, int z)
+{
+    edge_grid->levels = level_array_include(edge_grid->levels,
+                                            &edge_grid->levels_count,
+                                            &edge_grid->min_level,
+                                            z,
+                                            sizeof(struct edge_level));
+    return &edge_grid->levels[z - edge_grid->min_level];
+}
+
+
+struct edge_grid *
+edge_grid_alloc(void)
+{
+    return calloc_or_die(1, sizeof(struct edge_grid));
+}
+
+
+void
+edge_grid_free(struct edge_grid *edge_grid)
+{
+    if (edge_grid) {
+        for (int i = 0; i < edge_grid->levels_count; ++i) {
+            free_or_die(edge_grid->levels[i].south_walls.words);
+            free_or_die(edge_grid->levels[i].west_walls.words);
+        }
+        free_or_die(edge_grid->levels);
+        free_or_die(edge_grid);
+    }
+}
+
+
+enum wall_type
+edge_grid_south_wall(struct edge_grid const *edge_grid, struct point point)
+{
+    struct edge_level const *level = find_level(edge_grid, point.z);
+    if (!level) return wall_type_none;
+    return plane_wall(&level->south_walls, point.y, point.x);
+}
+
+
+uint64_t
+edge_grid_south_walls(struct edge_grid const *edge_grid,
+                      struct point point,
+                      int count)
+{
+    struct edge_level const *level = find_level(edge_grid, point.z);
+    if (!level) return 0;
+    return plane_walls(&level->south_walls, point.y, point.x, count);
+}
+
+
+void
+edge_grid_set_south_wall(struct edge_grid *edge_grid,
+                         struct point point,
+                         enum wall_type wall_type)
+{
+    struct edge_level *level = (wall_type_none == wall_type)
+                             ? find_level(edge_grid, point.z)
+                             : include_level(edge_grid, point.z);
+    if (level) set_plane_wall(&level->south_walls, point.y, point.x, wall_type);
+}
+
+
+void
+edge_grid_set_west_wall(struct edge_grid *edge_grid,
+                        struct point point,
+                        enum wall_type wall_type)
+{
+    struct edge_level *level = (wall_type_none == wall_type)
+                             ? find_level(edge_grid, point.z)
+                             : include_level(edge_grid, point.z);
+    if (level) set_plane_wall(&level->west_walls, point.x, point.y, wall_type);
+}
+
+
+enum wall_type
+edge_grid_west_wall(struct edge_grid const *edge_grid, struct point point)
+{
+    struct edge_level const *level = find_level(edge_grid, point.z);
+    if (!level) return wall_type_none;
+    return plane_wall(&level->west_walls, point.x, point.y);
+}
+
+
+uint64_t
+edge_grid_west_walls(struct edge_grid const *edge_grid,
+                     struct point point,
+                     int count)
+{
+    struct edge_level const *level = find_level(edge_grid, point.z);
+    if (!level) return 0;
+    return plane_walls(&level->west_walls, point.x, point.y, count);
+}
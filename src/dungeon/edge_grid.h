@@ -0,0 +1,108 @@
+#ifndef FNF_DUNGEON_EDGE_GRID_H_INCLUDED
+#define FNF_DUNGEON_EDGE_GRID_H_INCLUDED
+
+
+#include <stdint.h>
+
+#include <dungeon/point.h>
+#include <dungeon/wall_type.h>
+
+
+enum {
+    edge_grid_edge_bits = 2,
+    edge_grid_edges_per_word = 64 / edge_grid_edge_bits,
+};
+
+
+// Wall types for a rectangle of edges on one level, two bits per edge.
+// Edges are stored in lines; consecutive edges along a line share words.
+// `origin_offset' is always a multiple of the edges per word.
+struct edge_plane {
+    int origin_line;
+    int origin_offset;
+    int words_per_line;
+    int lines_count;
+    uint64_t *words;
+};
+
+
+// The south walls of a level are stored in rows, so a run of edges going
+// east is contiguous; the west walls are stored in columns, so a run going
+// north is contiguous.
+struct edge_level {
+    struct edge_plane south_walls;
+    struct edge_plane west_walls;
+};
+
+
+// The walls between tiles, indexed by the tile that owns them: each tile
+// owns the edges on its south and west sides.  Planes grow to include walls
+// as they're set; edges outside them have no wall.  `levels[i]' holds the
+// edges for level `min_level + i'.
+struct edge_grid {
+    struct edge_level *levels;
+    int levels_count;
+    int min_level;
+};
+
+
+struct edge_grid *
+edge_grid_alloc(void);
+
+void
+edge_grid_free(struct edge_grid *edge_grid);
+
+// Returns a bit mask with bit `i' set if the `i'th wall type packed in
+// `walls' is not solid.
+inline uint32_t
+edge_grid_exits_mask(uint64_t walls)
+{
+    uint64_t const low_bits = UINT64_C(0x5555555555555555);
+    uint64_t solid = walls & ~(walls >> 1) & low_bits;
+    uint64_t mask = ~solid & low_bits;
+    mask = (mask | (mask >> 1)) & UINT64_C(0x3333333333333333);
+    mask = (mask | (mask >> 2)) & UINT64_C(0x0f0f0f0f0f0f0f0f);
+    mask = (mask | (mask >> 4)) & UINT64_C(0x00ff00ff00ff00ff);
+    mask = (mask | (mask >> 8)) & UINT64_C(0x0000ffff0000ffff);
+    mask = (mask | (mask >> 16)) & UINT64_C(0x00000000ffffffff);
+    return (uint32_t)mask;
+}
+
+inline enum wall_type
+edge_grid_wall_at(uint64_t walls, int index)
+{
+    return (enum wall_type)((walls >> (index * edge_grid_edge_bits)) & 0x3);
+}
+
+enum wall_type
+edge_grid_south_wall(struct edge_grid const *edge_grid, struct point point);
+
+// Returns the wall types of up to 32 south walls starting at `point' and
+// running east, packed two bits each with the first wall in the low bits.
+uint64_t
+edge_grid_south_walls(struct edge_grid const *edge_grid,
+                      struct point point,
+                      int count);
+
+void
+edge_grid_set_south_wall(struct edge_grid *edge_grid,
+                         struct point point,
+                         enum wall_type wall_type);
+
+void
+edge_grid_set_west_wall(struct edge_grid *edge_grid,
+                        struct point point,
+                        enum wall_type wall_type);
+
+enum wall_type
+edge_grid_west_wall(struct edge_grid const *edge_grid, struct point point);
+
+// Returns the wall types of up to 32 west walls starting at `point' and
+// running north, packed two bits each with the first wall in the low bits.
+uint64_t
+edge_grid_west_walls(struct edge_grid const *edge_grid,
+                     struct point point,
+                     int count);
+
+
+#endif
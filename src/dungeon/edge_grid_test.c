@@ -0,0 +1,118 @@
+#include <assert.h>
+#include <base/base.h>
+#include "edge_grid.h"
+
+
+void
+edge_grid_test(void);
+
+
+static void
+edge_grid_alloc_test(void)
+{
+    struct edge_grid *edge_grid = edge_grid_alloc();
+
+    assert(0 == edge_grid->levels_count);
+    assert(wall_type_none == edge_grid_south_wall(edge_grid, point_make(0, 0, 1)));
+    assert(wall_type_none == edge_grid_west_wall(edge_grid, point_make(0, 0, 1)));
+    assert(0 == edge_grid_south_walls(edge_grid, point_make(0, 0, 1), 32));
+    assert(0 == edge_grid_west_walls(edge_grid, point_make(0, 0, 1), 32));
+
+    edge_grid_free(edge_grid);
+}
+
+
+static void
+edge_grid_set_wall_test(void)
+{
+    struct edge_grid *edge_grid = edge_grid_alloc();
+
+    edge_grid_set_south_wall(edge_grid, point_make(3, 4, 1), wall_type_door);
+    edge_grid_set_west_wall(edge_grid, point_make(3, 4, 1), wall_type_solid);
+    assert(wall_type_door == edge_grid_south_wall(edge_grid, point_make(3, 4, 1)));
+    assert(wall_type_solid == edge_grid_west_wall(edge_grid, point_make(3, 4, 1)));
+    assert(wall_type_none == edge_grid_south_wall(edge_grid, point_make(4, 4, 1)));
+    assert(wall_type_none == edge_grid_west_wall(edge_grid, point_make(3, 5, 1)));
+    assert(wall_type_none == edge_grid_south_wall(edge_grid, point_make(3, 4, 2)));
+
+    edge_grid_set_south_wall(edge_grid, point_make(-70, -40, 1), wall_type_secret_door);
+    edge_grid_set_west_wall(edge_grid, point_make(200, 90, 1), wall_type_door);
+    edge_grid_set_south_wall(edge_grid, point_make(0, 0, -2), wall_type_solid);
+    assert(-2 == edge_grid->min_level);
+    assert(4 == edge_grid->levels_count);
+    assert(wall_type_door == edge_grid_south_wall(edge_grid, point_make(3, 4, 1)));
+    assert(wall_type_solid == edge_grid_west_wall(edge_grid, point_make(3, 4, 1)));
+    assert(wall_type_secret_door == edge_grid_south_wall(edge_grid, point_make(-70, -40, 1)));
+    assert(wall_type_door == edge_grid_west_wall(edge_grid, point_make(200, 90, 1)));
+    assert(wall_type_solid == edge_grid_south_wall(edge_grid, point_make(0, 0, -2)));
+
+    edge_grid_set_south_wall(edge_grid, point_make(3, 4, 1), wall_type_none);
+    assert(wall_type_none == edge_grid_south_wall(edge_grid, point_make(3, 4, 1)));
+    edge_grid_set_west_wall(edge_grid, point_make(1000, 1000, 9), wall_type_none);
+    assert(4 == edge_grid->levels_count);
+
+    edge_grid_free(edge_grid);
+}
+
+
+static void
+edge_grid_walls_test(void)
+{
+    struct edge_grid *edge_grid = edge_grid_alloc();
+
+    edge_grid_set_south_wall(edge_grid, point_make(30, 7, 1), wall_type_solid);
+    edge_grid_set_south_wall(edge_grid, point_make(31, 7, 1), wall_type_door);
+    edge_grid_set_south_wall(edge_grid, point_make(32, 7, 1), wall_type_secret_door);
+    edge_grid_set_south_wall(edge_grid, point_make(-1, 7, 1), wall_type_door);
+
+    uint64_t walls = edge_grid_south_walls(edge_grid, point_make(29, 7, 1), 32);
+    assert(wall_type_none == edge_grid_wall_at(walls, 0));
+    assert(wall_type_solid == edge_grid_wall_at(walls, 1));
+    assert(wall_type_door == edge_grid_wall_at(walls, 2));
+    assert(wall_type_secret_door == edge_grid_wall_at(walls, 3));
+    assert(wall_type_none == edge_grid_wall_at(walls, 4));
+
+    walls = edge_grid_south_walls(edge_grid, point_make(-2, 7, 1), 3);
+    assert(wall_type_none == edge_grid_wall_at(walls, 0));
+    assert(wall_type_door == edge_grid_wall_at(walls, 1));
+    assert(0 == walls >> (3 * edge_grid_edge_bits));
+
+    walls = edge_grid_south_walls(edge_grid, point_make(31, 7, 1), 1);
+    assert(wall_type_door == walls);
+    assert(0 == edge_grid_south_walls(edge_grid, point_make(30, 8, 1), 32));
+    assert(0 == edge_grid_south_walls(edge_grid, point_make(-500, 7, 1), 32));
+
+    edge_grid_set_west_wall(edge_grid, point_make(5, -1, 0), wall_type_door);
+    edge_grid_set_west_wall(edge_grid, point_make(5, 0, 0), wall_type_solid);
+    walls = edge_grid_west_walls(edge_grid, point_make(5, -2, 0), 4);
+    assert(wall_type_none == edge_grid_wall_at(walls, 0));
+    assert(wall_type_door == edge_grid_wall_at(walls, 1));
+    assert(wall_type_solid == edge_grid_wall_at(walls, 2));
+    assert(wall_type_none == edge_grid_wall_at(walls, 3));
+
+    edge_grid_free(edge_grid);
+}
+
+
+static void
+edge_grid_exits_mask_test(void)
+{
+    assert(0xffffffff == edge_grid_exits_mask(0));
+
+    uint64_t walls = (uint64_t)wall_type_solid
+                   | (uint64_t)wall_type_door << 2
+                   | (uint64_t)wall_type_solid << 4
+                   | (uint64_t)wall_type_secret_door << 6
+                   | (uint64_t)wall_type_solid << 62;
+    assert(0x7ffffffa == edge_grid_exits_mask(walls));
+}
+
+
+void
+edge_grid_test(void)
+{
+    edge_grid_alloc_test();
+    edge_grid_set_wall_test();
+    edge_grid_walls_test();
+    edge_grid_exits_mask_test();
+}
@@ -4,8 +4,159 @@
 #include <stddef.h>
 #include <base/base.h>
 
+#include "dungeon.h"
+#include "edge_grid.h"
 #include "generator.h"
+#include "occupancy_map.h"
 #include "tile.h"
+#include "tile_grid.h"
+
+
+// A run of tiles just inside one side of a box.  The inside tiles start at
+// `inside' and run east or north; the outside tiles and the tiles that own
+// the walls between them run alongside.
+struct boundary {
+    enum direction direction;
+    bool is_row;
+    struct point inside;
+    struct point outside;
+    struct point wall_owner;
+    int length;
+};
+
+
+static struct boundary
+boundary_for_box(struct box box, enum direction direction)
+{
+    assert(1 == box.size.height);
+    struct point end = box_end_point(box);
+    struct boundary boundary = { .direction=direction };
+    switch (direction) {
+        case direction_north:
+            boundary.is_row = true;
+            boundary.inside = point_make(box.origin.x, end.y - 1, box.origin.z);
+            boundary.outside = point_north(boundary.inside);
+            boundary.wall_owner = boundary.outside;
+            boundary.length = box.size.width;
+            break;
+        case direction_south:
+            boundary.is_row = true;
+            boundary.inside = box.origin;
+            boundary.outside = point_south(boundary.inside);
+            boundary.wall_owner = boundary.inside;
+            boundary.length = box.size.width;
+            break;
+        case direction_east:
+            boundary.is_row = false;
+            boundary.inside = point_make(end.x - 1, box.origin.y, box.origin.z);
+            boundary.outside = point_east(boundary.inside);
+            boundary.wall_owner = boundary.outside;
+            boundary.length = box.size.length;
+            break;
+        case direction_west:
+            boundary.is_row = false;
+            boundary.inside = box.origin;
+            boundary.outside = point_west(boundary.inside);
+            boundary.wall_owner = boundary.inside;
+            boundary.length = box.size.length;
+            break;
+        default:
+            fail("Unrecognized direction %i", direction);
+            break;
+    }
+    return boundary;
+}
+
+
+static inline struct point
+advance(struct point point, int steps, bool is_row)
+{
+    if (is_row) {
+        point.x += steps;
+    } else {
+        point.y += steps;
+    }
+    return point;
+}
+
+
+static inline int
+lowest_bit_index(uint64_t bits)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(bits);
+#else
+    int index = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+
+static uint64_t
+excavated_bits(struct dungeon *dungeon, struct point point, int count, bool is_row)
+{
+    return is_row ? occupancy_map_row_bits(dungeon->occupancy_map, point, count)
+                  : occupancy_map_column_bits(dungeon->occupancy_map, point, count);
+}
+
+
+static uint64_t
+wall_types(struct dungeon *dungeon, struct point point, int count, bool is_row)
+{
+    return is_row ? edge_grid_south_walls(dungeon->edge_grid, point, count)
+                  : edge_grid_west_walls(dungeon->edge_grid, point, count);
+}
+
+
+// Finds exits from excavated inside tiles: to excavated outside tiles
+// through walls that aren't solid, or when `possible' is set, to
+// unexcavated outside tiles.  Works through the boundary a word of edges at
+// a time.
+static int
+find_exits(struct generator *generator,
+           struct boundary boundary,
+           bool possible,
+           struct exit *exits,
+           int exits_count)
+{
+    struct dungeon *dungeon = generator->dungeon;
+    bool is_row = boundary.is_row;
+    int count = 0;
+    for (int start = 0; start < boundary.length; start += edge_grid_edges_per_word) {
+        int length = min(boundary.length - start, edge_grid_edges_per_word);
+        uint64_t inside = excavated_bits(dungeon,
+                                         advance(boundary.inside, start, is_row),
+                                         length,
+                                         is_row);
+        uint64_t outside = excavated_bits(dungeon,
+                                          advance(boundary.outside, start, is_row),
+                                          length,
+                                          is_row);
+        uint64_t walls = wall_types(dungeon,
+                                    advance(boundary.wall_owner, start, is_row),
+                                    length,
+                                    is_row);
+        uint64_t found = possible ? inside & ~outside
+                                  : inside & outside & edge_grid_exits_mask(walls);
+        found &= (UINT64_C(1) << length) - 1;
+        while (found) {
+            int i = lowest_bit_index(found);
+            found &= found - 1;
+            int index = count;
+            ++count;
+            if (exits && index < exits_count) {
+                exits[index].direction = boundary.direction;
+                exits[index].point = advance(boundary.inside, start + i, is_row);
+                exits[index].type = edge_grid_wall_at(walls, i);
+            }
+        }
+    }
+    return count;
+}
 
 
 int
@@ -44,27 +195,8 @@ exits_east(struct generator *generator,
            struct exit *exits,
            int exits_count)
 {
-    assert(1 == box.size.height);
-    int count = 0;
-    struct point end = box_end_point(box);
-    for (int j = 0; j < box.size.length; ++j) {
-        struct point point = point_make(end.x, box.origin.y + j, box.origin.z);
-        struct tile *outside_tile = generator_tile_at(generator, point);
-        struct tile *inside_tile = generator_tile_at(generator, point_west(point));
-        if (   tile_is_escavated(outside_tile)
-            && tile_is_escavated(inside_tile)
-            && tile_has_west_exit(outside_tile))
-        {
-            int index = count;
-            ++count;
-            if (exits && index < exits_count) {
-                exits[index].direction = direction_east;
-                exits[index].point = inside_tile->point;
-                exits[index].type = outside_tile->walls.west;
-            }
-        }
-    }
-    return count;
+    return find_exits(generator, boundary_for_box(box, direction_east), false,
+                      exits, exits_count);
 }
 
 
@@ -97,27 +229,8 @@ exits_north(struct generator *generator,
             struct exit *exits,
             int exits_count)
 {
-    assert(1 == box.size.height);
-    int count = 0;
-    struct point end = box_end_point(box);
-    for (int i = 0; i < box.size.width; ++i) {
-        struct point point = point_make(box.origin.x + i, end.y, box.origin.z);
-        struct tile *outside_tile = generator_tile_at(generator, point);
-        struct tile *inside_tile = generator_tile_at(generator, point_south(point));
-        if (   tile_is_escavated(outside_tile)
-            && tile_is_escavated(inside_tile)
-            && tile_has_south_exit(outside_tile))
-        {
-            int index = count;
-            ++count;
-            if (exits && index < exits_count) {
-                exits[index].direction = direction_north;
-                exits[index].point = inside_tile->point;
-                exits[index].type = outside_tile->walls.south;
-            }
-        }
-    }
-    return count;
+    return find_exits(generator, boundary_for_box(box, direction_north), false,
+                      exits, exits_count);
 }
 
 
@@ -127,26 +240,8 @@ exits_south(struct generator *generator,
             struct exit *exits,
             int exits_count)
 {
-    assert(1 == box.size.height);
-    int count = 0;
-    for (int i = 0; i < box.size.width; ++i) {
-        struct point point = point_make(box.origin.x + i, box.origin.y, box.origin.z);
-        struct tile *inside_tile = generator_tile_at(generator, point);
-        struct tile *outside_tile = generator_tile_at(generator, point_south(point));
-        if (   tile_is_escavated(outside_tile)
-            && tile_is_escavated(inside_tile)
-            && tile_has_south_exit(inside_tile))
-        {
-            int index = count;
-            ++count;
-            if (exits && index < exits_count) {
-                exits[index].direction = direction_south;
-                exits[index].point = inside_tile->point;
-                exits[index].type = inside_tile->walls.south;
-            }
-        }
-    }
-    return count;
+    return find_exits(generator, boundary_for_box(box, direction_south), false,
+                      exits, exits_count);
 }
 
 
@@ -156,26 +251,8 @@ exits_west(struct generator *generator,
            struct exit *exits,
            int exits_count)
 {
-    assert(1 == box.size.height);
-    int count = 0;
-    for (int j = 0; j < box.size.length; ++j) {
-        struct point point = point_make(box.origin.x, box.origin.y + j, box.origin.z);
-        struct tile *inside_tile = generator_tile_at(generator, point);
-        struct tile *outside_tile = generator_tile_at(generator, point_west(point));
-        if (   tile_is_escavated(outside_tile)
-            && tile_is_escavated(inside_tile)
-            && tile_has_west_exit(inside_tile))
-        {
-            int index = count;
-            ++count;
-            if (exits && index < exits_count) {
-                exits[index].direction = direction_west;
-                exits[index].point = inside_tile->point;
-                exits[index].type = inside_tile->walls.west;
-            }
-        }
-    }
-    return count;
+    return find_exits(generator, boundary_for_box(box, direction_west), false,
+                      exits, exits_count);
 }
 
 
@@ -215,25 +292,8 @@ possible_exits_east(struct generator *generator,
                     struct exit *exits,
                     int exits_count)
 {
-    int count = 0;
-    struct point end = box_end_point(box);
-    for (int j = 0; j < box.size.length; ++j) {
-        struct point point = point_make(end.x, box.origin.y + j, box.origin.z);
-        struct tile *outside_tile = generator_tile_at(generator, point);
-        struct tile *inside_tile = generator_tile_at(generator, point_west(point));
-        if (   tile_is_unescavated(outside_tile)
-            && tile_is_escavated(inside_tile))
-        {
-            int index = count;
-            ++count;
-            if (exits && index < exits_count) {
-                exits[index].direction = direction_east;
-                exits[index].point = inside_tile->point;
-                exits[index].type = inside_tile->walls.west;
-            }
-        }
-    }
-    return count;
+    return find_exits(generator, boundary_for_box(box, direction_east), true,
+                      exits, exits_count);
 }
 
 
@@ -266,26 +326,8 @@ possible_exits_north(struct generator *generator,
                      struct exit *exits,
                      int exits_count)
 {
-    assert(1 == box.size.height);
-    int count = 0;
-    struct point end = box_end_point(box);
-    for (int i = 0; i < box.size.width; ++i) {
-        struct point point = point_make(box.origin.x + i, end.y, box.origin.z);
-        struct tile *outside_tile = generator_tile_at(generator, point);
-        struct tile *inside_tile = generator_tile_at(generator, point_south(point));
-        if (   tile_is_unescavated(outside_tile)
-            && tile_is_escavated(inside_tile))
-        {
-            int index = count;
-            ++count;
-            if (exits && index < exits_count) {
-                exits[index].direction = direction_north;
-                exits[index].point = inside_tile->point;
-                exits[index].type = outside_tile->walls.south;
-            }
-        }
-    }
-    return count;
+    return find_exits(generator, boundary_for_box(box, direction_north), true,
+                      exits, exits_count);
 }
 
 
@@ -295,25 +337,8 @@ possible_exits_south(struct generator *generator,
                      struct exit *exits,
                      int exits_count)
 {
-    assert(1 == box.size.height);
-    int count = 0;
-    for (int i = 0; i < box.size.width; ++i) {
-        struct point point = point_make(box.origin.x + i, box.origin.y, box.origin.z);
-        struct tile *inside_tile = generator_tile_at(generator, point);
-        struct tile *outside_tile = generator_tile_at(generator, point_south(point));
-        if (   tile_is_unescavated(outside_tile)
-            && tile_is_escavated(inside_tile))
-        {
-            int index = count;
-            ++count;
-            if (exits && index < exits_count) {
-                exits[index].direction = direction_south;
-                exits[index].point = inside_tile->point;
-                exits[index].type = inside_tile->walls.south;
-            }
-        }
-    }
-    return count;
+    return find_exits(generator, boundary_for_box(box, direction_south), true,
+                      exits, exits_count);
 }
 
 
@@ -323,23 +348,6 @@ possible_exits_west(struct generator *generator,
                     struct exit *exits,
                     int exits_count)
 {
-    assert(1 == box.size.height);
-    int count = 0;
-    for (int j = 0; j < box.size.length; ++j) {
-        struct point point = point_make(box.origin.x, box.origin.y + j, box.origin.z);
-        struct tile *inside_tile = generator_tile_at(generator, point);
-        struct tile *outside_tile = generator_tile_at(generator, point_west(point));
-        if (   tile_is_unescavated(outside_tile)
-            && tile_is_escavated(inside_tile))
-        {
-            int index = count;
-            ++count;
-            if (exits && index < exits_count) {
-                exits[index].direction = direction_west;
-                exits[index].point = inside_tile->point;
-                exits[index].type = inside_tile->walls.west;
-            }
-        }
-    }
-    return count;
+    return find_exits(generator, boundary_for_box(box, direction_west), true,
+                      exits, exits_count);
 }
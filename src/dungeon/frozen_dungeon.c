@@ -0,0 +1,255 @@
+#include "frozen_dungeon.h"
+
+#include <base/base.h>
+
+#include "area.h"
+#include "area_index.h"
+#include "dungeon.h"
+#include "level_map.h"
+#include "text_rectangle.h"
+#include "tile.h"
+#include "tile_grid.h"
+#include "tile_spans.h"
+
+
+static struct frozen_dungeon *
+alloc_frozen_dungeon(struct dungeon const *dungeon, bool is_compressed);
+
+static void
+copy_level_tiles(struct tile_grid const *tile_grid, struct frozen_level *level);
+
+
+static void
+copy_level_tiles(struct tile_grid const *tile_grid, struct frozen_level *level)
+{
+    struct box box = level->box;
+    struct point end = box_end_point(box);
+    for (int j = box.origin.y; j < end.y; ++j) {
+        int i = box.origin.x;
+        while (i < end.x) {
+            struct point point = point_make(i, j, box.origin.z);
+            int run_count;
+            struct tile const *run = tile_grid_find_tile_run(tile_grid, point, &run_count);
+            run_count = min(run_count, end.x - i);
+            if (run) {
+                memcpy(&level->tiles[box_index_for_point(box, point)],
+                       run,
+                       run_count * sizeof(struct tile));
+            }
+            i += run_count;
+        }
+    }
+}
+
+
+static struct frozen_dungeon *
+alloc_frozen_dungeon(struct dungeon const *dungeon, bool is_compressed)
+{
+    struct frozen_dungeon *frozen_dungeon = calloc_or_die(1, sizeof(struct frozen_dungeon));
+    frozen_dungeon->starting_level = dungeon_starting_level(dungeon);
+    frozen_dungeon->levels_count = dungeon_level_count(dungeon);
+    frozen_dungeon->levels = calloc_or_die(max(1, frozen_dungeon->levels_count),
+                                           sizeof(struct frozen_level));
+
+    for (int i = 0; i < frozen_dungeon->levels_count; ++i) {
+        struct frozen_level *level = &frozen_dungeon->levels[i];
+        struct box box = dungeon_box_for_level(dungeon, frozen_dungeon->starting_level + i);
+        level->box = box_expand(box, size_make(1, 1, 0));
+        if (is_compressed) {
+            level->tile_spans = tile_spans_alloc(dungeon->tile_grid, level->box);
+        } else {
+            // zeroed tiles are filled tiles
+            level->tiles = calloc_or_die(box_volume(level->box), sizeof(struct tile));
+            copy_level_tiles(dungeon->tile_grid, level);
+        }
+    }
+
+    for (int i = 0; i < frozen_dungeon->levels_count; ++i) {
+        int areas_count;
+        area_index_areas_for_level(dungeon->area_index,
+                                   frozen_dungeon->starting_level + i,
+                                   &areas_count);
+        frozen_dungeon->areas_count += areas_count;
+    }
+    frozen_dungeon->areas = calloc_or_die(max(1, frozen_dungeon->areas_count),
+                                          sizeof(struct area));
+    int next_index = 0;
+    for (int i = 0; i < frozen_dungeon->levels_count; ++i) {
+        struct frozen_level *level = &frozen_dungeon->levels[i];
+        struct area *const *areas = area_index_areas_for_level(dungeon->area_index,
+                                                               frozen_dungeon->starting_level + i,
+                                                               &level->areas_count);
+        level->areas = &frozen_dungeon->areas[next_index];
+        for (int j = 0; j < level->areas_count; ++j) {
+            frozen_dungeon->areas[next_index + j] = *areas[j];
+        }
+        next_index += level->areas_count;
+    }
+
+    return frozen_dungeon;
+}
+
+
+struct frozen_dungeon *
+frozen_dungeon_alloc(struct dungeon const *dungeon)
+{
+    return alloc_frozen_dungeon(dungeon, false);
+}
+
+
+struct frozen_dungeon *
+frozen_dungeon_alloc_compressed(struct dungeon const *dungeon)
+{
+    return alloc_frozen_dungeon(dungeon, true);
+}
+
+
+void
+frozen_dungeon_free(struct frozen_dungeon *frozen_dungeon)
+{
+    if (frozen_dungeon) {
+        for (int i = 0; i < frozen_dungeon->levels_count; ++i) {
+            free_or_die(frozen_dungeon->levels[i].tiles);
+            tile_spans_free(frozen_dungeon->levels[i].tile_spans);
+        }
+        free_or_die(frozen_dungeon->levels);
+        free_or_die(frozen_dungeon->areas);
+        free_or_die(frozen_dungeon);
+    }
+}
+
+
+struct ptr_array *
+frozen_dungeon_alloc_descriptions_of_chambers_and_rooms_for_level(struct frozen_dungeon const *frozen_dungeon,
+                                                                  int level)
+{
+    struct ptr_array *descriptions = ptr_array_alloc();
+    struct frozen_level const *frozen_level = frozen_dungeon_level(frozen_dungeon, level);
+    if (!frozen_level) return descriptions;
+    for (int i = 0; i < frozen_level->areas_count; ++i) {
+        struct area const *area = &frozen_level->areas[i];
+        if (area_is_chamber_or_room(area)) {
+            ptr_array_add(descriptions, area_alloc_located_description(area));
+        }
+    }
+    return descriptions;
+}
+
+
+struct ptr_array *
+frozen_dungeon_alloc_descriptions_of_entrances_and_exits_for_level(struct frozen_dungeon const *frozen_dungeon,
+                                                                   int level)
+{
+    struct ptr_array *descriptions = ptr_array_alloc();
+    struct frozen_level const *frozen_level = frozen_dungeon_level(frozen_dungeon, level);
+    if (!frozen_level) return descriptions;
+    for (int i = 0; i < frozen_level->areas_count; ++i) {
+        struct area const *area = &frozen_level->areas[i];
+        if (area_is_level_transition(area)) {
+            ptr_array_add(descriptions, area_alloc_located_description(area));
+        }
+    }
+    return descriptions;
+}
+
+
+struct text_rectangle *
+frozen_dungeon_alloc_text_rectangle_for_level(struct frozen_dungeon const *frozen_dungeon,
+                                              int level)
+{
+    struct frozen_level const *frozen_level = frozen_dungeon_level(frozen_dungeon, level);
+    if (!frozen_level) return NULL;
+    struct level_map *level_map = level_map_alloc_for_frozen_level(frozen_level);
+    struct text_rectangle *text_rectangle = level_map_alloc_text_rectangle(level_map, true);
+    level_map_free(level_map);
+    return text_rectangle;
+}
+
+
+int
+frozen_dungeon_ending_level(struct frozen_dungeon const *frozen_dungeon)
+{
+    if (!frozen_dungeon->levels_count) return 0;
+    return frozen_dungeon->starting_level + frozen_dungeon->levels_count - 1;
+}
+
+
+struct frozen_level const *
+frozen_dungeon_level(struct frozen_dungeon const *frozen_dungeon, int level)
+{
+    int index = level - frozen_dungeon->starting_level;
+    if (index < 0 || index >= frozen_dungeon->levels_count) return NULL;
+    return &frozen_dungeon->levels[index];
+}
+
+
+int
+frozen_dungeon_level_count(struct frozen_dungeon const *frozen_dungeon)
+{
+    return frozen_dungeon->levels_count;
+}
+
+
+void
+frozen_dungeon_print_areas_for_level(struct frozen_dungeon const *frozen_dungeon,
+                                     int level,
+                                     FILE *out)
+{
+    area_print_and_free_descriptions(frozen_dungeon_alloc_descriptions_of_entrances_and_exits_for_level(frozen_dungeon, level),
+                                     frozen_dungeon_alloc_descriptions_of_chambers_and_rooms_for_level(frozen_dungeon, level),
+                                     out);
+}
+
+
+void
+frozen_dungeon_print_map_for_level(struct frozen_dungeon const *frozen_dungeon,
+                                   int level,
+                                   FILE *out)
+{
+    struct text_rectangle *text_rectangle = frozen_dungeon_alloc_text_rectangle_for_level(frozen_dungeon, level);
+    if (!text_rectangle) return;
+    fprintf(out, "%s", text_rectangle->chars);
+    text_rectangle_free(text_rectangle);
+}
+
+
+int
+frozen_dungeon_starting_level(struct frozen_dungeon const *frozen_dungeon)
+{
+    return frozen_dungeon->starting_level;
+}
+
+
+struct tile const *
+frozen_dungeon_tile_at(struct frozen_dungeon const *frozen_dungeon,
+                       struct point point)
+{
+    struct frozen_level const *frozen_level = frozen_dungeon_level(frozen_dungeon, point.z);
+    if (!frozen_level) return NULL;
+    return frozen_level_tile_at(frozen_level, point);
+}
+
+
+void
+frozen_level_copy_row(struct frozen_level const *frozen_level,
+                      int y,
+                      struct tile *tiles)
+{
+    if (frozen_level->tile_spans) {
+        tile_spans_copy_row(frozen_level->tile_spans, y, tiles);
+    } else {
+        struct point point = point_make(frozen_level->box.origin.x, y, frozen_level->box.origin.z);
+        memcpy(tiles,
+               &frozen_level->tiles[box_index_for_point(frozen_level->box, point)],
+               frozen_level->box.size.width * sizeof(struct tile));
+    }
+}
+
+
+struct tile const *
+frozen_level_tile_at(struct frozen_level const *frozen_level, struct point point)
+{
+    if (frozen_level->tile_spans) return tile_spans_tile_at(frozen_level->tile_spans, point);
+    if (!box_contains_point(frozen_level->box, point)) return NULL;
+    return &frozen_level->tiles[box_index_for_point(frozen_level->box, point)];
+}
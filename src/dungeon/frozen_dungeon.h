@@ -0,0 +1,112 @@
+#ifndef FNF_DUNGEON_FROZEN_DUNGEON_H_INCLUDED
+#define FNF_DUNGEON_FROZEN_DUNGEON_H_INCLUDED
+
+
+#include <stdio.h>
+
+#include <dungeon/area.h>
+#include <dungeon/box.h>
+#include <dungeon/point.h>
+#include <dungeon/tile.h>
+
+
+struct area;
+struct dungeon;
+struct ptr_array;
+struct text_rectangle;
+struct tile;
+struct tile_spans;
+
+
+// The tiles of one level, stored densely in row order for `box', which is
+// the bounding box of the level's excavated tiles plus a border of one tile
+// on each side.  Levels of a compressed frozen dungeon leave `tiles' NULL
+// and store the same tiles in `tile_spans' instead.  The areas on the level
+// are `areas[0 .. areas_count)'.
+struct frozen_level {
+    struct box box;
+    struct tile *tiles;
+    struct tile_spans *tile_spans;
+    struct area const *areas;
+    int areas_count;
+};
+
+
+// An immutable copy of a generated dungeon.  Nothing in a frozen dungeon
+// changes after dungeon_freeze() returns and none of the lookup functions
+// allocate, so any number of threads may read it at once.  `levels[i]'
+// holds level `starting_level + i'; `areas' holds copies of the dungeon's
+// areas grouped by level, in the order they were added to the dungeon.
+struct frozen_dungeon {
+    struct frozen_level *levels;
+    int levels_count;
+    int starting_level;
+    struct area *areas;
+    int areas_count;
+};
+
+
+struct frozen_dungeon *
+frozen_dungeon_alloc(struct dungeon const *dungeon);
+
+// Stores each level as tile spans, which takes much less memory for levels
+// that are mostly solid rock, at the cost of a binary search for each tile
+// lookup.
+struct frozen_dungeon *
+frozen_dungeon_alloc_compressed(struct dungeon const *dungeon);
+
+void
+frozen_dungeon_free(struct frozen_dungeon *frozen_dungeon);
+
+int
+frozen_dungeon_ending_level(struct frozen_dungeon const *frozen_dungeon);
+
+// Returns NULL if the dungeon has no such level.
+struct frozen_level const *
+frozen_dungeon_level(struct frozen_dungeon const *frozen_dungeon, int level);
+
+int
+frozen_dungeon_level_count(struct frozen_dungeon const *frozen_dungeon);
+
+int
+frozen_dungeon_starting_level(struct frozen_dungeon const *frozen_dungeon);
+
+// Returns NULL for points outside the dungeon or its levels' boxes.
+struct tile const *
+frozen_dungeon_tile_at(struct frozen_dungeon const *frozen_dungeon,
+                       struct point point);
+
+struct ptr_array *
+frozen_dungeon_alloc_descriptions_of_entrances_and_exits_for_level(struct frozen_dungeon const *frozen_dungeon,
+                                                                   int level);
+
+struct ptr_array *
+frozen_dungeon_alloc_descriptions_of_chambers_and_rooms_for_level(struct frozen_dungeon const *frozen_dungeon,
+                                                                  int level);
+
+struct text_rectangle *
+frozen_dungeon_alloc_text_rectangle_for_level(struct frozen_dungeon const *frozen_dungeon,
+                                              int level);
+
+void
+frozen_dungeon_print_areas_for_level(struct frozen_dungeon const *frozen_dungeon,
+                                     int level,
+                                     FILE *out);
+
+void
+frozen_dungeon_print_map_for_level(struct frozen_dungeon const *frozen_dungeon,
+                                   int level,
+                                   FILE *out);
+
+// Writes the `box.size.width' tiles of row `y' of the level's box to `tiles'.
+void
+frozen_level_copy_row(struct frozen_level const *frozen_level,
+                      int y,
+                      struct tile *tiles);
+
+// Returns NULL for points outside the level's box.
+struct tile const *
+frozen_level_tile_at(struct frozen_level const *frozen_level, struct point point);
+
+
+#endif
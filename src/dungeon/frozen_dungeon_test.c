@@ -0,0 +1,157 @@
+#include <assert.h>
+
+#include <base/base.h>
+#include <dungeon/dungeon.h>
+#include "frozen_dungeon.h"
+#include "tile.h"
+
+
+void
+frozen_dungeon_test(void);
+
+
+static void
+frozen_dungeon_alloc_test(void)
+{
+    struct dungeon *dungeon = dungeon_alloc();
+    dungeon_generate_small(dungeon);
+    int tiles_count = dungeon->tile_grid->tiles_count;
+
+    struct frozen_dungeon *frozen_dungeon = dungeon_freeze(dungeon);
+
+    assert(tiles_count == dungeon->tile_grid->tiles_count);
+    assert(1 == frozen_dungeon_starting_level(frozen_dungeon));
+    assert(1 == frozen_dungeon_ending_level(frozen_dungeon));
+    assert(1 == frozen_dungeon_level_count(frozen_dungeon));
+    assert(!frozen_dungeon_level(frozen_dungeon, 0));
+    assert(!frozen_dungeon_level(frozen_dungeon, 2));
+
+    struct frozen_level const *level = frozen_dungeon_level(frozen_dungeon, 1);
+    assert(level);
+    assert(box_equals(box_make(point_make(-8, -1, 1), size_make(18, 17, 1)), level->box));
+    assert(dungeon->areas_count == level->areas_count);
+    assert(dungeon->areas_count == frozen_dungeon->areas_count);
+
+    frozen_dungeon_free(frozen_dungeon);
+    dungeon_free(dungeon);
+}
+
+
+static void
+frozen_dungeon_alloc_compressed_test(void)
+{
+    struct dungeon *dungeon = dungeon_alloc();
+    dungeon_generate_small(dungeon);
+    struct frozen_dungeon *frozen_dungeon = dungeon_freeze(dungeon);
+    struct frozen_dungeon *compressed = dungeon_freeze_compressed(dungeon);
+
+    assert(frozen_dungeon->levels_count == compressed->levels_count);
+    assert(frozen_dungeon->areas_count == compressed->areas_count);
+    struct frozen_level const *level = frozen_dungeon_level(frozen_dungeon, 1);
+    struct frozen_level const *compressed_level = frozen_dungeon_level(compressed, 1);
+    assert(!compressed_level->tiles);
+    assert(compressed_level->tile_spans);
+    assert(box_equals(level->box, compressed_level->box));
+
+    struct tile *row = calloc_or_die(level->box.size.width, sizeof(struct tile));
+    struct tile *compressed_row = calloc_or_die(level->box.size.width, sizeof(struct tile));
+    struct point end = box_end_point(level->box);
+    for (int j = level->box.origin.y; j < end.y; ++j) {
+        frozen_level_copy_row(level, j, row);
+        frozen_level_copy_row(compressed_level, j, compressed_row);
+        for (int i = level->box.origin.x; i < end.x; ++i) {
+            struct point point = point_make(i, j, 1);
+            struct tile const *tile = frozen_dungeon_tile_at(compressed, point);
+            assert(frozen_dungeon_tile_at(frozen_dungeon, point)->bits == tile->bits);
+            assert(row[i - level->box.origin.x].bits == tile->bits);
+            assert(compressed_row[i - level->box.origin.x].bits == tile->bits);
+        }
+    }
+    assert(!frozen_dungeon_tile_at(compressed, point_make(-9, 0, 1)));
+
+    struct text_rectangle *map = frozen_dungeon_alloc_text_rectangle_for_level(frozen_dungeon, 1);
+    struct text_rectangle *compressed_map = frozen_dungeon_alloc_text_rectangle_for_level(compressed, 1);
+    assert(str_eq(map->chars, compressed_map->chars));
+
+    free_or_die(row);
+    free_or_die(compressed_row);
+    text_rectangle_free(map);
+    text_rectangle_free(compressed_map);
+    frozen_dungeon_free(compressed);
+    frozen_dungeon_free(frozen_dungeon);
+    dungeon_free(dungeon);
+}
+
+
+static void
+frozen_dungeon_tile_at_test(void)
+{
+    struct dungeon *dungeon = dungeon_alloc();
+    dungeon_generate_small(dungeon);
+    struct frozen_dungeon *frozen_dungeon = dungeon_freeze(dungeon);
+
+    struct tile const *tile = frozen_dungeon_tile_at(frozen_dungeon, point_make(0, 0, 1));
+    assert(tile);
+    assert(tile_type_stairs_up == tile_get_type(tile));
+
+    tile = frozen_dungeon_tile_at(frozen_dungeon, point_make(0, 2, 1));
+    assert(tile);
+    assert(tile_type_empty == tile_get_type(tile));
+
+    tile = frozen_dungeon_tile_at(frozen_dungeon, point_make(-8, -1, 1));
+    assert(tile);
+    assert(tile_type_filled == tile_get_type(tile));
+
+    assert(!frozen_dungeon_tile_at(frozen_dungeon, point_make(-9, 0, 1)));
+    assert(!frozen_dungeon_tile_at(frozen_dungeon, point_make(0, 0, 2)));
+
+    // the frozen copy doesn't see later changes
+    struct tile *filled = tile_alloc(tile_type_filled);
+    dungeon_store_tile(dungeon, point_make(0, 2, 1), filled);
+    tile_free(filled);
+    tile = frozen_dungeon_tile_at(frozen_dungeon, point_make(0, 2, 1));
+    assert(tile_type_empty == tile_get_type(tile));
+
+    frozen_dungeon_free(frozen_dungeon);
+    dungeon_free(dungeon);
+}
+
+
+static void
+frozen_dungeon_alloc_text_rectangle_for_level_test(void)
+{
+    struct dungeon *dungeon = dungeon_alloc();
+    dungeon_generate_small(dungeon);
+    struct frozen_dungeon *frozen_dungeon = dungeon_freeze(dungeon);
+
+    struct text_rectangle *frozen_map = frozen_dungeon_alloc_text_rectangle_for_level(frozen_dungeon, 1);
+    struct text_rectangle *map = dungeon_alloc_text_rectangle_for_level(dungeon, 1);
+    assert(str_eq(map->chars, frozen_map->chars));
+    assert(!frozen_dungeon_alloc_text_rectangle_for_level(frozen_dungeon, 2));
+
+    struct ptr_array *frozen_descriptions = frozen_dungeon_alloc_descriptions_of_chambers_and_rooms_for_level(frozen_dungeon, 1);
+    struct ptr_array *descriptions = dungeon_alloc_descriptions_of_chambers_and_rooms_for_level(dungeon, 1);
+    assert(descriptions->count == frozen_descriptions->count);
+    for (int i = 0; i < descriptions->count; ++i) {
+        assert(str_eq(descriptions->elements[i], frozen_descriptions->elements[i]));
+    }
+
+    ptr_array_clear(descriptions, free_or_die);
+    ptr_array_free(descriptions);
+    ptr_array_clear(frozen_descriptions, free_or_die);
+    ptr_array_free(frozen_descriptions);
+    text_rectangle_free(map);
+    text_rectangle_free(frozen_map);
+    frozen_dungeon_free(frozen_dungeon);
+    dungeon_free(dungeon);
+}
+
+
+void
+frozen_dungeon_test(void)
+{
+    frozen_dungeon_alloc_test();
+    frozen_dungeon_alloc_compressed_test();
+    frozen_dungeon_tile_at_test();
+    frozen_dungeon_alloc_text_rectangle_for_level_test();
+}
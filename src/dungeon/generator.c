@@ -7,8 +7,35 @@
 #include "digger.h"
 #include "dungeon.h"
 #include "dungeon_options.h"
+#include "edge_grid.h"
+#include "level_boxes.h"
+#include "occupancy_map.h"
 #include "periodic_check.h"
 #include "tile.h"
+#include "tile_grid.h"
+#include "tile_journal.h"
+
+
+static void
+set_south_wall(struct generator *generator,
+               struct point point,
+               struct tile *tile,
+               enum wall_type wall_type)
+{
+    tile_set_south_wall(tile, wall_type);
+    edge_grid_set_south_wall(generator->dungeon->edge_grid, point, wall_type);
+}
+
+
+static void
+set_west_wall(struct generator *generator,
+              struct point point,
+              struct tile *tile,
+              enum wall_type wall_type)
+{
+    tile_set_west_wall(tile, wall_type);
+    edge_grid_set_west_wall(generator->dungeon->edge_grid, point, wall_type);
+}
 
 
 struct area *
@@ -18,12 +45,17 @@ generator_add_area(struct generator *generator,
                    struct box box,
                    enum tile_type tile_type)
 {
-    struct area *area = area_alloc(area_type, direction, box);
+    struct area *area = area_alloc_from_arena(generator->dungeon->arena,
+                                              area_type,
+                                              direction,
+                                              box);
     int index = generator->areas_count;
     ++generator->areas_count;
-    generator->areas = reallocarray_or_die(generator->areas,
-                                           generator->areas_count,
-                                           sizeof(struct area *));
+    generator->areas = arena_grow_array(generator->arena,
+                                        generator->areas,
+                                        generator->areas_count,
+                                        &generator->areas_capacity,
+                                        sizeof(struct area *));
     generator->areas[index] = area;
     generator_fill_box(generator, box, direction, tile_type);
     generator_set_walls(generator, box, wall_type_solid);
@@ -31,6 +63,27 @@ generator_add_area(struct generator *generator,
 }
 
 
+static void
+journal_digger(struct generator *generator,
+               enum digger_journal_entry_type type,
+               struct digger *digger,
+               int index)
+{
+    int journal_index = generator->digger_journal_count;
+    ++generator->digger_journal_count;
+    generator->digger_journal = arena_grow_array(generator->arena,
+                                                 generator->digger_journal,
+                                                 generator->digger_journal_count,
+                                                 &generator->digger_journal_capacity,
+                                                 sizeof(struct digger_journal_entry));
+    struct digger_journal_entry *entry = &generator->digger_journal[journal_index];
+    entry->type = type;
+    entry->digger = digger;
+    entry->original = *digger;
+    entry->index = index;
+}
+
+
 struct digger *
 generator_add_digger(struct generator *generator,
                      struct point point,
@@ -38,10 +91,14 @@ generator_add_digger(struct generator *generator,
 {
     int index = generator->diggers_count;
     ++generator->diggers_count;
-    generator->diggers = reallocarray_or_die(generator->diggers,
-                                             generator->diggers_count,
-                                             sizeof(struct digger *));
+    generator->diggers = arena_grow_array(generator->arena,
+                                          generator->diggers,
+                                          generator->diggers_count,
+                                          &generator->diggers_capacity,
+                                          sizeof(struct digger *));
     generator->diggers[index] = digger_alloc(generator, point, direction);
+    journal_digger(generator, digger_journal_entry_type_added,
+                   generator->diggers[index], index);
     return generator->diggers[index];
 }
 
@@ -61,10 +118,15 @@ generator_alloc(struct dungeon *dungeon,
     generator->max_size = dungeon_options->max_size;
     generator->padding = dungeon_options->padding;
     
-    generator->areas = calloc_or_die(1, sizeof(struct area *));
-    generator->diggers = calloc_or_die(1, sizeof(struct digger *));
-    generator->saved_diggers = calloc_or_die(1, sizeof(struct digger));
-    generator->tiles = calloc_or_die(1, sizeof(struct tile *));
+    generator->arena = arena_alloc();
+    generator->areas = arena_grow_array(generator->arena, NULL, 1,
+                                        &generator->areas_capacity,
+                                        sizeof(struct area *));
+    generator->diggers = arena_grow_array(generator->arena, NULL, 1,
+                                          &generator->diggers_capacity,
+                                          sizeof(struct digger *));
+    generator->tile_journal = tile_journal_alloc();
+    generator->level_boxes = level_boxes_alloc();
     
     generator->progress_callback = progress_callback;
     generator->callback_user_data = callback_user_data;
@@ -73,24 +135,39 @@ generator_alloc(struct dungeon *dungeon,
 }
 
 
-struct box
-generator_box_for_level(struct generator *generator, int level)
+static struct box
+scan_box_for_level(struct generator *generator, int level)
 {
     struct box box = box_make(point_make(0, 0, level), size_make(0, 0, 1));
-    for (size_t i = 0; i < generator->tiles_count; ++i) {
-        struct tile *tile = generator->tiles[i];
-        if (level != tile->point.z) continue;
-        if (tile_is_escavated(tile)) {
-            box = box_extend_to_include_point(box, tile->point);
+    struct tile_grid *tile_grid = generator->dungeon->tile_grid;
+    for (int i = 0; i < tile_grid->chunks_count; ++i) {
+        struct tile_chunk *chunk = tile_grid->chunks[i];
+        if (level != chunk->origin.z) continue;
+        for (int j = 0; j < tile_chunk_tiles_count; ++j) {
+            struct tile *tile = &chunk->tiles[j];
+            if (tile_is_escavated(tile)) {
+                box = box_extend_to_include_point(box, tile_chunk_point_at(chunk, j));
+            }
         }
     }
-    for (size_t i = 0; i < generator->dungeon->tiles_count; ++i) {
-        struct tile *dungeon_tile = generator->dungeon->tiles[i];
-        if (level != dungeon_tile->point.z) continue;
-        struct tile *tile = generator_tile_at(generator, dungeon_tile->point);
-        if (tile_is_escavated(tile)) {
-            box = box_extend_to_include_point(box, tile->point);
-        }
+    return box;
+}
+
+
+struct box
+generator_box_for_level(struct generator *generator, int level)
+{
+    // filling an excavated tile may shrink the box, so fall back to a scan
+    if (generator->level_boxes_are_stale) {
+        return scan_box_for_level(generator, level);
+    }
+    struct box box = dungeon_box_for_level(generator->dungeon, level);
+    struct box provisional = level_boxes_box_for_level(generator->level_boxes,
+                                                       level);
+    if (box_volume(provisional)) {
+        struct point end = box_end_point(provisional);
+        box = box_extend_to_include_point(box, provisional.origin);
+        box = box_extend_to_include_point(box, point_make(end.x - 1, end.y - 1, level));
     }
     return box;
 }
@@ -104,23 +181,20 @@ generator_commit(struct generator *generator)
     }
     generator->areas_count = 0;
     
-    generator->saved_diggers_count = generator->diggers_count;
-    generator->saved_diggers = reallocarray_or_die(generator->saved_diggers,
-                                                   generator->saved_diggers_count,
-                                                   sizeof(struct digger));
-    for (int i = 0; i < generator->diggers_count; ++i) {
-        generator->saved_diggers[i] = *(generator->diggers[i]);
+    for (int i = 0; i < generator->digger_journal_count; ++i) {
+        struct digger_journal_entry *entry = &generator->digger_journal[i];
+        if (digger_journal_entry_type_deleted == entry->type) {
+            digger_free(entry->digger);
+        }
     }
+    generator->digger_journal_count = 0;
     
-    for (int i = 0; i < generator->tiles_count; ++i) {
-        struct tile *tile = dungeon_tile_at(generator->dungeon,
-                                            generator->tiles[i]->point);
-        *tile = *generator->tiles[i];
-    }
-    for (int i = 0; i < generator->tiles_count; ++i) {
-        tile_free(generator->tiles[i]);
-    }
-    generator->tiles_count = 0;
+    dungeon_update_level_boxes(generator->dungeon,
+                               generator->level_boxes,
+                               generator->level_boxes_are_stale);
+    tile_journal_commit(generator->tile_journal);
+    level_boxes_clear(generator->level_boxes);
+    generator->level_boxes_are_stale = false;
 }
 
 
@@ -142,7 +216,7 @@ generator_delete_digger(struct generator *generator, struct digger *digger)
         }
     }
     assert(index >= 0 && index < generator->diggers_count);
-    digger_free(digger);
+    journal_digger(generator, digger_journal_entry_type_deleted, digger, index);
     
     int next_index = index + 1;
     int last_index = generator->diggers_count - 1;
@@ -153,9 +227,6 @@ generator_delete_digger(struct generator *generator, struct digger *digger)
         memmove(vacant, next, size);
     }
     --generator->diggers_count;
-    generator->diggers = reallocarray_or_die(generator->diggers,
-                                             generator->diggers_count,
-                                             sizeof(struct digger *));
 }
 
 
@@ -165,6 +236,10 @@ generator_fill_box(struct generator *generator,
                    enum direction direction,
                    enum tile_type tile_type)
 {
+    occupancy_map_set_box(generator->dungeon->occupancy_map,
+                          box,
+                          tile_type_filled != tile_type);
+
     struct box padded_box = box_expand(box, size_make(1, 1, 0));
     struct point point;
     for (int k = 0; k < padded_box.size.height; ++k) {
@@ -175,18 +250,25 @@ generator_fill_box(struct generator *generator,
                 point.x = padded_box.origin.x + i;
                 struct tile *tile = generator_tile_at(generator, point);
                 if (box_contains_point(box, point)) {
-                    tile->direction = direction;
-                    tile->type = tile_type;
+                    if (tile_is_escavated(tile) && tile_type_filled == tile_type) {
+                        generator->level_boxes_are_stale = true;
+                    }
+                    tile_set_direction(tile, direction);
+                    tile_set_type(tile, tile_type);
+                    if (tile_is_escavated(tile)) {
+                        level_boxes_extend_to_include_point(generator->level_boxes,
+                                                            point);
+                    }
                 }
                 
                 struct tile *west_tile = generator_tile_at(generator, point_west(point));
                 if (tile_is_escavated(west_tile) != tile_is_escavated(tile)) {
-                    tile->walls.west = wall_type_solid;
+                    set_west_wall(generator, point, tile, wall_type_solid);
                 }
                 
                 struct tile *south_tile = generator_tile_at(generator, point_south(point));
                 if (tile_is_escavated(south_tile) != tile_is_escavated(tile)) {
-                    tile->walls.south = wall_type_solid;
+                    set_south_wall(generator, point, tile, wall_type_solid);
                 }
             }
         }
@@ -194,17 +276,37 @@ generator_fill_box(struct generator *generator,
 }
 
 
+static void
+rollback_areas_and_tiles(struct generator *generator)
+{
+    for (int i = 0; i < generator->areas_count; ++i) {
+        area_free_to_arena(generator->dungeon->arena, generator->areas[i]);
+    }
+    generator->areas_count = 0;
+    
+    struct tile_journal *tile_journal = generator->tile_journal;
+    struct dungeon *dungeon = generator->dungeon;
+    for (int i = 0; i < tile_journal->tiles_count; ++i) {
+        struct tile const *original = tile_journal_original_tile(tile_journal, i);
+        struct point point = tile_journal->points[i];
+        occupancy_map_set(dungeon->occupancy_map, point, tile_is_escavated(original));
+        edge_grid_set_south_wall(dungeon->edge_grid, point, tile_get_south_wall(original));
+        edge_grid_set_west_wall(dungeon->edge_grid, point, tile_get_west_wall(original));
+    }
+    tile_journal_rollback(tile_journal);
+    level_boxes_clear(generator->level_boxes);
+    generator->level_boxes_are_stale = false;
+}
+
+
 void
 generator_free(struct generator *generator)
 {
-    generator_rollback(generator);
-    free_or_die(generator->areas);
-    for (int i = 0; i < generator->diggers_count; ++i) {
-        digger_free(generator->diggers[i]);
-    }
-    free_or_die(generator->diggers);
-    free_or_die(generator->saved_diggers);
-    free_or_die(generator->tiles);
+    // diggers are freed with the arena
+    rollback_areas_and_tiles(generator);
+    tile_journal_free(generator->tile_journal);
+    level_boxes_free(generator->level_boxes);
+    arena_free(generator->arena);
     free_or_die(generator);
 }
 
@@ -222,10 +324,14 @@ generator_generate(struct generator *generator)
     while (   generator->diggers_count
            && generator->iteration_count < generator->max_iteration_count)
     {
-        struct digger **diggers = arraydup_or_die(generator->diggers,
-                                                  generator->diggers_count,
-                                                  sizeof(struct digger *));
         int count = generator->diggers_count;
+        generator->checked_diggers = arena_grow_array(generator->arena,
+                                                      generator->checked_diggers,
+                                                      count,
+                                                      &generator->checked_diggers_capacity,
+                                                      sizeof(struct digger *));
+        struct digger **diggers = generator->checked_diggers;
+        memcpy(diggers, generator->diggers, count * sizeof(struct digger *));
         for (int i = 0; i < count; ++i) {
             if (periodic_check(diggers[i])) {
                 generator_commit(generator);
@@ -233,7 +339,6 @@ generator_generate(struct generator *generator)
                 generator_rollback(generator);
             }
         }
-        free_or_die(diggers);
         ++generator->iteration_count;
         if (generator->progress_callback) {
             generator->progress_callback(generator,
@@ -307,8 +412,7 @@ generator_generate_small(struct generator *generator)
     // dig connecting passage without constraints to make looping passage
     digger_dig_area(digger, 3, 1, 0, wall_type_none, area_type_passage);
     digger_move_forward(digger, 3);
-    struct tile *tile = generator_tile_at(generator, point_east(digger->point));
-    tile->walls.west = wall_type_none;
+    generator_set_wall(generator, digger->point, direction_east, wall_type_none);
     generator_commit(generator);
 }
 
@@ -316,18 +420,8 @@ generator_generate_small(struct generator *generator)
 bool
 generator_is_box_excavated(struct generator *generator, struct box box)
 {
-    for (int i = 0; i < box.size.width; ++i) {
-        for (int j = 0; j < box.size.length; ++j) {
-            for (int k = 0; k < box.size.height; ++k) {
-                struct point point = point_make(box.origin.x + i,
-                                                box.origin.y + j,
-                                                box.origin.z + k);
-                struct tile *tile = generator_tile_at(generator, point);
-                if (tile_is_escavated(tile)) return true;
-            }
-        }
-    }
-    return false;
+    // tiles are modified in place, so the dungeon sees pending changes
+    return dungeon_is_box_excavated(generator->dungeon, box);
 }
 
 
@@ -348,27 +442,30 @@ generator_min_level(struct generator const *generator)
 void
 generator_rollback(struct generator *generator)
 {
-    for (int i = 0; i < generator->areas_count; ++i) {
-        area_free(generator->areas[i]);
-    }
-    generator->areas_count = 0;
-    
-    while (generator->diggers_count < generator->saved_diggers_count) {
-        generator_add_digger(generator, point_make(0, 0, 0), direction_north);
-    }
-    while (generator->diggers_count > generator->saved_diggers_count) {
-        int last = generator->diggers_count - 1;
-        digger_free(generator->diggers[last]);
-        --generator->diggers_count;
-    }
-    for (int i = 0; i < generator->saved_diggers_count; ++i) {
-        *(generator->diggers[i]) = generator->saved_diggers[i];
+    for (int i = generator->digger_journal_count - 1; i >= 0; --i) {
+        struct digger_journal_entry *entry = &generator->digger_journal[i];
+        switch (entry->type) {
+            case digger_journal_entry_type_added:
+                assert(entry->digger == generator->diggers[generator->diggers_count - 1]);
+                --generator->diggers_count;
+                digger_free(entry->digger);
+                break;
+            case digger_journal_entry_type_changed:
+                *entry->digger = entry->original;
+                break;
+            case digger_journal_entry_type_deleted: {
+                struct digger **vacant = &generator->diggers[entry->index];
+                size_t size = (generator->diggers_count - entry->index) * sizeof(struct digger *);
+                memmove(vacant + 1, vacant, size);
+                *vacant = entry->digger;
+                ++generator->diggers_count;
+                break;
+            }
+        }
     }
+    generator->digger_journal_count = 0;
     
-    for (int i = 0; i < generator->tiles_count; ++i) {
-        tile_free(generator->tiles[i]);
-    }
-    generator->tiles_count = 0;
+    rollback_areas_and_tiles(generator);
 }
 
 
@@ -378,23 +475,21 @@ generator_set_wall(struct generator *generator,
                  enum direction direction,
                  enum wall_type wall_type)
 {
-    struct tile *tile;
+    struct point owner;
     switch (direction) {
         case direction_north:
-            tile = generator_tile_at(generator, point_north(point));
-            tile->walls.south = wall_type;
+            owner = point_north(point);
+            set_south_wall(generator, owner, generator_tile_at(generator, owner), wall_type);
             break;
         case direction_south:
-            tile = generator_tile_at(generator, point);
-            tile->walls.south = wall_type;
+            set_south_wall(generator, point, generator_tile_at(generator, point), wall_type);
             break;
         case direction_east:
-            tile = generator_tile_at(generator, point_east(point));
-            tile->walls.west = wall_type;
+            owner = point_east(point);
+            set_west_wall(generator, owner, generator_tile_at(generator, owner), wall_type);
             break;
         case direction_west:
-            tile = generator_tile_at(generator, point);
-            tile->walls.west = wall_type;
+            set_west_wall(generator, point, generator_tile_at(generator, point), wall_type);
             break;
         default:
             fail("Unrecognized direction %i", direction);
@@ -435,15 +530,15 @@ generator_set_walls(struct generator *generator,
 struct tile *
 generator_tile_at(struct generator *generator, struct point point)
 {
-    struct tile **tile = tile_find_in_array_sorted_by_point(generator->tiles,
-                                                            generator->tiles_count,
-                                                            point);
-    if (tile) return *tile;
-    
-    struct tile *dungeon_tile = dungeon_tile_at(generator->dungeon, point);
-    struct tile *copy = tile_alloc_copy(dungeon_tile);
-    generator->tiles = tile_add_to_array_sorted_by_point(generator->tiles,
-                                                         &generator->tiles_count,
-                                                         copy);
-    return copy;
+    struct tile *tile = tile_grid_tile_at(generator->dungeon->tile_grid, point);
+    tile_journal_record(generator->tile_journal, point, tile);
+    return tile;
+}
+
+
+void
+generator_will_change_digger(struct generator *generator,
+                             struct digger *digger)
+{
+    journal_digger(generator, digger_journal_entry_type_changed, digger, -1);
 }
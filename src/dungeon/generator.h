@@ -7,37 +7,65 @@
 
 #include <dungeon/area_type.h>
 #include <dungeon/box.h>
+#include <dungeon/digger.h>
 #include <dungeon/tile_type.h>
 #include <dungeon/wall_type.h>
 
 
 struct area;
+struct arena;
 struct digger;
 struct dungeon;
 struct dungeon_options;
 struct generator;
+struct level_boxes;
 struct rnd;
 struct tile;
+struct tile_journal;
+
+
+enum digger_journal_entry_type {
+    digger_journal_entry_type_added,
+    digger_journal_entry_type_changed,
+    digger_journal_entry_type_deleted,
+};
+
+
+// An undo record for a digger.  `original' holds the digger's value before a
+// change and `index' its position in the generator's diggers before deletion.
+struct digger_journal_entry {
+    enum digger_journal_entry_type type;
+    struct digger *digger;
+    struct digger original;
+    int index;
+};
 
 
 typedef void (generator_progress_callback)(struct generator *generator, void *user_data);
 
 
 struct generator {
+    struct arena *arena;
     struct area **areas;
     int areas_count;
+    int areas_capacity;
     struct digger **diggers;
     int diggers_count;
+    int diggers_capacity;
+    struct digger **checked_diggers;
+    int checked_diggers_capacity;
     struct dungeon *dungeon;
     int iteration_count;
     int max_iteration_count;
     struct size max_size;
     int padding;
     struct rnd *rnd;
-    struct digger *saved_diggers;
-    int saved_diggers_count;
-    struct tile **tiles;
-    int tiles_count;
+    struct digger_journal_entry *digger_journal;
+    int digger_journal_count;
+    int digger_journal_capacity;
+    struct tile_journal *tile_journal;
+    struct level_boxes *level_boxes;
+    bool level_boxes_are_stale;
     generator_progress_callback *progress_callback;
     void *callback_user_data;
 };
@@ -73,6 +101,12 @@ generator_delete_digger(struct generator *generator, struct digger *digger);
 void
 generator_commit(struct generator *generator);
 
+// Records the current value of `digger' so it can be restored by
+// generator_rollback().  Must be called before each change to a digger.
+void
+generator_will_change_digger(struct generator *generator,
+                             struct digger *digger);
+
 void
 generator_rollback(struct generator *generator);
 
@@ -2,6 +2,7 @@
 #include <stddef.h>
 #include <base/base.h>
 #include <dungeon/dungeon.h>
+#include "tile_journal.h"
 
 
 void
@@ -124,9 +125,57 @@ generator_delete_digger_test(void)
 }
 
 
+static void
+generator_rollback_test(void)
+{
+    struct dungeon *dungeon = dungeon_alloc();
+
+    struct dungeon_options *dungeon_options = dungeon_options_alloc_default();
+    struct generator *generator = generator_alloc(dungeon, global_rnd, dungeon_options, NULL, NULL);
+
+    struct digger *digger1 = generator_add_digger(generator,
+                                                  point_make(1, 1, 1),
+                                                  direction_north);
+    struct digger *digger2 = generator_add_digger(generator,
+                                                  point_make(2, 2, 1),
+                                                  direction_south);
+    generator_commit(generator);
+
+    digger_move_forward(digger1, 3);
+    digger_turn_90_degrees_left(digger2);
+    generator_add_digger(generator, point_make(3, 3, 1), direction_east);
+    generator_delete_digger(generator, digger1);
+    struct tile *tile = generator_tile_at(generator, point_make(5, 5, 1));
+    tile_set_type(tile, tile_type_empty);
+    assert(2 == generator->diggers_count);
+
+    generator_rollback(generator);
+
+    assert(2 == generator->diggers_count);
+    assert(digger1 == generator->diggers[0]);
+    assert(digger2 == generator->diggers[1]);
+    assert(point_equals(point_make(1, 1, 1), digger1->point));
+    assert(direction_north == digger1->direction);
+    assert(point_equals(point_make(2, 2, 1), digger2->point));
+    assert(direction_south == digger2->direction);
+    assert(tile_type_filled == tile_get_type(tile));
+    assert(0 == generator->tile_journal->tiles_count);
+
+    tile = generator_tile_at(generator, point_make(5, 5, 1));
+    tile_set_type(tile, tile_type_empty);
+    generator_commit(generator);
+    assert(tile_type_empty == tile_get_type(dungeon_get_tile(dungeon, point_make(5, 5, 1))));
+
+    generator_free(generator);
+    dungeon_options_free(dungeon_options);
+    dungeon_free(dungeon);
+}
+
+
 void generator_test(void)
 {
     generator_add_digger_test();
     generator_copy_digger_test();
     generator_delete_digger_test();
+    generator_rollback_test();
 }
@@ -0,0 +1,40 @@
+#include "level_array.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <base/base.h>
+
+
+extern inline int
+level_array_index(int levels_count, int min_level, int level);
+
+
+void *
+level_array_include(void *levels,
+                    int *levels_count,
+                    int *min_level,
+                    int level,
+                    size_t element_size)
+{
+    if (!*levels_count) {
+        *levels_count = 1;
+        *min_level = level;
+        return calloc_or_die(1, element_size);
+    }
+
+    int max_level = *min_level + *levels_count - 1;
+    int new_min_level = min(level, *min_level);
+    int new_count = max(level, max_level) - new_min_level + 1;
+    if (new_count == *levels_count) return levels;
+
+    int shift = *min_level - new_min_level;
+    uint8_t *bytes = reallocarray_or_die(levels, new_count, element_size);
+    if (shift) memmove(bytes + shift * element_size, bytes, *levels_count * element_size);
+    memset(bytes, 0, shift * element_size);
+    memset(bytes + (shift + *levels_count) * element_size,
+           0,
+           (new_count - shift - *levels_count) * element_size);
+    *levels_count = new_count;
+    *min_level = new_min_level;
+    return bytes;
+}
@@ -0,0 +1,31 @@
+#ifndef FNF_DUNGEON_LEVEL_ARRAY_H_INCLUDED
+#define FNF_DUNGEON_LEVEL_ARRAY_H_INCLUDED
+
+
+#include <stddef.h>
+
+
+// Helpers for arrays with one element per level, where element `i' is for
+// level `min_level + i'.
+
+
+// Returns the index of the element for `level', or -1 if there is none.
+inline int
+level_array_index(int levels_count, int min_level, int level)
+{
+    int index = level - min_level;
+    return (index < 0 || index >= levels_count) ? -1 : index;
+}
+
+// Grows `levels' to include an element for `level', zeroing any new
+// elements and updating `*levels_count' and `*min_level'.  Returns the
+// possibly moved array.
+void *
+level_array_include(void *levels,
+                    int *levels_count,
+                    int *min_level,
+                    int level,
+                    size_t element_size);
+
+
+#endif
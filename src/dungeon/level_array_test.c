@@ -0,0 +1,63 @@
+#include <assert.h>
+#include <base/base.h>
+#include "level_array.h"
+
+
+void
+level_array_test(void);
+
+
+static void
+level_array_include_test(void)
+{
+    int *levels = NULL;
+    int levels_count = 0;
+    int min_level = 0;
+
+    levels = level_array_include(levels, &levels_count, &min_level, 3, sizeof(int));
+    assert(1 == levels_count);
+    assert(3 == min_level);
+    levels[0] = 30;
+
+    levels = level_array_include(levels, &levels_count, &min_level, 5, sizeof(int));
+    assert(3 == levels_count);
+    assert(3 == min_level);
+    assert(30 == levels[0]);
+    assert(0 == levels[1]);
+    assert(0 == levels[2]);
+    levels[2] = 50;
+
+    levels = level_array_include(levels, &levels_count, &min_level, 1, sizeof(int));
+    assert(5 == levels_count);
+    assert(1 == min_level);
+    assert(0 == levels[0]);
+    assert(0 == levels[1]);
+    assert(30 == levels[2]);
+    assert(0 == levels[3]);
+    assert(50 == levels[4]);
+
+    levels = level_array_include(levels, &levels_count, &min_level, 4, sizeof(int));
+    assert(5 == levels_count);
+    assert(1 == min_level);
+
+    free_or_die(levels);
+}
+
+
+static void
+level_array_index_test(void)
+{
+    assert(-1 == level_array_index(0, 0, 0));
+    assert(0 == level_array_index(3, -1, -1));
+    assert(2 == level_array_index(3, -1, 1));
+    assert(-1 == level_array_index(3, -1, 2));
+    assert(-1 == level_array_index(3, -1, -2));
+}
+
+
+void
+level_array_test(void)
+{
+    level_array_include_test();
+    level_array_index_test();
+}
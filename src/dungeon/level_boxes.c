@@ -0,0 +1,134 @@
+#include "level_boxes.h"
+
+#include <assert.h>
+#include <base/base.h>
+
+
+static struct box
+empty_box_for_level(int level)
+{
+    return box_make(point_make(0, 0, level), size_make(0, 0, 1));
+}
+
+
+static void
+reserve(struct level_boxes *level_boxes, int count)
+{
+    if (count <= level_boxes->boxes_capacity) return;
+    level_boxes->boxes_capacity = max(count, level_boxes->boxes_capacity * 2);
+    level_boxes->boxes = reallocarray_or_die(level_boxes->boxes,
+                                             level_boxes->boxes_capacity,
+                                             sizeof(struct box));
+}
+
+
+static void
+include_level(struct level_boxes *level_boxes, int level)
+{
+    if (!level_boxes->boxes_count) {
+        level_boxes->boxes[0] = empty_box_for_level(level);
+        level_boxes->boxes_count = 1;
+        level_boxes->min_level = level;
+        return;
+    }
+
+    int max_level = level_boxes->min_level + level_boxes->boxes_count - 1;
+    int new_min_level = min(level, level_boxes->min_level);
+    int new_max_level = max(level, max_level);
+    int new_count = new_max_level - new_min_level + 1;
+    if (new_count == level_boxes->boxes_count) return;
+
+    int shift = level_boxes->min_level - new_min_level;
+    reserve(level_boxes, new_count);
+    if (shift) {
+        memmove(level_boxes->boxes + shift,
+                level_boxes->boxes,
+                level_boxes->boxes_count * sizeof(struct box));
+    }
+    for (int i = 0; i < new_count; ++i) {
+        if (i < shift || i >= shift + level_boxes->boxes_count) {
+            level_boxes->boxes[i] = empty_box_for_level(new_min_level + i);
+        }
+    }
+    level_boxes->boxes_count = new_count;
+    level_boxes->min_level = new_min_level;
+}
+
+
+struct level_boxes *
+level_boxes_alloc(void)
+{
+    struct level_boxes *level_boxes = calloc_or_die(1, sizeof(struct level_boxes));
+    level_boxes->boxes = calloc_or_die(1, sizeof(struct box));
+    level_boxes->boxes_capacity = 1;
+    return level_boxes;
+}
+
+
+struct box
+level_boxes_box_for_level(struct level_boxes const *level_boxes, int level)
+{
+    int index = level - level_boxes->min_level;
+    if (index < 0 || index >= level_boxes->boxes_count) {
+        return empty_box_for_level(level);
+    }
+    return level_boxes->boxes[index];
+}
+
+
+void
+level_boxes_clear(struct level_boxes *level_boxes)
+{
+    level_boxes->boxes_count = 0;
+    level_boxes->min_level = 0;
+}
+
+
+bool
+level_boxes_level_range(struct level_boxes const *level_boxes,
+                        int *min_level_out,
+                        int *max_level_out)
+{
+    int first = 0;
+    while (first < level_boxes->boxes_count && !box_volume(level_boxes->boxes[first])) ++first;
+    if (first == level_boxes->boxes_count) return false;
+    int last = level_boxes->boxes_count - 1;
+    while (!box_volume(level_boxes->boxes[last])) --last;
+    *min_level_out = level_boxes->min_level + first;
+    *max_level_out = level_boxes->min_level + last;
+    return true;
+}
+
+
+void
+level_boxes_extend_to_include_box(struct level_boxes *level_boxes,
+                                  struct box box)
+{
+    if (!box_volume(box)) return;
+    assert(1 == box.size.height);
+    struct point end = box_end_point(box);
+    level_boxes_extend_to_include_point(level_boxes, box.origin);
+    level_boxes_extend_to_include_point(level_boxes,
+                                        point_make(end.x - 1, end.y - 1, box.origin.z));
+}
+
+
+void
+level_boxes_extend_to_include_point(struct level_boxes *level_boxes,
+                                    struct point point)
+{
+    include_level(level_boxes, point.z);
+    int index = point.z - level_boxes->min_level;
+    level_boxes->boxes[index] = box_extend_to_include_point(level_boxes->boxes[index],
+                                                            point);
+}
+
+
+void
+level_boxes_free(struct level_boxes *level_boxes)
+{
+    if (level_boxes) {
+        free_or_die(level_boxes->boxes);
+        free_or_die(level_boxes);
+    }
+}
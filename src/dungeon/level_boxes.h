@@ -0,0 +1,51 @@
+#ifndef FNF_DUNGEON_LEVEL_BOXES_H_INCLUDED
+#define FNF_DUNGEON_LEVEL_BOXES_H_INCLUDED
+
+
+#include <stdbool.h>
+#include <dungeon/box.h>
+#include <dungeon/point.h>
+
+
+// The bounding box of the excavated tiles on each level, grown one point at a
+// time.  `boxes[i]' holds the box for level `min_level + i'; levels without
+// excavated tiles have an empty box.
+struct level_boxes {
+    struct box *boxes;
+    int boxes_count;
+    int boxes_capacity;
+    int min_level;
+};
+
+
+struct level_boxes *
+level_boxes_alloc(void);
+
+void
+level_boxes_free(struct level_boxes *level_boxes);
+
+// Sets the first and last levels with points, or returns false if no level
+// has any.
+bool
+level_boxes_level_range(struct level_boxes const *level_boxes,
+                        int *min_level_out,
+                        int *max_level_out);
+
+// Returns an empty box at (0, 0, level) if the level has no points.
+struct box
+level_boxes_box_for_level(struct level_boxes const *level_boxes, int level);
+
+void
+level_boxes_clear(struct level_boxes *level_boxes);
+
+// Does nothing if `box' is empty.  `box' must lie on a single level.
+void
+level_boxes_extend_to_include_box(struct level_boxes *level_boxes,
+                                  struct box box);
+
+void
+level_boxes_extend_to_include_point(struct level_boxes *level_boxes,
+                                    struct point point);
+
+
+#endif
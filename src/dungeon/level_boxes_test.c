@@ -0,0 +1,62 @@
+#include <assert.h>
+#include <base/base.h>
+#include "level_boxes.h"
+
+
+void
+level_boxes_test(void);
+
+
+static void
+level_boxes_alloc_test(void)
+{
+    struct level_boxes *level_boxes = level_boxes_alloc();
+
+    assert(0 == level_boxes->boxes_count);
+    struct box expected = box_make(point_make(0, 0, 3), size_make(0, 0, 1));
+    assert(box_equals(expected, level_boxes_box_for_level(level_boxes, 3)));
+
+    level_boxes_free(level_boxes);
+}
+
+
+static void
+level_boxes_extend_to_include_point_test(void)
+{
+    struct level_boxes *level_boxes = level_boxes_alloc();
+    struct box expected;
+
+    level_boxes_extend_to_include_point(level_boxes, point_make(5, 5, 2));
+    expected = box_make(point_make(5, 5, 2), size_make(1, 1, 1));
+    assert(box_equals(expected, level_boxes_box_for_level(level_boxes, 2)));
+
+    level_boxes_extend_to_include_point(level_boxes, point_make(-3, 7, 2));
+    expected = box_make(point_make(-3, 5, 2), size_make(9, 3, 1));
+    assert(box_equals(expected, level_boxes_box_for_level(level_boxes, 2)));
+
+    level_boxes_extend_to_include_point(level_boxes, point_make(1, 1, 5));
+    level_boxes_extend_to_include_point(level_boxes, point_make(0, 0, -1));
+    assert(-1 == level_boxes->min_level);
+    assert(7 == level_boxes->boxes_count);
+    assert(box_equals(expected, level_boxes_box_for_level(level_boxes, 2)));
+    expected = box_make(point_make(1, 1, 5), size_make(1, 1, 1));
+    assert(box_equals(expected, level_boxes_box_for_level(level_boxes, 5)));
+    expected = box_make(point_make(0, 0, -1), size_make(1, 1, 1));
+    assert(box_equals(expected, level_boxes_box_for_level(level_boxes, -1)));
+    expected = box_make(point_make(0, 0, 3), size_make(0, 0, 1));
+    assert(box_equals(expected, level_boxes_box_for_level(level_boxes, 3)));
+
+    level_boxes_clear(level_boxes);
+    expected = box_make(point_make(0, 0, 2), size_make(0, 0, 1));
+    assert(box_equals(expected, level_boxes_box_for_level(level_boxes, 2)));
+
+    level_boxes_free(level_boxes);
+}
+
+
+void
+level_boxes_test(void)
+{
+    level_boxes_alloc_test();
+    level_boxes_extend_to_include_point_test();
+}
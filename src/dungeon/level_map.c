@@ -5,6 +5,7 @@
 #include <base/base.h>
 
 #include "dungeon.h"
+#include "frozen_dungeon.h"
 #include "text_rectangle.h"
 #include "tile.h"
 #include "tile_type.h"
@@ -15,12 +16,12 @@ static char const *const margin =                "    ";
 
 
 static void
-fill_half_tile(struct tile *tile, char half_tile[5])
+fill_half_tile(struct tile const *tile, char half_tile[5])
 {
-    switch (tile->type) {
+    switch (tile_get_type(tile)) {
         case tile_type_empty: strcpy(half_tile, "    "); break;
         case tile_type_stairs_down:
-            switch (tile->direction) {
+            switch (tile_get_direction(tile)) {
                 case direction_north: strcpy(half_tile, "  ^ "); break;
                 case direction_south: strcpy(half_tile, "  v "); break;
                 case direction_east: strcpy(half_tile, " > >"); break;
@@ -29,7 +30,7 @@ fill_half_tile(struct tile *tile, char half_tile[5])
             }
             break;
         case tile_type_stairs_up:
-            switch (orientation_from_direction(tile->direction)) {
+            switch (orientation_from_direction(tile_get_direction(tile))) {
                 case orientation_north_to_south: strcpy(half_tile, "===="); break;
                 case orientation_east_to_west: strcpy(half_tile, "IIII"); break;
                 default: break;
@@ -54,6 +55,16 @@ level_map_alloc(struct dungeon *dungeon, int level)
 }
 
 
+struct level_map *
+level_map_alloc_for_frozen_level(struct frozen_level const *frozen_level)
+{
+    struct level_map *level_map = calloc_or_die(1, sizeof(struct level_map));
+    level_map->frozen_level = frozen_level;
+    level_map->box = frozen_level->box;
+    return level_map;
+}
+
+
 struct text_rectangle *
 level_map_alloc_text_rectangle(struct level_map *level_map, bool show_scale)
 {
@@ -147,9 +158,12 @@ level_map_free(struct level_map *level_map)
 }
 
 
-struct tile *
+struct tile const *
 level_map_tile_at(struct level_map const *level_map, struct point point)
 {
+    if (level_map->frozen_level) {
+        return frozen_level_tile_at(level_map->frozen_level, point);
+    }
     if(!box_contains_point(level_map->box, point)) return NULL;
     int index = box_index_for_point(level_map->box, point);
     return level_map->tiles[index];
@@ -189,22 +203,22 @@ level_map_fill_tile_bottom_half(struct level_map const *level_map,
                                 struct point point,
                                 char *half_tile)
 {
-    struct tile *tile = level_map_tile_at(level_map, point);
+    struct tile const *tile = level_map_tile_at(level_map, point);
     assert(tile);
 
-    if (wall_type_none == tile->walls.south) {
+    if (wall_type_none == tile_get_south_wall(tile)) {
         fill_half_tile(tile, half_tile);
-        if (tile_type_empty == tile->type) half_tile[0] = '.';
+        if (tile_type_empty == tile_get_type(tile)) half_tile[0] = '.';
     }
     
     // south wall
     if (level_map->box.origin.y == point.y) {
         strcpy(half_tile, "----");
-    } else if (wall_type_solid == tile->walls.south) {
+    } else if (wall_type_solid == tile_get_south_wall(tile)) {
         strcpy(half_tile, "----");
-    } else if (wall_type_door == tile->walls.south) {
+    } else if (wall_type_door == tile_get_south_wall(tile)) {
         strcpy(half_tile, "-[-]");
-    } else if (wall_type_secret_door == tile->walls.south) {
+    } else if (wall_type_secret_door == tile_get_south_wall(tile)) {
         strcpy(half_tile, "--s-");
     }
     
@@ -212,22 +226,23 @@ level_map_fill_tile_bottom_half(struct level_map const *level_map,
     if (tile_has_west_wall(tile)) half_tile[0] = '|';
     
     // corner
-    bool has_corner = level_map_tile_has_sw_corner(level_map, tile);
+    bool has_corner = level_map_tile_has_sw_corner(level_map, point);
     if (has_corner) half_tile[0] = '+';
 }
 
 
 bool
 level_map_tile_has_sw_corner(struct level_map const *level_map,
-                             struct tile *tile)
+                             struct point point)
 {
-    if (level_map->box.origin.x == tile->point.x) {
+    struct tile const *tile = level_map_tile_at(level_map, point);
+    if (level_map->box.origin.x == point.x) {
         return true;
-    } else if (level_map->box.origin.y == tile->point.y) {
+    } else if (level_map->box.origin.y == point.y) {
         return true;
     } else if (!tile_has_south_wall(tile) && !tile_has_west_wall(tile)) {
-        struct tile *south_tile = level_map_tile_at(level_map, point_south(tile->point));
-        struct tile *west_tile = level_map_tile_at(level_map, point_west(tile->point));
+        struct tile const *south_tile = level_map_tile_at(level_map, point_south(point));
+        struct tile const *west_tile = level_map_tile_at(level_map, point_west(point));
         if (   south_tile
                && west_tile
                && (tile_has_west_wall(south_tile) || tile_has_south_wall(west_tile)))
@@ -235,21 +250,21 @@ level_map_tile_has_sw_corner(struct level_map const *level_map,
             return true;
         }
     } else if (tile_has_south_wall(tile) && !tile_has_west_wall(tile)) {
-        struct tile *south_tile = level_map_tile_at(level_map, point_south(tile->point));
+        struct tile const *south_tile = level_map_tile_at(level_map, point_south(point));
         if (south_tile && tile_has_west_wall(south_tile)) {
             return true;
         } else {
-            struct tile *west_tile = level_map_tile_at(level_map, point_west(tile->point));
+            struct tile const *west_tile = level_map_tile_at(level_map, point_west(point));
             if (west_tile && !tile_has_south_wall(west_tile)) {
                 return true;
             }
         }
     } else if (!tile_has_south_wall(tile) && tile_has_west_wall(tile)) {
-        struct tile *south_tile = level_map_tile_at(level_map, point_south(tile->point));
+        struct tile const *south_tile = level_map_tile_at(level_map, point_south(point));
         if (south_tile && !tile_has_west_wall(south_tile)) {
             return true;
         } else {
-            struct tile *west_tile = level_map_tile_at(level_map, point_west(tile->point));
+            struct tile const *west_tile = level_map_tile_at(level_map, point_west(point));
             if (west_tile && tile_has_south_wall(west_tile)) {
                 return true;
             }
@@ -266,7 +281,7 @@ level_map_fill_tile_top_half(struct level_map const *level_map,
                              struct point point,
                              char *half_tile)
 {
-    struct tile *tile = level_map_tile_at(level_map, point);
+    struct tile const *tile = level_map_tile_at(level_map, point);
     assert(tile);
     fill_half_tile(tile, half_tile);
     
@@ -275,33 +290,33 @@ level_map_fill_tile_top_half(struct level_map const *level_map,
     // west wall
     if (level_map->box.origin.x == point.x) {
         half_tile[0] = '|';
-    } else if (wall_type_solid == tile->walls.west) {
+    } else if (wall_type_solid == tile_get_west_wall(tile)) {
         half_tile[0] = '|';
-    } else if (wall_type_door == tile->walls.west) {
+    } else if (wall_type_door == tile_get_west_wall(tile)) {
         half_tile[0] = '|';
         half_tile[1] = ']';
-    } else if (wall_type_secret_door == tile->walls.west) {
+    } else if (wall_type_secret_door == tile_get_west_wall(tile)) {
         half_tile[0] = '$';
     }
     
     // features
-    if (tile->features & tile_features_chimney_down) {
+    if (tile_get_features(tile) & tile_features_chimney_down) {
         half_tile[2] = 'o';
     }
-    if (tile->features & tile_features_chimney_up) {
+    if (tile_get_features(tile) & tile_features_chimney_up) {
         half_tile[1] = '(';
         half_tile[3] = ')';
     }
-    if (tile->features & tile_features_chute_entrance) {
+    if (tile_get_features(tile) & tile_features_chute_entrance) {
         half_tile[2] = '@';
     }
-    if (tile->features & tile_features_chute_exit) {
+    if (tile_get_features(tile) & tile_features_chute_exit) {
         half_tile[2] = '*';
     }
     
     // east door
-    struct tile *east_tile = level_map_tile_at(level_map, point_east(point));
-    if (east_tile && wall_type_door == east_tile->walls.west) {
+    struct tile const *east_tile = level_map_tile_at(level_map, point_east(point));
+    if (east_tile && wall_type_door == tile_get_west_wall(east_tile)) {
         half_tile[3] = '[';
     }
 }
@@ -7,24 +7,35 @@
 
 
 struct dungeon;
+struct frozen_level;
 struct text_rectangle;
 struct tile;
 
 
+// A map of a level and a border of one tile around it.  Tiles come either
+// from `tiles', which points into the dungeon's tile grid, or straight from
+// `frozen_level'.
 struct level_map {
     struct dungeon *dungeon;
+    struct frozen_level const *frozen_level;
     struct box box;
-    struct tile **tiles;
+    struct tile const **tiles;
 };
 
 
 struct level_map *
 level_map_alloc(struct dungeon *dungeon, int level);
 
+// Reads tiles from `frozen_level' without allocating them.
+struct level_map *
+level_map_alloc_for_frozen_level(struct frozen_level const *frozen_level);
+
 void
 level_map_free(struct level_map *level_map);
 
-struct tile *
+// Returns NULL for points outside the map, or for maps of frozen levels
+// outside the level itself.
+struct tile const *
 level_map_tile_at(struct level_map const *level_map, struct point point);
 
 struct text_rectangle *
@@ -57,6 +68,6 @@ level_map_fill_tile_top_half(struct level_map const *level_map,
 
 bool
 level_map_tile_has_sw_corner(struct level_map const *level_map,
-                             struct tile *tile);
+                             struct point point);
 
 #endif
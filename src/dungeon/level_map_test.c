@@ -25,19 +25,39 @@ level_map_alloc_test(void)
 }
 
 
+static void
+level_map_tile_at_for_frozen_level_test(void)
+{
+    struct dungeon *dungeon = dungeon_alloc();
+    dungeon_generate_small(dungeon);
+    struct frozen_dungeon *frozen_dungeon = dungeon_freeze(dungeon);
+    struct frozen_level const *frozen_level = frozen_dungeon_level(frozen_dungeon, 1);
+    struct level_map *level_map = level_map_alloc_for_frozen_level(frozen_level);
+
+    struct tile const *tile = level_map_tile_at(level_map, point_make(0, 0, 1));
+    assert(tile);
+    assert(tile == frozen_level_tile_at(frozen_level, point_make(0, 0, 1)));
+    assert(tile_type_stairs_up == tile_get_type(tile));
+
+    level_map_free(level_map);
+    frozen_dungeon_free(frozen_dungeon);
+    dungeon_free(dungeon);
+}
+
+
 static void
 level_map_tile_at_test(void)
 {
     struct dungeon *dungeon = dungeon_alloc();
     struct level_map *level_map = level_map_alloc(dungeon, 1);
-    struct tile *tile;
+    struct tile const *tile;
 
     tile = level_map_tile_at(level_map, point_make(4, 4, 1));
     assert(!tile);
 
     tile = level_map_tile_at(level_map, point_make(0, 0, 1));
     assert(tile);
-    assert(point_equals(point_make(0, 0, 1), tile->point));
+    assert(tile == dungeon_get_tile(dungeon, point_make(0, 0, 1)));
 
     level_map_free(level_map);
     dungeon_free(dungeon);
@@ -98,8 +118,9 @@ static void
 level_map_alloc_text_rectangle_test_with_tile_added(void)
 {
     struct dungeon *dungeon = dungeon_alloc();
-    struct tile *tile = dungeon_tile_at(dungeon, point_make(2, 3, 1));
-    tile->type = tile_type_empty;
+    struct tile *tile = tile_alloc(tile_type_empty);
+    dungeon_store_tile(dungeon, point_make(2, 3, 1), tile);
+    tile_free(tile);
     struct level_map *level_map = level_map_alloc(dungeon, 1);
     bool show_scale = true;
 
@@ -222,100 +243,119 @@ level_map_fill_tile_bottom_half_test(void)
 {
     struct dungeon *dungeon = dungeon_alloc();
 
-    struct tile *extent;
-    extent = dungeon_tile_at(dungeon, point_make(1, 3, 1));
-    extent->type = tile_type_empty;
-    extent = dungeon_tile_at(dungeon, point_make(3, 1, 1));
-    extent->type = tile_type_empty;
+    struct tile *extent = tile_alloc(tile_type_empty);
+    dungeon_store_tile(dungeon, point_make(1, 3, 1), extent);
+    dungeon_store_tile(dungeon, point_make(3, 1, 1), extent);
+    tile_free(extent);
     // produces a level map with origin (0, 0, 1) and size (5, 5, 1)
 
     struct level_map *level_map = level_map_alloc(dungeon, 1);
 
-    struct tile *tile = level_map_tile_at(level_map, point_make(1, 1, 1));
+    struct tile tile = *dungeon_get_tile(dungeon, point_make(1, 1, 1));
 
     char half_tile[5];
 
     // no walls
-    tile->walls.south = wall_type_none;
-    tile->walls.west = wall_type_none;
+    tile_set_south_wall(&tile, wall_type_none);
+    tile_set_west_wall(&tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
 
-    tile->type = tile_type_empty;
+    tile_set_type(&tile, tile_type_empty);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq(".   ", half_tile));
 
-    tile->type = tile_type_stairs_down;
-    tile->direction = direction_north;
+    tile_set_type(&tile, tile_type_stairs_down);
+    tile_set_direction(&tile, direction_north);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("  ^ ", half_tile));
 
-    tile->type = tile_type_stairs_down;
-    tile->direction = direction_south;
+    tile_set_type(&tile, tile_type_stairs_down);
+    tile_set_direction(&tile, direction_south);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("  v ", half_tile));
 
-    tile->type = tile_type_stairs_down;
-    tile->direction = direction_east;
+    tile_set_type(&tile, tile_type_stairs_down);
+    tile_set_direction(&tile, direction_east);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq(" > >", half_tile));
 
-    tile->type = tile_type_stairs_down;
-    tile->direction = direction_west;
+    tile_set_type(&tile, tile_type_stairs_down);
+    tile_set_direction(&tile, direction_west);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq(" < <", half_tile));
 
-    tile->type = tile_type_stairs_up;
-    tile->direction = direction_north;
+    tile_set_type(&tile, tile_type_stairs_up);
+    tile_set_direction(&tile, direction_north);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("====", half_tile));
 
-    tile->type = tile_type_stairs_up;
-    tile->direction = direction_east;
+    tile_set_type(&tile, tile_type_stairs_up);
+    tile_set_direction(&tile, direction_east);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("IIII", half_tile));
 
-    tile->type = tile_type_filled;
+    tile_set_type(&tile, tile_type_filled);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("::::", half_tile));
 
     // south wall
-    tile->type = tile_type_empty;
-    tile->walls.west = wall_type_none;
+    tile_set_type(&tile, tile_type_empty);
+    tile_set_west_wall(&tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
 
-    struct tile *west_tile = level_map_tile_at(level_map, point_make(0, 1, 1));
-    west_tile->type = tile_type_empty;
-    west_tile->walls.south = wall_type_solid;
+    struct tile west_tile = *dungeon_get_tile(dungeon, point_make(0, 1, 1));
+    tile_set_type(&west_tile, tile_type_empty);
+    tile_set_south_wall(&west_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
 
-    tile->walls.south = wall_type_solid;
+    tile_set_south_wall(&tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("----", half_tile));
 
-    tile->walls.south = wall_type_door;
+    tile_set_south_wall(&tile, wall_type_door);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("-[-]", half_tile));
 
-    tile->walls.south = wall_type_secret_door;
+    tile_set_south_wall(&tile, wall_type_secret_door);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("--s-", half_tile));
 
-    west_tile->type = tile_type_filled;
-    west_tile->walls.south = wall_type_none;
+    tile_set_type(&west_tile, tile_type_filled);
+    tile_set_south_wall(&west_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
 
     // west wall
-    tile->walls.south = wall_type_none;
-    tile->walls.west = wall_type_solid;
+    tile_set_south_wall(&tile, wall_type_none);
+    tile_set_west_wall(&tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
 
-    struct tile *south_tile = level_map_tile_at(level_map, point_make(1, 0, 1));
-    south_tile->walls.west = wall_type_solid;
+    struct tile south_tile = *dungeon_get_tile(dungeon, point_make(1, 0, 1));
+    tile_set_west_wall(&south_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
 
-    tile->type = tile_type_filled;
+    tile_set_type(&tile, tile_type_filled);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("|:::", half_tile));
 
-    tile->type = tile_type_empty;
+    tile_set_type(&tile, tile_type_empty);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_bottom_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("|   ", half_tile));
 
-    south_tile->walls.west = wall_type_none;
+    tile_set_west_wall(&south_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
 
     level_map_free(level_map);
     dungeon_free(dungeon);
@@ -330,106 +370,126 @@ level_map_fill_tile_top_half_test(void)
 {
     struct dungeon *dungeon = dungeon_alloc();
 
-    struct tile *extent;
-    extent = dungeon_tile_at(dungeon, point_make(1, 3, 1));
-    extent->type = tile_type_empty;
-    extent = dungeon_tile_at(dungeon, point_make(3, 1, 1));
-    extent->type = tile_type_empty;
+    struct tile *extent = tile_alloc(tile_type_empty);
+    dungeon_store_tile(dungeon, point_make(1, 3, 1), extent);
+    dungeon_store_tile(dungeon, point_make(3, 1, 1), extent);
+    tile_free(extent);
     // produces a level map with origin (0, 0, 1) and size (5, 5, 1)
 
     struct level_map *level_map = level_map_alloc(dungeon, 1);
 
-    struct tile *tile = level_map_tile_at(level_map, point_make(1, 1, 1));
+    struct tile tile = *dungeon_get_tile(dungeon, point_make(1, 1, 1));
 
     char half_tile[5];
 
     // no walls
-    tile->walls.south = wall_type_none;
-    tile->walls.west = wall_type_none;
+    tile_set_south_wall(&tile, wall_type_none);
+    tile_set_west_wall(&tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
 
-    tile->type = tile_type_empty;
+    tile_set_type(&tile, tile_type_empty);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("    ", half_tile));
 
-    tile->type = tile_type_stairs_down;
-    tile->direction = direction_north;
+    tile_set_type(&tile, tile_type_stairs_down);
+    tile_set_direction(&tile, direction_north);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("  ^ ", half_tile));
 
-    tile->type = tile_type_stairs_down;
-    tile->direction = direction_south;
+    tile_set_type(&tile, tile_type_stairs_down);
+    tile_set_direction(&tile, direction_south);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("  v ", half_tile));
 
-    tile->type = tile_type_stairs_down;
-    tile->direction = direction_east;
+    tile_set_type(&tile, tile_type_stairs_down);
+    tile_set_direction(&tile, direction_east);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq(" > >", half_tile));
 
-    tile->type = tile_type_stairs_down;
-    tile->direction = direction_west;
+    tile_set_type(&tile, tile_type_stairs_down);
+    tile_set_direction(&tile, direction_west);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq(" < <", half_tile));
 
-    tile->type = tile_type_stairs_up;
-    tile->direction = direction_north;
+    tile_set_type(&tile, tile_type_stairs_up);
+    tile_set_direction(&tile, direction_north);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("====", half_tile));
 
-    tile->type = tile_type_stairs_up;
-    tile->direction = direction_east;
+    tile_set_type(&tile, tile_type_stairs_up);
+    tile_set_direction(&tile, direction_east);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("IIII", half_tile));
 
-    tile->type = tile_type_filled;
-    tile->direction = direction_east;
+    tile_set_type(&tile, tile_type_filled);
+    tile_set_direction(&tile, direction_east);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("::::", half_tile));
 
     // west wall
-    tile->type = tile_type_empty;
+    tile_set_type(&tile, tile_type_empty);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
 
-    tile->walls.west = wall_type_solid;
+    tile_set_west_wall(&tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("|   ", half_tile));
 
-    tile->walls.west = wall_type_door;
+    tile_set_west_wall(&tile, wall_type_door);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("|]  ", half_tile));
 
-    tile->walls.west = wall_type_secret_door;
+    tile_set_west_wall(&tile, wall_type_secret_door);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("$   ", half_tile));
 
     // features
-    tile->type = tile_type_empty;
-    tile->walls.west = wall_type_none;
+    tile_set_type(&tile, tile_type_empty);
+    tile_set_west_wall(&tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
 
-    tile->features = tile_features_chimney_down;
+    tile_set_features(&tile, tile_features_chimney_down);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("  o ", half_tile));
 
-    tile->features = tile_features_chimney_up;
+    tile_set_features(&tile, tile_features_chimney_up);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq(" ( )", half_tile));
 
-    tile->features = tile_features_chimney_up | tile_features_chimney_down;
+    tile_set_features(&tile, tile_features_chimney_up | tile_features_chimney_down);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq(" (o)", half_tile));
 
-    tile->features = tile_features_chute_entrance;
+    tile_set_features(&tile, tile_features_chute_entrance);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("  @ ", half_tile));
 
-    tile->features = tile_features_chute_exit;
+    tile_set_features(&tile, tile_features_chute_exit);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("  * ", half_tile));
 
-    tile->features = tile_features_none;
+    tile_set_features(&tile, tile_features_none);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
 
     // east door
-    struct tile *east_tile = level_map_tile_at(level_map, point_make(2, 1, 1));
-    east_tile->walls.west = wall_type_door;
+    struct tile east_tile = *dungeon_get_tile(dungeon, point_make(2, 1, 1));
+    tile_set_west_wall(&east_tile, wall_type_door);
+    dungeon_store_tile(dungeon, point_make(2, 1, 1), &east_tile);
     level_map_fill_tile_top_half(level_map, point_make(1, 1, 1), half_tile);
     assert(str_eq("   [", half_tile));
 
@@ -443,127 +503,156 @@ level_map_tile_has_sw_corner_test()
 {
     struct dungeon *dungeon = dungeon_alloc();
 
-    struct tile *extent;
-    extent = dungeon_tile_at(dungeon, point_make(1, 3, 1));
-    extent->type = tile_type_empty;
-    extent = dungeon_tile_at(dungeon, point_make(3, 1, 1));
-    extent->type = tile_type_empty;
+    struct tile *extent = tile_alloc(tile_type_empty);
+    dungeon_store_tile(dungeon, point_make(1, 3, 1), extent);
+    dungeon_store_tile(dungeon, point_make(3, 1, 1), extent);
+    tile_free(extent);
     // produces a level map with origin (0, 0, 1) and size (5, 5, 1)
 
     struct level_map *level_map = level_map_alloc(dungeon, 1);
 
-    struct tile *tile = level_map_tile_at(level_map, point_make(1, 1, 1));
-    struct tile *south_tile = level_map_tile_at(level_map, point_make(1, 0, 1));
-    struct tile *west_tile = level_map_tile_at(level_map, point_make(0, 1, 1));
+    struct tile tile = *dungeon_get_tile(dungeon, point_make(1, 1, 1));
+    struct tile south_tile = *dungeon_get_tile(dungeon, point_make(1, 0, 1));
+    struct tile west_tile = *dungeon_get_tile(dungeon, point_make(0, 1, 1));
 
     // has no walls
-    tile->walls.west = wall_type_none;
-    tile->walls.south = wall_type_none;
+    tile_set_west_wall(&tile, wall_type_none);
+    tile_set_south_wall(&tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
 
     // ::::....
     // ::::....
     // ::::::::
-    south_tile->walls.west = wall_type_none;
-    west_tile->walls.south = wall_type_none;
-    assert(!level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_west_wall(&south_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(!level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
     // ::::....
     // ----+...
     // ::::::::
-    south_tile->walls.west = wall_type_none;
-    west_tile->walls.south = wall_type_solid;
-    assert(level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_west_wall(&south_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
     // ::::....
     // ::::+...
     // ::::|:::
-    south_tile->walls.west = wall_type_solid;
-    west_tile->walls.south = wall_type_none;
-    assert(level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_west_wall(&south_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
     // ::::....
     // ----+...
     // ::::|:::
-    south_tile->walls.west = wall_type_solid;
-    west_tile->walls.south = wall_type_solid;
-    assert(level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_west_wall(&south_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
 
     // has only south wall
-    tile->walls.west = wall_type_none;
-    tile->walls.south = wall_type_solid;
+    tile_set_west_wall(&tile, wall_type_none);
+    tile_set_south_wall(&tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
 
     // ::::....
     // ::::+---
     // ::::::::
-    south_tile->walls.west = wall_type_none;
-    west_tile->walls.south = wall_type_none;
-    assert(level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_west_wall(&south_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
     // ::::....
     // --------
     // ::::::::
-    south_tile->walls.west = wall_type_none;
-    west_tile->walls.south = wall_type_solid;
-    assert(!level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_west_wall(&south_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(!level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
     // ::::....
     // ::::+---
     // ::::|:::
-    south_tile->walls.west = wall_type_solid;
-    west_tile->walls.south = wall_type_none;
-    assert(level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_west_wall(&south_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
     // ::::....
     // ----+---
     // ::::|:::
-    south_tile->walls.west = wall_type_solid;
-    west_tile->walls.south = wall_type_solid;
-    assert(level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_west_wall(&south_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
 
     // has only west wall
-    tile->walls.west = wall_type_solid;
-    tile->walls.south = wall_type_none;
+    tile_set_west_wall(&tile, wall_type_solid);
+    tile_set_south_wall(&tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
 
     // ::::|...
     // ::::+...
     // ::::::::
-    south_tile->walls.west = wall_type_none;
-    west_tile->walls.south = wall_type_none;
-    assert(level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_west_wall(&south_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
     // ::::|...
     // ----+...
     // ::::::::
-    south_tile->walls.west = wall_type_none;
-    west_tile->walls.south = wall_type_solid;
-    assert(level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_west_wall(&south_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
     // ::::|...
     // ::::|...
     // ::::|:::
-    south_tile->walls.west = wall_type_solid;
-    west_tile->walls.south = wall_type_none;
-    assert(!level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_west_wall(&south_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(!level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
     // ::::|...
     // ----+...
     // ::::|:::
-    south_tile->walls.west = wall_type_solid;
-    west_tile->walls.south = wall_type_solid;
-    assert(level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_west_wall(&south_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
 
     // has both south and west walls
     // ::::|
     // ::::+---
     // ::::::::
-    tile->walls.south = wall_type_solid;
-    tile->walls.west = wall_type_solid;
-    south_tile->walls.west = wall_type_none;
-    west_tile->walls.south = wall_type_none;
-    assert(level_map_tile_has_sw_corner(level_map, tile));
+    tile_set_south_wall(&tile, wall_type_solid);
+    tile_set_west_wall(&tile, wall_type_solid);
+    dungeon_store_tile(dungeon, point_make(1, 1, 1), &tile);
+    tile_set_west_wall(&south_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(1, 0, 1), &south_tile);
+    tile_set_south_wall(&west_tile, wall_type_none);
+    dungeon_store_tile(dungeon, point_make(0, 1, 1), &west_tile);
+    assert(level_map_tile_has_sw_corner(level_map, point_make(1, 1, 1)));
 
     level_map_free(level_map);
     dungeon_free(dungeon);
@@ -575,6 +664,7 @@ level_map_test(void)
 {
     level_map_alloc_test();
     level_map_tile_at_test();
+    level_map_tile_at_for_frozen_level_test();
     level_map_alloc_text_rectangle_test();
     level_map_alloc_text_rectangle_test_without_scale();
     level_map_alloc_text_rectangle_test_with_tile_added();
@@ -0,0 +1,310 @@
+#include "mapped_dungeon.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <base/base.h>
+
+#include "area.h"
+#include "tile.h"
+
+
+static char const magic[8] = "FNFDUNG";
+static uint64_t const section_alignment = 8;
+
+
+static uint64_t
+align_offset(uint64_t offset);
+
+static bool
+is_area_valid(struct area const *area, struct box level_box);
+
+static bool
+is_box_valid(struct box box);
+
+static bool
+is_section_valid(struct mapped_dungeon const *mapped_dungeon,
+                 uint64_t offset,
+                 uint64_t count,
+                 size_t record_size);
+
+static bool
+map_levels(struct mapped_dungeon *mapped_dungeon);
+
+static bool
+write_level_tiles(FILE *out,
+                  uint64_t *position,
+                  struct mapped_dungeon_level const *mapped_level,
+                  struct frozen_level const *level);
+
+static bool
+write_section(FILE *out,
+              uint64_t *position,
+              uint64_t offset,
+              void const *bytes,
+              size_t size);
+
+
+static uint64_t
+align_offset(uint64_t offset)
+{
+    return (offset + section_alignment - 1) & ~(section_alignment - 1);
+}
+
+
+static bool
+is_area_valid(struct area const *area, struct box level_box)
+{
+    if ((unsigned)area->type > area_type_stairs_up) return false;
+    if (!direction_is_valid(area->direction)) return false;
+    if (area->features & ~area_features_all) return false;
+    if (!is_box_valid(area->box)) return false;
+    // descriptions give sizes in feet
+    if (area->box.size.width > INT_MAX / 10 || area->box.size.length > INT_MAX / 10) return false;
+    return box_contains_box(level_box, area->box);
+}
+
+
+static bool
+is_box_valid(struct box box)
+{
+    if (box.size.width < 0 || box.size.length < 0 || box.size.height < 0) return false;
+    if ((int64_t)box.origin.x + box.size.width > INT_MAX) return false;
+    if ((int64_t)box.origin.y + box.size.length > INT_MAX) return false;
+    return (int64_t)box.origin.z + box.size.height <= INT_MAX;
+}
+
+
+static bool
+is_section_valid(struct mapped_dungeon const *mapped_dungeon,
+                 uint64_t offset,
+                 uint64_t count,
+                 size_t record_size)
+{
+    if (offset % section_alignment) return false;
+    if (offset > mapped_dungeon->size) return false;
+    return count <= (mapped_dungeon->size - offset) / record_size;
+}
+
+
+static bool
+map_levels(struct mapped_dungeon *mapped_dungeon)
+{
+    uint8_t const *bytes = mapped_dungeon->bytes;
+    struct mapped_dungeon_header const *header = mapped_dungeon->bytes;
+    if (memcmp(magic, header->magic, sizeof magic)) return false;
+    if (mapped_dungeon_version != header->version) return false;
+    if (mapped_dungeon_byte_order != header->byte_order) return false;
+    if (sizeof(struct mapped_dungeon_header) != header->header_size) return false;
+    if (sizeof(struct mapped_dungeon_level) != header->level_size) return false;
+    if (sizeof(struct tile) != header->tile_size) return false;
+    if (sizeof(struct area) != header->area_size) return false;
+    if (mapped_dungeon->size != header->file_size) return false;
+    if (header->levels_count < 0) return false;
+    if (INT_MIN == header->starting_level) return false;
+    if ((int64_t)header->starting_level + header->levels_count > INT_MAX) return false;
+    if (header->areas_count > INT_MAX) return false;
+    if (!is_section_valid(mapped_dungeon, header->areas_offset, header->areas_count, sizeof(struct area))) {
+        return false;
+    }
+    if (!is_section_valid(mapped_dungeon, header->header_size, header->levels_count, header->level_size)) {
+        return false;
+    }
+
+    struct frozen_dungeon *frozen_dungeon = &mapped_dungeon->frozen_dungeon;
+    frozen_dungeon->starting_level = header->starting_level;
+    frozen_dungeon->areas = (struct area *)(bytes + header->areas_offset);
+    frozen_dungeon->areas_count = (int)header->areas_count;
+    frozen_dungeon->levels = calloc_or_die(max(1, header->levels_count),
+                                           sizeof(struct frozen_level));
+    frozen_dungeon->levels_count = header->levels_count;
+
+    struct mapped_dungeon_level const *levels = (struct mapped_dungeon_level const *)(bytes + header->header_size);
+    for (int i = 0; i < header->levels_count; ++i) {
+        struct mapped_dungeon_level const *mapped_level = &levels[i];
+        struct box box = box_make(point_make(mapped_level->x, mapped_level->y, mapped_level->z),
+                                  size_make(mapped_level->width, mapped_level->length, mapped_level->height));
+        if (header->starting_level + i != mapped_level->z) return false;
+        if (!is_box_valid(box) || 1 != mapped_level->height) return false;
+        uint64_t volume = (uint64_t)mapped_level->width * (uint64_t)mapped_level->length;
+        if (volume > INT_MAX) return false;
+        if (!is_section_valid(mapped_dungeon, mapped_level->tiles_offset, volume, sizeof(struct tile))) {
+            return false;
+        }
+        if (mapped_level->areas_count > header->areas_count) return false;
+        if (mapped_level->first_area > header->areas_count - mapped_level->areas_count) return false;
+
+        struct frozen_level *level = &frozen_dungeon->levels[i];
+        level->box = box;
+        level->tiles = (struct tile *)(bytes + mapped_level->tiles_offset);
+        level->areas = &frozen_dungeon->areas[mapped_level->first_area];
+        level->areas_count = (int)mapped_level->areas_count;
+        for (int j = 0; j < level->areas_count; ++j) {
+            if (!is_area_valid(&level->areas[j], level->box)) return false;
+        }
+    }
+    return true;
+}
+
+
+static bool
+write_level_tiles(FILE *out,
+                  uint64_t *position,
+                  struct mapped_dungeon_level const *mapped_level,
+                  struct frozen_level const *level)
+{
+    if (level->tiles) {
+        return write_section(out, position, mapped_level->tiles_offset, level->tiles,
+                             box_volume(level->box) * sizeof(struct tile));
+    }
+
+    // compressed levels are written a row at a time
+    size_t row_size = level->box.size.width * sizeof(struct tile);
+    struct tile *row = calloc_or_die(max(1, level->box.size.width), sizeof(struct tile));
+    bool is_written = true;
+    for (int j = 0; is_written && j < level->box.size.length; ++j) {
+        frozen_level_copy_row(level, level->box.origin.y + j, row);
+        is_written = write_section(out, position, mapped_level->tiles_offset + j * row_size,
+                                   row, row_size);
+    }
+    free_or_die(row);
+    return is_written;
+}
+
+
+static bool
+write_section(FILE *out,
+              uint64_t *position,
+              uint64_t offset,
+              void const *bytes,
+              size_t size)
+{
+    static uint8_t const padding[8];
+    size_t padding_size = (size_t)(offset - *position);
+    if (padding_size && 1 != fwrite(padding, padding_size, 1, out)) return false;
+    if (size && 1 != fwrite(bytes, size, 1, out)) return false;
+    *position = offset + size;
+    return true;
+}
+
+
+void
+mapped_dungeon_close(struct mapped_dungeon *mapped_dungeon)
+{
+    if (mapped_dungeon) {
+        free_or_die(mapped_dungeon->frozen_dungeon.levels);
+        munmap(mapped_dungeon->bytes, mapped_dungeon->size);
+        free_or_die(mapped_dungeon);
+    }
+}
+
+
+struct result
+mapped_dungeon_open(char const *path, struct mapped_dungeon **mapped_dungeon_out)
+{
+    *mapped_dungeon_out = NULL;
+    int fd = open(path, O_RDONLY);
+    if (-1 == fd) return result_system_error();
+
+    struct stat status;
+    if (-1 == fstat(fd, &status)) {
+        struct result result = result_system_error();
+        close(fd);
+        return result;
+    }
+    if (status.st_size < (off_t)sizeof(struct mapped_dungeon_header)
+        || (uintmax_t)status.st_size > SIZE_MAX)
+    {
+        close(fd);
+        return result_set_system_error(EINVAL);
+    }
+
+    size_t size = (size_t)status.st_size;
+    void *bytes = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED == bytes) {
+        struct result result = result_system_error();
+        close(fd);
+        return result;
+    }
+    close(fd);
+
+    struct mapped_dungeon *mapped_dungeon = calloc_or_die(1, sizeof(struct mapped_dungeon));
+    mapped_dungeon->bytes = bytes;
+    mapped_dungeon->size = size;
+    if (!map_levels(mapped_dungeon)) {
+        mapped_dungeon_close(mapped_dungeon);
+        return result_set_system_error(EINVAL);
+    }
+    *mapped_dungeon_out = mapped_dungeon;
+    return result_success();
+}
+
+
+struct result
+mapped_dungeon_save(struct frozen_dungeon const *frozen_dungeon,
+                    char const *path)
+{
+    struct mapped_dungeon_header header = {
+        .version=mapped_dungeon_version,
+        .byte_order=mapped_dungeon_byte_order,
+        .header_size=sizeof(struct mapped_dungeon_header),
+        .level_size=sizeof(struct mapped_dungeon_level),
+        .tile_size=sizeof(struct tile),
+        .area_size=sizeof(struct area),
+        .starting_level=frozen_dungeon->starting_level,
+        .levels_count=frozen_dungeon->levels_count,
+        .areas_count=(uint64_t)frozen_dungeon->areas_count,
+    };
+    memcpy(header.magic, magic, sizeof magic);
+
+    struct mapped_dungeon_level *levels = calloc_or_die(max(1, frozen_dungeon->levels_count),
+                                                        sizeof(struct mapped_dungeon_level));
+    uint64_t offset = align_offset(header.header_size
+                                   + (uint64_t)header.levels_count * header.level_size);
+    for (int i = 0; i < frozen_dungeon->levels_count; ++i) {
+        struct frozen_level const *level = &frozen_dungeon->levels[i];
+        levels[i] = (struct mapped_dungeon_level){
+            .x=level->box.origin.x,
+            .y=level->box.origin.y,
+            .z=level->box.origin.z,
+            .width=level->box.size.width,
+            .length=level->box.size.length,
+            .height=level->box.size.height,
+            .tiles_offset=offset,
+            .first_area=(uint64_t)(level->areas - frozen_dungeon->areas),
+            .areas_count=(uint64_t)level->areas_count,
+        };
+        offset = align_offset(offset + (uint64_t)box_volume(level->box) * sizeof(struct tile));
+    }
+    header.areas_offset = offset;
+    header.file_size = offset + header.areas_count * sizeof(struct area);
+
+    FILE *out = fopen(path, "wb");
+    if (!out) {
+        free_or_die(levels);
+        return result_system_error();
+    }
+
+    uint64_t position = 0;
+    bool is_written = write_section(out, &position, 0, &header, sizeof header)
+                   && write_section(out, &position, position, levels,
+                                    (size_t)header.levels_count * sizeof(struct mapped_dungeon_level));
+    for (int i = 0; is_written && i < frozen_dungeon->levels_count; ++i) {
+        is_written = write_level_tiles(out, &position, &levels[i], &frozen_dungeon->levels[i]);
+    }
+    if (is_written) {
+        is_written = write_section(out, &position, header.areas_offset, frozen_dungeon->areas,
+                                   (size_t)header.areas_count * sizeof(struct area));
+    }
+
+    struct result result = is_written ? result_success() : result_system_error();
+    if (EOF == fclose(out) && is_written) result = result_system_error();
+    if (!result_is_success(result)) remove(path);
+    free_or_die(levels);
+    return result;
+}
@@ -0,0 +1,81 @@
+#ifndef FNF_DUNGEON_MAPPED_DUNGEON_H_INCLUDED
+#define FNF_DUNGEON_MAPPED_DUNGEON_H_INCLUDED
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <base/result.h>
+
+#include <dungeon/frozen_dungeon.h>
+
+
+enum {
+    mapped_dungeon_version = 1,
+    mapped_dungeon_byte_order = 0x01020304,
+};
+
+
+// The file starts with this header, followed by `levels_count' level
+// records and then the tiles of each level and the areas of the whole
+// dungeon, each section aligned to 8 bytes.  Offsets are from the start
+// of the file.  Tiles and areas are stored in the in-memory layout of this
+// build, so `byte_order' and the record sizes are checked on open and
+// files written on another platform are rejected.
+struct mapped_dungeon_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t header_size;
+    uint32_t level_size;
+    uint32_t tile_size;
+    uint32_t area_size;
+    int32_t starting_level;
+    int32_t levels_count;
+    uint64_t areas_count;
+    uint64_t areas_offset;
+    uint64_t file_size;
+};
+
+
+// The tiles of the level are `tiles_offset' and on in row order for `box';
+// its areas are `first_area' and the next `areas_count' area records.
+struct mapped_dungeon_level {
+    int32_t x;
+    int32_t y;
+    int32_t z;
+    int32_t width;
+    int32_t length;
+    int32_t height;
+    uint64_t tiles_offset;
+    uint64_t first_area;
+    uint64_t areas_count;
+};
+
+
+// A dungeon file mapped read only into memory.  `frozen_dungeon' points
+// into the mapping, so any level can be read or drawn with level_map and
+// the frozen_dungeon functions while only the pages it touches are read
+// from disk.  Don't free `frozen_dungeon'; close the mapped dungeon instead.
+struct mapped_dungeon {
+    void *bytes;
+    size_t size;
+    struct frozen_dungeon frozen_dungeon;
+};
+
+
+// Opening reads the header, the level records and the area records but no
+// tiles, so it takes the same time however many tiles the file holds.
+// Returns EINVAL for files that aren't dungeon files, were written by
+// another platform or hold levels or areas that are out of range.
+struct result
+mapped_dungeon_open(char const *path, struct mapped_dungeon **mapped_dungeon_out);
+
+void
+mapped_dungeon_close(struct mapped_dungeon *mapped_dungeon);
+
+struct result
+mapped_dungeon_save(struct frozen_dungeon const *frozen_dungeon,
+                    char const *path);
+
+
+#endif
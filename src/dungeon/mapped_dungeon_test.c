@@ -0,0 +1,234 @@
+#include <assert.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <base/base.h>
+#include <dungeon/dungeon.h>
+#include "mapped_dungeon.h"
+#include "tile.h"
+
+
+void
+mapped_dungeon_test(void);
+
+
+static void
+make_temp_path(char *path, size_t size)
+{
+    snprintf(path, size, "%s/mapped_dungeon_test_XXXXXX", P_tmpdir);
+    int fd = mkstemp(path);
+    assert(-1 != fd);
+    close(fd);
+}
+
+
+static void
+patch_file(char const *path, long offset, void const *bytes, size_t size)
+{
+    FILE *file = fopen(path, "r+b");
+    assert(file);
+    int result = fseek(file, offset, SEEK_SET);
+    assert(0 == result);
+    size_t count = fwrite(bytes, size, 1, file);
+    assert(1 == count);
+    fclose(file);
+}
+
+
+static void
+read_header(char const *path, struct mapped_dungeon_header *header)
+{
+    FILE *file = fopen(path, "rb");
+    assert(file);
+    size_t count = fread(header, sizeof(struct mapped_dungeon_header), 1, file);
+    assert(1 == count);
+    fclose(file);
+}
+
+
+static void
+truncate_file(char const *path, long size)
+{
+    int result = truncate(path, size);
+    assert(0 == result);
+}
+
+
+static void
+mapped_dungeon_open_test(void)
+{
+    char path[256];
+    make_temp_path(path, sizeof path);
+
+    struct dungeon *dungeon = dungeon_alloc();
+    dungeon_generate_small(dungeon);
+    struct result result = dungeon_save(dungeon, path);
+    assert(result_is_success(result));
+
+    struct mapped_dungeon *mapped_dungeon;
+    result = dungeon_open_mapped(path, &mapped_dungeon);
+    assert(result_is_success(result));
+
+    struct frozen_dungeon *frozen_dungeon = dungeon_freeze(dungeon);
+    struct frozen_dungeon const *mapped = &mapped_dungeon->frozen_dungeon;
+    assert(frozen_dungeon->starting_level == mapped->starting_level);
+    assert(frozen_dungeon->levels_count == mapped->levels_count);
+    assert(frozen_dungeon->areas_count == mapped->areas_count);
+    assert(0 == memcmp(frozen_dungeon->areas,
+                       mapped->areas,
+                       frozen_dungeon->areas_count * sizeof(struct area)));
+    for (int i = 0; i < frozen_dungeon->levels_count; ++i) {
+        struct frozen_level const *level = &frozen_dungeon->levels[i];
+        struct frozen_level const *mapped_level = &mapped->levels[i];
+        assert(box_equals(level->box, mapped_level->box));
+        assert(0 == memcmp(level->tiles,
+                           mapped_level->tiles,
+                           box_volume(level->box) * sizeof(struct tile)));
+        assert(level->areas_count == mapped_level->areas_count);
+        assert(level->areas - frozen_dungeon->areas == mapped_level->areas - mapped->areas);
+    }
+
+    struct text_rectangle *map = dungeon_alloc_text_rectangle_for_level(dungeon, 1);
+    struct text_rectangle *mapped_map = frozen_dungeon_alloc_text_rectangle_for_level(mapped, 1);
+    assert(str_eq(map->chars, mapped_map->chars));
+
+    struct tile const *tile = frozen_dungeon_tile_at(mapped, point_make(0, 0, 1));
+    assert(tile);
+    assert(tile_type_stairs_up == tile_get_type(tile));
+
+    text_rectangle_free(map);
+    text_rectangle_free(mapped_map);
+    frozen_dungeon_free(frozen_dungeon);
+    mapped_dungeon_close(mapped_dungeon);
+    dungeon_free(dungeon);
+    remove(path);
+}
+
+
+static void
+mapped_dungeon_save_test(void)
+{
+    char path[256];
+    make_temp_path(path, sizeof path);
+    char compressed_path[256];
+    make_temp_path(compressed_path, sizeof compressed_path);
+
+    struct dungeon *dungeon = dungeon_alloc();
+    dungeon_generate_small(dungeon);
+    struct frozen_dungeon *frozen_dungeon = dungeon_freeze(dungeon);
+    struct frozen_dungeon *compressed = dungeon_freeze_compressed(dungeon);
+    struct result result = mapped_dungeon_save(frozen_dungeon, path);
+    assert(result_is_success(result));
+    result = mapped_dungeon_save(compressed, compressed_path);
+    assert(result_is_success(result));
+
+    struct mapped_dungeon *mapped_dungeon;
+    result = mapped_dungeon_open(path, &mapped_dungeon);
+    assert(result_is_success(result));
+    struct mapped_dungeon *compressed_mapped_dungeon;
+    result = mapped_dungeon_open(compressed_path, &compressed_mapped_dungeon);
+    assert(result_is_success(result));
+    assert(mapped_dungeon->size == compressed_mapped_dungeon->size);
+    assert(0 == memcmp(mapped_dungeon->bytes, compressed_mapped_dungeon->bytes, mapped_dungeon->size));
+
+    mapped_dungeon_close(mapped_dungeon);
+    mapped_dungeon_close(compressed_mapped_dungeon);
+    frozen_dungeon_free(frozen_dungeon);
+    frozen_dungeon_free(compressed);
+    dungeon_free(dungeon);
+    remove(path);
+    remove(compressed_path);
+}
+
+
+static void
+mapped_dungeon_open_for_invalid_file_test(void)
+{
+    char path[256];
+    make_temp_path(path, sizeof path);
+
+    struct mapped_dungeon *mapped_dungeon;
+    struct result result = dungeon_open_mapped(path, &mapped_dungeon);
+    assert(!result_is_success(result));
+    assert(EINVAL == result.error_code);
+    assert(!mapped_dungeon);
+
+    struct dungeon *dungeon = dungeon_alloc();
+    dungeon_generate_small(dungeon);
+    result = dungeon_save(dungeon, path);
+    assert(result_is_success(result));
+    truncate_file(path, sizeof(struct mapped_dungeon_header) + 8);
+
+    result = dungeon_open_mapped(path, &mapped_dungeon);
+    assert(!result_is_success(result));
+    assert(EINVAL == result.error_code);
+    assert(!mapped_dungeon);
+
+    result = dungeon_save(dungeon, path);
+    assert(result_is_success(result));
+    FILE *file = fopen(path, "r+b");
+    assert(file);
+    fputc('X', file);
+    fclose(file);
+
+    result = dungeon_open_mapped(path, &mapped_dungeon);
+    assert(!result_is_success(result));
+    assert(EINVAL == result.error_code);
+
+    // a level box whose end overflows
+    result = dungeon_save(dungeon, path);
+    assert(result_is_success(result));
+    int32_t x = INT32_MAX - 4;
+    patch_file(path, sizeof(struct mapped_dungeon_header) + offsetof(struct mapped_dungeon_level, x),
+               &x, sizeof x);
+    result = dungeon_open_mapped(path, &mapped_dungeon);
+    assert(!result_is_success(result));
+    assert(EINVAL == result.error_code);
+
+    // an area outside its level
+    result = dungeon_save(dungeon, path);
+    assert(result_is_success(result));
+    struct mapped_dungeon_header header;
+    read_header(path, &header);
+    struct area area = *dungeon->areas[0];
+    area.box.origin.x = -1000;
+    patch_file(path, (long)header.areas_offset, &area, sizeof area);
+    result = dungeon_open_mapped(path, &mapped_dungeon);
+    assert(!result_is_success(result));
+    assert(EINVAL == result.error_code);
+
+    // an area with an unknown type
+    area = *dungeon->areas[0];
+    area.type = (enum area_type)99;
+    patch_file(path, (long)header.areas_offset, &area, sizeof area);
+    result = dungeon_open_mapped(path, &mapped_dungeon);
+    assert(!result_is_success(result));
+    assert(EINVAL == result.error_code);
+
+    area = *dungeon->areas[0];
+    patch_file(path, (long)header.areas_offset, &area, sizeof area);
+    result = dungeon_open_mapped(path, &mapped_dungeon);
+    assert(result_is_success(result));
+    mapped_dungeon_close(mapped_dungeon);
+
+    remove(path);
+    result = dungeon_open_mapped(path, &mapped_dungeon);
+    assert(!result_is_success(result));
+    assert(ENOENT == result.error_code);
+
+    dungeon_free(dungeon);
+}
+
+
+void
+mapped_dungeon_test(void)
+{
+    mapped_dungeon_open_test();
+    mapped_dungeon_open_for_invalid_file_test();
+    mapped_dungeon_save_test();
+}
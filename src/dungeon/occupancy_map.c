@@ -0,0 +1,330 @@
+#include "occupancy_map.h"
+
+#include <assert.h>
+#include <base/base.h>
+
+#include "level_array.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+
+static int const min_grow_rows_count = 16;
+static int const min_grow_words_count = 1;
+
+
+// Bits [first, end) of a word, where 0 <= first < end <= 64.
+static inline uint64_t
+mask_for_bits(int first, int end)
+{
+    uint64_t high = (occupancy_word_bits == end) ? ~UINT64_C(0)
+                                                 : (UINT64_C(1) << end) - 1;
+    return high & (~UINT64_C(0) << first);
+}
+
+
+static inline int
+level_end_x(struct occupancy_level const *level)
+{
+    return level->origin_x + level->words_per_row * occupancy_word_bits;
+}
+
+
+static inline int
+level_end_y(struct occupancy_level const *level)
+{
+    return level->origin_y + level->rows_count;
+}
+
+
+static struct occupancy_level *
+find_level(struct occupancy_map const *occupancy_map, int z)
+{
+    int index = level_array_index(occupancy_map->levels_count, occupancy_map->min_level, z);
+    if (index < 0) return NULL;
+    struct occupancy_level *level = &occupancy_map->levels[index];
+    return level->words ? level : NULL;
+}
+
+
+static struct occupancy_level *
+include_level(struct occupancy_map *occupancy_map, int z)
+{
+    occupancy_map->levels = level_array_include(occupancy_map->levels,
+                                                &occupancy_map->levels_count,
+                                                &occupancy_map->min_level,
+                                                z,
+                                                sizeof(struct occupancy_level));
+    return &occupancy_map->levels[z - occupancy_map->min_level];
+}
+
+
+// Grows the level's bitmap to cover the rectangle from `origin' up to but not
+// including `end', with some slack in each direction it grows.
+static void
+include_rectangle(struct occupancy_level *level, struct point origin, struct point end)
+{
+    int origin_x = floor_to_multiple(origin.x, occupancy_word_bits);
+    int end_x = floor_to_multiple(end.x - 1, occupancy_word_bits) + occupancy_word_bits;
+    int origin_y = origin.y;
+    int end_y = end.y;
+
+    if (level->words) {
+        if (   origin_x >= level->origin_x && end_x <= level_end_x(level)
+            && origin_y >= level->origin_y && end_y <= level_end_y(level))
+        {
+            return;
+        }
+        int grow_words_count = max(min_grow_words_count, level->words_per_row / 2);
+        int grow_rows_count = max(min_grow_rows_count, level->rows_count / 2);
+        if (origin_x < level->origin_x) {
+            origin_x = min(origin_x, level->origin_x - grow_words_count * occupancy_word_bits);
+        } else {
+            origin_x = level->origin_x;
+        }
+        if (end_x > level_end_x(level)) {
+            end_x = max(end_x, level_end_x(level) + grow_words_count * occupancy_word_bits);
+        } else {
+            end_x = level_end_x(level);
+        }
+        if (origin_y < level->origin_y) {
+            origin_y = min(origin_y, level->origin_y - grow_rows_count);
+        } else {
+            origin_y = level->origin_y;
+        }
+        if (end_y > level_end_y(level)) {
+            end_y = max(end_y, level_end_y(level) + grow_rows_count);
+        } else {
+            end_y = level_end_y(level);
+        }
+    }
+
+    int words_per_row = (end_x - origin_x) / occupancy_word_bits;
+    int rows_count = end_y - origin_y;
+    uint64_t *words = calloc_or_die((size_t)words_per_row * rows_count,
+                                    sizeof(uint64_t));
+    if (level->words) {
+        int word_offset = (level->origin_x - origin_x) / occupancy_word_bits;
+        int row_offset = level->origin_y - origin_y;
+        for (int j = 0; j < level->rows_count; ++j) {
+            memcpy(&words[(j + row_offset) * words_per_row + word_offset],
+                   &level->words[j * level->words_per_row],
+                   level->words_per_row * sizeof(uint64_t));
+        }
+        free_or_die(level->words);
+    }
+    level->origin_x = origin_x;
+    level->origin_y = origin_y;
+    level->words_per_row = words_per_row;
+    level->rows_count = rows_count;
+    level->words = words;
+}
+
+
+// Returns true if any of bits [first, end) of `row' are set.
+static bool
+is_row_span_occupied(uint64_t const *row, int first, int end)
+{
+    int first_word = first / occupancy_word_bits;
+    int last_word = (end - 1) / occupancy_word_bits;
+    int first_bit = first % occupancy_word_bits;
+    int end_bit = (end - 1) % occupancy_word_bits + 1;
+    if (first_word == last_word) {
+        return row[first_word] & mask_for_bits(first_bit, end_bit);
+    }
+    if (row[first_word] & mask_for_bits(first_bit, occupancy_word_bits)) return true;
+    int i = first_word + 1;
+#if defined(__AVX2__)
+    for (; i + 4 <= last_word; i += 4) {
+        __m256i words = _mm256_loadu_si256((__m256i const *)&row[i]);
+        if (!_mm256_testz_si256(words, words)) return true;
+    }
+#endif
+    for (; i < last_word; ++i) {
+        if (row[i]) return true;
+    }
+    return row[last_word] & mask_for_bits(0, end_bit);
+}
+
+
+static void
+set_row_span(uint64_t *row, int first, int end, bool occupied)
+{
+    int first_word = first / occupancy_word_bits;
+    int last_word = (end - 1) / occupancy_word_bits;
+    int first_bit = first % occupancy_word_bits;
+    int end_bit = (end - 1) % occupancy_word_bits + 1;
+    for (int i = first_word; i <= last_word; ++i) {
+        uint64_t mask = mask_for_bits(i == first_word ? first_bit : 0,
+                                      i == last_word ? end_bit : occupancy_word_bits);
+        if (occupied) {
+            row[i] |= mask;
+        } else {
+            row[i] &= ~mask;
+        }
+    }
+}
+
+
+struct occupancy_map *
+occupancy_map_alloc(void)
+{
+    return calloc_or_die(1, sizeof(struct occupancy_map));
+}
+
+
+void
+occupancy_map_clear(struct occupancy_map *occupancy_map)
+{
+    for (int i = 0; i < occupancy_map->levels_count; ++i) {
+        struct occupancy_level *level = &occupancy_map->levels[i];
+        if (level->words) {
+            memset(level->words, 0,
+                   (size_t)level->words_per_row * level->rows_count * sizeof(uint64_t));
+        }
+    }
+}
+
+
+uint64_t
+occupancy_map_column_bits(struct occupancy_map const *occupancy_map,
+                          struct point point,
+                          int count)
+{
+    assert(count >= 0 && count <= occupancy_word_bits);
+    struct occupancy_level const *level = find_level(occupancy_map, point.z);
+    if (!level) return 0;
+    if (point.x < level->origin_x || point.x >= level_end_x(level)) return 0;
+
+    int word_index = (point.x - level->origin_x) / occupancy_word_bits;
+    int bit = (point.x - level->origin_x) % occupancy_word_bits;
+    int first_y = max(point.y, level->origin_y);
+    int end_y = min(point.y + count, level_end_y(level));
+    uint64_t bits = 0;
+    for (int y = first_y; y < end_y; ++y) {
+        uint64_t word = level->words[(y - level->origin_y) * level->words_per_row + word_index];
+        bits |= ((word >> bit) & 1) << (y - point.y);
+    }
+    return bits;
+}
+
+
+void
+occupancy_map_free(struct occupancy_map *occupancy_map)
+{
+    if (occupancy_map) {
+        for (int i = 0; i < occupancy_map->levels_count; ++i) {
+            free_or_die(occupancy_map->levels[i].words);
+        }
+        free_or_die(occupancy_map->levels);
+        free_or_die(occupancy_map);
+    }
+}
+
+
+bool
+occupancy_map_is_box_occupied(struct occupancy_map const *occupancy_map,
+                              struct box box)
+{
+    struct point end = box_end_point(box);
+    for (int z = box.origin.z; z < end.z; ++z) {
+        struct occupancy_level const *level = find_level(occupancy_map, z);
+        if (!level) continue;
+
+        int first_x = max(box.origin.x, level->origin_x);
+        int end_x = min(end.x, level_end_x(level));
+        int first_y = max(box.origin.y, level->origin_y);
+        int end_y = min(end.y, level_end_y(level));
+        if (first_x >= end_x || first_y >= end_y) continue;
+
+        for (int y = first_y; y < end_y; ++y) {
+            uint64_t const *row = &level->words[(y - level->origin_y) * level->words_per_row];
+            if (is_row_span_occupied(row,
+                                     first_x - level->origin_x,
+                                     end_x - level->origin_x))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+bool
+occupancy_map_is_occupied(struct occupancy_map const *occupancy_map,
+                          struct point point)
+{
+    return occupancy_map_is_box_occupied(occupancy_map, box_make_unit(point));
+}
+
+
+uint64_t
+occupancy_map_row_bits(struct occupancy_map const *occupancy_map,
+                       struct point point,
+                       int count)
+{
+    assert(count >= 0 && count <= occupancy_word_bits);
+    struct occupancy_level const *level = find_level(occupancy_map, point.z);
+    if (!level || !count) return 0;
+    if (point.y < level->origin_y || point.y >= level_end_y(level)) return 0;
+
+    int first_x = max(point.x, level->origin_x);
+    int end_x = min(point.x + count, level_end_x(level));
+    if (first_x >= end_x) return 0;
+
+    // the run spans at most two words
+    uint64_t const *row = &level->words[(point.y - level->origin_y) * level->words_per_row];
+    int word_index = (first_x - level->origin_x) / occupancy_word_bits;
+    int bit = (first_x - level->origin_x) % occupancy_word_bits;
+    uint64_t bits = row[word_index] >> bit;
+    if (bit && word_index + 1 < level->words_per_row) {
+        bits |= row[word_index + 1] << (occupancy_word_bits - bit);
+    }
+    int read_count = end_x - first_x;
+    if (read_count < occupancy_word_bits) {
+        bits &= (UINT64_C(1) << read_count) - 1;
+    }
+    return bits << (first_x - point.x);
+}
+
+
+void
+occupancy_map_set(struct occupancy_map *occupancy_map,
+                  struct point point,
+                  bool occupied)
+{
+    occupancy_map_set_box(occupancy_map, box_make_unit(point), occupied);
+}
+
+
+void
+occupancy_map_set_box(struct occupancy_map *occupancy_map,
+                      struct box box,
+                      bool occupied)
+{
+    if (!box_volume(box)) return;
+    struct point end = box_end_point(box);
+    for (int z = box.origin.z; z < end.z; ++z) {
+        struct occupancy_level *level;
+        if (occupied) {
+            level = include_level(occupancy_map, z);
+            include_rectangle(level, box.origin, end);
+        } else {
+            level = find_level(occupancy_map, z);
+            if (!level) continue;
+        }
+
+        int first_x = max(box.origin.x, level->origin_x);
+        int end_x = min(end.x, level_end_x(level));
+        int first_y = max(box.origin.y, level->origin_y);
+        int end_y = min(end.y, level_end_y(level));
+        if (first_x >= end_x || first_y >= end_y) continue;
+
+        for (int y = first_y; y < end_y; ++y) {
+            uint64_t *row = &level->words[(y - level->origin_y) * level->words_per_row];
+            set_row_span(row, first_x - level->origin_x, end_x - level->origin_x, occupied);
+        }
+    }
+}
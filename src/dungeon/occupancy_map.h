@@ -0,0 +1,83 @@
+#ifndef FNF_DUNGEON_OCCUPANCY_MAP_H_INCLUDED
+#define FNF_DUNGEON_OCCUPANCY_MAP_H_INCLUDED
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <dungeon/box.h>
+#include <dungeon/point.h>
+
+
+enum {
+    occupancy_word_bits = 64,
+};
+
+
+// A bit per tile for a rectangle of a single level, stored row by row.
+// `origin_x' is always a multiple of the word size so that a tile's bit
+// position within its word doesn't change as the rectangle grows.
+struct occupancy_level {
+    int origin_x;
+    int origin_y;
+    int words_per_row;
+    int rows_count;
+    uint64_t *words;
+};
+
+
+// A set of occupied points, one bitmap per level.  Each level's bitmap grows
+// to include points as they're marked occupied; points outside it are
+// unoccupied.  `levels[i]' holds the bitmap for level `min_level + i'.
+struct occupancy_map {
+    struct occupancy_level *levels;
+    int levels_count;
+    int min_level;
+};
+
+
+struct occupancy_map *
+occupancy_map_alloc(void);
+
+void
+occupancy_map_free(struct occupancy_map *occupancy_map);
+
+void
+occupancy_map_clear(struct occupancy_map *occupancy_map);
+
+// Returns true if any point in `box' is occupied.  Tests up to a word of
+// points per row at a time.
+bool
+occupancy_map_is_box_occupied(struct occupancy_map const *occupancy_map,
+                              struct box box);
+
+// Returns a bit mask with bit `i' set if the point `i' tiles north of
+// `point' is occupied, for `count' <= 64 points.
+uint64_t
+occupancy_map_column_bits(struct occupancy_map const *occupancy_map,
+                          struct point point,
+                          int count);
+
+bool
+occupancy_map_is_occupied(struct occupancy_map const *occupancy_map,
+                          struct point point);
+
+// Returns a bit mask with bit `i' set if the point `i' tiles east of
+// `point' is occupied, for `count' <= 64 points.
+uint64_t
+occupancy_map_row_bits(struct occupancy_map const *occupancy_map,
+                       struct point point,
+                       int count);
+
+void
+occupancy_map_set(struct occupancy_map *occupancy_map,
+                  struct point point,
+                  bool occupied);
+
+void
+occupancy_map_set_box(struct occupancy_map *occupancy_map,
+                      struct box box,
+                      bool occupied);
+
+
+#endif
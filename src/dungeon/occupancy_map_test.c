@@ -0,0 +1,119 @@
+#include <assert.h>
+#include <base/base.h>
+#include "occupancy_map.h"
+
+
+void
+occupancy_map_test(void);
+
+
+static void
+occupancy_map_alloc_test(void)
+{
+    struct occupancy_map *occupancy_map = occupancy_map_alloc();
+
+    assert(0 == occupancy_map->levels_count);
+    assert(!occupancy_map_is_occupied(occupancy_map, point_make(0, 0, 1)));
+    struct box box = box_make(point_make(-100, -100, -5), size_make(200, 200, 10));
+    assert(!occupancy_map_is_box_occupied(occupancy_map, box));
+
+    occupancy_map_free(occupancy_map);
+}
+
+
+static void
+occupancy_map_set_test(void)
+{
+    struct occupancy_map *occupancy_map = occupancy_map_alloc();
+
+    occupancy_map_set(occupancy_map, point_make(3, 4, 1), true);
+    assert(occupancy_map_is_occupied(occupancy_map, point_make(3, 4, 1)));
+    assert(!occupancy_map_is_occupied(occupancy_map, point_make(4, 4, 1)));
+    assert(!occupancy_map_is_occupied(occupancy_map, point_make(3, 5, 1)));
+    assert(!occupancy_map_is_occupied(occupancy_map, point_make(3, 4, 2)));
+    assert(0 == occupancy_map->levels[0].origin_x % occupancy_word_bits);
+
+    occupancy_map_set(occupancy_map, point_make(-70, -40, 1), true);
+    occupancy_map_set(occupancy_map, point_make(200, 90, 1), true);
+    occupancy_map_set(occupancy_map, point_make(0, 0, -2), true);
+    assert(-2 == occupancy_map->min_level);
+    assert(4 == occupancy_map->levels_count);
+    assert(occupancy_map_is_occupied(occupancy_map, point_make(3, 4, 1)));
+    assert(occupancy_map_is_occupied(occupancy_map, point_make(-70, -40, 1)));
+    assert(occupancy_map_is_occupied(occupancy_map, point_make(200, 90, 1)));
+    assert(occupancy_map_is_occupied(occupancy_map, point_make(0, 0, -2)));
+    assert(!occupancy_map_is_occupied(occupancy_map, point_make(0, 0, 0)));
+
+    occupancy_map_set(occupancy_map, point_make(3, 4, 1), false);
+    assert(!occupancy_map_is_occupied(occupancy_map, point_make(3, 4, 1)));
+    occupancy_map_set(occupancy_map, point_make(1000, 1000, 9), false);
+    assert(4 == occupancy_map->levels_count);
+
+    occupancy_map_free(occupancy_map);
+}
+
+
+static void
+occupancy_map_is_box_occupied_test(void)
+{
+    struct occupancy_map *occupancy_map = occupancy_map_alloc();
+
+    occupancy_map_set(occupancy_map, point_make(63, 10, 1), true);
+    assert(occupancy_map_is_box_occupied(occupancy_map, box_make(point_make(0, 0, 1), size_make(64, 11, 1))));
+    assert(occupancy_map_is_box_occupied(occupancy_map, box_make(point_make(63, 10, 1), size_make(1, 1, 1))));
+    assert(occupancy_map_is_box_occupied(occupancy_map, box_make(point_make(60, 8, 0), size_make(10, 5, 3))));
+    assert(!occupancy_map_is_box_occupied(occupancy_map, box_make(point_make(0, 0, 1), size_make(63, 20, 1))));
+    assert(!occupancy_map_is_box_occupied(occupancy_map, box_make(point_make(64, 0, 1), size_make(300, 20, 1))));
+    assert(!occupancy_map_is_box_occupied(occupancy_map, box_make(point_make(0, 11, 1), size_make(300, 20, 1))));
+    assert(!occupancy_map_is_box_occupied(occupancy_map, box_make(point_make(60, 8, 2), size_make(10, 5, 3))));
+
+    occupancy_map_set(occupancy_map, point_make(-1, 10, 1), true);
+    assert(occupancy_map_is_box_occupied(occupancy_map, box_make(point_make(-1, 10, 1), size_make(1, 1, 1))));
+    assert(!occupancy_map_is_box_occupied(occupancy_map, box_make(point_make(0, 10, 1), size_make(63, 1, 1))));
+
+    occupancy_map_set(occupancy_map, point_make(250, 10, 1), true);
+    assert(occupancy_map_is_box_occupied(occupancy_map, box_make(point_make(0, 10, 1), size_make(400, 1, 1))));
+    assert(!occupancy_map_is_box_occupied(occupancy_map, box_make(point_make(64, 10, 1), size_make(186, 1, 1))));
+
+    occupancy_map_free(occupancy_map);
+}
+
+
+static void
+occupancy_map_set_box_test(void)
+{
+    struct occupancy_map *occupancy_map = occupancy_map_alloc();
+
+    struct box box = box_make(point_make(-10, 5, 2), size_make(150, 3, 2));
+    occupancy_map_set_box(occupancy_map, box, true);
+    for (int z = 1; z <= 4; ++z) {
+        for (int y = 3; y < 10; ++y) {
+            for (int x = -80; x < 200; ++x) {
+                struct point point = point_make(x, y, z);
+                assert(box_contains_point(box, point) == occupancy_map_is_occupied(occupancy_map, point));
+            }
+        }
+    }
+
+    struct box hole = box_make(point_make(0, 6, 3), size_make(100, 1, 1));
+    occupancy_map_set_box(occupancy_map, hole, false);
+    assert(!occupancy_map_is_box_occupied(occupancy_map, hole));
+    assert(occupancy_map_is_occupied(occupancy_map, point_make(-1, 6, 3)));
+    assert(occupancy_map_is_occupied(occupancy_map, point_make(100, 6, 3)));
+    assert(occupancy_map_is_occupied(occupancy_map, point_make(50, 6, 2)));
+
+    occupancy_map_clear(occupancy_map);
+    assert(!occupancy_map_is_box_occupied(occupancy_map, box));
+
+    occupancy_map_free(occupancy_map);
+}
+
+
+void
+occupancy_map_test(void)
+{
+    occupancy_map_alloc_test();
+    occupancy_map_set_test();
+    occupancy_map_is_box_occupied_test();
+    occupancy_map_set_box_test();
+}
@@ -210,7 +210,7 @@ check_for_chute_down_one_level(struct digger *digger, struct area *area)
         struct digger *chute_digger = generator_copy_digger(digger->generator, digger);
         digger_move_backward(chute_digger, 1);
         struct tile *tile = generator_tile_at(chute_digger->generator, chute_digger->point);
-        tile->features |= tile_features_chute_entrance;
+        tile_add_features(tile, tile_features_chute_entrance);
         digger_descend(chute_digger, 1);
         // TODO: random direction?
         // TODO: random passage/room/chamber?
@@ -220,7 +220,7 @@ check_for_chute_down_one_level(struct digger *digger, struct area *area)
             passage->features |= area_features_chute_exit;
             digger_move_backward(chute_digger, 1);
             tile = generator_tile_at(chute_digger->generator, chute_digger->point);
-            tile->features |= tile_features_chute_exit;
+            tile_add_features(tile, tile_features_chute_exit);
             digger_move_forward(chute_digger, 1);
         } else {
             generator_delete_digger(chute_digger->generator, chute_digger);
@@ -239,16 +239,16 @@ check_wall_for_secret_door(struct generator *generator,
                                                   point_move(point, 1, direction));
     switch (direction) {
         case direction_north:
-            if (wall_type_solid != outside_tile->walls.south) return;
+            if (wall_type_solid != tile_get_south_wall(outside_tile)) return;
             break;
         case direction_south:
-            if (wall_type_solid != inside_tile->walls.south) return;
+            if (wall_type_solid != tile_get_south_wall(inside_tile)) return;
             break;
         case direction_east:
-            if (wall_type_solid != outside_tile->walls.west) return;
+            if (wall_type_solid != tile_get_west_wall(outside_tile)) return;
             break;
         case direction_west:
-            if (wall_type_solid != inside_tile->walls.west) return;
+            if (wall_type_solid != tile_get_west_wall(inside_tile)) return;
             break;
         default:
             fail("Unrecognized direction %i", direction);
@@ -257,9 +257,9 @@ check_wall_for_secret_door(struct generator *generator,
     
     int score = roll("1d4", generator->rnd);
     if (score == 1) {
-        if (tile_type_empty == outside_tile->type) {
+        if (tile_type_empty == tile_get_type(outside_tile)) {
             generator_set_wall(generator,
-                               inside_tile->point,
+                               point,
                                direction,
                                wall_type_secret_door);
         } else {
@@ -284,7 +284,7 @@ chimney_down_two_levels(struct digger *digger)
     passage->features |= area_features_chimney_down;
     digger_move_backward(digger, 1);
     struct tile *tile = generator_tile_at(digger->generator, digger->point);
-    tile->features |= tile_features_chimney_down;
+    tile_add_features(tile, tile_features_chimney_down);
     struct digger *digger_down_1 = generator_copy_digger(digger->generator, digger);
     digger_move_forward(digger, 1);
     
@@ -297,14 +297,14 @@ chimney_down_two_levels(struct digger *digger)
     passage->features |= area_features_chimney_up;
     digger_move_backward(digger_down_1, 1);
     tile = generator_tile_at(digger_down_1->generator, digger_down_1->point);
-    tile->features |= tile_features_chimney_up;
+    tile_add_features(tile, tile_features_chimney_up);
     if (digger_down_1->point.z == generator_max_level(digger_down_1->generator)) {
         digger_move_forward(digger_down_1, 1);
         return true;
     }
     
     passage->features |= area_features_chimney_down;
-    tile->features |= tile_features_chimney_down;
+    tile_add_features(tile, tile_features_chimney_down);
     
     struct digger *digger_down_2 = generator_copy_digger(digger_down_1->generator, digger_down_1);
     digger_move_forward(digger_down_1, 1);
@@ -318,7 +318,7 @@ chimney_down_two_levels(struct digger *digger)
     passage->features |= area_features_chimney_up;
     digger_move_backward(digger_down_2, 1);
     tile = generator_tile_at(digger_down_2->generator, digger_down_2->point);
-    tile->features |= tile_features_chimney_up;
+    tile_add_features(tile, tile_features_chimney_up);
     digger_move_forward(digger_down_2, 1);
     
     return true;
@@ -333,7 +333,7 @@ chimney_up_one_level(struct digger *digger)
     passage->features |= area_features_chimney_up;
     digger_move_backward(digger, 1);
     struct tile *tile = generator_tile_at(digger->generator, digger->point);
-    tile->features |= tile_features_chimney_up;
+    tile_add_features(tile, tile_features_chimney_up);
     struct digger *upper_digger = generator_copy_digger(digger->generator, digger);
     digger_move_forward(digger, 1);
         
@@ -351,7 +351,7 @@ chimney_up_one_level(struct digger *digger)
     passage->features |= area_features_chimney_down;
     digger_move_backward(upper_digger, 1);
     tile = generator_tile_at(upper_digger->generator, upper_digger->point);
-    tile->features |= tile_features_chimney_down;
+    tile_add_features(tile, tile_features_chimney_down);
     digger_move_forward(upper_digger, 1);
     
     return true;
@@ -366,7 +366,7 @@ chimney_up_two_levels(struct digger *digger)
     passage->features |= area_features_chimney_up;
     digger_move_backward(digger, 1);
     struct tile *tile = generator_tile_at(digger->generator, digger->point);
-    tile->features |= tile_features_chimney_up;
+    tile_add_features(tile, tile_features_chimney_up);
     struct digger *digger_up_1 = generator_copy_digger(digger->generator, digger);
     digger_move_forward(digger, 1);
     
@@ -384,7 +384,7 @@ chimney_up_two_levels(struct digger *digger)
     passage->features |= area_features_chimney_down | area_features_chimney_up;
     digger_move_backward(digger_up_1, 1);
     tile = generator_tile_at(digger_up_1->generator, digger_up_1->point);
-    tile->features |= tile_features_chimney_down | tile_features_chimney_up;
+    tile_add_features(tile, tile_features_chimney_down | tile_features_chimney_up);
     struct digger *digger_up_2 = generator_copy_digger(digger_up_1->generator, digger_up_1);
     digger_move_forward(digger_up_1, 1);
     
@@ -402,7 +402,7 @@ chimney_up_two_levels(struct digger *digger)
     passage->features |= area_features_chimney_up;
     digger_move_backward(digger_up_2, 1);
     tile = generator_tile_at(digger_up_2->generator, digger_up_2->point);
-    tile->features |= tile_features_chimney_down;
+    tile_add_features(tile, tile_features_chimney_down);
     digger_move_forward(digger_up_2, 1);
     
     return true;
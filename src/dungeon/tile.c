@@ -4,44 +4,54 @@
 #include <base/base.h>
 
 
-static int
-compare_point_to_tile(void const *key, void const *object)
-{
-    struct point const *point = key;
-    struct tile *const *tile = object;
-    return point_compare(*point, (*tile)->point);
-}
+extern inline enum direction
+tile_get_direction(struct tile const *tile);
 
+extern inline enum tile_features
+tile_get_features(struct tile const *tile);
 
-static int
-compare_by_point(void const *object, void const *other_object)
-{
-    struct tile *const *tile = object;
-    struct tile *const *other = other_object;
-    return point_compare((*tile)->point, (*other)->point);
-}
+extern inline enum wall_type
+tile_get_south_wall(struct tile const *tile);
 
+extern inline enum tile_type
+tile_get_type(struct tile const *tile);
 
-struct tile **
-tile_add_to_array_sorted_by_point(struct tile **tiles,
-                                  int *count,
-                                  struct tile *tile)
-{
-    int index = *count;
-    ++*count;
-    tiles = reallocarray_or_die(tiles, *count, sizeof(struct tile *));
-    tiles[index] = tile;
-    tile_sort_array_by_point(tiles, *count);
-    return tiles;
-}
+extern inline enum wall_type
+tile_get_west_wall(struct tile const *tile);
+
+extern inline void
+tile_set_bits(struct tile *tile, unsigned mask, unsigned shift, unsigned value);
+
+extern inline void
+tile_add_features(struct tile *tile, enum tile_features features);
+
+extern inline void
+tile_set_direction(struct tile *tile, enum direction direction);
+
+extern inline void
+tile_set_features(struct tile *tile, enum tile_features features);
+
+extern inline void
+tile_set_south_wall(struct tile *tile, enum wall_type wall_type);
+
+extern inline void
+tile_set_type(struct tile *tile, enum tile_type type);
+
+extern inline void
+tile_set_west_wall(struct tile *tile, enum wall_type wall_type);
+
+extern inline bool
+tile_is_escavated(struct tile const *tile);
+
+extern inline bool
+tile_is_unescavated(struct tile const *tile);
 
 
 struct tile *
-tile_alloc(struct point point, enum tile_type type)
+tile_alloc(enum tile_type type)
 {
     struct tile *tile = calloc_or_die(1, sizeof(struct tile));
-    tile->point = point;
-    tile->type = type;
+    tile_set_type(tile, type);
     return tile;
 }
 
@@ -58,22 +68,7 @@ tile_alloc_copy(struct tile *tile)
 bool
 tile_equals(struct tile const *tile, struct tile const *other)
 {
-    return tile->direction == other->direction
-        && tile->features == other->features
-        && point_equals(tile->point, other->point)
-        && tile->type == other->type
-        && tile->walls.south == other->walls.south
-        && tile->walls.west == other->walls.west;
-}
-
-
-struct tile **
-tile_find_in_array_sorted_by_point(struct tile **tiles,
-                                   int count,
-                                   struct point point)
-{
-    return bsearch(&point, tiles, count, sizeof(struct tile *),
-                   compare_point_to_tile);
+    return tile->bits == other->bits;
 }
 
 
@@ -87,64 +82,47 @@ tile_free(struct tile *tile)
 bool
 tile_has_south_exit(struct tile const *tile)
 {
-    return wall_type_none == tile->walls.south
-        || wall_type_door == tile->walls.south
-        || wall_type_secret_door == tile->walls.south;
+    enum wall_type south = tile_get_south_wall(tile);
+    return wall_type_none == south
+        || wall_type_door == south
+        || wall_type_secret_door == south;
 }
 
 
 bool
 tile_has_south_wall(struct tile const *tile)
 {
-    return wall_type_solid == tile->walls.south
-        || wall_type_door == tile->walls.south
-        || wall_type_secret_door == tile->walls.south;
+    enum wall_type south = tile_get_south_wall(tile);
+    return wall_type_solid == south
+        || wall_type_door == south
+        || wall_type_secret_door == south;
 }
 
 
 bool
 tile_has_west_exit(struct tile const *tile)
 {
-    return wall_type_none == tile->walls.west
-        || wall_type_door == tile->walls.west
-        || wall_type_secret_door == tile->walls.west;
+    enum wall_type west = tile_get_west_wall(tile);
+    return wall_type_none == west
+        || wall_type_door == west
+        || wall_type_secret_door == west;
 }
 
 
 bool
 tile_has_west_wall(struct tile const *tile)
 {
-    return wall_type_solid == tile->walls.west
-        || wall_type_door == tile->walls.west
-        || wall_type_secret_door == tile->walls.west;
+    enum wall_type west = tile_get_west_wall(tile);
+    return wall_type_solid == west
+        || wall_type_door == west
+        || wall_type_secret_door == west;
 }
 
 
 bool
 tile_is_blank(struct tile const *tile)
 {
-    return tile_type_filled == tile->type
-        && wall_type_none == tile->walls.south
-        && wall_type_none == tile->walls.west;
-}
-
-
-bool
-tile_is_escavated(struct tile const *tile)
-{
-    return tile_type_filled != tile->type;
-}
-
-
-bool
-tile_is_unescavated(struct tile const *tile)
-{
-    return tile_type_filled == tile->type;
-}
-
-
-void
-tile_sort_array_by_point(struct tile **tiles, int count)
-{
-    qsort(tiles, count, sizeof(struct tile *), compare_by_point);
+    return tile_type_filled == tile_get_type(tile)
+        && wall_type_none == tile_get_south_wall(tile)
+        && wall_type_none == tile_get_west_wall(tile);
 }
@@ -3,6 +3,7 @@
 
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <background/background.h>
 
 #include <dungeon/point.h>
@@ -11,20 +12,32 @@
 #include <dungeon/wall_type.h>
 
 
+// Bit positions and masks for the fields packed into `struct tile'.
+// Directions are stored in units of 45 degrees.
+enum {
+    tile_bits_type_shift = 0,
+    tile_bits_type_mask = 0x3 << tile_bits_type_shift,
+    tile_bits_direction_shift = 2,
+    tile_bits_direction_mask = 0x7 << tile_bits_direction_shift,
+    tile_bits_south_wall_shift = 5,
+    tile_bits_south_wall_mask = 0x3 << tile_bits_south_wall_shift,
+    tile_bits_west_wall_shift = 7,
+    tile_bits_west_wall_mask = 0x3 << tile_bits_west_wall_shift,
+    tile_bits_features_shift = 9,
+    tile_bits_features_mask = 0xf << tile_bits_features_shift,
+};
+
+
+// A tile packed into 16 bits.  All zero bits is a filled tile facing north
+// with no walls or features.  Tiles don't know their own location; a tile's
+// point comes from where it's stored.
 struct tile {
-    enum direction direction;
-    enum tile_features features;
-    struct point point;
-    enum tile_type type;
-    struct {
-        enum wall_type south;
-        enum wall_type west;
-    } walls;
+    uint16_t bits;
 };
 
 
 struct tile *
-tile_alloc(struct point point, enum tile_type type);
+tile_alloc(enum tile_type type);
 
 struct tile *
 tile_alloc_copy(struct tile *tile);
@@ -32,17 +45,95 @@ tile_alloc_copy(struct tile *tile);
 void
 tile_free(struct tile *tile);
 
+inline enum direction
+tile_get_direction(struct tile const *tile)
+{
+    return (enum direction)(45 * ((tile->bits & tile_bits_direction_mask) >> tile_bits_direction_shift));
+}
+
+inline enum tile_features
+tile_get_features(struct tile const *tile)
+{
+    return (enum tile_features)((tile->bits & tile_bits_features_mask) >> tile_bits_features_shift);
+}
+
+inline enum wall_type
+tile_get_south_wall(struct tile const *tile)
+{
+    return (enum wall_type)((tile->bits & tile_bits_south_wall_mask) >> tile_bits_south_wall_shift);
+}
+
+inline enum tile_type
+tile_get_type(struct tile const *tile)
+{
+    return (enum tile_type)((tile->bits & tile_bits_type_mask) >> tile_bits_type_shift);
+}
+
+inline enum wall_type
+tile_get_west_wall(struct tile const *tile)
+{
+    return (enum wall_type)((tile->bits & tile_bits_west_wall_mask) >> tile_bits_west_wall_shift);
+}
+
+inline void
+tile_set_bits(struct tile *tile, unsigned mask, unsigned shift, unsigned value)
+{
+    tile->bits = (uint16_t)((tile->bits & ~mask) | ((value << shift) & mask));
+}
+
+inline void
+tile_add_features(struct tile *tile, enum tile_features features)
+{
+    tile->bits |= (uint16_t)((features << tile_bits_features_shift) & tile_bits_features_mask);
+}
+
+inline void
+tile_set_direction(struct tile *tile, enum direction direction)
+{
+    tile_set_bits(tile, tile_bits_direction_mask, tile_bits_direction_shift, direction / 45);
+}
+
+inline void
+tile_set_features(struct tile *tile, enum tile_features features)
+{
+    tile_set_bits(tile, tile_bits_features_mask, tile_bits_features_shift, features);
+}
+
+inline void
+tile_set_south_wall(struct tile *tile, enum wall_type wall_type)
+{
+    tile_set_bits(tile, tile_bits_south_wall_mask, tile_bits_south_wall_shift, wall_type);
+}
+
+inline void
+tile_set_type(struct tile *tile, enum tile_type type)
+{
+    tile_set_bits(tile, tile_bits_type_mask, tile_bits_type_shift, type);
+}
+
+inline void
+tile_set_west_wall(struct tile *tile, enum wall_type wall_type)
+{
+    tile_set_bits(tile, tile_bits_west_wall_mask, tile_bits_west_wall_shift, wall_type);
+}
+
 bool
 tile_equals(struct tile const *tile, struct tile const *other);
 
 bool
 tile_is_blank(struct tile const *tile);
 
-bool
-tile_is_escavated(struct tile const *tile);
+inline bool
+tile_is_escavated(struct tile const *tile)
+{
+    return tile_type_filled != tile_get_type(tile);
+}
 
-bool
-tile_is_unescavated(struct tile const *tile);
+inline bool
+tile_is_unescavated(struct tile const *tile)
+{
+    return tile_type_filled == tile_get_type(tile);
+}
 
 bool
 tile_has_south_exit(struct tile const *tile);
@@ -56,18 +147,5 @@ tile_has_west_exit(struct tile const *tile);
 bool
 tile_has_west_wall(struct tile const *tile);
 
-struct tile **
-tile_add_to_array_sorted_by_point(struct tile **tiles,
-                                  int *count,
-                                  struct tile *tile);
-
-struct tile **
-tile_find_in_array_sorted_by_point(struct tile **tiles,
-                                   int count,
-                                   struct point point);
-
-void
-tile_sort_array_by_point(struct tile **tiles, int count);
-
 
 #endif
@@ -0,0 +1,172 @@
+#include "tile_grid.h"
+
+#include <stdint.h>
+#include <base/base.h>
+
+
+extern inline struct point
+tile_chunk_point_at(struct tile_chunk const *chunk, int index);
+
+
+static int const initial_chunks_capacity = 16;
+static int const initial_index_capacity = 32;
+
+
+static inline struct point
+chunk_origin_for_point(struct point point)
+{
+    return point_make(floor_to_multiple(point.x, tile_chunk_width),
+                      floor_to_multiple(point.y, tile_chunk_length),
+                      point.z);
+}
+
+
+static inline uint32_t
+hash_chunk_origin(struct point origin)
+{
+    uint32_t hash = (uint32_t)origin.x * 0x9e3779b1u
+                  ^ (uint32_t)origin.y * 0x85ebca77u
+                  ^ (uint32_t)origin.z * 0xc2b2ae3du;
+    return hash ^ (hash >> 15);
+}
+
+
+static inline int
+tile_index_in_chunk(struct tile_chunk const *chunk, struct point point)
+{
+    int i = point.x - chunk->origin.x;
+    int j = point.y - chunk->origin.y;
+    return j * tile_chunk_width + i;
+}
+
+
+static void
+insert_into_index(struct tile_chunk **index,
+                  int index_capacity,
+                  struct tile_chunk *chunk)
+{
+    uint32_t mask = (uint32_t)index_capacity - 1;
+    uint32_t slot = hash_chunk_origin(chunk->origin) & mask;
+    while (index[slot]) slot = (slot + 1) & mask;
+    index[slot] = chunk;
+}
+
+
+static void
+grow_index(struct tile_grid *tile_grid)
+{
+    int new_capacity = tile_grid->index_capacity * 2;
+    struct tile_chunk **new_index = calloc_or_die(new_capacity,
+                                                  sizeof(struct tile_chunk *));
+    for (int i = 0; i < tile_grid->chunks_count; ++i) {
+        insert_into_index(new_index, new_capacity, tile_grid->chunks[i]);
+    }
+    free_or_die(tile_grid->index);
+    tile_grid->index = new_index;
+    tile_grid->index_capacity = new_capacity;
+}
+
+
+static struct tile_chunk *
+add_chunk(struct tile_grid *tile_grid, struct point origin)
+{
+    struct tile_chunk *chunk = arena_calloc(tile_grid->arena, 1, sizeof(struct tile_chunk));
+    chunk->origin = origin;
+
+    if (tile_grid->chunks_count == tile_grid->chunks_capacity) {
+        tile_grid->chunks_capacity *= 2;
+        tile_grid->chunks = reallocarray_or_die(tile_grid->chunks,
+                                                tile_grid->chunks_capacity,
+                                                sizeof(struct tile_chunk *));
+    }
+    if ((tile_grid->chunks_count + 1) * 2 > tile_grid->index_capacity) {
+        grow_index(tile_grid);
+    }
+
+    tile_grid->chunks[tile_grid->chunks_count] = chunk;
+    ++tile_grid->chunks_count;
+    tile_grid->tiles_count += tile_chunk_tiles_count;
+    insert_into_index(tile_grid->index, tile_grid->index_capacity, chunk);
+    return chunk;
+}
+
+
+struct tile_grid *
+tile_grid_alloc(void)
+{
+    struct tile_grid *tile_grid = calloc_or_die(1, sizeof(struct tile_grid));
+    tile_grid->arena = arena_alloc();
+    tile_grid->chunks = calloc_or_die(initial_chunks_capacity,
+                                      sizeof(struct tile_chunk *));
+    tile_grid->chunks_capacity = initial_chunks_capacity;
+    tile_grid->index = calloc_or_die(initial_index_capacity,
+                                     sizeof(struct tile_chunk *));
+    tile_grid->index_capacity = initial_index_capacity;
+    return tile_grid;
+}
+
+
+struct tile_chunk *
+tile_grid_find_chunk(struct tile_grid const *tile_grid, struct point point)
+{
+    struct point origin = chunk_origin_for_point(point);
+    uint32_t mask = (uint32_t)tile_grid->index_capacity - 1;
+    uint32_t slot = hash_chunk_origin(origin) & mask;
+    while (tile_grid->index[slot]) {
+        struct tile_chunk *chunk = tile_grid->index[slot];
+        if (point_equals(origin, chunk->origin)) return chunk;
+        slot = (slot + 1) & mask;
+    }
+    return NULL;
+}
+
+
+struct tile *
+tile_grid_find_tile(struct tile_grid const *tile_grid, struct point point)
+{
+    struct tile_chunk *chunk = tile_grid_find_chunk(tile_grid, point);
+    if (!chunk) return NULL;
+    return &chunk->tiles[tile_index_in_chunk(chunk, point)];
+}
+
+
+struct tile *
+tile_grid_find_tile_run(struct tile_grid const *tile_grid,
+                        struct point point,
+                        int *count_out)
+{
+    *count_out = tile_chunk_width - (point.x - floor_to_multiple(point.x, tile_chunk_width));
+    return tile_grid_find_tile(tile_grid, point);
+}
+
+
+void
+tile_grid_free(struct tile_grid *tile_grid)
+{
+    if (tile_grid) {
+        arena_free(tile_grid->arena);
+        free_or_die(tile_grid->chunks);
+        free_or_die(tile_grid->index);
+        free_or_die(tile_grid);
+    }
+}
+
+
+struct tile *
+tile_grid_tile_at(struct tile_grid *tile_grid, struct point point)
+{
+    struct tile_chunk *chunk = tile_grid_find_chunk(tile_grid, point);
+    if (!chunk) chunk = add_chunk(tile_grid, chunk_origin_for_point(point));
+    return &chunk->tiles[tile_index_in_chunk(chunk, point)];
+}
+
+
+struct tile *
+tile_grid_tile_run_at(struct tile_grid *tile_grid,
+                      struct point point,
+                      int *count_out)
+{
+    struct tile *tile = tile_grid_tile_at(tile_grid, point);
+    *count_out = tile_chunk_width - (point.x - floor_to_multiple(point.x, tile_chunk_width));
+    return tile;
+}
@@ -0,0 +1,85 @@
+#ifndef FNF_DUNGEON_TILE_GRID_H_INCLUDED
+#define FNF_DUNGEON_TILE_GRID_H_INCLUDED
+
+
+#include <dungeon/point.h>
+#include <dungeon/tile.h>
+
+
+struct arena;
+
+
+enum {
+    tile_chunk_width = 16,
+    tile_chunk_length = 16,
+    tile_chunk_tiles_count = tile_chunk_width * tile_chunk_length,
+};
+
+
+// A square block of tiles on a single level.  `origin' is always a multiple
+// of the chunk width and length.  Tiles are stored in row order; a newly
+// allocated chunk is all zero bits, which is all filled tiles.
+struct tile_chunk {
+    struct point origin;
+    struct tile tiles[tile_chunk_tiles_count];
+};
+
+
+inline struct point
+tile_chunk_point_at(struct tile_chunk const *chunk, int index)
+{
+    return point_make(chunk->origin.x + index % tile_chunk_width,
+                      chunk->origin.y + index / tile_chunk_width,
+                      chunk->origin.z);
+}
+
+
+// Sparse storage for an unbounded grid of tiles, allocated one chunk at a time
+// from an arena and indexed by chunk coordinate.  Tile pointers remain valid
+// until the grid is freed.
+struct tile_grid {
+    struct arena *arena;
+    struct tile_chunk **chunks;
+    int chunks_count;
+    int chunks_capacity;
+    struct tile_chunk **index;
+    int index_capacity;
+    int tiles_count;
+};
+
+
+struct tile_grid *
+tile_grid_alloc(void);
+
+void
+tile_grid_free(struct tile_grid *tile_grid);
+
+// Returns NULL if the chunk containing `point' has not been allocated.
+struct tile_chunk *
+tile_grid_find_chunk(struct tile_grid const *tile_grid, struct point point);
+
+// Returns NULL if the chunk containing `point' has not been allocated.
+struct tile *
+tile_grid_find_tile(struct tile_grid const *tile_grid, struct point point);
+
+// Like tile_grid_find_tile(), and sets `*count_out' as for
+// tile_grid_tile_run_at() whether or not the chunk has been allocated.
+struct tile *
+tile_grid_find_tile_run(struct tile_grid const *tile_grid,
+                        struct point point,
+                        int *count_out);
+
+// Allocates the chunk containing `point' if needed.  New tiles are filled.
+struct tile *
+tile_grid_tile_at(struct tile_grid *tile_grid, struct point point);
+
+// Like tile_grid_tile_at(), and sets `*count_out' to the number of
+// consecutive tiles starting at `point' and running east that are stored
+// contiguously in the same chunk row.
+struct tile *
+tile_grid_tile_run_at(struct tile_grid *tile_grid,
+                      struct point point,
+                      int *count_out);
+
+
+#endif
@@ -0,0 +1,121 @@
+#include <assert.h>
+#include <base/base.h>
+#include <dungeon/dungeon.h>
+#include "tile_grid.h"
+
+
+void
+tile_grid_test(void);
+
+
+static void
+tile_grid_alloc_test(void)
+{
+    struct tile_grid *tile_grid = tile_grid_alloc();
+
+    assert(tile_grid->chunks);
+    assert(0 == tile_grid->chunks_count);
+    assert(0 == tile_grid->tiles_count);
+    assert(!tile_grid_find_tile(tile_grid, point_make(0, 0, 1)));
+
+    tile_grid_free(tile_grid);
+}
+
+
+static void
+tile_grid_tile_at_test(void)
+{
+    struct tile_grid *tile_grid = tile_grid_alloc();
+
+    struct tile *tile = tile_grid_tile_at(tile_grid, point_make(3, 4, 1));
+    assert(tile);
+    assert(tile == &tile_grid->chunks[0]->tiles[4 * tile_chunk_width + 3]);
+    assert(tile_type_filled == tile_get_type(tile));
+    assert(1 == tile_grid->chunks_count);
+    assert(tile_chunk_tiles_count == tile_grid->tiles_count);
+    assert(point_equals(point_make(0, 0, 1), tile_grid->chunks[0]->origin));
+
+    tile_set_type(tile, tile_type_empty);
+    assert(tile == tile_grid_tile_at(tile_grid, point_make(3, 4, 1)));
+    assert(tile == tile_grid_find_tile(tile_grid, point_make(3, 4, 1)));
+    assert(tile_type_empty == tile_get_type(tile));
+
+    struct tile *neighbor = tile_grid_tile_at(tile_grid, point_make(15, 15, 1));
+    assert(1 == tile_grid->chunks_count);
+    assert(neighbor == &tile_grid->chunks[0]->tiles[tile_chunk_tiles_count - 1]);
+    assert(point_equals(point_make(15, 15, 1),
+                        tile_chunk_point_at(tile_grid->chunks[0], tile_chunk_tiles_count - 1)));
+
+    tile = tile_grid_tile_at(tile_grid, point_make(-1, -16, 1));
+    assert(2 == tile_grid->chunks_count);
+    assert(tile == &tile_grid->chunks[1]->tiles[tile_chunk_width - 1]);
+    assert(point_equals(point_make(-16, -16, 1), tile_grid->chunks[1]->origin));
+
+    tile = tile_grid_tile_at(tile_grid, point_make(16, 0, 2));
+    assert(3 == tile_grid->chunks_count);
+    assert(tile == &tile_grid->chunks[2]->tiles[0]);
+    assert(!tile_grid_find_tile(tile_grid, point_make(16, 0, 1)));
+
+    tile_grid_free(tile_grid);
+}
+
+
+static void
+tile_grid_many_chunks_test(void)
+{
+    struct tile_grid *tile_grid = tile_grid_alloc();
+
+    for (int z = 1; z <= 3; ++z) {
+        for (int y = -100; y < 100; y += 7) {
+            for (int x = -100; x < 100; x += 5) {
+                struct tile *tile = tile_grid_tile_at(tile_grid, point_make(x, y, z));
+                tile_set_features(tile, (enum tile_features)((x + y + z) & 0xf));
+            }
+        }
+    }
+    for (int z = 1; z <= 3; ++z) {
+        for (int y = -100; y < 100; y += 7) {
+            for (int x = -100; x < 100; x += 5) {
+                struct tile *tile = tile_grid_find_tile(tile_grid, point_make(x, y, z));
+                assert(tile);
+                assert(tile == tile_grid_tile_at(tile_grid, point_make(x, y, z)));
+                assert(((x + y + z) & 0xf) == tile_get_features(tile));
+            }
+        }
+    }
+    assert(tile_chunk_tiles_count * tile_grid->chunks_count == tile_grid->tiles_count);
+
+    tile_grid_free(tile_grid);
+}
+
+
+static void
+tile_grid_tile_run_at_test(void)
+{
+    struct tile_grid *tile_grid = tile_grid_alloc();
+    int count;
+
+    struct tile *tile = tile_grid_tile_run_at(tile_grid, point_make(0, 0, 1), &count);
+    assert(tile == tile_grid_find_tile(tile_grid, point_make(0, 0, 1)));
+    assert(tile_chunk_width == count);
+    assert(&tile[count - 1] == tile_grid_find_tile(tile_grid, point_make(15, 0, 1)));
+
+    tile = tile_grid_tile_run_at(tile_grid, point_make(13, 2, 1), &count);
+    assert(3 == count);
+
+    tile = tile_grid_tile_run_at(tile_grid, point_make(-3, 2, 1), &count);
+    assert(3 == count);
+    assert(&tile[count - 1] == tile_grid_find_tile(tile_grid, point_make(-1, 2, 1)));
+
+    tile_grid_free(tile_grid);
+}
+
+
+void
+tile_grid_test(void)
+{
+    tile_grid_alloc_test();
+    tile_grid_tile_at_test();
+    tile_grid_many_chunks_test();
+    tile_grid_tile_run_at_test();
+}
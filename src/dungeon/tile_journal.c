@@ -0,0 +1,212 @@
+#include "tile_journal.h"
+
+#include <assert.h>
+#include <base/base.h>
+
+
+static int const initial_tiles_capacity = 64;
+static int const initial_slots_capacity = 128;
+
+
+static inline uint64_t
+pack_point(struct point point)
+{
+    assert(point.x >= -0x800000 && point.x < 0x800000);
+    assert(point.y >= -0x800000 && point.y < 0x800000);
+    assert(point.z >= -0x8000 && point.z < 0x8000);
+    return ((uint64_t)(uint16_t)point.z << 48)
+         | ((uint64_t)((uint32_t)point.y & 0xffffff) << 24)
+         | (uint64_t)((uint32_t)point.x & 0xffffff);
+}
+
+
+static inline uint32_t
+hash_key(uint64_t key)
+{
+    return (uint32_t)((key * 0x9e3779b97f4a7c15ull) >> 32);
+}
+
+
+static int
+find_slot_index(struct tile_journal_slot const *slots,
+                int slots_capacity,
+                uint64_t key)
+{
+    uint32_t mask = (uint32_t)slots_capacity - 1;
+    uint32_t index = hash_key(key) & mask;
+    while (slots[index].index >= 0 && slots[index].key != key) {
+        index = (index + 1) & mask;
+    }
+    return (int)index;
+}
+
+
+static struct tile_journal_slot *
+alloc_empty_slots(int slots_capacity)
+{
+    struct tile_journal_slot *slots = calloc_or_die(slots_capacity,
+                                                    sizeof(struct tile_journal_slot));
+    for (int i = 0; i < slots_capacity; ++i) {
+        slots[i].index = -1;
+    }
+    return slots;
+}
+
+
+static void
+grow_slots(struct tile_journal *tile_journal)
+{
+    int new_capacity = tile_journal->slots_capacity * 2;
+    struct tile_journal_slot *new_slots = alloc_empty_slots(new_capacity);
+    for (int i = 0; i < tile_journal->tiles_count; ++i) {
+        uint64_t key = pack_point(tile_journal->points[i]);
+        int slot_index = find_slot_index(new_slots, new_capacity, key);
+        new_slots[slot_index].key = key;
+        new_slots[slot_index].index = i;
+        tile_journal->slot_indexes[i] = slot_index;
+    }
+    free_or_die(tile_journal->slots);
+    tile_journal->slots = new_slots;
+    tile_journal->slots_capacity = new_capacity;
+}
+
+
+static void
+grow_tiles(struct tile_journal *tile_journal)
+{
+    tile_journal->tiles_capacity *= 2;
+    tile_journal->tiles = reallocarray_or_die(tile_journal->tiles,
+                                              tile_journal->tiles_capacity,
+                                              sizeof(struct tile *));
+    tile_journal->points = reallocarray_or_die(tile_journal->points,
+                                               tile_journal->tiles_capacity,
+                                               sizeof(struct point));
+    tile_journal->slot_indexes = reallocarray_or_die(tile_journal->slot_indexes,
+                                                     tile_journal->tiles_capacity,
+                                                     sizeof(int));
+}
+
+
+static inline struct tile *
+original_tile(struct tile_journal const *tile_journal, int index)
+{
+    int page_index = index / tile_journal_page_tiles_count;
+    int tile_index = index % tile_journal_page_tiles_count;
+    return &tile_journal->pages[page_index][tile_index];
+}
+
+
+struct tile_journal *
+tile_journal_alloc(void)
+{
+    struct tile_journal *tile_journal = calloc_or_die(1, sizeof(struct tile_journal));
+    tile_journal->tiles = calloc_or_die(initial_tiles_capacity,
+                                        sizeof(struct tile *));
+    tile_journal->points = calloc_or_die(initial_tiles_capacity,
+                                         sizeof(struct point));
+    tile_journal->slot_indexes = calloc_or_die(initial_tiles_capacity,
+                                               sizeof(int));
+    tile_journal->tiles_capacity = initial_tiles_capacity;
+    tile_journal->pages = calloc_or_die(1, sizeof(struct tile *));
+    tile_journal->slots = alloc_empty_slots(initial_slots_capacity);
+    tile_journal->slots_capacity = initial_slots_capacity;
+    return tile_journal;
+}
+
+
+void
+tile_journal_commit(struct tile_journal *tile_journal)
+{
+    for (int i = 0; i < tile_journal->tiles_count; ++i) {
+        int slot_index = tile_journal->slot_indexes[i];
+        tile_journal->slots[slot_index].key = 0;
+        tile_journal->slots[slot_index].index = -1;
+    }
+    tile_journal->tiles_count = 0;
+}
+
+
+struct tile *
+tile_journal_find(struct tile_journal const *tile_journal, struct point point)
+{
+    int slot_index = find_slot_index(tile_journal->slots,
+                                     tile_journal->slots_capacity,
+                                     pack_point(point));
+    int index = tile_journal->slots[slot_index].index;
+    return index >= 0 ? tile_journal->tiles[index] : NULL;
+}
+
+
+void
+tile_journal_free(struct tile_journal *tile_journal)
+{
+    if (tile_journal) {
+        for (int i = 0; i < tile_journal->pages_count; ++i) {
+            free_or_die(tile_journal->pages[i]);
+        }
+        free_or_die(tile_journal->pages);
+        free_or_die(tile_journal->slots);
+        free_or_die(tile_journal->slot_indexes);
+        free_or_die(tile_journal->points);
+        free_or_die(tile_journal->tiles);
+        free_or_die(tile_journal);
+    }
+}
+
+
+struct tile const *
+tile_journal_original_tile(struct tile_journal const *tile_journal, int index)
+{
+    return original_tile(tile_journal, index);
+}
+
+
+void
+tile_journal_record(struct tile_journal *tile_journal,
+                    struct point point,
+                    struct tile *tile)
+{
+    uint64_t key = pack_point(point);
+    int slot_index = find_slot_index(tile_journal->slots,
+                                     tile_journal->slots_capacity,
+                                     key);
+    if (tile_journal->slots[slot_index].index >= 0) return;
+
+    if ((tile_journal->tiles_count + 1) * 2 > tile_journal->slots_capacity) {
+        grow_slots(tile_journal);
+        slot_index = find_slot_index(tile_journal->slots,
+                                     tile_journal->slots_capacity,
+                                     key);
+    }
+    if (tile_journal->tiles_count == tile_journal->tiles_capacity) {
+        grow_tiles(tile_journal);
+    }
+
+    int index = tile_journal->tiles_count;
+    int page_index = index / tile_journal_page_tiles_count;
+    if (page_index == tile_journal->pages_count) {
+        ++tile_journal->pages_count;
+        tile_journal->pages = reallocarray_or_die(tile_journal->pages,
+                                                  tile_journal->pages_count,
+                                                  sizeof(struct tile *));
+        tile_journal->pages[page_index] = calloc_or_die(tile_journal_page_tiles_count,
+                                                        sizeof(struct tile));
+    }
+    *original_tile(tile_journal, index) = *tile;
+    tile_journal->slots[slot_index].key = key;
+    tile_journal->slots[slot_index].index = index;
+    tile_journal->tiles[index] = tile;
+    tile_journal->points[index] = point;
+    tile_journal->slot_indexes[index] = slot_index;
+    ++tile_journal->tiles_count;
+}
+
+
+void
+tile_journal_rollback(struct tile_journal *tile_journal)
+{
+    for (int i = tile_journal->tiles_count - 1; i >= 0; --i) {
+        *tile_journal->tiles[i] = *original_tile(tile_journal, i);
+    }
+    tile_journal_commit(tile_journal);
+}
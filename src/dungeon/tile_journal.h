@@ -0,0 +1,71 @@
+#ifndef FNF_DUNGEON_TILE_JOURNAL_H_INCLUDED
+#define FNF_DUNGEON_TILE_JOURNAL_H_INCLUDED
+
+
+#include <stdint.h>
+
+#include <dungeon/point.h>
+#include <dungeon/tile.h>
+
+
+enum {
+    tile_journal_page_tiles_count = 256,
+};
+
+
+struct tile_journal_slot {
+    uint64_t key;
+    int index;
+};
+
+
+// An undo log for tiles that are modified in place, indexed by point.  Each
+// tile is recorded once, before its first modification: `tiles' and `points'
+// list the recorded tiles in order and the matching original values are kept
+// in pages that are reused from one transaction to the next.
+struct tile_journal {
+    struct tile **tiles;
+    struct point *points;
+    int tiles_count;
+    int tiles_capacity;
+    int *slot_indexes;
+    struct tile **pages;
+    int pages_count;
+    struct tile_journal_slot *slots;
+    int slots_capacity;
+};
+
+
+struct tile_journal *
+tile_journal_alloc(void);
+
+void
+tile_journal_free(struct tile_journal *tile_journal);
+
+// Forgets all recorded tiles, keeping their current values, in time
+// proportional to the number of recorded tiles.
+void
+tile_journal_commit(struct tile_journal *tile_journal);
+
+// Returns NULL if no tile at `point' has been recorded.
+struct tile *
+tile_journal_find(struct tile_journal const *tile_journal, struct point point);
+
+// Returns the value the `index'th recorded tile had when it was recorded.
+struct tile const *
+tile_journal_original_tile(struct tile_journal const *tile_journal, int index);
+
+// Saves the current value of `tile', which is stored at `point', unless a
+// tile at the same point has already been recorded.
+void
+tile_journal_record(struct tile_journal *tile_journal,
+                    struct point point,
+                    struct tile *tile);
+
+// Restores the original values of all recorded tiles in reverse order and
+// forgets them.
+void
+tile_journal_rollback(struct tile_journal *tile_journal);
+
+
+#endif
@@ -0,0 +1,135 @@
+#include <assert.h>
+#include <base/base.h>
+#include "tile_grid.h"
+#include "tile_journal.h"
+
+
+void
+tile_journal_test(void);
+
+
+static void
+tile_journal_alloc_test(void)
+{
+    struct tile_journal *tile_journal = tile_journal_alloc();
+
+    assert(tile_journal->tiles);
+    assert(0 == tile_journal->tiles_count);
+    assert(!tile_journal_find(tile_journal, point_make(0, 0, 1)));
+
+    tile_journal_free(tile_journal);
+}
+
+
+static void
+tile_journal_record_test(void)
+{
+    struct tile_journal *tile_journal = tile_journal_alloc();
+    struct tile *tile = tile_alloc(tile_type_filled);
+
+    tile_journal_record(tile_journal, point_make(3, -4, 1), tile);
+    assert(1 == tile_journal->tiles_count);
+    assert(tile == tile_journal->tiles[0]);
+    assert(point_equals(point_make(3, -4, 1), tile_journal->points[0]));
+    assert(tile == tile_journal_find(tile_journal, point_make(3, -4, 1)));
+    assert(!tile_journal_find(tile_journal, point_make(3, -4, 2)));
+    assert(!tile_journal_find(tile_journal, point_make(-4, 3, 1)));
+
+    tile_set_type(tile, tile_type_empty);
+    tile_journal_record(tile_journal, point_make(3, -4, 1), tile);
+    assert(1 == tile_journal->tiles_count);
+
+    tile_journal_rollback(tile_journal);
+    assert(0 == tile_journal->tiles_count);
+    assert(tile_type_filled == tile_get_type(tile));
+    assert(!tile_journal_find(tile_journal, point_make(3, -4, 1)));
+
+    tile_free(tile);
+    tile_journal_free(tile_journal);
+}
+
+
+static void
+tile_journal_commit_test(void)
+{
+    struct tile_journal *tile_journal = tile_journal_alloc();
+    struct tile *tile = tile_alloc(tile_type_filled);
+
+    tile_journal_record(tile_journal, point_make(0, 0, 1), tile);
+    tile_set_type(tile, tile_type_empty);
+    tile_set_features(tile, tile_features_chimney_up);
+    tile_journal_commit(tile_journal);
+
+    assert(0 == tile_journal->tiles_count);
+    assert(!tile_journal_find(tile_journal, point_make(0, 0, 1)));
+    assert(tile_type_empty == tile_get_type(tile));
+
+    tile_journal_record(tile_journal, point_make(0, 0, 1), tile);
+    tile_set_type(tile, tile_type_stairs_up);
+    tile_journal_rollback(tile_journal);
+    assert(tile_type_empty == tile_get_type(tile));
+    assert(tile_features_chimney_up == tile_get_features(tile));
+
+    tile_free(tile);
+    tile_journal_free(tile_journal);
+}
+
+
+static void
+tile_journal_many_tiles_test(void)
+{
+    struct tile_journal *tile_journal = tile_journal_alloc();
+    struct tile_grid *tile_grid = tile_grid_alloc();
+
+    for (int z = -1; z <= 2; ++z) {
+        for (int y = -30; y < 30; ++y) {
+            for (int x = -30; x < 30; x += 3) {
+                struct point point = point_make(x, y, z);
+                struct tile *tile = tile_grid_tile_at(tile_grid, point);
+                tile_journal_record(tile_journal, point, tile);
+                tile_set_type(tile, tile_type_empty);
+            }
+        }
+    }
+    assert(4 * 60 * 20 == tile_journal->tiles_count);
+
+    for (int z = -1; z <= 2; ++z) {
+        for (int y = -30; y < 30; ++y) {
+            for (int x = -30; x < 30; ++x) {
+                struct tile *found = tile_journal_find(tile_journal, point_make(x, y, z));
+                if (0 == (x + 30) % 3) {
+                    assert(found);
+                    assert(found == tile_grid_find_tile(tile_grid, point_make(x, y, z)));
+                } else {
+                    assert(!found);
+                }
+            }
+        }
+    }
+    int pages_count = tile_journal->pages_count;
+
+    tile_journal_rollback(tile_journal);
+    for (int i = 0; i < tile_grid->chunks_count; ++i) {
+        for (int j = 0; j < tile_chunk_tiles_count; ++j) {
+            assert(tile_is_unescavated(&tile_grid->chunks[i]->tiles[j]));
+        }
+    }
+
+    struct tile *tile = tile_grid_tile_at(tile_grid, point_make(0, 0, 1));
+    tile_journal_record(tile_journal, point_make(0, 0, 1), tile);
+    assert(tile == tile_journal_find(tile_journal, point_make(0, 0, 1)));
+    assert(pages_count == tile_journal->pages_count);
+
+    tile_grid_free(tile_grid);
+    tile_journal_free(tile_journal);
+}
+
+
+void
+tile_journal_test(void)
+{
+    tile_journal_alloc_test();
+    tile_journal_record_test();
+    tile_journal_commit_test();
+    tile_journal_many_tiles_test();
+}
@@ -0,0 +1,195 @@
+#include "tile_spans.h"
+
+#include <string.h>
+#include <base/base.h>
+
+#include "tile_grid.h"
+
+
+static int const initial_capacity = 64;
+// longer gaps take more memory as zero tiles than a new span does
+static int const max_gap = sizeof(struct tile_span) / sizeof(struct tile);
+static struct tile const blank_tile;
+
+
+struct builder {
+    struct tile_spans *tile_spans;
+    int spans_capacity;
+    int tiles_capacity;
+    int row_start;
+    int gap;
+};
+
+
+static void
+add_tile(struct builder *builder, int x, struct tile tile);
+
+static void
+add_tiles(struct builder *builder, int x, struct tile const *tiles, int count);
+
+
+static void
+add_tile(struct builder *builder, int x, struct tile tile)
+{
+    struct tile_spans *tile_spans = builder->tile_spans;
+    bool extends_last = tile_spans->spans_count > builder->row_start
+                     && builder->gap <= max_gap;
+    int count = extends_last ? builder->gap + 1 : 1;
+    if (tile_spans->tiles_count + count > builder->tiles_capacity) {
+        while (tile_spans->tiles_count + count > builder->tiles_capacity) {
+            builder->tiles_capacity *= 2;
+        }
+        tile_spans->tiles = reallocarray_or_die(tile_spans->tiles,
+                                                builder->tiles_capacity,
+                                                sizeof(struct tile));
+    }
+
+    if (extends_last) {
+        memset(&tile_spans->tiles[tile_spans->tiles_count], 0, builder->gap * sizeof(struct tile));
+        tile_spans->spans[tile_spans->spans_count - 1].count += count;
+    } else {
+        if (tile_spans->spans_count == builder->spans_capacity) {
+            builder->spans_capacity *= 2;
+            tile_spans->spans = reallocarray_or_die(tile_spans->spans,
+                                                    builder->spans_capacity,
+                                                    sizeof(struct tile_span));
+        }
+        tile_spans->spans[tile_spans->spans_count] = (struct tile_span){
+            .x=x,
+            .count=1,
+            .first_tile=tile_spans->tiles_count,
+        };
+        ++tile_spans->spans_count;
+    }
+    tile_spans->tiles_count += count;
+    tile_spans->tiles[tile_spans->tiles_count - 1] = tile;
+    builder->gap = 0;
+}
+
+
+static void
+add_tiles(struct builder *builder, int x, struct tile const *tiles, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        if (tiles[i].bits) {
+            add_tile(builder, x + i, tiles[i]);
+        } else {
+            ++builder->gap;
+        }
+    }
+}
+
+
+struct tile_spans *
+tile_spans_alloc(struct tile_grid const *tile_grid, struct box box)
+{
+    struct tile_spans *tile_spans = calloc_or_die(1, sizeof(struct tile_spans));
+    tile_spans->box = box;
+    tile_spans->row_starts = calloc_or_die(box.size.length + 1, sizeof(int));
+    struct builder builder = {
+        .tile_spans=tile_spans,
+        .spans_capacity=initial_capacity,
+        .tiles_capacity=initial_capacity,
+    };
+    tile_spans->spans = calloc_or_die(builder.spans_capacity, sizeof(struct tile_span));
+    tile_spans->tiles = calloc_or_die(builder.tiles_capacity, sizeof(struct tile));
+
+    struct point end = box_end_point(box);
+    for (int j = 0; j < box.size.length; ++j) {
+        builder.row_start = tile_spans->spans_count;
+        builder.gap = 0;
+        tile_spans->row_starts[j] = builder.row_start;
+        int i = box.origin.x;
+        while (i < end.x) {
+            struct point point = point_make(i, box.origin.y + j, box.origin.z);
+            int run_count;
+            struct tile const *run = tile_grid_find_tile_run(tile_grid, point, &run_count);
+            run_count = min(run_count, end.x - i);
+            if (run) {
+                add_tiles(&builder, i, run, run_count);
+            } else {
+                builder.gap += run_count;
+            }
+            i += run_count;
+        }
+    }
+    tile_spans->row_starts[box.size.length] = tile_spans->spans_count;
+
+    tile_spans->spans = reallocarray_or_die(tile_spans->spans,
+                                            max(1, tile_spans->spans_count),
+                                            sizeof(struct tile_span));
+    tile_spans->tiles = reallocarray_or_die(tile_spans->tiles,
+                                            max(1, tile_spans->tiles_count),
+                                            sizeof(struct tile));
+    return tile_spans;
+}
+
+
+void
+tile_spans_free(struct tile_spans *tile_spans)
+{
+    if (tile_spans) {
+        free_or_die(tile_spans->row_starts);
+        free_or_die(tile_spans->spans);
+        free_or_die(tile_spans->tiles);
+        free_or_die(tile_spans);
+    }
+}
+
+
+void
+tile_spans_copy_row(struct tile_spans const *tile_spans, int y, struct tile *tiles)
+{
+    memset(tiles, 0, tile_spans->box.size.width * sizeof(struct tile));
+    int spans_count;
+    struct tile_span const *spans = tile_spans_row(tile_spans, y, &spans_count);
+    for (int i = 0; i < spans_count; ++i) {
+        memcpy(&tiles[spans[i].x - tile_spans->box.origin.x],
+               &tile_spans->tiles[spans[i].first_tile],
+               spans[i].count * sizeof(struct tile));
+    }
+}
+
+
+struct tile_span const *
+tile_spans_row(struct tile_spans const *tile_spans, int y, int *spans_count_out)
+{
+    int j = y - tile_spans->box.origin.y;
+    if (j < 0 || j >= tile_spans->box.size.length) {
+        *spans_count_out = 0;
+        return NULL;
+    }
+    *spans_count_out = tile_spans->row_starts[j + 1] - tile_spans->row_starts[j];
+    return &tile_spans->spans[tile_spans->row_starts[j]];
+}
+
+
+size_t
+tile_spans_size(struct tile_spans const *tile_spans)
+{
+    return (tile_spans->box.size.length + 1) * sizeof(int)
+         + tile_spans->spans_count * sizeof(struct tile_span)
+         + tile_spans->tiles_count * sizeof(struct tile);
+}
+
+
+struct tile const *
+tile_spans_tile_at(struct tile_spans const *tile_spans, struct point point)
+{
+    if (!box_contains_point(tile_spans->box, point)) return NULL;
+
+    int spans_count;
+    struct tile_span const *spans = tile_spans_row(tile_spans, point.y, &spans_count);
+    int low = 0;
+    int high = spans_count;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (spans[middle].x + spans[middle].count <= point.x) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low == spans_count || spans[low].x > point.x) return &blank_tile;
+    return &tile_spans->tiles[spans[low].first_tile + point.x - spans[low].x];
+}
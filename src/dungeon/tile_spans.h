@@ -0,0 +1,66 @@
+#ifndef FNF_DUNGEON_TILE_SPANS_H_INCLUDED
+#define FNF_DUNGEON_TILE_SPANS_H_INCLUDED
+
+
+#include <stddef.h>
+#include <dungeon/box.h>
+#include <dungeon/point.h>
+#include <dungeon/tile.h>
+
+
+struct tile_grid;
+
+
+// `count' tiles of a row starting at column `x', stored in order starting
+// at `tiles[first_tile]' of the owning tile_spans.
+struct tile_span {
+    int x;
+    int count;
+    int first_tile;
+};
+
+
+// The tiles of a box on one level, stored as spans of each row.  Tiles with
+// all bits zero, the filled tiles that make up most of a level, are only
+// stored inside a span, where a short gap costs less than starting a new
+// span.  So memory grows with the excavated part of the box rather than its
+// area.  The spans of row `box.origin.y + j' are
+// `spans[row_starts[j] .. row_starts[j + 1])', in order of x.
+struct tile_spans {
+    struct box box;
+    int *row_starts;
+    struct tile_span *spans;
+    int spans_count;
+    struct tile *tiles;
+    int tiles_count;
+};
+
+
+// Copies the tiles of `box' from `tile_grid' without allocating a tile for
+// each point of the box.
+struct tile_spans *
+tile_spans_alloc(struct tile_grid const *tile_grid, struct box box);
+
+void
+tile_spans_free(struct tile_spans *tile_spans);
+
+// Writes the `box.size.width' tiles of row `y' to `tiles'.
+void
+tile_spans_copy_row(struct tile_spans const *tile_spans, int y, struct tile *tiles);
+
+// Returns the spans of row `y' and sets `*spans_count_out', or returns NULL
+// with a zero count for rows outside the box.
+struct tile_span const *
+tile_spans_row(struct tile_spans const *tile_spans, int y, int *spans_count_out);
+
+// Returns the bytes allocated for the spans, tiles and row starts.
+size_t
+tile_spans_size(struct tile_spans const *tile_spans);
+
+// Finds the span containing `point' with a binary search of its row.
+// Returns NULL for points outside the box.
+struct tile const *
+tile_spans_tile_at(struct tile_spans const *tile_spans, struct point point);
+
+
+#endif
@@ -0,0 +1,112 @@
+#include <assert.h>
+#include <base/base.h>
+#include <dungeon/dungeon.h>
+#include "tile_grid.h"
+#include "tile_spans.h"
+
+
+void
+tile_spans_test(void);
+
+
+static void
+tile_spans_alloc_test(void)
+{
+    struct tile_grid *tile_grid = tile_grid_alloc();
+    // a passage crossing the chunk boundary at x = 16, a short gap and a
+    // tile too far away to share its span
+    for (int i = 12; i < 20; ++i) {
+        tile_set_type(tile_grid_tile_at(tile_grid, point_make(i, 3, 1)), tile_type_empty);
+    }
+    tile_set_type(tile_grid_tile_at(tile_grid, point_make(22, 3, 1)), tile_type_empty);
+    tile_set_south_wall(tile_grid_tile_at(tile_grid, point_make(40, 3, 1)), wall_type_solid);
+    tile_set_south_wall(tile_grid_tile_at(tile_grid, point_make(14, 5, 1)), wall_type_solid);
+
+    struct box box = box_make(point_make(10, 2, 1), size_make(40, 40, 1));
+    struct tile_spans *tile_spans = tile_spans_alloc(tile_grid, box);
+    assert(box_equals(box, tile_spans->box));
+    assert(3 == tile_spans->spans_count);
+    assert(13 == tile_spans->tiles_count);
+
+    int spans_count;
+    struct tile_span const *spans = tile_spans_row(tile_spans, 3, &spans_count);
+    assert(2 == spans_count);
+    assert(12 == spans[0].x);
+    assert(11 == spans[0].count);
+    assert(tile_type_filled == tile_get_type(&tile_spans->tiles[spans[0].first_tile + 9]));
+    assert(tile_type_empty == tile_get_type(&tile_spans->tiles[spans[0].first_tile + 10]));
+    assert(40 == spans[1].x);
+    assert(1 == spans[1].count);
+
+    spans = tile_spans_row(tile_spans, 4, &spans_count);
+    assert(0 == spans_count);
+    spans = tile_spans_row(tile_spans, 5, &spans_count);
+    assert(1 == spans_count);
+    assert(14 == spans[0].x);
+    assert(1 == spans[0].count);
+
+    assert(!tile_spans_row(tile_spans, 1, &spans_count));
+    assert(0 == spans_count);
+    assert(!tile_spans_row(tile_spans, 42, &spans_count));
+
+    assert(tile_spans_size(tile_spans) < box_volume(box) * sizeof(struct tile));
+
+    tile_spans_free(tile_spans);
+    tile_grid_free(tile_grid);
+}
+
+
+static void
+tile_spans_copy_row_test(void)
+{
+    struct tile_grid *tile_grid = tile_grid_alloc();
+    tile_set_type(tile_grid_tile_at(tile_grid, point_make(1, 0, 1)), tile_type_empty);
+    tile_set_type(tile_grid_tile_at(tile_grid, point_make(2, 0, 1)), tile_type_stairs_down);
+
+    struct tile_spans *tile_spans = tile_spans_alloc(tile_grid, box_make(point_make(0, 0, 1), size_make(4, 1, 1)));
+    struct tile tiles[4];
+    tile_spans_copy_row(tile_spans, 0, tiles);
+    assert(tile_type_filled == tile_get_type(&tiles[0]));
+    assert(tile_type_empty == tile_get_type(&tiles[1]));
+    assert(tile_type_stairs_down == tile_get_type(&tiles[2]));
+    assert(tile_type_filled == tile_get_type(&tiles[3]));
+
+    tile_spans_free(tile_spans);
+    tile_grid_free(tile_grid);
+}
+
+
+static void
+tile_spans_tile_at_test(void)
+{
+    struct dungeon *dungeon = dungeon_alloc();
+    dungeon_generate_small(dungeon);
+    struct box box = box_expand(dungeon_box_for_level(dungeon, 1), size_make(2, 2, 0));
+    struct tile_spans *tile_spans = tile_spans_alloc(dungeon->tile_grid, box);
+
+    struct point end = box_end_point(box);
+    for (int j = box.origin.y; j < end.y; ++j) {
+        for (int i = box.origin.x; i < end.x; ++i) {
+            struct point point = point_make(i, j, 1);
+            struct tile const *tile = tile_spans_tile_at(tile_spans, point);
+            assert(tile);
+            struct tile const *expected = tile_grid_find_tile(dungeon->tile_grid, point);
+            assert((expected ? expected->bits : 0) == tile->bits);
+        }
+    }
+    assert(!tile_spans_tile_at(tile_spans, point_make(box.origin.x - 1, 0, 1)));
+    assert(!tile_spans_tile_at(tile_spans, point_make(0, end.y, 1)));
+    assert(!tile_spans_tile_at(tile_spans, point_make(0, 0, 2)));
+
+    tile_spans_free(tile_spans);
+    dungeon_free(dungeon);
+}
+
+
+void
+tile_spans_test(void)
+{
+    tile_spans_alloc_test();
+    tile_spans_copy_row_test();
+    tile_spans_tile_at_test();
+}
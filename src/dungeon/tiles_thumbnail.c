@@ -13,7 +13,7 @@ static void
 print_tile_direction(struct text_rectangle *text_rectangle, struct tile *tile)
 {
     char const *direction;
-    switch (tile->direction) {
+    switch (tile_get_direction(tile)) {
         case direction_north:     direction = " n"; break;
         case direction_northeast: direction = "ne"; break;
         case direction_east:      direction = " e"; break;
@@ -31,7 +31,7 @@ print_tile_direction(struct text_rectangle *text_rectangle, struct tile *tile)
 static void
 print_tile_features(struct text_rectangle *text_rectangle, struct tile *tile)
 {
-    text_rectangle_print_format(text_rectangle, " %x ", tile->features);
+    text_rectangle_print_format(text_rectangle, " %x ", tile_get_features(tile));
 }
 
 
@@ -39,7 +39,7 @@ static void
 print_tile_type(struct text_rectangle *text_rectangle, struct tile *tile)
 {
     char type;
-    switch (tile->type) {
+    switch (tile_get_type(tile)) {
         case tile_type_filled:      type = ':'; break;
         case tile_type_empty:       type = '.'; break;
         case tile_type_stairs_down: type = 'v'; break;
@@ -54,7 +54,7 @@ static void
 print_tile_walls(struct text_rectangle *text_rectangle, struct tile *tile)
 {
     char south_wall;
-    switch (tile->walls.south) {
+    switch (tile_get_south_wall(tile)) {
         case wall_type_none:        south_wall = '.'; break;
         case wall_type_solid:       south_wall = '_'; break;
         case wall_type_door:        south_wall = '='; break;
@@ -62,7 +62,7 @@ print_tile_walls(struct text_rectangle *text_rectangle, struct tile *tile)
         default:                    south_wall = ' '; break;
     }
     char west_wall;
-    switch (tile->walls.west) {
+    switch (tile_get_west_wall(tile)) {
         case wall_type_none:        west_wall = '.'; break;
         case wall_type_solid:       west_wall = '|'; break;
         case wall_type_door:        west_wall = ']'; break;
@@ -74,13 +74,16 @@ print_tile_walls(struct text_rectangle *text_rectangle, struct tile *tile)
 
 
 static char *
-tiles_thumbnail_alloc(struct tile **tiles, int tiles_count, print_tile_fn print_tile)
+tiles_thumbnail_alloc(struct tile **tiles,
+                      struct point const *points,
+                      int tiles_count,
+                      print_tile_fn print_tile)
 {
     if (!tiles_count) return str_alloc_empty();
 
-    struct box box = box_make_unit(tiles[0]->point);
+    struct box box = box_make_unit(points[0]);
     for (int i = 0; i < tiles_count; ++i) {
-        box = box_extend_to_include_point(box, tiles[i]->point);
+        box = box_extend_to_include_point(box, points[i]);
     }
 
     int column_count = 3 * (1 + box.size.width);
@@ -104,11 +107,10 @@ tiles_thumbnail_alloc(struct tile **tiles, int tiles_count, print_tile_fn print_
     }
 
     for (int i = 0; i < tiles_count; ++i) {
-        struct tile *tile = tiles[i];
-        int column_index = 3 * (1 + tile->point.x - box.origin.x);
-        int row_index = 1 + (box.size.length - 1) - (tile->point.y - box.origin.y);
+        int column_index = 3 * (1 + points[i].x - box.origin.x);
+        int row_index = 1 + (box.size.length - 1) - (points[i].y - box.origin.y);
         text_rectangle_move_to(text_rectangle, column_index, row_index);
-        print_tile(text_rectangle, tile);
+        print_tile(text_rectangle, tiles[i]);
     }
 
     char *thumbnail = strdup_or_die(text_rectangle->chars);
@@ -118,28 +120,36 @@ tiles_thumbnail_alloc(struct tile **tiles, int tiles_count, print_tile_fn print_
 
 
 char *
-tiles_thumbnail_directions_alloc(struct tile **tiles, int tiles_count)
+tiles_thumbnail_directions_alloc(struct tile **tiles,
+                                 struct point const *points,
+                                 int tiles_count)
 {
-    return tiles_thumbnail_alloc(tiles, tiles_count, print_tile_direction);
+    return tiles_thumbnail_alloc(tiles, points, tiles_count, print_tile_direction);
 }
 
 
 char *
-tiles_thumbnail_features_alloc(struct tile **tiles, int tiles_count)
+tiles_thumbnail_features_alloc(struct tile **tiles,
+                               struct point const *points,
+                               int tiles_count)
 {
-    return tiles_thumbnail_alloc(tiles, tiles_count, print_tile_features);
+    return tiles_thumbnail_alloc(tiles, points, tiles_count, print_tile_features);
 }
 
 
 char *
-tiles_thumbnail_types_alloc(struct tile **tiles, int tiles_count)
+tiles_thumbnail_types_alloc(struct tile **tiles,
+                            struct point const *points,
+                            int tiles_count)
 {
-    return tiles_thumbnail_alloc(tiles, tiles_count, print_tile_type);
+    return tiles_thumbnail_alloc(tiles, points, tiles_count, print_tile_type);
 }
 
 
 char *
-tiles_thumbnail_walls_alloc(struct tile **tiles, int tiles_count)
+tiles_thumbnail_walls_alloc(struct tile **tiles,
+                            struct point const *points,
+                            int tiles_count)
 {
-    return tiles_thumbnail_alloc(tiles, tiles_count, print_tile_walls);
+    return tiles_thumbnail_alloc(tiles, points, tiles_count, print_tile_walls);
 }
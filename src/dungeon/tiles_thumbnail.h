@@ -2,20 +2,29 @@
 #define FNF_DUNGEON_TILES_THUMBNAIL_H_INCLUDED
 
 
+struct point;
 struct tile;
 
 
 char *
-tiles_thumbnail_directions_alloc(struct tile **tiles, int tiles_count);
+tiles_thumbnail_directions_alloc(struct tile **tiles,
+                                 struct point const *points,
+                                 int tiles_count);
 
 char *
-tiles_thumbnail_features_alloc(struct tile **tiles, int tiles_count);
+tiles_thumbnail_features_alloc(struct tile **tiles,
+                               struct point const *points,
+                               int tiles_count);
 
 char *
-tiles_thumbnail_types_alloc(struct tile **tiles, int tiles_count);
+tiles_thumbnail_types_alloc(struct tile **tiles,
+                            struct point const *points,
+                            int tiles_count);
 
 char *
-tiles_thumbnail_walls_alloc(struct tile **tiles, int tiles_count);
+tiles_thumbnail_walls_alloc(struct tile **tiles,
+                            struct point const *points,
+                            int tiles_count);
 
 
 #endif
@@ -13,24 +13,33 @@ tiles_thumbnail_directions_alloc_test_for_each_direction(void)
 {
     int tiles_count = 8;
     struct tile **tiles = calloc_or_die(tiles_count, sizeof(struct tile *));
-    tiles[0] = tile_alloc(point_make(-4, 0, 1), tile_type_empty);
-    tiles[0]->direction = direction_north;
-    tiles[1] = tile_alloc(point_make(-3, 0, 1), tile_type_empty);
-    tiles[1]->direction = direction_south;
-    tiles[2] = tile_alloc(point_make(-2, 0, 1), tile_type_empty);
-    tiles[2]->direction = direction_east;
-    tiles[3] = tile_alloc(point_make(-1, 0, 1), tile_type_empty);
-    tiles[3]->direction = direction_west;
-    tiles[4] = tile_alloc(point_make( 0, 0, 1), tile_type_empty);
-    tiles[4]->direction = direction_northwest;
-    tiles[5] = tile_alloc(point_make( 1, 0, 1), tile_type_empty);
-    tiles[5]->direction = direction_northeast;
-    tiles[6] = tile_alloc(point_make( 2, 0, 1), tile_type_empty);
-    tiles[6]->direction = direction_southwest;
-    tiles[7] = tile_alloc(point_make( 3, 0, 1), tile_type_empty);
-    tiles[7]->direction = direction_southeast;
-
-    char *thumbnail = tiles_thumbnail_directions_alloc(tiles, tiles_count);
+    struct point *points = calloc_or_die(tiles_count, sizeof(struct point));
+    points[0] = point_make(-4, 0, 1);
+    tiles[0] = tile_alloc(tile_type_empty);
+    tile_set_direction(tiles[0], direction_north);
+    points[1] = point_make(-3, 0, 1);
+    tiles[1] = tile_alloc(tile_type_empty);
+    tile_set_direction(tiles[1], direction_south);
+    points[2] = point_make(-2, 0, 1);
+    tiles[2] = tile_alloc(tile_type_empty);
+    tile_set_direction(tiles[2], direction_east);
+    points[3] = point_make(-1, 0, 1);
+    tiles[3] = tile_alloc(tile_type_empty);
+    tile_set_direction(tiles[3], direction_west);
+    points[4] = point_make( 0, 0, 1);
+    tiles[4] = tile_alloc(tile_type_empty);
+    tile_set_direction(tiles[4], direction_northwest);
+    points[5] = point_make( 1, 0, 1);
+    tiles[5] = tile_alloc(tile_type_empty);
+    tile_set_direction(tiles[5], direction_northeast);
+    points[6] = point_make( 2, 0, 1);
+    tiles[6] = tile_alloc(tile_type_empty);
+    tile_set_direction(tiles[6], direction_southwest);
+    points[7] = point_make( 3, 0, 1);
+    tiles[7] = tile_alloc(tile_type_empty);
+    tile_set_direction(tiles[7], direction_southeast);
+
+    char *thumbnail = tiles_thumbnail_directions_alloc(tiles, points, tiles_count);
     assert(thumbnail);
     char const *expected =
             "   -4 -3 -2 -1  0  1  2  3 \n"
@@ -39,6 +48,7 @@ tiles_thumbnail_directions_alloc_test_for_each_direction(void)
 
     free_or_die(thumbnail);
     for (int i = 0; i < tiles_count; ++i) tile_free(tiles[i]);
+    free_or_die(points);
     free_or_die(tiles);
 }
 
@@ -48,12 +58,17 @@ tiles_thumbnail_features_alloc_test_for_various_feature_combinations(void)
 {
     int tiles_count = 4;
     struct tile **tiles = calloc_or_die(tiles_count, sizeof(struct tile *));
-    tiles[0] = tile_alloc(point_make(0, 1, 1), tile_type_empty);
-    tiles[1] = tile_alloc(point_make(0, 2, 1), tile_type_filled);
-    tiles[2] = tile_alloc(point_make(0, 3, 1), tile_type_stairs_down);
-    tiles[3] = tile_alloc(point_make(0,  4, 1), tile_type_stairs_up);
-
-    char *thumbnail = tiles_thumbnail_types_alloc(tiles, tiles_count);
+    struct point *points = calloc_or_die(tiles_count, sizeof(struct point));
+    points[0] = point_make(0, 1, 1);
+    tiles[0] = tile_alloc(tile_type_empty);
+    points[1] = point_make(0, 2, 1);
+    tiles[1] = tile_alloc(tile_type_filled);
+    points[2] = point_make(0, 3, 1);
+    tiles[2] = tile_alloc(tile_type_stairs_down);
+    points[3] = point_make(0,  4, 1);
+    tiles[3] = tile_alloc(tile_type_stairs_up);
+
+    char *thumbnail = tiles_thumbnail_types_alloc(tiles, points, tiles_count);
     assert(thumbnail);
     char const *expected =
             "    0 \n"
@@ -65,6 +80,7 @@ tiles_thumbnail_features_alloc_test_for_various_feature_combinations(void)
 
     free_or_die(thumbnail);
     for (int i = 0; i < tiles_count; ++i) tile_free(tiles[i]);
+    free_or_die(points);
     free_or_die(tiles);
 }
 
@@ -74,22 +90,30 @@ tiles_thumbnail_types_alloc_test_for_each_tile_type(void)
 {
     int tiles_count = 7;
     struct tile **tiles = calloc_or_die(tiles_count, sizeof(struct tile *));
-    tiles[0] = tile_alloc(point_make(-2, 12, 1), tile_type_empty);
-    tiles[0]->features = tile_features_none;
-    tiles[1] = tile_alloc(point_make(-1, 12, 1), tile_type_filled);
-    tiles[1]->features = tile_features_chimney_up;
-    tiles[2] = tile_alloc(point_make( 0, 12, 1), tile_type_stairs_down);
-    tiles[2]->features = tile_features_chimney_down;
-    tiles[3] = tile_alloc(point_make( 1,  12, 1), tile_type_stairs_up);
-    tiles[3]->features = tile_features_chute_entrance;
-    tiles[4] = tile_alloc(point_make( 2,  12, 1), tile_type_stairs_up);
-    tiles[4]->features = tile_features_chute_exit;
-    tiles[5] = tile_alloc(point_make( 3,  12, 1), tile_type_stairs_up);
-    tiles[5]->features = tile_features_chimney_up | tile_features_chimney_down;
-    tiles[6] = tile_alloc(point_make( 4,  12, 1), tile_type_stairs_up);
-    tiles[6]->features = tile_features_chute_entrance | tile_features_chute_exit;
-
-    char *thumbnail = tiles_thumbnail_features_alloc(tiles, tiles_count);
+    struct point *points = calloc_or_die(tiles_count, sizeof(struct point));
+    points[0] = point_make(-2, 12, 1);
+    tiles[0] = tile_alloc(tile_type_empty);
+    tile_set_features(tiles[0], tile_features_none);
+    points[1] = point_make(-1, 12, 1);
+    tiles[1] = tile_alloc(tile_type_filled);
+    tile_set_features(tiles[1], tile_features_chimney_up);
+    points[2] = point_make( 0, 12, 1);
+    tiles[2] = tile_alloc(tile_type_stairs_down);
+    tile_set_features(tiles[2], tile_features_chimney_down);
+    points[3] = point_make( 1,  12, 1);
+    tiles[3] = tile_alloc(tile_type_stairs_up);
+    tile_set_features(tiles[3], tile_features_chute_entrance);
+    points[4] = point_make( 2,  12, 1);
+    tiles[4] = tile_alloc(tile_type_stairs_up);
+    tile_set_features(tiles[4], tile_features_chute_exit);
+    points[5] = point_make( 3,  12, 1);
+    tiles[5] = tile_alloc(tile_type_stairs_up);
+    tile_set_features(tiles[5], tile_features_chimney_up | tile_features_chimney_down);
+    points[6] = point_make( 4,  12, 1);
+    tiles[6] = tile_alloc(tile_type_stairs_up);
+    tile_set_features(tiles[6], tile_features_chute_entrance | tile_features_chute_exit);
+
+    char *thumbnail = tiles_thumbnail_features_alloc(tiles, points, tiles_count);
     assert(thumbnail);
     char const *expected =
             "   -2 -1  0  1  2  3  4 \n"
@@ -98,6 +122,7 @@ tiles_thumbnail_types_alloc_test_for_each_tile_type(void)
 
     free_or_die(thumbnail);
     for (int i = 0; i < tiles_count; ++i) tile_free(tiles[i]);
+    free_or_die(points);
     free_or_die(tiles);
 }
 
@@ -107,20 +132,25 @@ tiles_thumbnail_walls_alloc_test_for_each_wall_type(void)
 {
     int tiles_count = 4;
     struct tile **tiles = calloc_or_die(tiles_count, sizeof(struct tile *));
-    tiles[0] = tile_alloc(point_make(-1, -1, 4), tile_type_empty);
-    tiles[0]->walls.south = wall_type_solid;
-    tiles[0]->walls.west = wall_type_solid;
-    tiles[1] = tile_alloc(point_make( 0, -1, 4), tile_type_empty);
-    tiles[1]->walls.south = wall_type_secret_door;
-    tiles[1]->walls.west = wall_type_secret_door;
-    tiles[2] = tile_alloc(point_make( 1, -1, 4), tile_type_empty);
-    tiles[2]->walls.south = wall_type_none;
-    tiles[2]->walls.west = wall_type_none;
-    tiles[3] = tile_alloc(point_make( 2, -1, 4), tile_type_empty);
-    tiles[3]->walls.south = wall_type_door;
-    tiles[3]->walls.west = wall_type_door;
-
-    char *thumbnail = tiles_thumbnail_walls_alloc(tiles, tiles_count);
+    struct point *points = calloc_or_die(tiles_count, sizeof(struct point));
+    points[0] = point_make(-1, -1, 4);
+    tiles[0] = tile_alloc(tile_type_empty);
+    tile_set_south_wall(tiles[0], wall_type_solid);
+    tile_set_west_wall(tiles[0], wall_type_solid);
+    points[1] = point_make( 0, -1, 4);
+    tiles[1] = tile_alloc(tile_type_empty);
+    tile_set_south_wall(tiles[1], wall_type_secret_door);
+    tile_set_west_wall(tiles[1], wall_type_secret_door);
+    points[2] = point_make( 1, -1, 4);
+    tiles[2] = tile_alloc(tile_type_empty);
+    tile_set_south_wall(tiles[2], wall_type_none);
+    tile_set_west_wall(tiles[2], wall_type_none);
+    points[3] = point_make( 2, -1, 4);
+    tiles[3] = tile_alloc(tile_type_empty);
+    tile_set_south_wall(tiles[3], wall_type_door);
+    tile_set_west_wall(tiles[3], wall_type_door);
+
+    char *thumbnail = tiles_thumbnail_walls_alloc(tiles, points, tiles_count);
     assert(thumbnail);
     char const *expected =
             "   -1  0  1  2 \n"
@@ -129,6 +159,7 @@ tiles_thumbnail_walls_alloc_test_for_each_wall_type(void)
 
     free_or_die(thumbnail);
     for (int i = 0; i < tiles_count; ++i) tile_free(tiles[i]);
+    free_or_die(points);
     free_or_die(tiles);
 }
 
@@ -138,13 +169,15 @@ tiles_thumbnail_types_alloc_test_for_no_tiles(void)
 {
     int tiles_count = 0;
     struct tile **tiles = calloc_or_die(tiles_count, sizeof(struct tile *));
+    struct point *points = calloc_or_die(tiles_count, sizeof(struct point));
 
-    char *thumbnail = tiles_thumbnail_types_alloc(tiles, tiles_count);
+    char *thumbnail = tiles_thumbnail_types_alloc(tiles, points, tiles_count);
     assert(thumbnail);
     assert(str_eq("", thumbnail));
 
     free_or_die(thumbnail);
     for (int i = 0; i < tiles_count; ++i) tile_free(tiles[i]);
+    free_or_die(points);
     free_or_die(tiles);
 }
 
@@ -154,9 +187,11 @@ tiles_thumbnail_types_alloc_test_for_one_tile(void)
 {
     int tiles_count = 1;
     struct tile **tiles = calloc_or_die(tiles_count, sizeof(struct tile *));
-    tiles[0] = tile_alloc(point_make(7, 12, 1), tile_type_empty);
+    struct point *points = calloc_or_die(tiles_count, sizeof(struct point));
+    points[0] = point_make(7, 12, 1);
+    tiles[0] = tile_alloc(tile_type_empty);
 
-    char *thumbnail = tiles_thumbnail_types_alloc(tiles, tiles_count);
+    char *thumbnail = tiles_thumbnail_types_alloc(tiles, points, tiles_count);
     assert(thumbnail);
     char const *expected =
             "    7 \n"
@@ -165,6 +200,7 @@ tiles_thumbnail_types_alloc_test_for_one_tile(void)
 
     free_or_die(thumbnail);
     for (int i = 0; i < tiles_count; ++i) tile_free(tiles[i]);
+    free_or_die(points);
     free_or_die(tiles);
 }
 
@@ -174,13 +210,19 @@ tiles_thumbnail_types_alloc_test_for_multiple_tiles(void)
 {
     int tiles_count = 5;
     struct tile **tiles = calloc_or_die(tiles_count, sizeof(struct tile *));
-    tiles[0] = tile_alloc(point_make(0, 0, 4), tile_type_empty);
-    tiles[1] = tile_alloc(point_make(5, 5, 4), tile_type_filled);
-    tiles[2] = tile_alloc(point_make(2, 2, 4), tile_type_stairs_down);
-    tiles[3] = tile_alloc(point_make(3, 2, 4), tile_type_stairs_down);
-    tiles[4] = tile_alloc(point_make(4, 3, 4), tile_type_filled);
-
-    char *thumbnail = tiles_thumbnail_types_alloc(tiles, tiles_count);
+    struct point *points = calloc_or_die(tiles_count, sizeof(struct point));
+    points[0] = point_make(0, 0, 4);
+    tiles[0] = tile_alloc(tile_type_empty);
+    points[1] = point_make(5, 5, 4);
+    tiles[1] = tile_alloc(tile_type_filled);
+    points[2] = point_make(2, 2, 4);
+    tiles[2] = tile_alloc(tile_type_stairs_down);
+    points[3] = point_make(3, 2, 4);
+    tiles[3] = tile_alloc(tile_type_stairs_down);
+    points[4] = point_make(4, 3, 4);
+    tiles[4] = tile_alloc(tile_type_filled);
+
+    char *thumbnail = tiles_thumbnail_types_alloc(tiles, points, tiles_count);
     assert(thumbnail);
     char const *expected =
             "    0  1  2  3  4  5 \n"
@@ -194,6 +236,7 @@ tiles_thumbnail_types_alloc_test_for_multiple_tiles(void)
 
     free_or_die(thumbnail);
     for (int i = 0; i < tiles_count; ++i) tile_free(tiles[i]);
+    free_or_die(points);
     free_or_die(tiles);
 }
 
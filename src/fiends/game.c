@@ -428,11 +428,14 @@ list_dungeon_level_areas(struct dungeon *dungeon,
         }
     }
     
+    int areas_count;
+    struct area *const *areas = area_index_areas_for_level(dungeon->area_index,
+                                                           level,
+                                                           &areas_count);
     struct ptr_array *lines = ptr_array_alloc();
     ptr_array_add(lines, strdup_or_die("Entrances and Exits:"));
-    for (int i = 0; i < dungeon->areas_count; ++i) {
-        struct area *area = dungeon->areas[i];
-        if (level != area->box.origin.z) continue;
+    for (int i = 0; i < areas_count; ++i) {
+        struct area *area = areas[i];
         if (area_is_level_transition(area)) {
             char *location = point_alloc_xy(area_center_point(area));
             char *description = area_alloc_description(area);
@@ -445,9 +448,8 @@ list_dungeon_level_areas(struct dungeon *dungeon,
     ptr_array_add(lines, strdup_or_die(""));
     ptr_array_add(lines, strdup_or_die("Chambers and Rooms:"));
     
-    for (int i = 0; i < dungeon->areas_count; ++i) {
-        struct area *area = dungeon->areas[i];
-        if (level != area->box.origin.z) continue;
+    for (int i = 0; i < areas_count; ++i) {
+        struct area *area = areas[i];
         if (area_is_chamber_or_room(area)) {
             char *location = point_alloc_xy(area_center_point(area));
             char *description = area_alloc_description(area);
@@ -505,7 +507,7 @@ dungeon_generation_progress(struct generator *generator, void *user_data)
     mvwprintw(window, 4, 2, "%i diggers", generator->diggers_count);
     wclrtoeol(window);
     mvwprintw(window, 5, 2, "%i areas", generator->dungeon->areas_count);
-    mvwprintw(window, 6, 2, "%i tiles", generator->dungeon->tiles_count);
+    mvwprintw(window, 6, 2, "%i tiles", generator->dungeon->tile_grid->tiles_count);
     
     mvwprintw(window, 8, 2, "%i max depth", generator->max_size.height);
     mvwprintw(window, 9, 2, "%i max width", generator->max_size.width);
@@ -561,7 +563,7 @@ generate_dungeon(struct game *game)
     mvwprintw(window, 3, 2, "%i iterations", generator->iteration_count);
     mvwprintw(window, 4, 2, "%i diggers", generator->diggers_count);
     mvwprintw(window, 5, 2, "%i areas", dungeon->areas_count);
-    mvwprintw(window, 6, 2, "%i tiles", dungeon->tiles_count);
+    mvwprintw(window, 6, 2, "%i tiles", dungeon->tile_grid->tiles_count);
     
     mvwprintw(window, 8, 2, "%i max depth", generator->max_size.height);
     mvwprintw(window, 9, 2, "%i max width", generator->max_size.width);
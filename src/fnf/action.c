@@ -15,6 +15,7 @@ static struct {
     { action_magic, "magic" },
     { action_map, "map" },
     { action_table, "table" },
+    { action_treasure, "treasure" },
 };
 static int action_strings_count = ARRAY_COUNT(action_strings);
 
@@ -16,6 +16,9 @@ action_from_string_test(void)
 
     assert(action_treasure == action_from_string("z"));
     assert(action_treasure == action_from_string("Z"));
+
+    assert(action_treasure == action_from_string("treasure"));
+    assert(action_treasure == action_from_string("TREASURE"));
 }
 
 
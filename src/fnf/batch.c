@@ -0,0 +1,125 @@
+#include "batch.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <base/base.h>
+
+
+static int const items_ahead_per_job = 4;
+
+
+struct batch_output {
+    char *buffer;
+    size_t size;
+    bool is_done;
+};
+
+
+struct batch {
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+    batch_item_fn *item;
+    void *user_data;
+    int count;
+    int next_index;
+    int write_index;
+    int max_items_ahead;
+    struct batch_output *outputs;
+};
+
+
+static void
+run_item(struct batch *batch, int index)
+{
+    struct batch_output output = { .is_done=true };
+    FILE *out = open_memstream(&output.buffer, &output.size);
+    if (!out) print_error_and_die();
+    batch->item(index, batch->user_data, out);
+    if (fclose(out)) print_error_and_die();
+
+    pthread_mutex_lock(&batch->mutex);
+    batch->outputs[index] = output;
+    pthread_cond_broadcast(&batch->changed);
+    pthread_mutex_unlock(&batch->mutex);
+}
+
+
+static void *
+run_worker(void *user_data)
+{
+    struct batch *batch = user_data;
+    while (true) {
+        pthread_mutex_lock(&batch->mutex);
+        while (   batch->next_index < batch->count
+               && batch->next_index >= batch->write_index + batch->max_items_ahead)
+        {
+            pthread_cond_wait(&batch->changed, &batch->mutex);
+        }
+        int index = batch->next_index;
+        if (index < batch->count) ++batch->next_index;
+        pthread_mutex_unlock(&batch->mutex);
+
+        if (index >= batch->count) {
+            alloc_or_die_flush_counts();
+            return NULL;
+        }
+        run_item(batch, index);
+    }
+}
+
+
+void
+batch_run(int count,
+          int jobs,
+          batch_item_fn *item,
+          void *user_data,
+          FILE *out)
+{
+    if (jobs <= 1 || count <= 1) {
+        for (int i = 0; i < count; ++i) {
+            item(i, user_data, out);
+        }
+        return;
+    }
+
+    jobs = min(jobs, count);
+    struct batch batch = {
+        .item=item,
+        .user_data=user_data,
+        .count=count,
+        .max_items_ahead=jobs * items_ahead_per_job,
+        .outputs=calloc_or_die(count, sizeof(struct batch_output)),
+    };
+    pthread_mutex_init(&batch.mutex, NULL);
+    pthread_cond_init(&batch.changed, NULL);
+
+    pthread_t *threads = calloc_or_die(jobs, sizeof(pthread_t));
+    for (int i = 0; i < jobs; ++i) {
+        int error = pthread_create(&threads[i], NULL, run_worker, &batch);
+        if (error) fail("Unable to start worker thread: %s", strerror(error));
+    }
+
+    for (int i = 0; i < count; ++i) {
+        pthread_mutex_lock(&batch.mutex);
+        while (!batch.outputs[i].is_done) {
+            pthread_cond_wait(&batch.changed, &batch.mutex);
+        }
+        struct batch_output output = batch.outputs[i];
+        batch.outputs[i].buffer = NULL;
+        batch.write_index = i + 1;
+        pthread_cond_broadcast(&batch.changed);
+        pthread_mutex_unlock(&batch.mutex);
+
+        fwrite(output.buffer, 1, output.size, out);
+        // allocated by open_memstream(), not counted by alloc_or_die
+        free(output.buffer);
+    }
+
+    for (int i = 0; i < jobs; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    free_or_die(threads);
+    pthread_cond_destroy(&batch.changed);
+    pthread_mutex_destroy(&batch.mutex);
+    free_or_die(batch.outputs);
+}
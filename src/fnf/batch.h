@@ -0,0 +1,24 @@
+#ifndef FNF_BATCH_H_INCLUDED
+#define FNF_BATCH_H_INCLUDED
+
+
+#include <stdio.h>
+
+
+// Writes the output for item `index' of a batch to `out'.  Called on worker
+// threads, so it must not touch state shared with other items.
+typedef void (batch_item_fn)(int index, void *user_data, FILE *out);
+
+
+// Runs `item' for indices 0 to `count' - 1 on `jobs' threads and writes their
+// output to `out' in index order, so the output doesn't depend on the number
+// of jobs.  Workers run at most a few items ahead of the output.
+void
+batch_run(int count,
+          int jobs,
+          batch_item_fn *item,
+          void *user_data,
+          FILE *out);
+
+
+#endif
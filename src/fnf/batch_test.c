@@ -0,0 +1,58 @@
+#include <assert.h>
+#include <base/base.h>
+#include "batch.h"
+
+
+void
+batch_test(void);
+
+
+static void
+print_item(int index, void *user_data, FILE *out)
+{
+    char *text = str_alloc_formatted("item %i of %i\n", index, *(int *)user_data);
+    fprintf(out, "%s", text);
+    free_or_die(text);
+}
+
+
+static char *
+alloc_batch_output(int count, int jobs)
+{
+    char *buffer = NULL;
+    size_t size = 0;
+    FILE *out = open_memstream(&buffer, &size);
+    batch_run(count, jobs, print_item, &count, out);
+    fclose(out);
+    char *output = strdup_or_die(buffer);
+    free(buffer);
+    return output;
+}
+
+
+static void
+batch_run_test(void)
+{
+    char *expected = alloc_batch_output(3, 1);
+    assert(str_eq("item 0 of 3\nitem 1 of 3\nitem 2 of 3\n", expected));
+    free_or_die(expected);
+
+    expected = alloc_batch_output(200, 1);
+    for (int jobs = 2; jobs <= 8; jobs *= 2) {
+        char *output = alloc_batch_output(200, jobs);
+        assert(str_eq(expected, output));
+        free_or_die(output);
+    }
+    free_or_die(expected);
+
+    char *output = alloc_batch_output(0, 4);
+    assert(str_eq("", output));
+    free_or_die(output);
+}
+
+
+void
+batch_test(void)
+{
+    batch_run_test();
+}
@@ -5,6 +5,9 @@
 void
 action_test(void);
 
+void
+batch_test(void);
+
 void
 options_test(void);
 
@@ -13,6 +16,7 @@ int
 main(int argc, char *argv[])
 {
     action_test();
+    batch_test();
     options_test();
     alloc_count_is_zero_or_die();
     return EXIT_SUCCESS;
@@ -1,5 +1,7 @@
 #include "options.h"
 
+#include <limits.h>
+#include <time.h>
 #include <base/base.h>
 #include <character/character.h>
 #include <dungeon/dungeon.h>
@@ -7,10 +9,15 @@
 #include <mechanics/mechanics.h>
 #include <treasure/treasure.h>
 
+#include "batch.h"
+
 
 static void
 check(FILE *out, uint32_t constant);
 
+static void
+check_streams(FILE *out);
+
 static void
 enumerate_treasure_items(struct treasure *treasure, FILE *out);
 
@@ -19,6 +26,13 @@ generate_character(struct rnd *rnd,
                    FILE *out,
                    enum ability_score_generation_method method);
 
+static void
+generate_characters(struct rnd *rnd,
+                    enum ability_score_generation_method method,
+                    int count,
+                    enum output_format output_format,
+                    FILE *out);
+
 static void
 generate_each_treasure(struct rnd *rnd, FILE *out);
 
@@ -33,9 +47,22 @@ generate_random_dungeon(struct rnd *rnd,
                         struct dungeon_options *dungeon_options,
                         FILE *out);
 
+static void
+generate_random_dungeons(struct rnd *rnd, int count, int jobs, FILE *out);
+
 static void
 generate_sample_dungeon(struct rnd *rnd, FILE *out);
 
+static void
+generate_substream_treasure(int index, void *user_data, FILE *out);
+
+static void
+generate_treasure_hoards(struct rnd *rnd,
+                         char letter,
+                         int count,
+                         char const *command_name,
+                         FILE *out);
+
 static void
 generate_treasure_type(struct rnd *rnd,
                        FILE *out,
@@ -72,6 +99,9 @@ print_treasure_as_json(struct treasure *treasure, FILE *out);
 static void
 print_treasure_as_text(struct treasure *treasure, FILE *out);
 
+static void
+print_values(char const *label, struct rnd *rnd, FILE *out);
+
 
 static void
 check(FILE *out, uint32_t constant)
@@ -97,6 +127,40 @@ check(FILE *out, uint32_t constant)
 }
 
 
+static void
+check_streams(FILE *out)
+{
+    uint64_t const seed = 12345;
+    int const substreams_count = 8;
+    int const jobs = 4;
+
+    struct rnd *rnd = rnd_alloc_splitmix64(seed);
+    print_values("splitmix64 seed 12345", rnd, out);
+    rnd_jump(rnd, 1000000);
+    print_values("after jumping 1000000", rnd, out);
+
+    for (int i = 0; i < 3; ++i) {
+        char *label = str_alloc_formatted("substream %i", i);
+        struct rnd *substream = rnd_alloc_substream(rnd, i);
+        print_values(label, substream, out);
+        rnd_free(substream);
+        free_or_die(label);
+    }
+
+    struct rnd *substream = rnd_alloc_substream(rnd, 1);
+    struct rnd *nested = rnd_alloc_substream(substream, 2);
+    print_values("substream 2 of substream 1", nested, out);
+    rnd_free(nested);
+    rnd_free(substream);
+    fprintf(out, "\n");
+
+    // the same treasures for any number of jobs
+    batch_run(substreams_count, jobs, generate_substream_treasure, rnd, out);
+
+    rnd_free(rnd);
+}
+
+
 static void
 enumerate_treasure_items(struct treasure *treasure, FILE *out)
 {
@@ -200,6 +264,43 @@ generate_character(struct rnd *rnd,
 }
 
 
+static void
+generate_characters(struct rnd *rnd,
+                    enum ability_score_generation_method method,
+                    int count,
+                    enum output_format output_format,
+                    FILE *out)
+{
+    int const batch_capacity = 1024;
+    enum ability_flag special_abilities = ability_flag_strength;
+    struct abilities_batch *batch = abilities_batch_alloc(min(count, batch_capacity));
+
+    if (output_format_csv == output_format) {
+        fprintf(out, "strength,intelligence,wisdom,dexterity,constitution,charisma\n");
+    }
+    for (int first = 0; first < count; first += batch->capacity) {
+        int batch_count = min(count - first, batch->capacity);
+        abilities_generate_batch(method, special_abilities, rnd, batch_count, batch);
+        for (int i = 0; i < batch_count; ++i) {
+            if (output_format_csv == output_format) {
+                fprintf(out, "%i,%i,%i,%i,%i,%i\n",
+                        batch->strength[i], batch->intelligence[i],
+                        batch->wisdom[i], batch->dexterity[i],
+                        batch->constitution[i], batch->charisma[i]);
+            } else {
+                fprintf(out, "{\"strength\":%i,\"intelligence\":%i,\"wisdom\":%i,"
+                             "\"dexterity\":%i,\"constitution\":%i,\"charisma\":%i}\n",
+                        batch->strength[i], batch->intelligence[i],
+                        batch->wisdom[i], batch->dexterity[i],
+                        batch->constitution[i], batch->charisma[i]);
+            }
+        }
+    }
+
+    abilities_batch_free(batch);
+}
+
+
 static void
 generate_each_treasure(struct rnd *rnd, FILE *out)
 {
@@ -256,6 +357,44 @@ generate_random_dungeon(struct rnd *rnd,
 }
 
 
+static void
+generate_seeded_dungeon(int index, void *user_data, FILE *out)
+{
+    unsigned short (*seeds)[3] = user_data;
+    unsigned short *seed = seeds[index];
+    unsigned long long long_seed = (unsigned long long)seed[2] << 32
+                                 | (unsigned long long)seed[1] << 16
+                                 | seed[0];
+    // matches `fnf --jrand48=SEED dungeon'
+    struct rnd *rnd = rnd_alloc_jrand48(seed);
+    struct dungeon_options *dungeon_options = dungeon_options_alloc_default();
+    dungeon_options->padding = rnd_next_uniform_value(rnd, 2);
+
+    if (index > 0) fprintf(out, "\n");
+    fprintf(out, "Dungeon %i (jrand48 seed %llu)\n", index + 1, long_seed);
+    fprintf(out, "\n");
+    generate_random_dungeon(rnd, dungeon_options, out);
+
+    dungeon_options_free(dungeon_options);
+    rnd_free(rnd);
+}
+
+
+static void
+generate_random_dungeons(struct rnd *rnd, int count, int jobs, FILE *out)
+{
+    // seeds are drawn up front so each dungeon is the same for any `jobs'
+    unsigned short (*seeds)[3] = calloc_or_die(count, sizeof seeds[0]);
+    for (int i = 0; i < count; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            seeds[i][j] = rnd_next_uniform_value_in_range(rnd, 0, USHRT_MAX);
+        }
+    }
+    batch_run(count, jobs, generate_seeded_dungeon, seeds, out);
+    free_or_die(seeds);
+}
+
+
 static void
 generate_sample_dungeon(struct rnd *rnd, FILE *out)
 {
@@ -266,6 +405,51 @@ generate_sample_dungeon(struct rnd *rnd, FILE *out)
 }
 
 
+static void
+generate_substream_treasure(int index, void *user_data, FILE *out)
+{
+    struct rnd *substream = rnd_alloc_substream(user_data, index);
+    char letter = 'A' + index;
+    fprintf(out, "Substream %i, treasure type %c:\n", index, letter);
+    generate_treasure_type(substream, out, output_format_text, letter);
+    rnd_free(substream);
+}
+
+
+static void
+generate_treasure_hoards(struct rnd *rnd,
+                         char letter,
+                         int count,
+                         char const *command_name,
+                         FILE *out)
+{
+    struct treasure_type *treasure_type = treasure_type_by_letter(letter);
+    struct treasure treasure;
+    struct json_writer *writer = json_writer_alloc_for_file(out, false);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    // one treasure is cleared and reused, so its arrays only grow when a
+    // hoard needs more room
+    treasure_initialize(&treasure);
+    for (int i = 0; i < count; ++i) {
+        treasure_type_generate(treasure_type, rnd, &treasure);
+        treasure_write_json(&treasure, writer);
+        fputc('\n', out);
+        treasure_clear(&treasure);
+    }
+    treasure_finalize(&treasure);
+
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (double)(end.tv_sec - start.tv_sec)
+                   + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    fprintf(stderr, "%s: %i hoards in %.3f seconds (%.0f hoards/second)\n",
+            command_name, count, seconds, seconds > 0.0 ? count / seconds : 0.0);
+    json_writer_free(writer);
+}
+
+
 static void
 generate_treasure_type(struct rnd *rnd,
                        FILE *out,
@@ -283,6 +467,8 @@ generate_treasure_type(struct rnd *rnd,
         case output_format_json:
             print_treasure_as_json(&treasure, out);
             break;
+        case output_format_csv:
+            break;
     }
 
     treasure_finalize(&treasure);
@@ -306,6 +492,7 @@ main(int argc, char *argv[])
 {
     FILE *out = stdout;
     struct options *options = options_alloc(argc, argv);
+    bool are_records_streamed = false;
     
     if (options->error || options->help) {
         options_print_usage(options);
@@ -317,14 +504,34 @@ main(int argc, char *argv[])
     }
     switch (options->action) {
         case action_character:
-            generate_character(options->rnd, out, options->character_method);
+            if (output_format_text == options->output_format) {
+                for (int i = 0; i < options->count; ++i) {
+                    generate_character(options->rnd, out, options->character_method);
+                }
+            } else {
+                are_records_streamed = true;
+                generate_characters(options->rnd,
+                                    options->character_method,
+                                    options->count,
+                                    options->output_format,
+                                    out);
+            }
             break;
         case action_check:
-            check(out, options->check_constant);
+            if (options->check_streams) {
+                check_streams(out);
+            } else {
+                check(out, options->check_constant);
+            }
             break;
         case action_dungeon:
             if (options->dungeon_type_small) {
                 generate_sample_dungeon(options->rnd, out);
+            } else if (options->count > 1) {
+                generate_random_dungeons(options->rnd,
+                                         options->count,
+                                         options->jobs,
+                                         out);
             } else {
                 generate_random_dungeon(options->rnd,
                                         options->dungeon_options,
@@ -344,16 +551,28 @@ main(int argc, char *argv[])
             generate_treasure_type_table(out);
             break;
         case action_treasure:
-            generate_treasure_type(options->rnd,
-                                   out,
-                                   options->output_format,
-                                   options->treasure_type);
+            if (output_format_json == options->output_format && options->count > 1) {
+                are_records_streamed = true;
+                generate_treasure_hoards(options->rnd,
+                                         options->treasure_type,
+                                         options->count,
+                                         options->command_name,
+                                         out);
+            } else {
+                for (int i = 0; i < options->count; ++i) {
+                    generate_treasure_type(options->rnd,
+                                           out,
+                                           options->output_format,
+                                           options->treasure_type);
+                }
+            }
             break;
         default:
             fprintf(stderr, "%s: unrecognized option\n", options->command_name);
             break;
     }
-    fprintf(out, "\n");
+    // json and csv records are streamed one per line with nothing after them
+    if (!are_records_streamed) fprintf(out, "\n");
 
     options_free(options);
     alloc_count_is_zero_or_die();
@@ -488,29 +707,30 @@ print_character_ability_scores(struct ability_scores *ability_scores,
 static void
 print_dungeon(struct dungeon *dungeon, FILE *out)
 {
-    int starting_level = dungeon_starting_level(dungeon);
-    int level_count = dungeon_level_count(dungeon);
+    struct frozen_dungeon *frozen_dungeon = dungeon_freeze(dungeon);
+    int starting_level = frozen_dungeon_starting_level(frozen_dungeon);
+    int level_count = frozen_dungeon_level_count(frozen_dungeon);
     for (int i = 0; i < level_count; ++i) {
         if (i > 0) fprintf(out, "\n");
         int level = starting_level + i;
         fprintf(out, "Level %i\n", level);
         fprintf(out, "\n");
-        dungeon_print_map_for_level(dungeon, level, out);
+        frozen_dungeon_print_map_for_level(frozen_dungeon, level, out);
         fprintf(out, "\n");
         fprintf(out, "Level %i Areas of Interest:\n", level);
-        dungeon_print_areas_for_level(dungeon, level, out);
+        frozen_dungeon_print_areas_for_level(frozen_dungeon, level, out);
     }
+    frozen_dungeon_free(frozen_dungeon);
 }
 
 
 static void
 print_treasure_as_json(struct treasure *treasure, FILE *out)
 {
-    struct cJSON *json_object = treasure_create_json_object(treasure);
-    char *json_string = cJSON_Print(json_object);
-    fprintf(out, "%s\n", json_string);
-    free(json_string);
-    cJSON_Delete(json_object);
+    struct json_writer *writer = json_writer_alloc_for_file(out, true);
+    treasure_write_json(treasure, writer);
+    fputc('\n', out);
+    json_writer_free(writer);
 }
 
 
@@ -524,3 +744,14 @@ print_treasure_as_text(struct treasure *treasure, FILE *out)
     ptr_array_clear(lines, free_or_die);
     ptr_array_free(lines);
 }
+
+
+static void
+print_values(char const *label, struct rnd *rnd, FILE *out)
+{
+    fprintf(out, "%-28s", label);
+    for (int i = 0; i < 4; ++i) {
+        fprintf(out, " %10u", rnd_next_value(rnd));
+    }
+    fprintf(out, "\n");
+}
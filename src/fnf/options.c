@@ -7,6 +7,12 @@
 
 
 static struct option long_options[] = {
+    {
+        .name="count",
+        .has_arg=required_argument,
+        .flag=NULL,
+        .val=option_value_count
+    },
     {
         .name="debug",
         .has_arg=no_argument,
@@ -25,12 +31,24 @@ static struct option long_options[] = {
         .flag=NULL,
         .val=option_value_help
     },
+    {
+        .name="jobs",
+        .has_arg=required_argument,
+        .flag=NULL,
+        .val=option_value_jobs
+    },
     {
         .name="jrand48",
         .has_arg=required_argument,
         .flag=NULL,
         .val=option_value_jrand48
     },
+    {
+        .name="splitmix64",
+        .has_arg=required_argument,
+        .flag=NULL,
+        .val=option_value_splitmix64
+    },
     {
         .name="verbose",
         .has_arg=no_argument,
@@ -50,6 +68,7 @@ static char const short_options[] = "dhj:v";
 static char const *output_formats[] = {
         "text",
         "json",
+        "csv",
 };
 static size_t const output_formats_count = ARRAY_COUNT(output_formats);
 
@@ -88,6 +107,10 @@ get_action(struct options *options, int argc, char *argv[], int start_index)
     
     set_action_modifier_defaults(options, action_string);
     if (remaining_arg_count) get_action_modifiers(options, argc, argv, i);
+    if (action_treasure == options->action && !options->treasure_type && !options->error) {
+        fprintf(stderr, "%s: no treasure type given\n", options->command_name);
+        options->error = true;
+    }
 }
 
 
@@ -115,6 +138,10 @@ get_action_modifiers(struct options *options,
             }
             break;
         case action_check:
+            if (0 == strcasecmp("streams", modifier_string)) {
+                options->check_streams = true;
+                break;
+            }
             errno = 0;
             options->check_constant = (uint32_t)strtoul(modifier_string, NULL, 10);
             if (errno) {
@@ -143,6 +170,15 @@ get_action_modifiers(struct options *options,
                         options->command_name, modifier_string);
             }
             break;
+        case action_treasure:
+            if (1 == strlen(modifier_string) && isalpha(modifier_string[0])) {
+                options->treasure_type = toupper(modifier_string[0]);
+            } else {
+                options->error = true;
+                fprintf(stderr, "%s: invalid treasure type - %s\n",
+                        options->command_name, modifier_string);
+            }
+            break;
         default:
             break;
     }
@@ -156,6 +192,21 @@ get_action_modifiers(struct options *options,
 }
 
 
+static int
+get_positive_int(struct options *options, char const *arg, char const *name)
+{
+    char *end;
+    errno = 0;
+    long value = strtol(arg, &end, 10);
+    if (errno || end == arg || *end || value < 1 || value > INT_MAX) {
+        options->error = true;
+        fprintf(stderr, "%s: invalid %s - %s\n", options->command_name, name, arg);
+        return 1;
+    }
+    return (int)value;
+}
+
+
 static void
 get_format(struct options *options, char const *arg)
 {
@@ -191,6 +242,23 @@ get_jrand48(struct options *options, char const *arg)
 }
 
 
+static void
+get_splitmix64(struct options *options, char const *arg)
+{
+    char *end;
+    errno = 0;
+    unsigned long long seed = strtoull(arg, &end, 0);
+    if (errno || end == arg || *end) {
+        options->error = true;
+        fprintf(stderr, "%s: invalid splitmix64 seed - %s\n",
+                options->command_name, arg);
+        return;
+    }
+    rnd_free(options->rnd);
+    options->rnd = rnd_alloc_splitmix64(seed);
+}
+
+
 static void
 getopt_reset(void)
 {
@@ -209,6 +277,9 @@ get_options(struct options *options, int argc, char *argv[])
     int long_option_index;
     while (-1 != (ch = getopt_long(argc, argv, short_options, long_options, &long_option_index))) {
         switch (ch) {
+            case option_value_count:
+                options->count = get_positive_int(options, optarg, "count");
+                break;
             case option_value_debug:
                 options->debug = true;
                 break;
@@ -218,9 +289,15 @@ get_options(struct options *options, int argc, char *argv[])
             case option_value_help:
                 options->help = true;
                 return optind;
+            case option_value_jobs:
+                options->jobs = get_positive_int(options, optarg, "jobs");
+                break;
             case option_value_jrand48:
                 get_jrand48(options, optarg);
                 break;
+            case option_value_splitmix64:
+                get_splitmix64(options, optarg);
+                break;
             case option_value_verbose:
                 options->verbose = true;
                 break;
@@ -238,12 +315,30 @@ options_alloc(int argc, char *argv[])
 {
     struct options *options = calloc_or_die(1, sizeof(struct options));
     options->command_name = basename_or_die(argv[0]);
+    options->count = 1;
+    options->jobs = 1;
     options->rnd = rnd_alloc();
     
     int action_index = get_options(options, argc, argv);
     if (options->error) return options;
     
     get_action(options, argc, argv, action_index);
+    if (   output_format_csv == options->output_format
+        && action_character != options->action
+        && !options->error)
+    {
+        options->error = true;
+        fprintf(stderr, "%s: csv format is only available for characters\n",
+                options->command_name);
+    }
+    if (   options->jobs > 1
+        && (action_dungeon != options->action || options->dungeon_type_small)
+        && !options->error)
+    {
+        options->error = true;
+        fprintf(stderr, "%s: jobs are only available for random dungeons\n",
+                options->command_name);
+    }
     return options;
 }
 
@@ -268,12 +363,20 @@ options_print_usage(struct options const *options)
     
     fprintf(out, "Usage: %s [OPTIONS] ACTION\n", options->command_name);
     fprintf(out, "\n");
+    fprintf(out, "  --count=N           generate N dungeons, characters or treasures\n");
+    fprintf(out, "                        (default 1)\n");
     fprintf(out, "  -d, --debug         print debugging information\n");
     fprintf(out, "  -h, --help          display this help message and exit\n");
+    fprintf(out, "  --jobs=J            generate random dungeons on J threads\n");
+    fprintf(out, "                        (default 1)\n");
     fprintf(out, "  -j, --jrand48=SEED  use the jrand48 random number generator\n");
     fprintf(out, "                        with the given 48-bit SEED\n");
+    fprintf(out, "  --splitmix64=SEED   use the splitmix64 random number generator\n");
+    fprintf(out, "                        with the given 64-bit SEED\n");
     fprintf(out, "  ---format=FORMAT    output format where FORMAT is\n");
-    fprintf(out, "                        `text' or `json' (default `text'\n");
+    fprintf(out, "                        `text', `json' or `csv' (default `text');\n");
+    fprintf(out, "                        characters in `json' are one object per line,\n");
+    fprintf(out, "                        as are treasures when N is more than 1\n");
     fprintf(out, "  -v, --verbose       print more details\n");
     fprintf(out, "\n");
     fprintf(out, "Available actions:\n");
@@ -283,13 +386,15 @@ options_print_usage(struct options const *options)
     fprintf(out, "                        (default `simple')\n");
     fprintf(out, "  check [N]           run tests where N is the \"constant\"\n");
     fprintf(out, "                        random number (default 0)\n");
+    fprintf(out, "  check streams       check splitmix64 streams and substreams\n");
     fprintf(out, "  dungeon [TYPE]      generate a dungeon where TYPE is\n");
     fprintf(out, "                        `random' or `small' (default `random')\n");
     fprintf(out, "  each                generate one of each treasure\n");
     fprintf(out, "  magic [COUNT]       generate COUNT magic items (default 10)\n");
     fprintf(out, "  map                 generate one treasure map\n");
     fprintf(out, "  table               generate the treasure type table\n");
-    fprintf(out, "  LETTER              generate the treasure type for LETTER (A-Z)\n");
+    fprintf(out, "  treasure LETTER     generate the treasure type for LETTER (A-Z)\n");
+    fprintf(out, "  LETTER              same as `treasure LETTER'\n");
 }
 
 
@@ -302,6 +407,7 @@ set_action_modifier_defaults(struct options *options, char const *action_string)
             break;
         case action_check:
             options->check_constant = 0;
+            options->check_streams = false;
             break;
         case action_dungeon:
             options->dungeon_type_small = false;
@@ -312,7 +418,11 @@ set_action_modifier_defaults(struct options *options, char const *action_string)
             options->magic_count = 10;
             break;
         case action_treasure:
-            options->treasure_type = toupper(action_string[0]);
+            if (1 == strlen(action_string)) {
+                options->treasure_type = toupper(action_string[0]);
+            } else {
+                options->treasure_type = '\0';
+            }
             break;
         default:
             break;
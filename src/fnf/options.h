@@ -14,6 +14,7 @@
 enum output_format {
     output_format_text = 0,
     output_format_json,
+    output_format_csv,
 };
 
 
@@ -26,7 +27,10 @@ enum option_value {
     option_value_verbose = 'v',
 
     option_value_long_only = CHAR_MAX,
+    option_value_count,
     option_value_format,
+    option_value_jobs,
+    option_value_splitmix64,
 };
 
 
@@ -43,11 +47,14 @@ struct options {
         int magic_count;
         char treasure_type;
     };
+    bool check_streams;
     char *command_name;
+    int count;
     bool debug;
     struct dungeon_options *dungeon_options;
     bool error;
     bool help;
+    int jobs;
     enum output_format output_format;
     struct rnd *rnd;
     bool verbose;
@@ -23,6 +23,8 @@ options_alloc_with_no_args_test(void)
     assert(output_format_text == options->output_format);
     assert(options->rnd);
     assert( ! options->verbose);
+    assert(1 == options->count);
+    assert(1 == options->jobs);
 
     options_free(options);
 }
@@ -81,6 +83,47 @@ options_alloc_with_character_action_test(void)
 }
 
 
+static void
+options_alloc_with_character_count_test(void)
+{
+    char *argv[] = {
+        "/usr/local/bin/fnf",
+        "--count=500",
+        "--format=csv",
+        "character",
+        "generalnpc",
+    };
+    int argc = ARRAY_COUNT(argv);
+    struct options *options = options_alloc(argc, argv);
+
+    assert(action_character == options->action);
+    assert(ability_score_generation_method_general_NPC == options->character_method);
+    assert(500 == options->count);
+    assert(output_format_csv == options->output_format);
+    assert( ! options->error);
+
+    options_free(options);
+}
+
+
+static void
+options_alloc_with_csv_format_for_treasure_test(void)
+{
+    char *argv[] = {
+        "/usr/local/bin/fnf",
+        "--format=csv",
+        "A",
+    };
+    int argc = ARRAY_COUNT(argv);
+    struct options *options = options_alloc(argc, argv);
+
+    assert(action_treasure == options->action);
+    assert(options->error);
+
+    options_free(options);
+}
+
+
 static void
 options_alloc_with_check_action_test(void)
 {
@@ -93,6 +136,7 @@ options_alloc_with_check_action_test(void)
 
     assert(action_check == options->action);
     assert(0 == options->check_constant);
+    assert( ! options->check_streams);
 
     assert(str_eq("fnf", options->command_name));
     assert( ! options->debug);
@@ -107,6 +151,25 @@ options_alloc_with_check_action_test(void)
 }
 
 
+static void
+options_alloc_with_check_streams_action_test(void)
+{
+    char *argv[] = {
+        "/usr/local/bin/fnf",
+        "check",
+        "streams",
+    };
+    int argc = ARRAY_COUNT(argv);
+    struct options *options = options_alloc(argc, argv);
+
+    assert(action_check == options->action);
+    assert(options->check_streams);
+    assert( ! options->error);
+
+    options_free(options);
+}
+
+
 static void
 options_alloc_with_dungeon_action_test(void)
 {
@@ -133,6 +196,103 @@ options_alloc_with_dungeon_action_test(void)
 }
 
 
+static void
+options_alloc_with_dungeon_count_test(void)
+{
+    char *argv[] = {
+        "/usr/local/bin/fnf",
+        "--jrand48=42",
+        "dungeon",
+        "random",
+        "--count", "12",
+        "--jobs=4",
+    };
+    int argc = ARRAY_COUNT(argv);
+    struct options *options = options_alloc(argc, argv);
+
+    assert(action_dungeon == options->action);
+    assert( ! options->dungeon_type_small);
+    assert(12 == options->count);
+    assert(4 == options->jobs);
+    assert( ! options->error);
+
+    options_free(options);
+}
+
+
+static void
+options_alloc_with_jobs_for_small_dungeon_test(void)
+{
+    char *argv[] = {
+        "/usr/local/bin/fnf",
+        "--jobs=4",
+        "dungeon",
+        "small",
+    };
+    int argc = ARRAY_COUNT(argv);
+    struct options *options = options_alloc(argc, argv);
+
+    assert(action_dungeon == options->action);
+    assert(options->error);
+
+    options_free(options);
+}
+
+
+static void
+options_alloc_with_jobs_for_treasure_test(void)
+{
+    char *argv[] = {
+        "/usr/local/bin/fnf",
+        "--jobs=4",
+        "--count=10",
+        "A",
+    };
+    int argc = ARRAY_COUNT(argv);
+    struct options *options = options_alloc(argc, argv);
+
+    assert(action_treasure == options->action);
+    assert(options->error);
+
+    options_free(options);
+}
+
+
+static void
+options_alloc_with_splitmix64_test(void)
+{
+    char *argv[] = {
+        "/usr/local/bin/fnf",
+        "--splitmix64=12345",
+        "each",
+    };
+    int argc = ARRAY_COUNT(argv);
+    struct options *options = options_alloc(argc, argv);
+
+    assert( ! options->error);
+    assert(571572824 == rnd_next_value(options->rnd));
+
+    options_free(options);
+}
+
+
+static void
+options_alloc_with_invalid_count_test(void)
+{
+    char *argv[] = {
+        "/usr/local/bin/fnf",
+        "--count=0",
+        "dungeon",
+    };
+    int argc = ARRAY_COUNT(argv);
+    struct options *options = options_alloc(argc, argv);
+
+    assert(options->error);
+
+    options_free(options);
+}
+
+
 static void
 options_alloc_with_each_action_test(void)
 {
@@ -260,17 +420,86 @@ options_alloc_with_treasure_type_action_test(void)
 }
 
 
+static void
+options_alloc_with_treasure_action_test(void)
+{
+    char *argv[] = {
+        "/usr/local/bin/fnf",
+        "--count=1000",
+        "--format=json",
+        "treasure",
+        "h",
+    };
+    int argc = ARRAY_COUNT(argv);
+    struct options *options = options_alloc(argc, argv);
+
+    assert(action_treasure == options->action);
+    assert('H' == options->treasure_type);
+    assert(1000 == options->count);
+    assert(output_format_json == options->output_format);
+    assert( ! options->error);
+
+    options_free(options);
+}
+
+
+static void
+options_alloc_with_treasure_action_without_type_test(void)
+{
+    char *argv[] = {
+        "/usr/local/bin/fnf",
+        "treasure",
+    };
+    int argc = ARRAY_COUNT(argv);
+    struct options *options = options_alloc(argc, argv);
+
+    assert(action_treasure == options->action);
+    assert(options->error);
+
+    options_free(options);
+}
+
+
+static void
+options_alloc_with_treasure_action_invalid_type_test(void)
+{
+    char *argv[] = {
+        "/usr/local/bin/fnf",
+        "treasure",
+        "hh",
+    };
+    int argc = ARRAY_COUNT(argv);
+    struct options *options = options_alloc(argc, argv);
+
+    assert(action_treasure == options->action);
+    assert(options->error);
+
+    options_free(options);
+}
+
+
 void
 options_test(void)
 {
     options_alloc_with_no_args_test();
     options_alloc_with_no_action_test();
     options_alloc_with_character_action_test();
+    options_alloc_with_character_count_test();
+    options_alloc_with_csv_format_for_treasure_test();
     options_alloc_with_check_action_test();
+    options_alloc_with_check_streams_action_test();
     options_alloc_with_dungeon_action_test();
+    options_alloc_with_dungeon_count_test();
+    options_alloc_with_jobs_for_small_dungeon_test();
+    options_alloc_with_jobs_for_treasure_test();
+    options_alloc_with_invalid_count_test();
+    options_alloc_with_splitmix64_test();
     options_alloc_with_each_action_test();
     options_alloc_with_magic_action_test();
     options_alloc_with_map_action_test();
     options_alloc_with_table_action_test();
     options_alloc_with_treasure_type_action_test();
+    options_alloc_with_treasure_action_test();
+    options_alloc_with_treasure_action_without_type_test();
+    options_alloc_with_treasure_action_invalid_type_test();
 }
@@ -23,6 +23,57 @@ json_array_get_string_value(struct cJSON *json_array,
     assert(cJSON_IsArray(json_array));
 
     struct cJSON *item = cJSON_GetArrayItem(json_array, index);
+    return json_item_get_string_value(item, default_value);
+}
+
+
+char *
+json_item_alloc_string_value(struct cJSON *item, char const *default_value)
+{
+    char const *string_value = json_item_get_string_value(item, default_value);
+    return string_value ? strdup_or_die(string_value) : NULL;
+}
+
+
+bool
+json_item_get_bool_value(struct cJSON *item, bool default_value)
+{
+    if (cJSON_IsTrue(item)) {
+        return true;
+    } else if (cJSON_IsFalse(item)) {
+        return false;
+    } else {
+        return default_value;
+    }
+}
+
+
+int
+json_item_get_int_value(struct cJSON *item, int default_value)
+{
+    if ( ! cJSON_IsNumber(item)) return default_value;
+    if (item->valuedouble > (double)INT_MAX) return INT_MAX;
+    if (item->valuedouble < (double)INT_MIN) return INT_MIN;
+    return (int)item->valuedouble;
+}
+
+
+int
+json_item_get_string_enum_value(struct cJSON *item,
+                                json_string_enum_lookup_fn lookup_fn,
+                                int default_value)
+{
+    if (cJSON_IsString(item)) {
+        return lookup_fn(item->valuestring, default_value);
+    } else {
+        return default_value;
+    }
+}
+
+
+char const *
+json_item_get_string_value(struct cJSON *item, char const *default_value)
+{
     return cJSON_IsString(item) ? item->valuestring : default_value;
 }
 
@@ -45,13 +96,7 @@ json_object_get_bool_value(struct cJSON *json_object,
     assert(cJSON_IsObject(json_object));
 
     struct cJSON *item = cJSON_GetObjectItemCaseSensitive(json_object, name);
-    if (cJSON_IsTrue(item)) {
-        return true;
-    } else if (cJSON_IsFalse(item)) {
-        return false;
-    } else {
-        return default_value;
-    }
+    return json_item_get_bool_value(item, default_value);
 }
 
 
@@ -63,10 +108,7 @@ json_object_get_int_value(struct cJSON *json_object,
     assert(cJSON_IsObject(json_object));
 
     struct cJSON *item = cJSON_GetObjectItemCaseSensitive(json_object, name);
-    if ( ! cJSON_IsNumber(item)) return default_value;
-    if (item->valuedouble > (double)INT_MAX) return INT_MAX;
-    if (item->valuedouble < (double)INT_MIN) return INT_MIN;
-    return (int)item->valuedouble;
+    return json_item_get_int_value(item, default_value);
 }
 
 
@@ -79,11 +121,7 @@ json_object_get_string_enum_value(struct cJSON *json_object,
     assert(cJSON_IsObject(json_object));
 
     struct cJSON *item = cJSON_GetObjectItemCaseSensitive(json_object, name);
-    if (cJSON_IsString(item)) {
-        return lookup_fn(item->valuestring, default_value);
-    } else {
-        return default_value;
-    }
+    return json_item_get_string_enum_value(item, lookup_fn, default_value);
 }
 
 
@@ -95,7 +133,7 @@ json_object_get_string_value(struct cJSON *json_object,
     assert(cJSON_IsObject(json_object));
 
     struct cJSON *item = cJSON_GetObjectItemCaseSensitive(json_object, name);
-    return cJSON_IsString(item) ? item->valuestring : default_value;
+    return json_item_get_string_value(item, default_value);
 }
 
 
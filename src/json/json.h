@@ -5,6 +5,10 @@
 #include <stdbool.h>
 #include <cJSON.h>
 
+#include "json_key_index.h"
+#include "json_reader.h"
+#include "json_writer.h"
+
 
 typedef int
 (json_string_enum_lookup_fn)(char const *value, int default_value);
@@ -20,6 +24,25 @@ json_array_get_string_value(struct cJSON *json_array,
                             int index,
                             char const *default_value);
 
+// The json_item_* functions read the value of an array element or object
+// member already in hand, such as the one from cJSON_ArrayForEach().
+char *
+json_item_alloc_string_value(struct cJSON *item, char const *default_value);
+
+bool
+json_item_get_bool_value(struct cJSON *item, bool default_value);
+
+int
+json_item_get_int_value(struct cJSON *item, int default_value);
+
+int
+json_item_get_string_enum_value(struct cJSON *item,
+                                json_string_enum_lookup_fn lookup_fn,
+                                int default_value);
+
+char const *
+json_item_get_string_value(struct cJSON *item, char const *default_value);
+
 char *
 json_object_alloc_string_value(struct cJSON *json_object,
                                char const *name,
@@ -0,0 +1,75 @@
+#include "json_key_index.h"
+
+#include <assert.h>
+#include <base/base.h>
+
+
+static uint32_t
+hash_name(char const *name)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (unsigned char const *ch = (unsigned char const *)name; *ch; ++ch) {
+        hash = (hash ^ *ch) * 16777619u;
+    }
+    return hash;
+}
+
+
+int
+json_key_index_find(struct json_key_index const *json_key_index,
+                    char const *name)
+{
+    if (!name) return -1;
+    uint32_t const mask = json_key_index_slots_count - 1;
+    uint32_t hash = hash_name(name);
+    uint32_t slot = hash & mask;
+    while (json_key_index->positions[slot] >= 0) {
+        int position = json_key_index->positions[slot];
+        if (   hash == json_key_index->hashes[slot]
+            && str_eq(name, json_key_index->names[position]))
+        {
+            return position;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+
+int
+json_key_index_find_first(struct json_key_index const *json_key_index,
+                          char const *name,
+                          uint32_t *seen)
+{
+    int position = json_key_index_find(json_key_index, name);
+    if (position < 0) return -1;
+    uint32_t bit = UINT32_C(1) << position;
+    if (*seen & bit) return -1;
+    *seen |= bit;
+    return position;
+}
+
+
+void
+json_key_index_initialize(struct json_key_index *json_key_index,
+                          char const *const names[],
+                          int names_count)
+{
+    assert(names_count <= json_key_index_max_names_count);
+    uint32_t const mask = json_key_index_slots_count - 1;
+
+    json_key_index->names = names;
+    json_key_index->names_count = names_count;
+    for (int i = 0; i < json_key_index_slots_count; ++i) {
+        json_key_index->hashes[i] = 0;
+        json_key_index->positions[i] = -1;
+    }
+    for (int i = 0; i < names_count; ++i) {
+        uint32_t hash = hash_name(names[i]);
+        uint32_t slot = hash & mask;
+        while (json_key_index->positions[slot] >= 0) slot = (slot + 1) & mask;
+        json_key_index->hashes[slot] = hash;
+        json_key_index->positions[slot] = i;
+    }
+}
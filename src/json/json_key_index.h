@@ -0,0 +1,44 @@
+#ifndef FNF_JSON_JSON_KEY_INDEX_H_INCLUDED
+#define FNF_JSON_JSON_KEY_INDEX_H_INCLUDED
+
+
+#include <stdint.h>
+
+
+enum {
+    json_key_index_max_names_count = 16,
+    json_key_index_slots_count = 2 * json_key_index_max_names_count,
+};
+
+
+// Maps the member names a loader knows about to their positions in `names',
+// so each member of an object is dispatched with one hash and one compare
+// instead of a scan per field.
+struct json_key_index {
+    char const *const *names;
+    int names_count;
+    uint32_t hashes[json_key_index_slots_count];
+    signed char positions[json_key_index_slots_count];
+};
+
+
+void
+json_key_index_initialize(struct json_key_index *json_key_index,
+                          char const *const names[],
+                          int names_count);
+
+// Returns the position of `name' in the names, or -1 if it isn't one.
+int
+json_key_index_find(struct json_key_index const *json_key_index,
+                    char const *name);
+
+// Like json_key_index_find(), but returns -1 for a name already marked in
+// `seen', so the first of several members with the same name wins the way
+// it does for cJSON_GetObjectItemCaseSensitive().
+int
+json_key_index_find_first(struct json_key_index const *json_key_index,
+                          char const *name,
+                          uint32_t *seen);
+
+
+#endif
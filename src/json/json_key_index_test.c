@@ -0,0 +1,56 @@
+#include <assert.h>
+#include <base/base.h>
+#include <json/json.h>
+
+
+void
+json_key_index_test(void);
+
+
+static char const *const names[] = {
+    "struct",
+    "rev",
+    "size",
+    "type",
+    "kind",
+    "colors",
+};
+
+
+static void
+json_key_index_find_test(void)
+{
+    struct json_key_index json_key_index;
+    json_key_index_initialize(&json_key_index, names, ARRAY_COUNT(names));
+
+    for (int i = 0; i < (int)ARRAY_COUNT(names); ++i) {
+        assert(i == json_key_index_find(&json_key_index, names[i]));
+    }
+    assert(-1 == json_key_index_find(&json_key_index, "Struct"));
+    assert(-1 == json_key_index_find(&json_key_index, "colours"));
+    assert(-1 == json_key_index_find(&json_key_index, ""));
+    assert(-1 == json_key_index_find(&json_key_index, NULL));
+}
+
+
+static void
+json_key_index_find_first_test(void)
+{
+    struct json_key_index json_key_index;
+    json_key_index_initialize(&json_key_index, names, ARRAY_COUNT(names));
+
+    uint32_t seen = 0;
+    assert(3 == json_key_index_find_first(&json_key_index, "type", &seen));
+    assert(0 == json_key_index_find_first(&json_key_index, "struct", &seen));
+    assert(-1 == json_key_index_find_first(&json_key_index, "type", &seen));
+    assert(-1 == json_key_index_find_first(&json_key_index, "unknown", &seen));
+    assert(5 == json_key_index_find_first(&json_key_index, "colors", &seen));
+}
+
+
+void
+json_key_index_test(void)
+{
+    json_key_index_find_test();
+    json_key_index_find_first_test();
+}
@@ -0,0 +1,548 @@
+#include "json_reader.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <base/base.h>
+
+
+enum expected {
+    expected_value = 0,
+    expected_value_or_end_array,
+    expected_key,
+    expected_key_or_end_object,
+    expected_separator,
+    expected_end,
+};
+
+
+static size_t const initial_string_capacity = 64;
+static int const initial_containers_capacity = 16;
+// same as CJSON_NESTING_LIMIT
+static int const max_containers_count = 1000;
+
+
+static void
+append(char **buffer,
+       size_t *capacity,
+       size_t *length,
+       char const *bytes,
+       size_t count);
+
+static void
+append_utf8(char **buffer, size_t *capacity, size_t *length, uint32_t code_point);
+
+static enum json_token
+did_read_value(struct json_reader *reader, enum json_token token);
+
+static enum json_token
+fail_with_error(struct json_reader *reader);
+
+static bool
+read_escape(struct json_reader *reader,
+            char **buffer,
+            size_t *capacity,
+            size_t *length);
+
+static bool
+read_hex4(struct json_reader *reader, uint32_t *value);
+
+static enum json_token
+read_end_of_container(struct json_reader *reader, char ch);
+
+static enum json_token
+read_key(struct json_reader *reader, char ch);
+
+static enum json_token
+read_literal(struct json_reader *reader, char const *literal, enum json_token token);
+
+static enum json_token
+read_number(struct json_reader *reader);
+
+static bool
+read_string(struct json_reader *reader, char **buffer, size_t *capacity);
+
+static enum json_token
+read_value(struct json_reader *reader, char ch);
+
+static void
+skip_whitespace(struct json_reader *reader);
+
+
+static void
+append(char **buffer,
+       size_t *capacity,
+       size_t *length,
+       char const *bytes,
+       size_t count)
+{
+    size_t needed = *length + count + 1;
+    if (needed > *capacity) {
+        size_t new_capacity = *capacity * 2;
+        while (new_capacity < needed) new_capacity *= 2;
+        *buffer = realloc_or_die(*buffer, new_capacity);
+        *capacity = new_capacity;
+    }
+    memcpy(*buffer + *length, bytes, count);
+    *length += count;
+    (*buffer)[*length] = '\0';
+}
+
+
+static void
+append_utf8(char **buffer, size_t *capacity, size_t *length, uint32_t code_point)
+{
+    char bytes[4];
+    size_t count;
+    if (code_point < 0x80) {
+        bytes[0] = (char)code_point;
+        count = 1;
+    } else if (code_point < 0x800) {
+        bytes[0] = (char)(0xc0 | code_point >> 6);
+        bytes[1] = (char)(0x80 | (code_point & 0x3f));
+        count = 2;
+    } else if (code_point < 0x10000) {
+        bytes[0] = (char)(0xe0 | code_point >> 12);
+        bytes[1] = (char)(0x80 | (code_point >> 6 & 0x3f));
+        bytes[2] = (char)(0x80 | (code_point & 0x3f));
+        count = 3;
+    } else {
+        bytes[0] = (char)(0xf0 | code_point >> 18);
+        bytes[1] = (char)(0x80 | (code_point >> 12 & 0x3f));
+        bytes[2] = (char)(0x80 | (code_point >> 6 & 0x3f));
+        bytes[3] = (char)(0x80 | (code_point & 0x3f));
+        count = 4;
+    }
+    append(buffer, capacity, length, bytes, count);
+}
+
+
+static enum json_token
+did_read_value(struct json_reader *reader, enum json_token token)
+{
+    reader->expected = reader->containers_count ? expected_separator : expected_end;
+    reader->token = token;
+    return token;
+}
+
+
+static enum json_token
+fail_with_error(struct json_reader *reader)
+{
+    reader->token = json_token_error;
+    return json_token_error;
+}
+
+
+static bool
+read_escape(struct json_reader *reader,
+            char **buffer,
+            size_t *capacity,
+            size_t *length)
+{
+    // `offset' is just past the backslash
+    if (reader->offset == reader->length) return false;
+    char ch = reader->bytes[reader->offset];
+    ++reader->offset;
+
+    char unescaped;
+    switch (ch) {
+        case '"': unescaped = '"'; break;
+        case '\\': unescaped = '\\'; break;
+        case '/': unescaped = '/'; break;
+        case 'b': unescaped = '\b'; break;
+        case 'f': unescaped = '\f'; break;
+        case 'n': unescaped = '\n'; break;
+        case 'r': unescaped = '\r'; break;
+        case 't': unescaped = '\t'; break;
+        case 'u': {
+            uint32_t code_point;
+            if (!read_hex4(reader, &code_point)) return false;
+            if (code_point >= 0xdc00 && code_point <= 0xdfff) return false;
+            if (code_point >= 0xd800 && code_point <= 0xdbff) {
+                uint32_t low;
+                if (   reader->length - reader->offset < 2
+                    || '\\' != reader->bytes[reader->offset]
+                    || 'u' != reader->bytes[reader->offset + 1])
+                {
+                    return false;
+                }
+                reader->offset += 2;
+                if (!read_hex4(reader, &low)) return false;
+                if (low < 0xdc00 || low > 0xdfff) return false;
+                code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+            }
+            append_utf8(buffer, capacity, length, code_point);
+            return true;
+        }
+        default:
+            return false;
+    }
+    append(buffer, capacity, length, &unescaped, 1);
+    return true;
+}
+
+
+static bool
+read_hex4(struct json_reader *reader, uint32_t *value)
+{
+    if (reader->length - reader->offset < 4) return false;
+    *value = 0;
+    for (int i = 0; i < 4; ++i) {
+        char ch = reader->bytes[reader->offset + i];
+        uint32_t digit;
+        if (ch >= '0' && ch <= '9') {
+            digit = ch - '0';
+        } else if (ch >= 'a' && ch <= 'f') {
+            digit = ch - 'a' + 10;
+        } else if (ch >= 'A' && ch <= 'F') {
+            digit = ch - 'A' + 10;
+        } else {
+            return false;
+        }
+        *value = *value << 4 | digit;
+    }
+    reader->offset += 4;
+    return true;
+}
+
+
+static enum json_token
+read_end_of_container(struct json_reader *reader, char ch)
+{
+    char container = reader->containers[reader->containers_count - 1];
+    enum json_token token;
+    if ('}' == ch && '{' == container) {
+        token = json_token_end_object;
+    } else if (']' == ch && '[' == container) {
+        token = json_token_end_array;
+    } else {
+        return fail_with_error(reader);
+    }
+    ++reader->offset;
+    --reader->containers_count;
+    return did_read_value(reader, token);
+}
+
+
+static enum json_token
+read_key(struct json_reader *reader, char ch)
+{
+    if ('"' != ch) return fail_with_error(reader);
+    if (!read_string(reader, &reader->key, &reader->key_capacity)) return fail_with_error(reader);
+    skip_whitespace(reader);
+    if (reader->offset == reader->length || ':' != reader->bytes[reader->offset]) {
+        return fail_with_error(reader);
+    }
+    ++reader->offset;
+    reader->expected = expected_value;
+    reader->token = json_token_key;
+    return json_token_key;
+}
+
+
+static enum json_token
+read_literal(struct json_reader *reader, char const *literal, enum json_token token)
+{
+    size_t length = strlen(literal);
+    if (   reader->length - reader->offset < length
+        || 0 != memcmp(reader->bytes + reader->offset, literal, length))
+    {
+        return fail_with_error(reader);
+    }
+    reader->offset += length;
+    return did_read_value(reader, token);
+}
+
+
+static enum json_token
+read_number(struct json_reader *reader)
+{
+    char const *bytes = reader->bytes;
+    size_t start = reader->offset;
+    size_t i = start;
+    size_t end = reader->length;
+
+    if (i < end && '-' == bytes[i]) ++i;
+    if (i < end && '0' == bytes[i]) {
+        ++i;
+    } else if (i < end && bytes[i] >= '1' && bytes[i] <= '9') {
+        while (i < end && bytes[i] >= '0' && bytes[i] <= '9') ++i;
+    } else {
+        return fail_with_error(reader);
+    }
+    if (i < end && '.' == bytes[i]) {
+        ++i;
+        if (i == end || bytes[i] < '0' || bytes[i] > '9') return fail_with_error(reader);
+        while (i < end && bytes[i] >= '0' && bytes[i] <= '9') ++i;
+    }
+    if (i < end && ('e' == bytes[i] || 'E' == bytes[i])) {
+        ++i;
+        if (i < end && ('+' == bytes[i] || '-' == bytes[i])) ++i;
+        if (i == end || bytes[i] < '0' || bytes[i] > '9') return fail_with_error(reader);
+        while (i < end && bytes[i] >= '0' && bytes[i] <= '9') ++i;
+    }
+
+    // the buffer isn't NUL-terminated, so strtod() reads a copy
+    size_t length = 0;
+    append(&reader->string, &reader->string_capacity, &length, bytes + start, i - start);
+    reader->number = strtod(reader->string, NULL);
+    reader->offset = i;
+    return did_read_value(reader, json_token_number);
+}
+
+
+static bool
+read_string(struct json_reader *reader, char **buffer, size_t *capacity)
+{
+    // `offset' is at the opening quote
+    ++reader->offset;
+    size_t length = 0;
+    (*buffer)[0] = '\0';
+    while (true) {
+        size_t start = reader->offset;
+        while (reader->offset < reader->length) {
+            unsigned char ch = reader->bytes[reader->offset];
+            if ('"' == ch || '\\' == ch || ch < 0x20) break;
+            ++reader->offset;
+        }
+        if (reader->offset > start) {
+            append(buffer, capacity, &length,
+                   reader->bytes + start, reader->offset - start);
+        }
+        if (reader->offset == reader->length) return false;
+
+        char ch = reader->bytes[reader->offset];
+        ++reader->offset;
+        if ('"' == ch) return true;
+        if ('\\' != ch) return false;
+        if (!read_escape(reader, buffer, capacity, &length)) return false;
+    }
+}
+
+
+static enum json_token
+read_value(struct json_reader *reader, char ch)
+{
+    switch (ch) {
+        case '{':
+        case '[':
+            if (reader->containers_count == max_containers_count) return fail_with_error(reader);
+            if (reader->containers_count == reader->containers_capacity) {
+                reader->containers_capacity *= 2;
+                reader->containers = realloc_or_die(reader->containers,
+                                                    reader->containers_capacity);
+            }
+            reader->containers[reader->containers_count] = ch;
+            ++reader->containers_count;
+            ++reader->offset;
+            if ('{' == ch) {
+                reader->expected = expected_key_or_end_object;
+                reader->token = json_token_begin_object;
+            } else {
+                reader->expected = expected_value_or_end_array;
+                reader->token = json_token_begin_array;
+            }
+            return reader->token;
+        case '"':
+            if (!read_string(reader, &reader->string, &reader->string_capacity)) {
+                return fail_with_error(reader);
+            }
+            return did_read_value(reader, json_token_string);
+        case 't':
+            return read_literal(reader, "true", json_token_true);
+        case 'f':
+            return read_literal(reader, "false", json_token_false);
+        case 'n':
+            return read_literal(reader, "null", json_token_null);
+        default:
+            if ('-' == ch || (ch >= '0' && ch <= '9')) return read_number(reader);
+            return fail_with_error(reader);
+    }
+}
+
+
+static void
+skip_whitespace(struct json_reader *reader)
+{
+    while (reader->offset < reader->length) {
+        char ch = reader->bytes[reader->offset];
+        if (' ' != ch && '\t' != ch && '\n' != ch && '\r' != ch) return;
+        ++reader->offset;
+    }
+}
+
+
+struct json_reader *
+json_reader_alloc(char const *bytes, size_t length)
+{
+    struct json_reader *reader = calloc_or_die(1, sizeof(struct json_reader));
+    reader->bytes = bytes;
+    reader->length = length;
+    reader->key = calloc_or_die(initial_string_capacity, 1);
+    reader->key_capacity = initial_string_capacity;
+    reader->string = calloc_or_die(initial_string_capacity, 1);
+    reader->string_capacity = initial_string_capacity;
+    reader->containers = calloc_or_die(initial_containers_capacity, 1);
+    reader->containers_capacity = initial_containers_capacity;
+    return reader;
+}
+
+
+void
+json_reader_free(struct json_reader *reader)
+{
+    if (reader) {
+        free_or_die(reader->containers);
+        free_or_die(reader->key);
+        free_or_die(reader->string);
+        free_or_die(reader);
+    }
+}
+
+
+char *
+json_reader_alloc_string_value(struct json_reader *reader,
+                               char const *default_value)
+{
+    char const *string_value = json_reader_get_string_value(reader, default_value);
+    return string_value ? strdup_or_die(string_value) : NULL;
+}
+
+
+bool
+json_reader_finish(struct json_reader *reader)
+{
+    return json_token_end == json_reader_next(reader);
+}
+
+
+bool
+json_reader_get_bool_value(struct json_reader *reader, bool default_value)
+{
+    switch (reader->token) {
+        case json_token_true:
+            return true;
+        case json_token_false:
+            return false;
+        default:
+            json_reader_skip_value(reader);
+            return default_value;
+    }
+}
+
+
+int
+json_reader_get_int_value(struct json_reader *reader, int default_value)
+{
+    if (json_token_number != reader->token) {
+        json_reader_skip_value(reader);
+        return default_value;
+    }
+    if (reader->number > (double)INT_MAX) return INT_MAX;
+    if (reader->number < (double)INT_MIN) return INT_MIN;
+    return (int)reader->number;
+}
+
+
+int
+json_reader_get_string_enum_value(struct json_reader *reader,
+                                  int (*lookup_fn)(char const *value, int default_value),
+                                  int default_value)
+{
+    if (json_token_string != reader->token) {
+        json_reader_skip_value(reader);
+        return default_value;
+    }
+    return lookup_fn(reader->string, default_value);
+}
+
+
+char const *
+json_reader_get_string_value(struct json_reader *reader,
+                             char const *default_value)
+{
+    if (json_token_string != reader->token) {
+        json_reader_skip_value(reader);
+        return default_value;
+    }
+    return reader->string;
+}
+
+
+enum json_token
+json_reader_next(struct json_reader *reader)
+{
+    if (json_token_error == reader->token || json_token_end == reader->token) {
+        return reader->token;
+    }
+
+    skip_whitespace(reader);
+    if (reader->offset == reader->length) {
+        if (expected_end != reader->expected) return fail_with_error(reader);
+        reader->token = json_token_end;
+        return json_token_end;
+    }
+
+    char ch = reader->bytes[reader->offset];
+    switch (reader->expected) {
+        case expected_value_or_end_array:
+            if (']' == ch) return read_end_of_container(reader, ch);
+            return read_value(reader, ch);
+        case expected_value:
+            return read_value(reader, ch);
+        case expected_key_or_end_object:
+            if ('}' == ch) return read_end_of_container(reader, ch);
+            return read_key(reader, ch);
+        case expected_key:
+            return read_key(reader, ch);
+        case expected_separator:
+            if (',' != ch) return read_end_of_container(reader, ch);
+            ++reader->offset;
+            skip_whitespace(reader);
+            if (reader->offset == reader->length) return fail_with_error(reader);
+            ch = reader->bytes[reader->offset];
+            if ('{' == reader->containers[reader->containers_count - 1]) {
+                return read_key(reader, ch);
+            } else {
+                return read_value(reader, ch);
+            }
+        default:
+            return fail_with_error(reader);
+    }
+}
+
+
+bool
+json_reader_next_element(struct json_reader *reader)
+{
+    enum json_token token = json_reader_next(reader);
+    return json_token_end_array != token
+        && json_token_end_object != token
+        && json_token_key != token
+        && json_token_error != token;
+}
+
+
+bool
+json_reader_next_member(struct json_reader *reader)
+{
+    if (json_token_key != json_reader_next(reader)) return false;
+    return json_token_error != json_reader_next(reader);
+}
+
+
+void
+json_reader_skip_value(struct json_reader *reader)
+{
+    if (   json_token_begin_array != reader->token
+        && json_token_begin_object != reader->token)
+    {
+        return;
+    }
+    int containers_count = reader->containers_count - 1;
+    while (reader->containers_count > containers_count) {
+        if (json_token_error == json_reader_next(reader)) return;
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef FNF_JSON_JSON_READER_H_INCLUDED
+#define FNF_JSON_JSON_READER_H_INCLUDED
+
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+enum json_token {
+    json_token_none = 0,
+    json_token_begin_array,
+    json_token_begin_object,
+    json_token_end_array,
+    json_token_end_object,
+    json_token_false,
+    json_token_key,
+    json_token_null,
+    json_token_number,
+    json_token_string,
+    json_token_true,
+    json_token_end,
+    json_token_error,
+};
+
+
+// Pulls JSON tokens one at a time from a byte buffer without building a
+// cJSON tree.  `key' holds the name of the latest key and `string' the
+// latest string value, both NUL-terminated and reused for the next token.
+// After a syntax error every call returns `json_token_error'.
+struct json_reader {
+    char const *bytes;
+    size_t length;
+    size_t offset;
+    enum json_token token;
+    int expected;
+    char *key;
+    size_t key_capacity;
+    char *string;
+    size_t string_capacity;
+    double number;
+    char *containers;
+    int containers_count;
+    int containers_capacity;
+};
+
+
+struct json_reader *
+json_reader_alloc(char const *bytes, size_t length);
+
+void
+json_reader_free(struct json_reader *reader);
+
+// Call after reading the top level value.  Returns true when the rest of
+// the buffer is only whitespace and no syntax errors came up.
+bool
+json_reader_finish(struct json_reader *reader);
+
+// The json_reader_*_value functions read the current value token and skip
+// it, returning `default_value' for a value of another type.
+char *
+json_reader_alloc_string_value(struct json_reader *reader,
+                               char const *default_value);
+
+bool
+json_reader_get_bool_value(struct json_reader *reader, bool default_value);
+
+int
+json_reader_get_int_value(struct json_reader *reader, int default_value);
+
+int
+json_reader_get_string_enum_value(struct json_reader *reader,
+                                  int (*lookup_fn)(char const *value, int default_value),
+                                  int default_value);
+
+// The returned string is only valid until the next token is read.
+char const *
+json_reader_get_string_value(struct json_reader *reader,
+                             char const *default_value);
+
+// Reads the next token.
+enum json_token
+json_reader_next(struct json_reader *reader);
+
+// Reads the next element of the current array, returning false at the end
+// of the array.
+bool
+json_reader_next_element(struct json_reader *reader);
+
+// Reads the next member of the current object, leaving its name in `key'
+// and its value as the current token, returning false at the end of the
+// object.
+bool
+json_reader_next_member(struct json_reader *reader);
+
+// Skips the current value, including everything in it when it begins an
+// array or object.
+void
+json_reader_skip_value(struct json_reader *reader);
+
+
+#endif
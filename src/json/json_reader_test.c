@@ -0,0 +1,170 @@
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <base/base.h>
+#include <json/json.h>
+
+
+void
+json_reader_test(void);
+
+
+static struct json_reader *
+reader_alloc(char const *json_string)
+{
+    return json_reader_alloc(json_string, strlen(json_string));
+}
+
+
+static void
+json_reader_next_test(void)
+{
+    struct json_reader *reader = reader_alloc(" { \"a\" : [1, -2.5e1, \"x\\ty\", true, false, null, {}, []] , \"b\":{\"c\":0}} ");
+
+    assert(json_token_begin_object == json_reader_next(reader));
+    assert(json_token_key == json_reader_next(reader));
+    assert(str_eq("a", reader->key));
+    assert(json_token_begin_array == json_reader_next(reader));
+    assert(json_token_number == json_reader_next(reader));
+    assert(1.0 == reader->number);
+    assert(json_token_number == json_reader_next(reader));
+    assert(-25.0 == reader->number);
+    assert(json_token_string == json_reader_next(reader));
+    assert(str_eq("x\ty", reader->string));
+    assert(json_token_true == json_reader_next(reader));
+    assert(json_token_false == json_reader_next(reader));
+    assert(json_token_null == json_reader_next(reader));
+    assert(json_token_begin_object == json_reader_next(reader));
+    assert(json_token_end_object == json_reader_next(reader));
+    assert(json_token_begin_array == json_reader_next(reader));
+    assert(json_token_end_array == json_reader_next(reader));
+    assert(json_token_end_array == json_reader_next(reader));
+    assert(json_token_key == json_reader_next(reader));
+    assert(str_eq("b", reader->key));
+    assert(json_token_begin_object == json_reader_next(reader));
+    assert(json_token_key == json_reader_next(reader));
+    assert(json_token_number == json_reader_next(reader));
+    assert(json_token_end_object == json_reader_next(reader));
+    assert(json_token_end_object == json_reader_next(reader));
+    assert(json_reader_finish(reader));
+    assert(json_token_end == json_reader_next(reader));
+
+    json_reader_free(reader);
+}
+
+
+static void
+json_reader_next_for_escapes_test(void)
+{
+    struct json_reader *reader = reader_alloc("\"\\\" \\\\ \\/ \\b\\f\\n\\r\\t \\u0041\\u00e9\\u20ac\\ud83d\\ude00\"");
+
+    assert(json_token_string == json_reader_next(reader));
+    assert(str_eq("\" \\ / \b\f\n\r\t A\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80", reader->string));
+    assert(json_reader_finish(reader));
+
+    json_reader_free(reader);
+}
+
+
+static void
+json_reader_next_for_malformed_json_test(void)
+{
+    char const *json_strings[] = {
+        "",
+        "{",
+        "[1,]",
+        "{\"a\" 1}",
+        "{\"a\":1,}",
+        "[1 2]",
+        "{\"a\":1]",
+        "01",
+        "-",
+        "1.",
+        "1e",
+        "tru",
+        "\"unterminated",
+        "\"bad \\x escape\"",
+        "\"\\ud83d alone\"",
+        "\"raw\ttab\"",
+        "{} {}",
+        "{1:2}",
+    };
+    for (size_t i = 0; i < ARRAY_COUNT(json_strings); ++i) {
+        struct json_reader *reader = reader_alloc(json_strings[i]);
+        while (   json_token_end != reader->token
+               && json_token_error != reader->token)
+        {
+            json_reader_next(reader);
+        }
+        assert(json_token_error == reader->token);
+        assert(json_token_error == json_reader_next(reader));
+        assert( ! json_reader_finish(reader));
+        json_reader_free(reader);
+    }
+}
+
+
+static void
+json_reader_next_member_test(void)
+{
+    struct json_reader *reader = reader_alloc("{"
+                                              "\"flag\":true,"
+                                              "\"count\":2147483648,"
+                                              "\"low\":-2147483649,"
+                                              "\"float\":2.999,"
+                                              "\"name\":\"bar\","
+                                              "\"skipped\":{\"nested\":[1,{\"deep\":[]}]},"
+                                              "\"list\":[\"a\",3,\"b\"]"
+                                              "}");
+
+    assert(json_token_begin_object == json_reader_next(reader));
+
+    assert(json_reader_next_member(reader));
+    assert(str_eq("flag", reader->key));
+    assert(json_reader_get_bool_value(reader, false));
+
+    assert(json_reader_next_member(reader));
+    assert(INT_MAX == json_reader_get_int_value(reader, 42));
+
+    assert(json_reader_next_member(reader));
+    assert(INT_MIN == json_reader_get_int_value(reader, 42));
+
+    assert(json_reader_next_member(reader));
+    assert(2 == json_reader_get_int_value(reader, 42));
+
+    assert(json_reader_next_member(reader));
+    char *name = json_reader_alloc_string_value(reader, NULL);
+    assert(str_eq("bar", name));
+    free_or_die(name);
+
+    assert(json_reader_next_member(reader));
+    assert(str_eq("skipped", reader->key));
+    assert(42 == json_reader_get_int_value(reader, 42));
+
+    assert(json_reader_next_member(reader));
+    assert(str_eq("list", reader->key));
+    assert(json_token_begin_array == reader->token);
+    assert(json_reader_next_element(reader));
+    assert(str_eq("a", json_reader_get_string_value(reader, NULL)));
+    assert(json_reader_next_element(reader));
+    assert(NULL == json_reader_get_string_value(reader, NULL));
+    assert(json_reader_next_element(reader));
+    assert(str_eq("b", json_reader_get_string_value(reader, NULL)));
+    assert( ! json_reader_next_element(reader));
+
+    assert( ! json_reader_next_member(reader));
+    assert(json_token_end_object == reader->token);
+    assert(json_reader_finish(reader));
+
+    json_reader_free(reader);
+}
+
+
+void
+json_reader_test(void)
+{
+    json_reader_next_test();
+    json_reader_next_for_escapes_test();
+    json_reader_next_for_malformed_json_test();
+    json_reader_next_member_test();
+}
@@ -5,6 +5,16 @@
 #include <json/json.h>
 
 
+void
+json_key_index_test(void);
+
+void
+json_reader_test(void);
+
+void
+json_writer_test(void);
+
+
 static void
 json_array_alloc_string_value_when_missing_test(void)
 {
@@ -454,6 +464,10 @@ main(int argc, char *argv[])
     json_object_has_struct_member_when_wrong_value_test();
     json_object_has_struct_member_test();
 
+    json_key_index_test();
+    json_reader_test();
+    json_writer_test();
+
     alloc_count_is_zero_or_die();
     return EXIT_SUCCESS;
 }
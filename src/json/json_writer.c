@@ -0,0 +1,396 @@
+#include "json_writer.h"
+
+#include <assert.h>
+#include <float.h>
+#include <locale.h>
+#include <math.h>
+#include <string.h>
+#include <base/base.h>
+
+
+static size_t const initial_buffer_capacity = 256;
+static int const initial_levels_capacity = 8;
+
+
+struct json_writer_level {
+    bool is_object;
+    bool has_members;
+};
+
+
+static void
+begin_level(struct json_writer *writer, bool is_object);
+
+static void
+begin_value(struct json_writer *writer);
+
+static void
+end_level(struct json_writer *writer, bool is_object);
+
+static char *
+reserve(struct json_writer *writer, size_t count);
+
+static void
+write_bytes(struct json_writer *writer, char const *bytes, size_t count);
+
+static void
+write_char(struct json_writer *writer, char ch);
+
+static void
+write_escaped_string(struct json_writer *writer, char const *value);
+
+static void
+write_tabs(struct json_writer *writer, int count);
+
+
+static void
+begin_level(struct json_writer *writer, bool is_object)
+{
+    begin_value(writer);
+    if (writer->levels_count == writer->levels_capacity) {
+        writer->levels_capacity *= 2;
+        writer->levels = reallocarray_or_die(writer->levels,
+                                             writer->levels_capacity,
+                                             sizeof(struct json_writer_level));
+    }
+    writer->levels[writer->levels_count] = (struct json_writer_level){
+        .is_object=is_object,
+    };
+    ++writer->levels_count;
+}
+
+
+static void
+begin_value(struct json_writer *writer)
+{
+    if (!writer->levels_count) return;
+    struct json_writer_level *level = &writer->levels[writer->levels_count - 1];
+    if (level->is_object) return;
+
+    if (level->has_members) {
+        if (writer->pretty) {
+            write_bytes(writer, ", ", 2);
+        } else {
+            write_char(writer, ',');
+        }
+    }
+    level->has_members = true;
+}
+
+
+static void
+end_level(struct json_writer *writer, bool is_object)
+{
+    assert(writer->levels_count);
+    assert(is_object == writer->levels[writer->levels_count - 1].is_object);
+    --writer->levels_count;
+}
+
+
+static char *
+reserve(struct json_writer *writer, size_t count)
+{
+    size_t needed = writer->length + count + 1;
+    if (needed > writer->capacity) {
+        size_t capacity = writer->capacity * 2;
+        while (capacity < needed) capacity *= 2;
+        writer->buffer = realloc_or_die(writer->buffer, capacity);
+        writer->capacity = capacity;
+    }
+    return writer->buffer + writer->length;
+}
+
+
+static void
+write_bytes(struct json_writer *writer, char const *bytes, size_t count)
+{
+    if (writer->out) {
+        fwrite(bytes, 1, count, writer->out);
+    } else {
+        char *end = reserve(writer, count);
+        memcpy(end, bytes, count);
+        writer->length += count;
+        writer->buffer[writer->length] = '\0';
+    }
+}
+
+
+static void
+write_char(struct json_writer *writer, char ch)
+{
+    if (writer->out) {
+        putc(ch, writer->out);
+    } else {
+        char *end = reserve(writer, 1);
+        end[0] = ch;
+        ++writer->length;
+        writer->buffer[writer->length] = '\0';
+    }
+}
+
+
+static void
+write_escaped_string(struct json_writer *writer, char const *value)
+{
+    write_char(writer, '"');
+    unsigned char const *run = (unsigned char const *)value;
+    unsigned char const *next = run;
+    while (*next) {
+        if (*next >= 32 && '"' != *next && '\\' != *next) {
+            ++next;
+            continue;
+        }
+        write_bytes(writer, (char const *)run, next - run);
+
+        char escape[8];
+        switch (*next) {
+            case '"': write_bytes(writer, "\\\"", 2); break;
+            case '\\': write_bytes(writer, "\\\\", 2); break;
+            case '\b': write_bytes(writer, "\\b", 2); break;
+            case '\f': write_bytes(writer, "\\f", 2); break;
+            case '\n': write_bytes(writer, "\\n", 2); break;
+            case '\r': write_bytes(writer, "\\r", 2); break;
+            case '\t': write_bytes(writer, "\\t", 2); break;
+            default:
+                snprintf(escape, sizeof escape, "\\u%04x", *next);
+                write_bytes(writer, escape, 6);
+                break;
+        }
+        ++next;
+        run = next;
+    }
+    write_bytes(writer, (char const *)run, next - run);
+    write_char(writer, '"');
+}
+
+
+static void
+write_tabs(struct json_writer *writer, int count)
+{
+    static char const tabs[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+    int const tabs_count = sizeof tabs - 1;
+    while (count > 0) {
+        int length = min(count, tabs_count);
+        write_bytes(writer, tabs, length);
+        count -= length;
+    }
+}
+
+
+struct json_writer *
+json_writer_alloc(bool pretty)
+{
+    struct json_writer *writer = calloc_or_die(1, sizeof(struct json_writer));
+    writer->pretty = pretty;
+    writer->buffer = calloc_or_die(initial_buffer_capacity, 1);
+    writer->capacity = initial_buffer_capacity;
+    writer->levels = calloc_or_die(initial_levels_capacity,
+                                   sizeof(struct json_writer_level));
+    writer->levels_capacity = initial_levels_capacity;
+    return writer;
+}
+
+
+struct json_writer *
+json_writer_alloc_for_file(FILE *out, bool pretty)
+{
+    struct json_writer *writer = json_writer_alloc(pretty);
+    writer->out = out;
+    return writer;
+}
+
+
+void
+json_writer_free(struct json_writer *writer)
+{
+    if (writer) {
+        free_or_die(writer->buffer);
+        free_or_die(writer->levels);
+        free_or_die(writer);
+    }
+}
+
+
+void
+json_writer_begin_array(struct json_writer *writer)
+{
+    begin_level(writer, false);
+    write_char(writer, '[');
+}
+
+
+void
+json_writer_begin_object(struct json_writer *writer)
+{
+    begin_level(writer, true);
+    write_char(writer, '{');
+    if (writer->pretty) write_char(writer, '\n');
+}
+
+
+void
+json_writer_bool(struct json_writer *writer, bool value)
+{
+    begin_value(writer);
+    if (value) {
+        write_bytes(writer, "true", 4);
+    } else {
+        write_bytes(writer, "false", 5);
+    }
+}
+
+
+void
+json_writer_clear(struct json_writer *writer)
+{
+    writer->length = 0;
+    writer->buffer[0] = '\0';
+    writer->levels_count = 0;
+}
+
+
+void
+json_writer_end_array(struct json_writer *writer)
+{
+    end_level(writer, false);
+    write_char(writer, ']');
+}
+
+
+void
+json_writer_end_object(struct json_writer *writer)
+{
+    bool has_members = writer->levels[writer->levels_count - 1].has_members;
+    end_level(writer, true);
+    if (writer->pretty) {
+        if (has_members) write_char(writer, '\n');
+        write_tabs(writer, writer->levels_count);
+    }
+    write_char(writer, '}');
+}
+
+
+void
+json_writer_int(struct json_writer *writer, int value)
+{
+    begin_value(writer);
+    char digits[16];
+    int i = sizeof digits;
+    unsigned magnitude = value < 0 ? 0u - (unsigned)value : (unsigned)value;
+    do {
+        digits[--i] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude);
+    if (value < 0) digits[--i] = '-';
+    write_bytes(writer, digits + i, sizeof digits - i);
+}
+
+
+void
+json_writer_key(struct json_writer *writer, char const *name)
+{
+    assert(writer->levels_count);
+    struct json_writer_level *level = &writer->levels[writer->levels_count - 1];
+    assert(level->is_object);
+
+    if (level->has_members) {
+        if (writer->pretty) {
+            write_bytes(writer, ",\n", 2);
+        } else {
+            write_char(writer, ',');
+        }
+    }
+    level->has_members = true;
+    if (writer->pretty) write_tabs(writer, writer->levels_count);
+    write_escaped_string(writer, name);
+    if (writer->pretty) {
+        write_bytes(writer, ":\t", 2);
+    } else {
+        write_char(writer, ':');
+    }
+}
+
+
+void
+json_writer_member_bool(struct json_writer *writer,
+                        char const *name,
+                        bool value)
+{
+    json_writer_key(writer, name);
+    json_writer_bool(writer, value);
+}
+
+
+void
+json_writer_member_int(struct json_writer *writer,
+                       char const *name,
+                       int value)
+{
+    json_writer_key(writer, name);
+    json_writer_int(writer, value);
+}
+
+
+void
+json_writer_member_null(struct json_writer *writer, char const *name)
+{
+    json_writer_key(writer, name);
+    json_writer_null(writer);
+}
+
+
+void
+json_writer_member_string(struct json_writer *writer,
+                          char const *name,
+                          char const *value)
+{
+    if (!value) return;
+    json_writer_key(writer, name);
+    json_writer_string(writer, value);
+}
+
+
+void
+json_writer_null(struct json_writer *writer)
+{
+    begin_value(writer);
+    write_bytes(writer, "null", 4);
+}
+
+
+void
+json_writer_number(struct json_writer *writer, double value)
+{
+    begin_value(writer);
+    if (isnan(value) || isinf(value)) {
+        write_bytes(writer, "null", 4);
+        return;
+    }
+
+    // same precision rules as cJSON
+    char number[32];
+    int length = snprintf(number, sizeof number, "%1.15g", value);
+    double test;
+    if (   1 != sscanf(number, "%lg", &test)
+        || fabs(test - value) > fmax(fabs(test), fabs(value)) * DBL_EPSILON)
+    {
+        length = snprintf(number, sizeof number, "%1.17g", value);
+    }
+    char decimal_point = localeconv()->decimal_point[0];
+    for (int i = 0; i < length; ++i) {
+        if (decimal_point == number[i]) number[i] = '.';
+    }
+    write_bytes(writer, number, length);
+}
+
+
+void
+json_writer_string(struct json_writer *writer, char const *value)
+{
+    begin_value(writer);
+    if (value) {
+        write_escaped_string(writer, value);
+    } else {
+        write_bytes(writer, "null", 4);
+    }
+}
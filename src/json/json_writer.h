@@ -0,0 +1,92 @@
+#ifndef FNF_JSON_JSON_WRITER_H_INCLUDED
+#define FNF_JSON_JSON_WRITER_H_INCLUDED
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+
+struct json_writer_level;
+
+
+// Writes JSON tokens straight to a growable buffer or a `FILE *' without
+// building a cJSON tree.  Output matches cJSON_Print() when `pretty' is set
+// and cJSON_PrintUnformatted() otherwise.  Without a file, `buffer' holds
+// `length' bytes of output followed by a NUL.
+struct json_writer {
+    FILE *out;
+    bool pretty;
+    char *buffer;
+    size_t length;
+    size_t capacity;
+    struct json_writer_level *levels;
+    int levels_count;
+    int levels_capacity;
+};
+
+
+struct json_writer *
+json_writer_alloc(bool pretty);
+
+struct json_writer *
+json_writer_alloc_for_file(FILE *out, bool pretty);
+
+void
+json_writer_free(struct json_writer *writer);
+
+void
+json_writer_begin_array(struct json_writer *writer);
+
+void
+json_writer_begin_object(struct json_writer *writer);
+
+void
+json_writer_bool(struct json_writer *writer, bool value);
+
+// Empties the buffer so the writer can be reused for the next value.
+void
+json_writer_clear(struct json_writer *writer);
+
+void
+json_writer_end_array(struct json_writer *writer);
+
+void
+json_writer_end_object(struct json_writer *writer);
+
+void
+json_writer_int(struct json_writer *writer, int value);
+
+void
+json_writer_key(struct json_writer *writer, char const *name);
+
+void
+json_writer_member_bool(struct json_writer *writer,
+                        char const *name,
+                        bool value);
+
+void
+json_writer_member_int(struct json_writer *writer,
+                       char const *name,
+                       int value);
+
+void
+json_writer_member_null(struct json_writer *writer, char const *name);
+
+// Like cJSON_AddStringToObject(), a NULL `value' leaves out the member.
+void
+json_writer_member_string(struct json_writer *writer,
+                          char const *name,
+                          char const *value);
+
+void
+json_writer_null(struct json_writer *writer);
+
+void
+json_writer_number(struct json_writer *writer, double value);
+
+void
+json_writer_string(struct json_writer *writer, char const *value);
+
+
+#endif
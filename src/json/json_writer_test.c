@@ -0,0 +1,154 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <base/base.h>
+#include <json/json.h>
+
+
+void
+json_writer_test(void);
+
+
+static struct cJSON *
+create_sample_json_object(void)
+{
+    struct cJSON *json_object = cJSON_CreateObject();
+    cJSON_AddStringToObject(json_object, "struct", "sample");
+    cJSON_AddNumberToObject(json_object, "rev", 0);
+    cJSON_AddNumberToObject(json_object, "negative", -2147483647 - 1);
+    cJSON_AddNumberToObject(json_object, "fraction", 0.1);
+    cJSON_AddNumberToObject(json_object, "third", 1.0 / 3.0);
+    cJSON_AddBoolToObject(json_object, "yes", true);
+    cJSON_AddBoolToObject(json_object, "no", false);
+    cJSON_AddNullToObject(json_object, "nothing");
+    cJSON_AddStringToObject(json_object, "escaped", "\"quoted\" \\ \b\f\n\r\t \x01 caf\xc3\xa9");
+    cJSON_AddObjectToObject(json_object, "empty_object");
+    cJSON_AddArrayToObject(json_object, "empty_array");
+
+    struct cJSON *array = cJSON_AddArrayToObject(json_object, "array");
+    cJSON_AddItemToArray(array, cJSON_CreateNumber(1));
+    cJSON_AddItemToArray(array, cJSON_CreateString("two"));
+    struct cJSON *nested = cJSON_CreateObject();
+    cJSON_AddNumberToObject(nested, "three", 3);
+    cJSON_AddItemToObject(nested, "list", cJSON_CreateArray());
+    cJSON_AddItemToArray(array, nested);
+    cJSON_AddItemToArray(array, cJSON_CreateObject());
+    return json_object;
+}
+
+
+static void
+write_sample(struct json_writer *writer)
+{
+    json_writer_begin_object(writer);
+    json_writer_member_string(writer, "struct", "sample");
+    json_writer_member_int(writer, "rev", 0);
+    json_writer_member_int(writer, "negative", -2147483647 - 1);
+    json_writer_key(writer, "fraction");
+    json_writer_number(writer, 0.1);
+    json_writer_key(writer, "third");
+    json_writer_number(writer, 1.0 / 3.0);
+    json_writer_member_bool(writer, "yes", true);
+    json_writer_member_bool(writer, "no", false);
+    json_writer_member_null(writer, "nothing");
+    json_writer_member_string(writer, "missing", NULL);
+    json_writer_member_string(writer, "escaped", "\"quoted\" \\ \b\f\n\r\t \x01 caf\xc3\xa9");
+    json_writer_key(writer, "empty_object");
+    json_writer_begin_object(writer);
+    json_writer_end_object(writer);
+    json_writer_key(writer, "empty_array");
+    json_writer_begin_array(writer);
+    json_writer_end_array(writer);
+
+    json_writer_key(writer, "array");
+    json_writer_begin_array(writer);
+    json_writer_int(writer, 1);
+    json_writer_string(writer, "two");
+    json_writer_begin_object(writer);
+    json_writer_member_int(writer, "three", 3);
+    json_writer_key(writer, "list");
+    json_writer_begin_array(writer);
+    json_writer_end_array(writer);
+    json_writer_end_object(writer);
+    json_writer_begin_object(writer);
+    json_writer_end_object(writer);
+    json_writer_end_array(writer);
+
+    json_writer_end_object(writer);
+}
+
+
+static void
+json_writer_matches_cjson_test(void)
+{
+    struct cJSON *json_object = create_sample_json_object();
+    char *unformatted = cJSON_PrintUnformatted(json_object);
+    char *formatted = cJSON_Print(json_object);
+
+    struct json_writer *writer = json_writer_alloc(false);
+    write_sample(writer);
+    assert(str_eq(unformatted, writer->buffer));
+    assert(strlen(unformatted) == writer->length);
+    json_writer_free(writer);
+
+    writer = json_writer_alloc(true);
+    write_sample(writer);
+    assert(str_eq(formatted, writer->buffer));
+    json_writer_free(writer);
+
+    free(formatted);
+    free(unformatted);
+    cJSON_Delete(json_object);
+}
+
+
+static void
+json_writer_clear_test(void)
+{
+    struct json_writer *writer = json_writer_alloc(false);
+    write_sample(writer);
+    json_writer_clear(writer);
+    assert(0 == writer->length);
+    assert(str_eq("", writer->buffer));
+
+    json_writer_begin_array(writer);
+    json_writer_int(writer, -42);
+    json_writer_null(writer);
+    json_writer_string(writer, NULL);
+    json_writer_end_array(writer);
+    assert(str_eq("[-42,null,null]", writer->buffer));
+
+    json_writer_free(writer);
+}
+
+
+static void
+json_writer_alloc_for_file_test(void)
+{
+    char *buffer = NULL;
+    size_t size = 0;
+    FILE *out = open_memstream(&buffer, &size);
+    assert(out);
+
+    struct json_writer *writer = json_writer_alloc_for_file(out, true);
+    write_sample(writer);
+    assert(0 == writer->length);
+    json_writer_free(writer);
+    fclose(out);
+
+    struct cJSON *json_object = create_sample_json_object();
+    char *formatted = cJSON_Print(json_object);
+    assert(str_eq(formatted, buffer));
+    free(formatted);
+    cJSON_Delete(json_object);
+    // allocated by open_memstream(), not counted by alloc_or_die
+    free(buffer);
+}
+
+
+void
+json_writer_test(void)
+{
+    json_writer_matches_cjson_test();
+    json_writer_clear_test();
+    json_writer_alloc_for_file_test();
+}
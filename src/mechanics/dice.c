@@ -3,13 +3,69 @@
 #include <assert.h>
 #include <errno.h>
 #include <limits.h>
+#include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <base/base.h>
 
 
+#if defined(__GNUC__)
+#define thread_local_cache __thread
+#else
+// single threaded
+#define thread_local_cache
+#endif
+
+
+enum {
+    parsed_dice_cache_bits = 8,
+    parsed_dice_cache_size = 1 << parsed_dice_cache_bits,
+};
+
+
+struct parsed_dice {
+    char const *dice_string;
+    struct dice dice;
+};
+
+
+static thread_local_cache struct parsed_dice parsed_dice_cache[parsed_dice_cache_size];
+
+// above this many dice, sums are found by recurrence instead of convolution
+static int const convolution_max_count = 8;
+static double const rescale_threshold = 1e200;
+// kept dice are found by insertion sort up to this many dice, then by
+// tallying scores when dice have few enough sides
+static int const insertion_sort_max_count = 16;
+static int const tally_max_sides = 64;
+
+
+static struct dice_distribution *
+alloc_distribution(int min_base_score, int multiplier, int probabilities_count);
+
+static void
+convolve_uniform_dice(int count, int sides, double probabilities[]);
+
 static inline double
 max_possible_total(struct dice dice);
 
+static void
+recur_uniform_dice(int count, int sides, double probabilities[]);
+
+static inline int
+score_at(struct dice_distribution const *dice_distribution, int index);
+
+static int
+sum_kept_die_scores(int die_scores[],
+                    int count,
+                    int sides,
+                    int keep_high,
+                    int keep_low);
+
+static void
+sum_uniform_dice(int count, int sides, double probabilities[]);
+
 
 static int
 compare_die_scores(void const *item1, void const *item2)
@@ -69,6 +125,170 @@ dice_alloc_range_description(struct dice dice)
 }
 
 
+struct dice_distribution *
+dice_distribution_alloc(struct dice dice)
+{
+    assert(dice_is_valid(dice));
+    if (dice_has_constant_score(dice)) {
+        struct dice_distribution *dice_distribution
+                = alloc_distribution(dice_min_base_score(dice), dice.multiplier, 1);
+        dice_distribution->probabilities[0] = 1.0;
+        return dice_distribution;
+    }
+
+    struct dice_distribution *dice_distribution
+            = alloc_distribution(dice_min_base_score(dice),
+                                 dice.multiplier,
+                                 dice.count * (dice.sides - 1) + 1);
+    sum_uniform_dice(dice.count, dice.sides, dice_distribution->probabilities);
+    return dice_distribution;
+}
+
+
+struct dice_distribution *
+dice_distribution_alloc_adjusting_upwards(struct dice dice)
+{
+    assert(dice_is_valid(dice));
+
+    // scores for one die run from 2 up
+    int max_die_score = (dice.sides < 6) ? dice.sides + 1 : dice.sides;
+    int die_probabilities_count = max_die_score - 1;
+    double die_probabilities[die_probabilities_count];
+    memset(die_probabilities, 0, sizeof die_probabilities);
+    for (int i = 1; i <= dice.sides; ++i) {
+        int die_score = (i < 6) ? i + 1 : i;
+        die_probabilities[die_score - 2] += 1.0 / dice.sides;
+    }
+
+    int probabilities_count = dice.count * (die_probabilities_count - 1) + 1;
+    struct dice_distribution *dice_distribution
+            = alloc_distribution(2 * dice.count, 1, probabilities_count);
+    double *probabilities = dice_distribution->probabilities;
+    double *previous = calloc_or_die(probabilities_count, sizeof(double));
+    probabilities[0] = 1.0;
+    int count = 1;
+    for (int i = 0; i < dice.count; ++i) {
+        memcpy(previous, probabilities, count * sizeof(double));
+        int next_count = count + die_probabilities_count - 1;
+        memset(probabilities, 0, next_count * sizeof(double));
+        for (int j = 0; j < count; ++j) {
+            for (int k = 0; k < die_probabilities_count; ++k) {
+                probabilities[j + k] += previous[j] * die_probabilities[k];
+            }
+        }
+        count = next_count;
+    }
+    free_or_die(previous);
+    return dice_distribution;
+}
+
+
+struct dice_distribution *
+dice_distribution_alloc_dropping_lowest(struct dice dice)
+{
+    assert(dice_is_valid(dice));
+    if (!dice.count) {
+        struct dice_distribution *dice_distribution = alloc_distribution(0, 1, 1);
+        dice_distribution->probabilities[0] = 1.0;
+        return dice_distribution;
+    }
+
+    // The chance that all dice are at least `m' and total `t' is the chance
+    // of `t' on dice with `sides - m + 1' sides, scaled down.  Those with a
+    // lowest die of `m' are the ones at least `m' less the ones at least
+    // `m + 1', and keep `t - m'.
+    int const count = dice.count;
+    int const kept_count = (count - 1) * (dice.sides - 1) + 1;
+    struct dice_distribution *dice_distribution
+            = alloc_distribution(count - 1, 1, kept_count);
+    double *probabilities = dice_distribution->probabilities;
+    double *sums = calloc_or_die(count * (dice.sides - 1) + 1, sizeof(double));
+    for (int m = 1; m <= dice.sides; ++m) {
+        int sides = dice.sides - m + 1;
+        double scale = pow((double)sides / dice.sides, count);
+        sum_uniform_dice(count, sides, sums);
+        int sums_count = count * (sides - 1) + 1;
+        for (int i = 0; i < sums_count; ++i) {
+            int total = count * m + i;
+            int index = total - m - (count - 1);
+            if (index < kept_count) probabilities[index] += scale * sums[i];
+            if (m > 1 && index + 1 < kept_count) {
+                probabilities[index + 1] -= scale * sums[i];
+            }
+        }
+    }
+    free_or_die(sums);
+    for (int i = 0; i < kept_count; ++i) {
+        if (probabilities[i] < 0.0) probabilities[i] = 0.0;
+    }
+    return dice_distribution;
+}
+
+
+void
+dice_distribution_free(struct dice_distribution *dice_distribution)
+{
+    if (dice_distribution) {
+        free_or_die(dice_distribution->probabilities);
+        free_or_die(dice_distribution);
+    }
+}
+
+
+double
+dice_distribution_mean(struct dice_distribution const *dice_distribution)
+{
+    double mean = 0.0;
+    for (int i = 0; i < dice_distribution->probabilities_count; ++i) {
+        mean += dice_distribution->probabilities[i] * score_at(dice_distribution, i);
+    }
+    return mean;
+}
+
+
+int
+dice_distribution_percentile(struct dice_distribution const *dice_distribution,
+                             double percent)
+{
+    int const count = dice_distribution->probabilities_count;
+    double const fraction = percent / 100.0 - 1e-12;
+    bool const is_descending = dice_distribution->multiplier < 0;
+    double cumulative = 0.0;
+    for (int i = 0; i < count; ++i) {
+        int index = is_descending ? count - 1 - i : i;
+        cumulative += dice_distribution->probabilities[index];
+        if (cumulative >= fraction) return score_at(dice_distribution, index);
+    }
+    return score_at(dice_distribution, is_descending ? 0 : count - 1);
+}
+
+
+double
+dice_distribution_probability(struct dice_distribution const *dice_distribution,
+                              int score)
+{
+    int const multiplier = dice_distribution->multiplier;
+    if (!multiplier) return score ? 0.0 : 1.0;
+    if (score % multiplier) return 0.0;
+    int index = score / multiplier - dice_distribution->min_base_score;
+    if (index < 0 || index >= dice_distribution->probabilities_count) return 0.0;
+    return dice_distribution->probabilities[index];
+}
+
+
+double
+dice_distribution_variance(struct dice_distribution const *dice_distribution)
+{
+    double mean = dice_distribution_mean(dice_distribution);
+    double variance = 0.0;
+    for (int i = 0; i < dice_distribution->probabilities_count; ++i) {
+        double difference = score_at(dice_distribution, i) - mean;
+        variance += dice_distribution->probabilities[i] * difference * difference;
+    }
+    return variance;
+}
+
+
 bool
 dice_has_constant_score(struct dice dice)
 {
@@ -210,12 +430,15 @@ dice_roll(struct dice dice, struct rnd *rnd, int die_scores[])
         return (dice.count + dice.modifier) * dice.multiplier;
     } else {
         int score = dice.modifier;
-        for (int i = 0; i < dice.count; ++i) {
-            int die_score = (int)rnd_next_uniform_value_in_range(rnd,
-                                                                 1,
-                                                                 dice.sides);
-            if (die_scores) die_scores[i] = die_score;
-            score += die_score;
+        uint32_t values[rnd_values_capacity];
+        for (int i = 0; i < dice.count; i += rnd_values_capacity) {
+            int values_count = min(dice.count - i, rnd_values_capacity);
+            rnd_fill_uniform(rnd, 1, (uint32_t)dice.sides, values, (uint32_t)values_count);
+            for (int j = 0; j < values_count; ++j) {
+                int die_score = (int)values[j];
+                if (die_scores) die_scores[i + j] = die_score;
+                score += die_score;
+            }
         }
         return score * dice.multiplier;
     }
@@ -248,19 +471,77 @@ dice_roll_and_drop_lowest(struct dice dice, struct rnd *rnd)
 {
     assert(dice_is_valid(dice));
     assert(rnd);
+    return dice_roll_keep(dice_make(dice.count, dice.sides),
+                          rnd,
+                          max(0, dice.count - 1),
+                          0);
+}
 
-    int die_scores[dice.count];
-    dice_roll(dice, rnd, die_scores);
-    qsort(die_scores, (size_t)dice.count, sizeof die_scores[0], compare_die_scores);
 
-    int score = 0;
-    for (int i = 1; i < dice.count; ++i) {
-        score += die_scores[i];
-    }
+int
+dice_roll_keep(struct dice dice, struct rnd *rnd, int keep_high, int keep_low)
+{
+    int score;
+    dice_roll_keep_batch(dice, rnd, keep_high, keep_low, &score, 1);
     return score;
 }
 
 
+void
+dice_roll_keep_batch(struct dice dice,
+                     struct rnd *rnd,
+                     int keep_high,
+                     int keep_low,
+                     int scores[],
+                     int scores_count)
+{
+    assert(dice_is_valid(dice));
+    assert(rnd);
+    assert(keep_high >= 0);
+    assert(keep_low >= 0);
+
+    if (dice_has_constant_score(dice)) {
+        int kept = min(dice.count, keep_high + keep_low);
+        for (int i = 0; i < scores_count; ++i) {
+            scores[i] = (kept + dice.modifier) * dice.multiplier;
+        }
+        return;
+    }
+
+    if (dice.count > rnd_values_capacity) {
+        struct dice base_dice = dice_make(dice.count, dice.sides);
+        int *die_scores = calloc_or_die(dice.count, sizeof(int));
+        for (int i = 0; i < scores_count; ++i) {
+            dice_roll(base_dice, rnd, die_scores);
+            int kept = sum_kept_die_scores(die_scores, dice.count, dice.sides,
+                                           keep_high, keep_low);
+            scores[i] = (kept + dice.modifier) * dice.multiplier;
+        }
+        free_or_die(die_scores);
+        return;
+    }
+
+    // roll as many expressions at a time as the dice fit in one fill
+    int const scores_per_fill = rnd_values_capacity / dice.count;
+    uint32_t values[rnd_values_capacity];
+    int die_scores[rnd_values_capacity];
+    for (int i = 0; i < scores_count; i += scores_per_fill) {
+        int fill_count = min(scores_count - i, scores_per_fill);
+        int values_count = fill_count * dice.count;
+        rnd_fill_uniform(rnd, 1, (uint32_t)dice.sides, values, (uint32_t)values_count);
+        for (int j = 0; j < values_count; ++j) {
+            die_scores[j] = (int)values[j];
+        }
+        for (int j = 0; j < fill_count; ++j) {
+            int kept = sum_kept_die_scores(&die_scores[j * dice.count],
+                                           dice.count, dice.sides,
+                                           keep_high, keep_low);
+            scores[i + j] = (kept + dice.modifier) * dice.multiplier;
+        }
+    }
+}
+
+
 int
 dice_roll_with_average_scoring(struct dice dice, struct rnd *rnd)
 {
@@ -290,6 +571,42 @@ dice_roll_with_average_scoring(struct dice dice, struct rnd *rnd)
 }
 
 
+static struct dice_distribution *
+alloc_distribution(int min_base_score, int multiplier, int probabilities_count)
+{
+    struct dice_distribution *dice_distribution
+            = calloc_or_die(1, sizeof(struct dice_distribution));
+    dice_distribution->min_base_score = min_base_score;
+    dice_distribution->multiplier = multiplier;
+    dice_distribution->probabilities_count = probabilities_count;
+    dice_distribution->probabilities = calloc_or_die(probabilities_count,
+                                                     sizeof(double));
+    return dice_distribution;
+}
+
+
+static void
+convolve_uniform_dice(int count, int sides, double probabilities[])
+{
+    int const probabilities_count = count * (sides - 1) + 1;
+    double *prefix_sums = calloc_or_die(probabilities_count + 1, sizeof(double));
+    probabilities[0] = 1.0;
+    int sums_count = 1;
+    for (int i = 0; i < count; ++i) {
+        for (int j = 0; j < sums_count; ++j) {
+            prefix_sums[j + 1] = prefix_sums[j] + probabilities[j];
+        }
+        sums_count += sides - 1;
+        for (int j = 0; j < sums_count; ++j) {
+            int low = max(0, j - sides + 1);
+            int high = min(j, sums_count - sides);
+            probabilities[j] = (prefix_sums[high + 1] - prefix_sums[low]) / sides;
+        }
+    }
+    free_or_die(prefix_sums);
+}
+
+
 static inline double
 max_possible_total(struct dice dice)
 {
@@ -299,8 +616,147 @@ max_possible_total(struct dice dice)
 }
 
 
+static inline struct dice
+parse_cached(char const *dice_string)
+{
+    uint64_t hash = (uint64_t)(uintptr_t)dice_string * 0x9e3779b97f4a7c15;
+    struct parsed_dice *parsed = &parsed_dice_cache[hash >> (64 - parsed_dice_cache_bits)];
+    if (parsed->dice_string != dice_string) {
+        parsed->dice = dice_parse(dice_string);
+        parsed->dice_string = dice_string;
+    }
+    return parsed->dice;
+}
+
+
+static void
+recur_uniform_dice(int count, int sides, double probabilities[])
+{
+    // The sums are the coefficients of ((1 - x^sides) / (1 - x))^count.
+    // Its derivative gives a recurrence for each coefficient from three
+    // earlier ones.  They're symmetric, so only the lower half is worked out.
+    int const probabilities_count = count * (sides - 1) + 1;
+    int const half_count = (probabilities_count + 1) / 2;
+    double const n = count;
+    double const s = sides;
+    probabilities[0] = 1.0;
+    for (int k = 0; k + 1 < half_count; ++k) {
+        // only the first product depends on the previous coefficient, so
+        // keep the rest of the work off that chain
+        double reciprocal = 1.0 / (k + 1);
+        double earlier = 0.0;
+        if (k >= sides - 1) {
+            earlier += (k - s + 1 - n * s) * probabilities[k - sides + 1];
+        }
+        if (k >= sides) {
+            earlier += (n * (s - 1) - k + s) * probabilities[k - sides];
+        }
+        probabilities[k + 1] = (k + n) * reciprocal * probabilities[k]
+                             + earlier * reciprocal;
+        if (probabilities[k + 1] > rescale_threshold) {
+            for (int i = 0; i <= k + 1; ++i) {
+                probabilities[i] /= rescale_threshold;
+            }
+        }
+    }
+
+    double total = 0.0;
+    for (int i = 0; i < probabilities_count; ++i) {
+        if (i >= half_count) {
+            probabilities[i] = probabilities[probabilities_count - 1 - i];
+        }
+        total += probabilities[i];
+    }
+    for (int i = 0; i < probabilities_count; ++i) {
+        probabilities[i] /= total;
+    }
+}
+
+
+static inline int
+score_at(struct dice_distribution const *dice_distribution, int index)
+{
+    return (dice_distribution->min_base_score + index) * dice_distribution->multiplier;
+}
+
+
+static int
+sum_kept_die_scores(int die_scores[],
+                    int count,
+                    int sides,
+                    int keep_high,
+                    int keep_low)
+{
+    int total = 0;
+    if (keep_high + keep_low >= count) {
+        for (int i = 0; i < count; ++i) total += die_scores[i];
+        return total;
+    }
+
+    if (keep_high + keep_low == count - 1 && (!keep_high || !keep_low)) {
+        // dropping one die from either end only needs its score
+        int lowest = die_scores[0];
+        int highest = die_scores[0];
+        for (int i = 0; i < count; ++i) {
+            total += die_scores[i];
+            if (die_scores[i] < lowest) lowest = die_scores[i];
+            if (die_scores[i] > highest) highest = die_scores[i];
+        }
+        return total - (keep_low ? highest : lowest);
+    }
+
+    if (count > insertion_sort_max_count && sides <= tally_max_sides) {
+        int tallies[tally_max_sides + 1];
+        memset(tallies, 0, sizeof tallies);
+        for (int i = 0; i < count; ++i) ++tallies[die_scores[i]];
+        for (int score = 1, remaining = keep_low; remaining; ++score) {
+            int taken = min(remaining, tallies[score]);
+            total += taken * score;
+            tallies[score] -= taken;
+            remaining -= taken;
+        }
+        for (int score = sides, remaining = keep_high; remaining; --score) {
+            int taken = min(remaining, tallies[score]);
+            total += taken * score;
+            remaining -= taken;
+        }
+        return total;
+    }
+
+    if (count <= insertion_sort_max_count) {
+        for (int i = 1; i < count; ++i) {
+            int die_score = die_scores[i];
+            int j = i;
+            for (; j > 0 && die_scores[j - 1] > die_score; --j) {
+                die_scores[j] = die_scores[j - 1];
+            }
+            die_scores[j] = die_score;
+        }
+    } else {
+        qsort(die_scores, (size_t)count, sizeof die_scores[0], compare_die_scores);
+    }
+    for (int i = 0; i < keep_low; ++i) total += die_scores[i];
+    for (int i = count - keep_high; i < count; ++i) total += die_scores[i];
+    return total;
+}
+
+
+// Fills in the chances of totals from `count' to `count * sides'.
+static void
+sum_uniform_dice(int count, int sides, double probabilities[])
+{
+    if (!count || sides == 1) {
+        probabilities[0] = 1.0;
+    } else if (count <= convolution_max_count) {
+        convolve_uniform_dice(count, sides, probabilities);
+    } else {
+        recur_uniform_dice(count, sides, probabilities);
+    }
+}
+
+
 int
 roll(char const *dice_string, struct rnd *rnd)
 {
-    return dice_roll(dice_parse(dice_string), rnd, NULL);
+    return dice_roll(parse_cached(dice_string), rnd, NULL);
 }
@@ -16,6 +16,33 @@ struct dice {
 };
 
 
+// Initializers for dice in static tables, like dice_make() and friends.
+#define DICE(dice_count, dice_sides) \
+    DICE_PLUS_TIMES(dice_count, dice_sides, 0, 1)
+
+#define DICE_PLUS(dice_count, dice_sides, dice_modifier) \
+    DICE_PLUS_TIMES(dice_count, dice_sides, dice_modifier, 1)
+
+#define DICE_PLUS_TIMES(dice_count, dice_sides, dice_modifier, dice_multiplier) \
+    { \
+        .count=(dice_count), \
+        .sides=(dice_sides), \
+        .modifier=(dice_modifier), \
+        .multiplier=(dice_multiplier), \
+    }
+
+
+// The exact probability of each score of a dice expression.  Entry `i' of
+// `probabilities' is the chance of a base score of `min_base_score + i',
+// which is then multiplied by `multiplier'.
+struct dice_distribution {
+    int min_base_score;
+    int multiplier;
+    int probabilities_count;
+    double *probabilities;
+};
+
+
 char *
 dice_alloc_base_range_description(struct dice dice);
 
@@ -25,6 +52,37 @@ dice_alloc_description(struct dice dice);
 char *
 dice_alloc_range_description(struct dice dice);
 
+// Distribution of dice_roll() scores.
+struct dice_distribution *
+dice_distribution_alloc(struct dice dice);
+
+// Distribution of dice_roll_and_adjust_upwards() scores.
+struct dice_distribution *
+dice_distribution_alloc_adjusting_upwards(struct dice dice);
+
+// Distribution of dice_roll_and_drop_lowest() scores.
+struct dice_distribution *
+dice_distribution_alloc_dropping_lowest(struct dice dice);
+
+void
+dice_distribution_free(struct dice_distribution *dice_distribution);
+
+double
+dice_distribution_mean(struct dice_distribution const *dice_distribution);
+
+// Returns the lowest score with at least `percent' percent of scores at or
+// below it.
+int
+dice_distribution_percentile(struct dice_distribution const *dice_distribution,
+                             double percent);
+
+double
+dice_distribution_probability(struct dice_distribution const *dice_distribution,
+                              int score);
+
+double
+dice_distribution_variance(struct dice_distribution const *dice_distribution);
+
 bool
 dice_has_constant_score(struct dice dice);
 
@@ -64,9 +122,25 @@ dice_roll_and_adjust_upwards(struct dice dice, struct rnd *rnd);
 int
 dice_roll_and_drop_lowest(struct dice dice, struct rnd *rnd);
 
+// Rolls the dice and scores the `keep_high' highest and `keep_low' lowest,
+// plus the modifier, times the multiplier.
+int
+dice_roll_keep(struct dice dice, struct rnd *rnd, int keep_high, int keep_low);
+
+// Like dice_roll_keep(), once for each of `scores'.
+void
+dice_roll_keep_batch(struct dice dice,
+                     struct rnd *rnd,
+                     int keep_high,
+                     int keep_low,
+                     int scores[],
+                     int scores_count);
+
 int
 dice_roll_with_average_scoring(struct dice dice, struct rnd *rnd);
 
+// Parsed dice are cached by the address of `dice_string', so it must be a
+// string constant or otherwise never change.
 int
 roll(char const *dice_string, struct rnd *rnd);
 
@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <base/base.h>
+#include <mechanics/mechanics.h>
+
+
+static char const *const dice_strings[] = {
+    "1d20",
+    "1d100",
+    "3d6",
+    "4d10",
+    "1d6x1000",
+    "2d20+1*10",
+};
+static int const dice_strings_count = ARRAY_COUNT(dice_strings);
+
+static char const *const distribution_strings[] = {
+    "3d6",
+    "4d10+2",
+    "1d10x1000",
+    "100d100",
+};
+static int const distribution_strings_count = ARRAY_COUNT(distribution_strings);
+
+
+// Each way of rolling uses either the string or the parsed dice.
+typedef int (roll_fn)(char const *dice_string, struct dice dice, struct rnd *rnd);
+
+
+static int
+parse_and_roll(char const *dice_string, struct dice dice, struct rnd *rnd)
+{
+    (void)dice;
+    return dice_roll(dice_parse(dice_string), rnd, NULL);
+}
+
+
+static int
+roll_string(char const *dice_string, struct dice dice, struct rnd *rnd)
+{
+    (void)dice;
+    return roll(dice_string, rnd);
+}
+
+
+static int
+roll_dice(char const *dice_string, struct dice dice, struct rnd *rnd)
+{
+    (void)dice_string;
+    return dice_roll(dice, rnd, NULL);
+}
+
+
+static double
+microseconds_per_distribution(char const *dice_string, int distributions_count)
+{
+    struct dice dice = dice_parse(dice_string);
+
+    double total = 0.0;
+    clock_t start = clock();
+    for (int i = 0; i < distributions_count; ++i) {
+        struct dice_distribution *distribution = dice_distribution_alloc(dice);
+        total += dice_distribution_mean(distribution);
+        dice_distribution_free(distribution);
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // keep the distributions from being optimized away
+    if (total < 0.0) fprintf(stderr, "%f\n", total);
+    return seconds * 1e6 / distributions_count;
+}
+
+
+static double
+nanoseconds_per_roll(roll_fn *roll_fn, char const *dice_string, int rolls_count)
+{
+    unsigned short seed[3] = { 0x1234, 0x5678, 0x9abc };
+    struct rnd *rnd = rnd_alloc_jrand48(seed);
+    struct dice dice = dice_parse(dice_string);
+
+    long total = 0;
+    clock_t start = clock();
+    for (int i = 0; i < rolls_count; ++i) {
+        total += roll_fn(dice_string, dice, rnd);
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    rnd_free(rnd);
+    // keep the rolls from being optimized away
+    if (total < 0) fprintf(stderr, "%li\n", total);
+    return seconds * 1e9 / rolls_count;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    int rolls_count = 1000000;
+    if (argc > 1) rolls_count = max(1, atoi(argv[1]));
+
+    FILE *out = stdout;
+    fprintf(out, "Dice rolls (%i per expression, ns/roll)\n", rolls_count);
+    fprintf(out, "  expression     parsed each roll     roll()    dice_roll()\n");
+    for (int i = 0; i < dice_strings_count; ++i) {
+        char const *dice_string = dice_strings[i];
+        fprintf(out, "  %-12s  %17.1f  %9.1f  %13.1f\n",
+                dice_string,
+                nanoseconds_per_roll(parse_and_roll, dice_string, rolls_count),
+                nanoseconds_per_roll(roll_string, dice_string, rolls_count),
+                nanoseconds_per_roll(roll_dice, dice_string, rolls_count));
+    }
+
+    int distributions_count = max(1, rolls_count / 1000);
+    fprintf(out, "\nDice distributions (%i per expression, us/distribution)\n",
+            distributions_count);
+    for (int i = 0; i < distribution_strings_count; ++i) {
+        char const *dice_string = distribution_strings[i];
+        fprintf(out, "  %-12s  %9.2f\n",
+                dice_string,
+                microseconds_per_distribution(dice_string, distributions_count));
+    }
+
+    alloc_count_is_zero_or_die();
+    return EXIT_SUCCESS;
+}
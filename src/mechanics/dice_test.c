@@ -1,5 +1,6 @@
 #include <assert.h>
 #include <limits.h>
+#include <math.h>
 #include <string.h>
 #include <base/base.h>
 #include <mechanics/mechanics.h>
@@ -124,6 +125,122 @@ dice_alloc_range_description_test(void)
 }
 
 
+static bool
+is_close(double expected, double actual)
+{
+    return fabs(expected - actual) <= 1e-9 * fmax(1.0, fabs(expected));
+}
+
+
+static void
+dice_distribution_alloc_test(void)
+{
+    struct dice_distribution *distribution = dice_distribution_alloc(dice_make(3, 6));
+    assert(3 == distribution->min_base_score);
+    assert(16 == distribution->probabilities_count);
+    assert(is_close(1.0 / 216, dice_distribution_probability(distribution, 3)));
+    assert(is_close(27.0 / 216, dice_distribution_probability(distribution, 10)));
+    assert(is_close(1.0 / 216, dice_distribution_probability(distribution, 18)));
+    assert(0.0 == dice_distribution_probability(distribution, 2));
+    assert(0.0 == dice_distribution_probability(distribution, 19));
+    assert(is_close(10.5, dice_distribution_mean(distribution)));
+    assert(is_close(35.0 / 4, dice_distribution_variance(distribution)));
+    assert(3 == dice_distribution_percentile(distribution, 0));
+    assert(10 == dice_distribution_percentile(distribution, 50));
+    assert(18 == dice_distribution_percentile(distribution, 100));
+    dice_distribution_free(distribution);
+
+    distribution = dice_distribution_alloc(dice_make_plus(4, 10, 2));
+    assert(is_close(24.0, dice_distribution_mean(distribution)));
+    assert(is_close(4 * 99.0 / 12, dice_distribution_variance(distribution)));
+    assert(is_close(1e-4, dice_distribution_probability(distribution, 6)));
+    dice_distribution_free(distribution);
+
+    distribution = dice_distribution_alloc(dice_make_plus_times(1, 10, 0, 1000));
+    assert(is_close(0.1, dice_distribution_probability(distribution, 1000)));
+    assert(0.0 == dice_distribution_probability(distribution, 1500));
+    assert(is_close(5500.0, dice_distribution_mean(distribution)));
+    assert(5000 == dice_distribution_percentile(distribution, 50));
+    dice_distribution_free(distribution);
+
+    distribution = dice_distribution_alloc(dice_make_plus(0, 6, 2));
+    assert(1.0 == dice_distribution_probability(distribution, 2));
+    assert(0.0 == dice_distribution_variance(distribution));
+    dice_distribution_free(distribution);
+
+    // more than a few dice are summed by recurrence
+    distribution = dice_distribution_alloc(dice_make(10, 6));
+    assert(is_close(4395456.0 / 60466176, dice_distribution_probability(distribution, 35)));
+    assert(is_close(1.0 / 60466176, dice_distribution_probability(distribution, 10)));
+    dice_distribution_free(distribution);
+
+    distribution = dice_distribution_alloc(dice_make(100, 100));
+    double total = 0.0;
+    for (int i = 0; i < distribution->probabilities_count; ++i) {
+        total += distribution->probabilities[i];
+    }
+    assert(is_close(1.0, total));
+    assert(is_close(5050.0, dice_distribution_mean(distribution)));
+    assert(is_close(100 * 9999.0 / 12, dice_distribution_variance(distribution)));
+    assert(5050 == dice_distribution_percentile(distribution, 50));
+    dice_distribution_free(distribution);
+
+    // too many ways to roll to count in a double
+    distribution = dice_distribution_alloc(dice_make(300, 20));
+    assert(is_close(3150.0, dice_distribution_mean(distribution)));
+    assert(is_close(300 * 399.0 / 12, dice_distribution_variance(distribution)));
+    dice_distribution_free(distribution);
+}
+
+
+static void
+dice_distribution_alloc_adjusting_upwards_test(void)
+{
+    struct dice_distribution *distribution
+            = dice_distribution_alloc_adjusting_upwards(dice_make(1, 6));
+    assert(0.0 == dice_distribution_probability(distribution, 1));
+    assert(is_close(1.0 / 6, dice_distribution_probability(distribution, 2)));
+    assert(is_close(2.0 / 6, dice_distribution_probability(distribution, 6)));
+    dice_distribution_free(distribution);
+
+    distribution = dice_distribution_alloc_adjusting_upwards(dice_make(3, 6));
+    assert(is_close(1.0 / 216, dice_distribution_probability(distribution, 6)));
+    assert(is_close(8.0 / 216, dice_distribution_probability(distribution, 18)));
+    assert(is_close(13.0, dice_distribution_mean(distribution)));
+    dice_distribution_free(distribution);
+}
+
+
+static void
+dice_distribution_alloc_dropping_lowest_test(void)
+{
+    struct dice_distribution *distribution
+            = dice_distribution_alloc_dropping_lowest(dice_make(4, 6));
+    assert(3 == distribution->min_base_score);
+    assert(16 == distribution->probabilities_count);
+    assert(is_close(1.0 / 1296, dice_distribution_probability(distribution, 3)));
+    assert(is_close(172.0 / 1296, dice_distribution_probability(distribution, 13)));
+    assert(is_close(21.0 / 1296, dice_distribution_probability(distribution, 18)));
+    assert(is_close(15869.0 / 1296, dice_distribution_mean(distribution)));
+    dice_distribution_free(distribution);
+
+    distribution = dice_distribution_alloc_dropping_lowest(dice_make(1, 6));
+    assert(is_close(1.0, dice_distribution_probability(distribution, 0)));
+    dice_distribution_free(distribution);
+
+    distribution = dice_distribution_alloc_dropping_lowest(dice_make(20, 6));
+    double total = 0.0;
+    for (int i = 0; i < distribution->probabilities_count; ++i) {
+        assert(distribution->probabilities[i] >= 0.0);
+        total += distribution->probabilities[i];
+    }
+    assert(is_close(1.0, total));
+    double expected = 101 * pow(1.0 / 6, 20);
+    assert(fabs(expected - dice_distribution_probability(distribution, 19 * 6)) < 1e-6 * expected);
+    dice_distribution_free(distribution);
+}
+
+
 static void
 dice_has_constant_score_test(void)
 {
@@ -376,6 +493,73 @@ dice_roll_and_drop_lowest_test(void)
 }
 
 
+static void
+dice_roll_keep_test(void)
+{
+    struct rnd *ascending = rnd_alloc_fake_ascending(0);
+    struct rnd *always_two = rnd_alloc_fake_fixed(1);
+    int score;
+
+    // rolls 1, 2, 3, 4
+    score = dice_roll_keep(dice_make(4, 6), ascending, 3, 0);
+    assert(9 == score);
+
+    // rolls 5, 6, 1, 2
+    score = dice_roll_keep(dice_make(4, 6), ascending, 0, 1);
+    assert(1 == score);
+
+    // rolls 3, 4, 5, 6, 1
+    score = dice_roll_keep(dice_make(5, 6), ascending, 2, 1);
+    assert(12 == score);
+
+    // rolls 2, 3, 4, 5, 6, 1, ... sorted by tallies
+    score = dice_roll_keep(dice_make(20, 6), ascending, 5, 2);
+    assert(30 == score);
+
+    score = dice_roll_keep(dice_make_plus_times(4, 6, 1, 10), always_two, 3, 0);
+    assert(70 == score);
+
+    score = dice_roll_keep(dice_make(70, 6), always_two, 1, 0);
+    assert(2 == score);
+
+    score = dice_roll_keep(dice_make(20, 100), always_two, 4, 4);
+    assert(16 == score);
+
+    score = dice_roll_keep(dice_make(3, 1), always_two, 2, 0);
+    assert(2 == score);
+
+    score = dice_roll_keep(dice_make_plus(0, 6, 2), always_two, 2, 0);
+    assert(2 == score);
+
+    rnd_free(ascending);
+    rnd_free(always_two);
+}
+
+
+static void
+dice_roll_keep_batch_test(void)
+{
+    struct rnd *ascending = rnd_alloc_fake_ascending(0);
+    int scores[3];
+    dice_roll_keep_batch(dice_make(4, 6), ascending, 3, 0, scores, 3);
+    assert(9 == scores[0]);
+    assert(13 == scores[1]);
+    assert(15 == scores[2]);
+    rnd_free(ascending);
+
+    // rolls the same dice as one at a time
+    struct rnd *batched = rnd_alloc_splitmix64(42);
+    struct rnd *single = rnd_alloc_splitmix64(42);
+    int batch_scores[100];
+    dice_roll_keep_batch(dice_make(4, 6), batched, 3, 0, batch_scores, 100);
+    for (int i = 0; i < 100; ++i) {
+        assert(batch_scores[i] == dice_roll_keep(dice_make(4, 6), single, 3, 0));
+    }
+    rnd_free(batched);
+    rnd_free(single);
+}
+
+
 static void
 dice_roll_with_average_scoring_test(void)
 {
@@ -468,6 +652,9 @@ dice_test(void)
     dice_alloc_base_range_description_test();
     dice_alloc_description_test();
     dice_alloc_range_description_test();
+    dice_distribution_alloc_test();
+    dice_distribution_alloc_adjusting_upwards_test();
+    dice_distribution_alloc_dropping_lowest_test();
     dice_has_constant_score_test();
     dice_is_valid_test();
     dice_make_test();
@@ -481,6 +668,8 @@ dice_test(void)
     dice_roll_test();
     dice_roll_and_adjust_upwards_test();
     dice_roll_and_drop_lowest_test();
+    dice_roll_keep_test();
+    dice_roll_keep_batch_test();
     dice_roll_with_average_scoring_test();
     roll_test();
 }
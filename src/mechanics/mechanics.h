@@ -2,5 +2,6 @@
 #define FNF_MECHANICS_MECHANICS_H_INCLUDED
 
 #include <mechanics/dice.h>
+#include <mechanics/weighted_table.h>
 
 #endif
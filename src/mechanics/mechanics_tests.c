@@ -6,11 +6,15 @@
 void
 dice_test(void);
 
+void
+weighted_table_test(void);
+
 
 int
 main(int argc, char *argv[])
 {
     dice_test();
+    weighted_table_test();
     alloc_count_is_zero_or_die();
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,66 @@
+#include "weighted_table.h"
+
+#include <assert.h>
+#include <base/base.h>
+
+#include "dice.h"
+
+
+int
+weighted_table_initialize(struct weighted_table *weighted_table,
+                          int const weights[],
+                          int weights_count,
+                          int cumulative_weights[])
+{
+    int first_index = 0;
+    while (first_index < weights_count && !weights[first_index]) ++first_index;
+    int end_index = weights_count;
+    while (end_index > first_index && !weights[end_index - 1]) --end_index;
+
+    int total_weight = 0;
+    for (int i = first_index; i < end_index; ++i) {
+        assert(weights[i] >= 0);
+        total_weight += weights[i];
+        cumulative_weights[i - first_index] = total_weight;
+    }
+
+    *weighted_table = (struct weighted_table){
+        .cumulative_weights=cumulative_weights,
+        .first_index=first_index,
+        .count=end_index - first_index,
+        .total_weight=total_weight,
+    };
+    return weighted_table->count;
+}
+
+
+int
+weighted_table_index_for_score(struct weighted_table const *weighted_table,
+                               int score)
+{
+    if (score < 1 || score > weighted_table->total_weight) {
+        fail("Did not match table entry (score=%i, total weight=%i)",
+             score, weighted_table->total_weight);
+    }
+
+    int low = 0;
+    int high = weighted_table->count - 1;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (weighted_table->cumulative_weights[middle] < score) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return weighted_table->first_index + low;
+}
+
+
+int
+weighted_table_roll(struct weighted_table const *weighted_table,
+                    struct rnd *rnd)
+{
+    int score = dice_roll(dice_make(1, weighted_table->total_weight), rnd, NULL);
+    return weighted_table_index_for_score(weighted_table, score);
+}
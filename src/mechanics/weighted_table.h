@@ -0,0 +1,43 @@
+#ifndef FNF_MECHANICS_WEIGHTED_TABLE_H_INCLUDED
+#define FNF_MECHANICS_WEIGHTED_TABLE_H_INCLUDED
+
+
+struct rnd;
+
+
+// Chooses entries with probability proportional to their weights.  A score
+// from 1 to `total_weight' picks the first entry whose cumulative weight is
+// at least the score, the way the percentage tables in the DMG are read.
+// Entries with no weight are never picked, and runs of them at either end
+// aren't stored.  `cumulative_weights[i]' is the cumulative weight of entry
+// `first_index + i'.
+struct weighted_table {
+    int const *cumulative_weights;
+    int first_index;
+    int count;
+    int total_weight;
+};
+
+
+// Stores the cumulative weights in `cumulative_weights', which needs room for
+// `weights_count' values and must outlive the table.  Returns the number of
+// values used, so several tables can share one array.
+int
+weighted_table_initialize(struct weighted_table *weighted_table,
+                          int const weights[],
+                          int weights_count,
+                          int cumulative_weights[]);
+
+// Returns the index into the weights of the entry for `score'.
+int
+weighted_table_index_for_score(struct weighted_table const *weighted_table,
+                               int score);
+
+// Rolls 1 to `total_weight' and returns the index into the weights of the
+// entry picked.
+int
+weighted_table_roll(struct weighted_table const *weighted_table,
+                    struct rnd *rnd);
+
+
+#endif
@@ -0,0 +1,108 @@
+#include <assert.h>
+#include <base/base.h>
+#include <mechanics/mechanics.h>
+
+
+void
+weighted_table_test(void);
+
+
+static void
+weighted_table_initialize_test(void)
+{
+    int weights[] = { 0, 2, 0, 3, 1, 0 };
+    int cumulative_weights[ARRAY_COUNT(weights)];
+    struct weighted_table weighted_table;
+
+    int count = weighted_table_initialize(&weighted_table,
+                                          weights,
+                                          ARRAY_COUNT(weights),
+                                          cumulative_weights);
+
+    assert(4 == count);
+    assert(1 == weighted_table.first_index);
+    assert(4 == weighted_table.count);
+    assert(6 == weighted_table.total_weight);
+    assert(2 == weighted_table.cumulative_weights[0]);
+    assert(2 == weighted_table.cumulative_weights[1]);
+    assert(5 == weighted_table.cumulative_weights[2]);
+    assert(6 == weighted_table.cumulative_weights[3]);
+}
+
+
+static void
+weighted_table_index_for_score_test(void)
+{
+    int weights[] = { 0, 2, 0, 3, 1, 0 };
+    int cumulative_weights[ARRAY_COUNT(weights)];
+    struct weighted_table weighted_table;
+    weighted_table_initialize(&weighted_table,
+                              weights,
+                              ARRAY_COUNT(weights),
+                              cumulative_weights);
+
+    assert(1 == weighted_table_index_for_score(&weighted_table, 1));
+    assert(1 == weighted_table_index_for_score(&weighted_table, 2));
+    assert(3 == weighted_table_index_for_score(&weighted_table, 3));
+    assert(3 == weighted_table_index_for_score(&weighted_table, 5));
+    assert(4 == weighted_table_index_for_score(&weighted_table, 6));
+}
+
+
+static void
+weighted_table_index_for_score_matches_scan_test(void)
+{
+    int weights[] = { 5, 4, 2, 8, 0, 7, 6, 3, 1, 1, 5, 0, 6, 5, 4, 2, 1, 1, 6, 3, 0, 30 };
+    int weights_count = ARRAY_COUNT(weights);
+    int cumulative_weights[ARRAY_COUNT(weights)];
+    struct weighted_table weighted_table;
+    weighted_table_initialize(&weighted_table,
+                              weights,
+                              weights_count,
+                              cumulative_weights);
+    assert(100 == weighted_table.total_weight);
+
+    for (int score = 1; score <= 100; ++score) {
+        int range = 0;
+        int expected = -1;
+        for (int i = 0; i < weights_count; ++i) {
+            range += weights[i];
+            if (score <= range) {
+                expected = i;
+                break;
+            }
+        }
+        assert(expected == weighted_table_index_for_score(&weighted_table, score));
+    }
+}
+
+
+static void
+weighted_table_roll_test(void)
+{
+    int weights[] = { 0, 2, 0, 3, 1, 0 };
+    int cumulative_weights[ARRAY_COUNT(weights)];
+    struct weighted_table weighted_table;
+    weighted_table_initialize(&weighted_table,
+                              weights,
+                              ARRAY_COUNT(weights),
+                              cumulative_weights);
+
+    struct rnd *min = rnd_alloc_fake_min();
+    assert(1 == weighted_table_roll(&weighted_table, min));
+    rnd_free(min);
+
+    struct rnd *max = rnd_alloc_fake_max();
+    assert(4 == weighted_table_roll(&weighted_table, max));
+    rnd_free(max);
+}
+
+
+void
+weighted_table_test(void)
+{
+    weighted_table_initialize_test();
+    weighted_table_index_for_score_test();
+    weighted_table_index_for_score_matches_scan_test();
+    weighted_table_roll_test();
+}
@@ -1,11 +1,41 @@
 #include "coins.h"
 
+#include <pthread.h>
 #include <stdio.h>
 #include <base/base.h>
 #include <background/background.h>
 #include <json/json.h>
 
 
+enum coins_key {
+    coins_key_struct,
+    coins_key_pp,
+    coins_key_gp,
+    coins_key_ep,
+    coins_key_sp,
+    coins_key_cp,
+};
+
+static char const *const coins_key_names[] = {
+    "struct",
+    "pp",
+    "gp",
+    "ep",
+    "sp",
+    "cp",
+};
+
+static struct json_key_index coins_keys;
+static pthread_once_t coins_keys_once = PTHREAD_ONCE_INIT;
+
+
+static void
+initialize_coins_keys(void)
+{
+    json_key_index_initialize(&coins_keys, coins_key_names, ARRAY_COUNT(coins_key_names));
+}
+
+
 char *
 coins_alloc_description(struct coins coins)
 {
@@ -136,6 +166,19 @@ coins_make(int pp, int gp, int ep, int sp, int cp)
 }
 
 
+struct coins
+coins_make_from_binary_reader(struct binary_reader *reader)
+{
+    struct coins coins = coins_make_zero();
+    coins.pp = binary_reader_int(reader);
+    coins.gp = binary_reader_int(reader);
+    coins.ep = binary_reader_int(reader);
+    coins.sp = binary_reader_int(reader);
+    coins.cp = binary_reader_int(reader);
+    return coins;
+}
+
+
 struct coins
 coins_make_from_cp(int cp)
 {
@@ -158,15 +201,53 @@ coins_make_from_json_object(struct cJSON *json_object)
     if ( ! cJSON_IsObject(json_object)) return coins;
     if ( !json_object_has_struct_member(json_object, "coins")) return coins;
 
-    coins.pp = json_object_get_int_value(json_object, "pp", 0);
-    coins.gp = json_object_get_int_value(json_object, "gp", 0);
-    coins.ep = json_object_get_int_value(json_object, "ep", 0);
-    coins.sp = json_object_get_int_value(json_object, "sp", 0);
-    coins.cp = json_object_get_int_value(json_object, "cp", 0);
+    pthread_once(&coins_keys_once, initialize_coins_keys);
+    uint32_t seen = 0;
+    struct cJSON *item;
+    cJSON_ArrayForEach(item, json_object) {
+        switch (json_key_index_find_first(&coins_keys, item->string, &seen)) {
+            case coins_key_pp: coins.pp = json_item_get_int_value(item, 0); break;
+            case coins_key_gp: coins.gp = json_item_get_int_value(item, 0); break;
+            case coins_key_ep: coins.ep = json_item_get_int_value(item, 0); break;
+            case coins_key_sp: coins.sp = json_item_get_int_value(item, 0); break;
+            case coins_key_cp: coins.cp = json_item_get_int_value(item, 0); break;
+            default: break;
+        }
+    }
     return coins;
 }
 
 
+struct coins
+coins_make_from_json_reader(struct json_reader *reader)
+{
+    struct coins coins = coins_make_zero();
+
+    if (json_token_begin_object != reader->token) {
+        json_reader_skip_value(reader);
+        return coins;
+    }
+
+    pthread_once(&coins_keys_once, initialize_coins_keys);
+    bool is_coins = false;
+    uint32_t seen = 0;
+    while (json_reader_next_member(reader)) {
+        switch (json_key_index_find_first(&coins_keys, reader->key, &seen)) {
+            case coins_key_struct:
+                is_coins = str_eq("coins", json_reader_get_string_value(reader, ""));
+                break;
+            case coins_key_pp: coins.pp = json_reader_get_int_value(reader, 0); break;
+            case coins_key_gp: coins.gp = json_reader_get_int_value(reader, 0); break;
+            case coins_key_ep: coins.ep = json_reader_get_int_value(reader, 0); break;
+            case coins_key_sp: coins.sp = json_reader_get_int_value(reader, 0); break;
+            case coins_key_cp: coins.cp = json_reader_get_int_value(reader, 0); break;
+            default: json_reader_skip_value(reader); break;
+        }
+    }
+    return is_coins ? coins : coins_make_zero();
+}
+
+
 struct coins
 coins_make_zero(void)
 {
@@ -239,3 +320,29 @@ coins_to_cp(struct coins coins)
     coins = coins_sp_to_cp(coins);
     return coins.cp;
 }
+
+
+void
+coins_write_binary(struct coins *coins, struct binary_writer *writer)
+{
+    binary_writer_int(writer, coins->pp);
+    binary_writer_int(writer, coins->gp);
+    binary_writer_int(writer, coins->ep);
+    binary_writer_int(writer, coins->sp);
+    binary_writer_int(writer, coins->cp);
+}
+
+
+void
+coins_write_json(struct coins *coins, struct json_writer *writer)
+{
+    json_writer_begin_object(writer);
+    json_writer_member_string(writer, "struct", "coins");
+    json_writer_member_int(writer, "rev", 0);
+    json_writer_member_int(writer, "pp", coins->pp);
+    json_writer_member_int(writer, "gp", coins->gp);
+    json_writer_member_int(writer, "ep", coins->ep);
+    json_writer_member_int(writer, "sp", coins->sp);
+    json_writer_member_int(writer, "cp", coins->cp);
+    json_writer_end_object(writer);
+}
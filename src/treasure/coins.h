@@ -5,7 +5,11 @@
 #include <stdbool.h>
 
 
+struct binary_reader;
+struct binary_writer;
 struct cJSON;
+struct json_reader;
+struct json_writer;
 
 
 struct coins {
@@ -32,6 +36,9 @@ coins_is_zero(struct coins coins);
 struct coins
 coins_make(int pp, int gp, int ep, int sp, int cp);
 
+struct coins
+coins_make_from_binary_reader(struct binary_reader *reader);
+
 struct coins
 coins_make_from_cp(int cp);
 
@@ -41,6 +48,9 @@ coins_make_from_gp_cp(int gp, int cp);
 struct coins
 coins_make_from_json_object(struct cJSON *json_object);
 
+struct coins
+coins_make_from_json_reader(struct json_reader *reader);
+
 struct coins
 coins_make_zero(void);
 
@@ -83,5 +93,11 @@ coins_ep_to_sp(struct coins coins);
 struct coins
 coins_sp_to_cp(struct coins coins);
 
+void
+coins_write_binary(struct coins *coins, struct binary_writer *writer);
+
+void
+coins_write_json(struct coins *coins, struct json_writer *writer);
+
 
 #endif
@@ -1,6 +1,7 @@
 #include "gem.h"
 
 #include <assert.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 #include <base/base.h>
@@ -306,6 +307,38 @@ static char const *const colors[] = {
 };
 static size_t colors_count = ARRAY_COUNT(colors);
 
+enum gem_key {
+    gem_key_struct,
+    gem_key_size,
+    gem_key_type,
+    gem_key_kind,
+    gem_key_colors,
+    gem_key_value_percent_modifier,
+    gem_key_value_rank_modifier,
+};
+
+static char const *const gem_key_names[] = {
+    "struct",
+    "size",
+    "type",
+    "kind",
+    "colors",
+    "value_percent_modifier",
+    "value_rank_modifier",
+};
+
+static struct json_key_index gem_keys;
+static pthread_once_t gem_keys_once = PTHREAD_ONCE_INIT;
+
+
+static char const *
+colors_for_name(char const *name);
+
+static unsigned
+colors_index(char const *name);
+
+static void
+initialize_gem_keys(void);
 
 static char *
 gem_alloc_true_description_modifiers(struct gem *gem);
@@ -347,6 +380,30 @@ compare_colors(void const *first, void const *second)
 }
 
 
+static char const *
+colors_for_name(char const *name)
+{
+    char *const *colors_value = bsearch(&name, colors, colors_count, sizeof colors[0], compare_colors);
+    return colors_value ? *colors_value : colors_gray;
+}
+
+
+static unsigned
+colors_index(char const *name)
+{
+    char const *color = colors_for_name(name ? name : colors_gray);
+    char const *const *colors_value = bsearch(&color, colors, colors_count, sizeof colors[0], compare_colors);
+    return (unsigned)(colors_value - colors);
+}
+
+
+static void
+initialize_gem_keys(void)
+{
+    json_key_index_initialize(&gem_keys, gem_key_names, ARRAY_COUNT(gem_key_names));
+}
+
+
 static char const *
 select_random_string(struct rnd *rnd, char const **strings, int count)
 {
@@ -787,6 +844,27 @@ gem_initialize(struct gem *gem)
 }
 
 
+void
+gem_initialize_from_binary_reader(struct gem *gem,
+                                  struct binary_reader *reader)
+{
+    gem_initialize(gem);
+
+    unsigned size = binary_reader_uint(reader);
+    unsigned type = binary_reader_uint(reader);
+    unsigned kind = binary_reader_uint(reader);
+    unsigned colors_code = binary_reader_uint(reader);
+    gem->size = size < gem_size_names_count ? gem_size_very_small + (int)size : gem_size_average;
+    gem->type = type < gem_type_names_count ? gem_type_unknown + (int)type : gem_type_unknown;
+    gem->kind = kind < gem_kind_names_count ? gem_kind_unknown + (int)kind : gem_kind_unknown;
+    gem->colors = colors_code < colors_count ? colors[colors_code] : colors_gray;
+    gem->value_percent_modifier = binary_reader_int(reader);
+    gem->value_rank_modifier = binary_reader_int(reader);
+    gem->true_description = gem_alloc_true_description(gem);
+    gem->visible_description = gem_alloc_visible_description(gem);
+}
+
+
 void
 gem_initialize_from_json_object(struct gem *gem, struct cJSON *json_object)
 {
@@ -795,25 +873,93 @@ gem_initialize_from_json_object(struct gem *gem, struct cJSON *json_object)
     if ( ! cJSON_IsObject(json_object)) return;
     if ( ! json_object_has_struct_member(json_object, "gem")) return;
 
-    gem->size = json_object_get_string_enum_value(json_object, "size", gem_size_for_name, gem_size_average);
-    gem->type = json_object_get_string_enum_value(json_object, "type", gem_type_for_name, gem_type_unknown);
-    gem->kind = json_object_get_string_enum_value(json_object, "kind", gem_kind_for_name, gem_kind_unknown);
-
-    char const *json_colors = json_object_get_string_value(json_object, "colors", colors_gray);
-    char *const *colors_value = bsearch(&json_colors, colors, colors_count, sizeof colors[0], compare_colors);
-    gem->colors = colors_value ? *colors_value : colors_gray;
-
-    gem->value_percent_modifier = json_object_get_int_value(json_object,
-                                                            "value_percent_modifier",
-                                                            0);
-    gem->value_rank_modifier = json_object_get_int_value(json_object,
-                                                         "value_rank_modifier",
-                                                         0);
+    pthread_once(&gem_keys_once, initialize_gem_keys);
+    gem->size = gem_size_average;
+    gem->colors = colors_gray;
+    uint32_t seen = 0;
+    struct cJSON *item;
+    cJSON_ArrayForEach(item, json_object) {
+        switch (json_key_index_find_first(&gem_keys, item->string, &seen)) {
+            case gem_key_size:
+                gem->size = json_item_get_string_enum_value(item, gem_size_for_name, gem_size_average);
+                break;
+            case gem_key_type:
+                gem->type = json_item_get_string_enum_value(item, gem_type_for_name, gem_type_unknown);
+                break;
+            case gem_key_kind:
+                gem->kind = json_item_get_string_enum_value(item, gem_kind_for_name, gem_kind_unknown);
+                break;
+            case gem_key_colors:
+                gem->colors = colors_for_name(json_item_get_string_value(item, colors_gray));
+                break;
+            case gem_key_value_percent_modifier:
+                gem->value_percent_modifier = json_item_get_int_value(item, 0);
+                break;
+            case gem_key_value_rank_modifier:
+                gem->value_rank_modifier = json_item_get_int_value(item, 0);
+                break;
+            default:
+                break;
+        }
+    }
     gem->true_description = gem_alloc_true_description(gem);
     gem->visible_description = gem_alloc_visible_description(gem);
 }
 
 
+void
+gem_initialize_from_json_reader(struct gem *gem, struct json_reader *reader)
+{
+    gem_initialize(gem);
+
+    if (json_token_begin_object != reader->token) {
+        json_reader_skip_value(reader);
+        return;
+    }
+
+    pthread_once(&gem_keys_once, initialize_gem_keys);
+    gem->size = gem_size_average;
+    gem->colors = colors_gray;
+    bool is_gem = false;
+    uint32_t seen = 0;
+    while (json_reader_next_member(reader)) {
+        switch (json_key_index_find_first(&gem_keys, reader->key, &seen)) {
+            case gem_key_struct:
+                is_gem = str_eq("gem", json_reader_get_string_value(reader, ""));
+                break;
+            case gem_key_size:
+                gem->size = json_reader_get_string_enum_value(reader, gem_size_for_name, gem_size_average);
+                break;
+            case gem_key_type:
+                gem->type = json_reader_get_string_enum_value(reader, gem_type_for_name, gem_type_unknown);
+                break;
+            case gem_key_kind:
+                gem->kind = json_reader_get_string_enum_value(reader, gem_kind_for_name, gem_kind_unknown);
+                break;
+            case gem_key_colors:
+                gem->colors = colors_for_name(json_reader_get_string_value(reader, colors_gray));
+                break;
+            case gem_key_value_percent_modifier:
+                gem->value_percent_modifier = json_reader_get_int_value(reader, 0);
+                break;
+            case gem_key_value_rank_modifier:
+                gem->value_rank_modifier = json_reader_get_int_value(reader, 0);
+                break;
+            default:
+                json_reader_skip_value(reader);
+                break;
+        }
+    }
+
+    if (is_gem) {
+        gem->true_description = gem_alloc_true_description(gem);
+        gem->visible_description = gem_alloc_visible_description(gem);
+    } else {
+        gem_initialize(gem);
+    }
+}
+
+
 static int
 gem_kind_for_name(char const *name, int default_value)
 {
@@ -955,3 +1101,31 @@ gem_type_name(struct gem *gem)
     int index = gem->type - gem_type_unknown;
     return gem_type_names[index];
 }
+
+
+void
+gem_write_binary(struct gem *gem, struct binary_writer *writer)
+{
+    binary_writer_uint(writer, (unsigned)(gem->size - gem_size_very_small));
+    binary_writer_uint(writer, (unsigned)(gem->type - gem_type_unknown));
+    binary_writer_uint(writer, (unsigned)(gem->kind - gem_kind_unknown));
+    binary_writer_uint(writer, colors_index(gem->colors));
+    binary_writer_int(writer, gem->value_percent_modifier);
+    binary_writer_int(writer, gem->value_rank_modifier);
+}
+
+
+void
+gem_write_json(struct gem *gem, struct json_writer *writer)
+{
+    json_writer_begin_object(writer);
+    json_writer_member_string(writer, "struct", "gem");
+    json_writer_member_int(writer, "rev", 0);
+    json_writer_member_string(writer, "size", gem_size_name(gem));
+    json_writer_member_string(writer, "type", gem_type_name(gem));
+    json_writer_member_string(writer, "kind", gem_kind_name(gem));
+    json_writer_member_string(writer, "colors", gem->colors);
+    json_writer_member_int(writer, "value_percent_modifier", gem->value_percent_modifier);
+    json_writer_member_int(writer, "value_rank_modifier", gem->value_rank_modifier);
+    json_writer_end_object(writer);
+}
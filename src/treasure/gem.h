@@ -2,7 +2,11 @@
 #define FNF_TREASURE_GEM_H_INCLUDED
 
 
+struct binary_reader;
+struct binary_writer;
 struct cJSON;
+struct json_reader;
+struct json_writer;
 struct rnd;
 
 
@@ -125,8 +129,21 @@ gem_generate(struct gem *gem, struct rnd *rnd);
 void
 gem_initialize(struct gem *gem);
 
+void
+gem_initialize_from_binary_reader(struct gem *gem,
+                                  struct binary_reader *reader);
+
 void
 gem_initialize_from_json_object(struct gem *gem, struct cJSON *json_object);
 
+void
+gem_initialize_from_json_reader(struct gem *gem, struct json_reader *reader);
+
+void
+gem_write_binary(struct gem *gem, struct binary_writer *writer);
+
+void
+gem_write_json(struct gem *gem, struct json_writer *writer);
+
 
 #endif
@@ -455,10 +455,53 @@ gem_generate_for_decreased_value_test(void)
 }
 
 
+static void
+gem_write_json_test(void)
+{
+    struct rnd *rnd = rnd_alloc_fake_median();
+    struct gem gem;
+    gem_initialize(&gem);
+    struct json_writer *writer = json_writer_alloc(false);
+
+    // `colors' is left out while NULL, as cJSON does
+    gem_write_json(&gem, writer);
+    char const *expected = "{"
+                           "\"struct\":\"gem\","
+                           "\"rev\":0,"
+                           "\"size\":\"average\","
+                           "\"type\":\"unknown\","
+                           "\"kind\":\"unknown\","
+                           "\"value_percent_modifier\":0,"
+                           "\"value_rank_modifier\":0"
+                           "}";
+    assert(str_eq(expected, writer->buffer));
+
+    gem_generate(&gem, rnd);
+    json_writer_clear(writer);
+    gem_write_json(&gem, writer);
+    expected = "{"
+               "\"struct\":\"gem\","
+               "\"rev\":0,"
+               "\"size\":\"average\","
+               "\"type\":\"fancy\","
+               "\"kind\":\"jade\","
+               "\"colors\":\"green and white\","
+               "\"value_percent_modifier\":0,"
+               "\"value_rank_modifier\":0"
+               "}";
+    assert(str_eq(expected, writer->buffer));
+
+    json_writer_free(writer);
+    gem_finalize(&gem);
+    rnd_free(rnd);
+}
+
+
 void
 gem_test(void)
 {
     gem_create_json_object_test();
+    gem_write_json_test();
     gem_initialize_test();
     gem_initialize_from_json_object_for_empty_object_test();
     gem_initialize_from_json_object_for_empty_array_test();
@@ -1,6 +1,7 @@
 #include "jewelry.h"
 
 #include <assert.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -179,6 +180,32 @@ static size_t const jewelry_rank_count = ARRAY_COUNT(jewelry_ranks);
 static int const jewelry_min_rank = 1;
 static int const jewelry_max_rank = (int)(jewelry_rank_count - 1);
 
+enum jewelry_key {
+    jewelry_key_struct,
+    jewelry_key_has_gems,
+    jewelry_key_form,
+    jewelry_key_material,
+    jewelry_key_workmanship_bonus,
+    jewelry_key_exceptional_stone_bonus,
+    jewelry_key_value_in_cp,
+};
+
+static char const *const jewelry_key_names[] = {
+    "struct",
+    "has_gems",
+    "form",
+    "material",
+    "workmanship_bonus",
+    "exceptional_stone_bonus",
+    "value_in_cp",
+};
+
+static struct json_key_index jewelry_keys;
+static pthread_once_t jewelry_keys_once = PTHREAD_ONCE_INIT;
+
+
+static void
+initialize_jewelry_keys(void);
 
 static char *
 jewelry_alloc_true_description_prefix(struct jewelry *jewelry);
@@ -373,6 +400,15 @@ jewelry_generate(struct jewelry *jewelry, struct rnd *rnd)
 }
 
 
+static void
+initialize_jewelry_keys(void)
+{
+    json_key_index_initialize(&jewelry_keys,
+                              jewelry_key_names,
+                              ARRAY_COUNT(jewelry_key_names));
+}
+
+
 void
 jewelry_initialize(struct jewelry *jewelry)
 {
@@ -380,6 +416,24 @@ jewelry_initialize(struct jewelry *jewelry)
 }
 
 
+void
+jewelry_initialize_from_binary_reader(struct jewelry *jewelry,
+                                      struct binary_reader *reader)
+{
+    jewelry_initialize(jewelry);
+
+    jewelry->has_gems = binary_reader_bool(reader);
+    unsigned form = binary_reader_uint(reader);
+    unsigned material = binary_reader_uint(reader);
+    jewelry->form = form < jewelry_form_table_count ? jewelry_form_anklet + (int)form : jewelry_form_anklet;
+    jewelry->material = material < jewelry_material_names_count ? jewelry_material_fake + (int)material : jewelry_material_fake;
+    jewelry->workmanship_bonus = binary_reader_int(reader);
+    jewelry->exceptional_stone_bonus = binary_reader_int(reader);
+    jewelry->value_in_cp = binary_reader_int(reader);
+    jewelry->true_description = jewelry_alloc_true_description(jewelry);
+}
+
+
 void
 jewelry_initialize_from_json_object(struct jewelry *jewelry,
                                     struct cJSON *json_object)
@@ -389,16 +443,88 @@ jewelry_initialize_from_json_object(struct jewelry *jewelry,
     if ( ! cJSON_IsObject(json_object)) return;
     if ( ! json_object_has_struct_member(json_object, "jewelry")) return;
 
-    jewelry->has_gems = json_object_get_bool_value(json_object, "has_gems", false);
-    jewelry->form = json_object_get_string_enum_value(json_object, "form", jewelry_form_for_name, jewelry_form_anklet);
-    jewelry->material = json_object_get_string_enum_value(json_object, "material", jewelry_material_for_name, jewelry_material_fake);
-    jewelry->workmanship_bonus = json_object_get_int_value(json_object, "workmanship_bonus", 0);
-    jewelry->exceptional_stone_bonus = json_object_get_int_value(json_object, "exceptional_stone_bonus", 0);
-    jewelry->value_in_cp = json_object_get_int_value(json_object, "value_in_cp", 0);
+    pthread_once(&jewelry_keys_once, initialize_jewelry_keys);
+    uint32_t seen = 0;
+    struct cJSON *item;
+    cJSON_ArrayForEach(item, json_object) {
+        switch (json_key_index_find_first(&jewelry_keys, item->string, &seen)) {
+            case jewelry_key_has_gems:
+                jewelry->has_gems = json_item_get_bool_value(item, false);
+                break;
+            case jewelry_key_form:
+                jewelry->form = json_item_get_string_enum_value(item, jewelry_form_for_name, jewelry_form_anklet);
+                break;
+            case jewelry_key_material:
+                jewelry->material = json_item_get_string_enum_value(item, jewelry_material_for_name, jewelry_material_fake);
+                break;
+            case jewelry_key_workmanship_bonus:
+                jewelry->workmanship_bonus = json_item_get_int_value(item, 0);
+                break;
+            case jewelry_key_exceptional_stone_bonus:
+                jewelry->exceptional_stone_bonus = json_item_get_int_value(item, 0);
+                break;
+            case jewelry_key_value_in_cp:
+                jewelry->value_in_cp = json_item_get_int_value(item, 0);
+                break;
+            default:
+                break;
+        }
+    }
     jewelry->true_description = jewelry_alloc_true_description(jewelry);
 }
 
 
+void
+jewelry_initialize_from_json_reader(struct jewelry *jewelry,
+                                    struct json_reader *reader)
+{
+    jewelry_initialize(jewelry);
+
+    if (json_token_begin_object != reader->token) {
+        json_reader_skip_value(reader);
+        return;
+    }
+
+    pthread_once(&jewelry_keys_once, initialize_jewelry_keys);
+    bool is_jewelry = false;
+    uint32_t seen = 0;
+    while (json_reader_next_member(reader)) {
+        switch (json_key_index_find_first(&jewelry_keys, reader->key, &seen)) {
+            case jewelry_key_struct:
+                is_jewelry = str_eq("jewelry", json_reader_get_string_value(reader, ""));
+                break;
+            case jewelry_key_has_gems:
+                jewelry->has_gems = json_reader_get_bool_value(reader, false);
+                break;
+            case jewelry_key_form:
+                jewelry->form = json_reader_get_string_enum_value(reader, jewelry_form_for_name, jewelry_form_anklet);
+                break;
+            case jewelry_key_material:
+                jewelry->material = json_reader_get_string_enum_value(reader, jewelry_material_for_name, jewelry_material_fake);
+                break;
+            case jewelry_key_workmanship_bonus:
+                jewelry->workmanship_bonus = json_reader_get_int_value(reader, 0);
+                break;
+            case jewelry_key_exceptional_stone_bonus:
+                jewelry->exceptional_stone_bonus = json_reader_get_int_value(reader, 0);
+                break;
+            case jewelry_key_value_in_cp:
+                jewelry->value_in_cp = json_reader_get_int_value(reader, 0);
+                break;
+            default:
+                json_reader_skip_value(reader);
+                break;
+        }
+    }
+
+    if (is_jewelry) {
+        jewelry->true_description = jewelry_alloc_true_description(jewelry);
+    } else {
+        jewelry_initialize(jewelry);
+    }
+}
+
+
 static int
 jewelry_material_for_name(char const *name, int default_value)
 {
@@ -426,3 +552,31 @@ jewelry_value_in_cp(struct jewelry *jewelry)
 {
     return jewelry->value_in_cp;
 }
+
+
+void
+jewelry_write_binary(struct jewelry *jewelry, struct binary_writer *writer)
+{
+    binary_writer_bool(writer, jewelry->has_gems);
+    binary_writer_uint(writer, (unsigned)(jewelry->form - jewelry_form_anklet));
+    binary_writer_uint(writer, (unsigned)(jewelry->material - jewelry_material_fake));
+    binary_writer_int(writer, jewelry->workmanship_bonus);
+    binary_writer_int(writer, jewelry->exceptional_stone_bonus);
+    binary_writer_int(writer, jewelry->value_in_cp);
+}
+
+
+void
+jewelry_write_json(struct jewelry *jewelry, struct json_writer *writer)
+{
+    json_writer_begin_object(writer);
+    json_writer_member_string(writer, "struct", "jewelry");
+    json_writer_member_int(writer, "rev", 0);
+    json_writer_member_bool(writer, "has_gems", jewelry->has_gems);
+    json_writer_member_string(writer, "form", jewelry_form_name(jewelry));
+    json_writer_member_string(writer, "material", jewelry_material_name(jewelry));
+    json_writer_member_int(writer, "workmanship_bonus", jewelry->workmanship_bonus);
+    json_writer_member_int(writer, "exceptional_stone_bonus", jewelry->exceptional_stone_bonus);
+    json_writer_member_int(writer, "value_in_cp", jewelry->value_in_cp);
+    json_writer_end_object(writer);
+}
@@ -5,7 +5,11 @@
 #include <stdbool.h>
 
 
+struct binary_reader;
+struct binary_writer;
 struct cJSON;
+struct json_reader;
+struct json_writer;
 struct rnd;
 
 
@@ -86,12 +90,26 @@ jewelry_generate(struct jewelry *jewelry, struct rnd *rnd);
 void
 jewelry_initialize(struct jewelry *jewelry);
 
+void
+jewelry_initialize_from_binary_reader(struct jewelry *jewelry,
+                                      struct binary_reader *reader);
+
 void
 jewelry_initialize_from_json_object(struct jewelry *jewelry,
                                     struct cJSON *json_object);
 
+void
+jewelry_initialize_from_json_reader(struct jewelry *jewelry,
+                                    struct json_reader *reader);
+
 int
 jewelry_value_in_cp(struct jewelry *jewelry);
 
+void
+jewelry_write_binary(struct jewelry *jewelry, struct binary_writer *writer);
+
+void
+jewelry_write_json(struct jewelry *jewelry, struct json_writer *writer);
+
 
 #endif
@@ -1,6 +1,7 @@
 #include "magic_item.h"
 
 #include <assert.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
@@ -68,6 +69,11 @@ generate_jewel_of_flawlessness(struct magic_item *magic_item, struct rnd *rnd);
 static void
 generate_medallion_of_ESP(struct magic_item *magic_item, struct rnd *rnd);
 
+static void
+generate_misc_magic_item(struct magic_item *magic_item,
+                         struct rnd *rnd,
+                         int table_index);
+
 static void
 generate_misc_magic_item_table1(struct magic_item *magic_item, struct rnd *rnd);
 
@@ -134,6 +140,18 @@ generate_sword(struct magic_item *magic_item, struct rnd *rnd);
 static void
 generate_teeth_of_dahlver_nar(struct magic_item *magic_item, struct rnd *rnd);
 
+static void
+initialize_magic_item_keys(void);
+
+static void
+initialize_magic_items_weighted_tables(void);
+
+static void
+initialize_misc_magic_items_weighted_tables(void);
+
+static void
+initialize_misc_weapons_weighted_table(void);
+
 static int
 magic_item_type_for_name(char const *name, int default_value);
 
@@ -662,51 +680,63 @@ generate_jewel_of_flawlessness(struct magic_item *magic_item, struct rnd *rnd)
 }
 
 
+static struct {
+    int percent;
+    possible_magic_items_t possible_magic_items;
+    enum magic_item_type type;
+    generate_function generate;
+} const magic_items_table[] = {
+    {  20 -  0, POTION, magic_item_type_potion, generate_potion },
+    {  35 - 20, SCROLL, magic_item_type_scroll, generate_scroll },
+    {  40 - 35, RING, magic_item_type_ring, generate_ring },
+    {  45 - 40, ROD_STAFF_WAND, magic_item_type_rod_staff_or_wand, generate_rod_staff_or_wand },
+    {  48 - 45, MISC_MAGIC, magic_item_type_misc, generate_misc_magic_item_table1 },
+    {  51 - 48, MISC_MAGIC, magic_item_type_misc, generate_misc_magic_item_table2 },
+    {  54 - 51, MISC_MAGIC, magic_item_type_misc, generate_misc_magic_item_table3 },
+    {  57 - 54, MISC_MAGIC, magic_item_type_misc, generate_misc_magic_item_table4 },
+    {  60 - 57, MISC_MAGIC, magic_item_type_misc, generate_misc_magic_item_table5 },
+    {  75 - 60, ARMOR_SHIELD, magic_item_type_armor, generate_armor_or_shield },
+    {  86 - 75, SWORD, magic_item_type_sword, generate_sword },
+    { 100 - 86, MISC_WEAPON, magic_item_type_misc_weapon, generate_misc_weapon }
+};
+enum { magic_items_table_count = ARRAY_COUNT(magic_items_table) };
+
+
+// one table for each combination of possible magic items
+static struct weighted_table magic_items_weighted_tables[ANY_MAGIC_ITEM + 1];
+static int magic_items_cumulative_weights[(ANY_MAGIC_ITEM + 1) * magic_items_table_count];
+static pthread_once_t magic_items_weighted_tables_once = PTHREAD_ONCE_INIT;
+
+
+static void
+initialize_magic_items_weighted_tables(void)
+{
+    int *cumulative_weights = magic_items_cumulative_weights;
+    for (possible_magic_items_t mask = 0; mask <= ANY_MAGIC_ITEM; ++mask) {
+        int weights[magic_items_table_count];
+        for (int i = 0; i < magic_items_table_count; ++i) {
+            bool is_possible = mask & magic_items_table[i].possible_magic_items;
+            weights[i] = is_possible ? magic_items_table[i].percent : 0;
+        }
+        cumulative_weights += weighted_table_initialize(&magic_items_weighted_tables[mask],
+                                                        weights,
+                                                        magic_items_table_count,
+                                                        cumulative_weights);
+    }
+}
+
+
 void magic_item_generate(struct magic_item *magic_item,
                          struct rnd *rnd,
                          possible_magic_items_t possible_magic_items)
 {
-    struct {
-        int percent;
-        possible_magic_items_t possible_magic_items;
-        enum magic_item_type type;
-        generate_function generate;
-    } const magic_items_table[] = {
-        {  20 -  0, POTION, magic_item_type_potion, generate_potion },
-        {  35 - 20, SCROLL, magic_item_type_scroll, generate_scroll },
-        {  40 - 35, RING, magic_item_type_ring, generate_ring },
-        {  45 - 40, ROD_STAFF_WAND, magic_item_type_rod_staff_or_wand, generate_rod_staff_or_wand },
-        {  48 - 45, MISC_MAGIC, magic_item_type_misc, generate_misc_magic_item_table1 },
-        {  51 - 48, MISC_MAGIC, magic_item_type_misc, generate_misc_magic_item_table2 },
-        {  54 - 51, MISC_MAGIC, magic_item_type_misc, generate_misc_magic_item_table3 },
-        {  57 - 54, MISC_MAGIC, magic_item_type_misc, generate_misc_magic_item_table4 },
-        {  60 - 57, MISC_MAGIC, magic_item_type_misc, generate_misc_magic_item_table5 },
-        {  75 - 60, ARMOR_SHIELD, magic_item_type_armor, generate_armor_or_shield },
-        {  86 - 75, SWORD, magic_item_type_sword, generate_sword },
-        { 100 - 86, MISC_WEAPON, magic_item_type_misc_weapon, generate_misc_weapon }
-    };
-    size_t const magic_items_table_count = ARRAY_COUNT(magic_items_table);
-    
-    int total = 0;
-    for (int i = 0; i < magic_items_table_count; ++i) {
-        if (possible_magic_items & magic_items_table[i].possible_magic_items) {
-            total += magic_items_table[i].percent;
-        }
-    }
-    
-    int score = dice_roll(dice_make(1, total), rnd, NULL);
-    int range = 0;
-    for (int i = 0; i < magic_items_table_count; ++i) {
-        if (possible_magic_items & magic_items_table[i].possible_magic_items) {
-            range += magic_items_table[i].percent;
-            if (score <= range) {
-                magic_item->type = magic_items_table[i].type;
-                magic_items_table[i].generate(magic_item, rnd);
-                return;
-            }
-        }
-    }
-    fail("Did not match table entry (score=%i, range=%i)", score, range);
+    pthread_once(&magic_items_weighted_tables_once,
+                 initialize_magic_items_weighted_tables);
+    struct weighted_table const *weighted_table
+            = &magic_items_weighted_tables[possible_magic_items & ANY_MAGIC_ITEM];
+    int index = weighted_table_roll(weighted_table, rnd);
+    magic_item->type = magic_items_table[index].type;
+    magic_items_table[index].generate(magic_item, rnd);
 }
 
 
@@ -739,57 +769,247 @@ generate_medallion_of_ESP(struct magic_item *magic_item, struct rnd *rnd)
 }
 
 
+static struct misc_magic_item const misc_magic_items_table1[] = {
+    {   2 -  0, "alchemy jug", 3000, 12000 },
+    {   4 -  2, "amulet of inescapable location", 0, 1000 },
+    {   5 -  4, "amulet of life protection", 5000, 20000 },
+    {   7 -  5, "amulet of the planes", 6000, 30000 },
+    {  11 -  7, "amulet of proof against detection and location", 4000, 15000 },
+    {  13 - 11, "apparatus of kwalish", 8000, 35000 },
+    {  16 - 13, "arrow of direction", 2500, 17500 },
+    {  17 - 16, "artifact or relic", 0, 0, NO_CLASS_RESTRICTIONS, generate_artifact_or_relic },
+    {  20 - 17, "bag of beans", 1000, 5000 },
+    {  21 - 20, "bag of devouring", 0, 1500 },
+    {  26 - 21, "bag of holding", 5000, 25000 },
+    {  27 - 26, "bag of transmuting", 0, 500 },
+    {  29 - 27, "bag of tricks", 2500, 15000 },
+    {  31 - 29, "beaker of plentiful potions", 1500, 12500 },
+    {  32 - 31, "folding boat", 10000, 25000 },
+    {  33 - 32, "book of exalted deeds", 8000, 40000, CLERICS },
+    {  34 - 33, "book of infinite spells", 9000, 50000 },
+    {  35 - 34, "book of vile darkness", 8000, 40000, CLERICS },
+    {  36 - 35, "boots of dancing", 0, 5000 },
+    {  42 - 36, "boots of elvenkind", 1000, 5000 },
+    {  47 - 42, "boots of levitation", 2000, 15000 },
+    {  51 - 47, "boots of speed", 2500, 20000 },
+    {  55 - 51, "boots of striding and springing", 2500, 20000 },
+    {  58 - 55, "bowl commanding water elementals", 4000, 25000, MAGIC_USERS },
+    {  59 - 58, "bowl of watery death", 0, 1000 },
+    {  79 - 59, "bracers of defense", 500, 3000, NO_CLASS_RESTRICTIONS, generate_bracers_of_defense },
+    {  81 - 79, "bracers of defenselessness", 0, 2000 },
+    {  84 - 81, "brazier commanding fire elementals", 4000, 25000, MAGIC_USERS },
+    {  85 - 84, "brazier of sleep smoke", 0, 1000, MAGIC_USERS },
+    {  92 - 85, "brooch of shielding", 1000, 10000 },
+    {  93 - 92, "broom of animated attack", 0, 3000 },
+    {  98 - 93, "broom of flying", 2000, 10000 },
+    { 100 - 98, "Bucknards everfull purse", 1500, 15000, NO_CLASS_RESTRICTIONS, generate_bucknards_everfull_purse }
+};
+
+
+static struct misc_magic_item const misc_magic_items_table2[] = {
+    {   6 -  0, "candle of invocation", 1000, 5000, CLERICS },
+    {   8 -  6, "carpet of flying", 7500, 25000 },
+    {  10 -  8, "censer controlling air elementals", 4000, 25000, MAGIC_USERS },
+    {  11 - 10, "censer of summoning hostile air elementals", 0, 1000, MAGIC_USERS },
+    {  13 - 11, "chime of opening", 3500, 20000 },
+    {  14 - 13, "chime of hunger", 0, 0 },
+    {  18 - 14, "cloak of displacement", 3000, 17500 },
+    {  27 - 18, "cloak of elvenkind", 1000, 6000 },
+    {  30 - 27, "cloak of manta ray", 2000, 12500 },
+    {  32 - 30, "cloak of poisonousness", 0, 2500 },
+    {  55 - 32, "cloak of protection", 1000, 10000, NO_CLASS_RESTRICTIONS, generate_cloak_of_protection },
+    {  60 - 55, "crystal ball", 1000, 5000, MAGIC_USERS, generate_crystal_ball },
+    {  61 - 60, "crystal hypnosis ball", 0, 3000, MAGIC_USERS },
+    {  63 - 61, "cube of force", 3000, 20000 },
+    {  65 - 63, "cube of frost resistance", 2000, 14000 },
+    {  67 - 65, "cubic gate", 5000, 17500 },
+    {  69 - 67, "Daern's instant fortress", 7000, 27500 },
+    {  72 - 69, "decanter of endless water", 1000, 3000 },
+    {  76 - 72, "deck of many things", 0, 10000 },
+    {  77 - 76, "drums of deafening", 0, 500 },
+    {  79 - 77, "drums of panic", 6500, 35000 },
+    {  85 - 79, "dust of appearance", 1000, 4000 },
+    {  91 - 85, "dust of disappearance", 2000, 8000 },
+    {  92 - 91, "dust of sneezing and choking", 0, 1000 },
+    {  93 - 92, "efreeti bottle", 9000, 45000 },
+    {  94 - 93, "eversmoking bottle", 500, 2500 },
+    {  95 - 94, "eyes of charming", 4000, 24000, MAGIC_USERS },
+    {  97 - 95, "eyes of the eagle", 3500, 18000 },
+    {  99 - 97, "eyes of minute seeing", 2000, 12500 },
+    { 100 - 99, "eyes of petrification", 0, 0, NO_CLASS_RESTRICTIONS, generate_eyes_of_petrification }
+};
+
+
+static struct misc_magic_item const misc_magic_items_table3[] = {
+    {  15 -  0, "figurine of wondrous power", 100, 1000, NO_CLASS_RESTRICTIONS, generate_figurine_of_wondrous_power },
+    {  16 - 15, "flask of curses", 0, 1000 },
+    {  18 - 16, "gauntlets of dexterity", 1000, 10000 },
+    {  20 - 18, "gauntlets of fumbling", 0, 1000 },
+    {  22 - 20, "gauntlets of ogre power", 1000, 15000, CLERICS | FIGHTERS | THIEVES },
+    {  25 - 22, "gauntlets of swimming and climbing", 1000, 10000, CLERICS | FIGHTERS | THIEVES },
+    {  26 - 25, "gem of brightness", 2000, 17500 },
+    {  27 - 26, "gem of seeing", 2000, 25000 },
+    {  28 - 27, "girdle of femininity/masculinity", 0, 1000, CLERICS | FIGHTERS | THIEVES },
+    {  29 - 28, "girdle of giant strength", 200, 2500, CLERICS | FIGHTERS | THIEVES, generate_girdle_of_giant_strength },
+    {  30 - 29, "helm of brilliance", 2500, 60000 },
+    {  35 - 30, "helm of comprehending languages & reading magic", 1000, 12500 },
+    {  37 - 35, "helm of opposite alignment", 0, 1000 },
+    {  39 - 37, "helm of telepathy", 3000, 35000 },
+    {  40 - 39, "helm of teleportation", 2500, 30000 },
+    {  45 - 40, "helm of underwater action", 1000, 10000 },
+    {  46 - 45, "horn of blasting", 5000, 55000 },
+    {  48 - 46, "horn of bubbles", 0, 0 },
+    {  49 - 48, "horn of collapsing", 1500, 25000 },
+    {  53 - 49, "horn of the tritons", 2000, 17500, CLERICS | FIGHTERS },
+    {  60 - 53, "horn of Valhalla", 1000, 15000, NO_CLASS_RESTRICTIONS, generate_horn_of_valhalla },
+    {  63 - 60, "horseshoes of speed", 2000, 10000 },
+    {  65 - 63, "horseshoes of a zephyr", 1500, 7500 },
+    {  70 - 65, "incense of meditation", 500, 7500, CLERICS },
+    {  71 - 70, "incense of obsession", 0, 500, CLERICS },
+    {  72 - 71, "ioun stones", 300, 5000, NO_CLASS_RESTRICTIONS, generate_ioun_stones },
+    {  78 - 72, "instrument of the bards", 1000, 5000, NO_CLASS_RESTRICTIONS, generate_instrument_of_the_bards },
+    {  80 - 78, "iron flask", 0, 0 },
+    {  85 - 80, "javelin of lightning", 250, 3000, FIGHTERS },
+    {  90 - 85, "javelin of piercing", 250, 3000, FIGHTERS },
+    {  91 - 90, "jewel of attacks", 0, 1000 },
+    {  92 - 91, "jewel of flawlessness", 0, 1000, NO_CLASS_RESTRICTIONS, generate_jewel_of_flawlessness },
+    { 100 - 92, "Keoghtom's ointment", 500, 10000 }
+};
+
+
+static struct misc_magic_item const misc_magic_items_table4[] = {
+    {   1 -  0, "libram of gainful conjuration", 8000, 40000, MAGIC_USERS },
+    {   2 -  1, "libram of ineffable damnation", 8000, 40000, MAGIC_USERS },
+    {   3 -  2, "libram of silver magic", 8000, 40000, MAGIC_USERS },
+    {   4 -  3, "lyre of building", 5000, 30000 },
+    {   5 -  4, "manual of bodily health", 5000, 50000 },
+    {   6 -  5, "manual of gainful exercise", 5000, 50000 },
+    {   7 -  6, "manual of golems", 3000, 30000, CLERICS | MAGIC_USERS },
+    {   8 -  7, "manual of puissant skill at arms", 8000, 40000, FIGHTERS },
+    {   9 -  8, "manual of quickness of action", 5000, 50000 },
+    {  10 -  9, "manual of stealthy pilfering", 8000, 40000, THIEVES },
+    {  11 - 10, "mattock of the titans", 3500, 7000, FIGHTERS },
+    {  12 - 11, "maul of the titans", 4000, 12000 },
+    {  15 - 12, "medallion of ESP", 1000, 10000, NO_CLASS_RESTRICTIONS, generate_medallion_of_ESP },
+    {  17 - 15, "medallion of thought projection", 0, 1000 },
+    {  18 - 17, "mirror of life trapping", 2500, 25000, MAGIC_USERS },
+    {  19 - 18, "mirror of mental prowess", 5000, 50000 },
+    {  20 - 19, "mirror of opposition", 0, 2000 },
+    {  23 - 20, "necklace of adaptation", 1000, 10000 },
+    {  27 - 23, "necklace of missiles", 50, 200, NO_CLASS_RESTRICTIONS, generate_necklace_of_missiles },
+    {  33 - 27, "necklace of prayer beads", 500, 3000, CLERICS, generate_necklace_of_prayer_beads },
+    {  35 - 33, "necklace of strangulation", 0, 1000 },
+    {  38 - 35, "net of entrapment", 1000, 7500, CLERICS | FIGHTERS | THIEVES },
+    {  42 - 38, "net of snaring", 1000, 6000, CLERICS | FIGHTERS | THIEVES },
+    {  44 - 42, "Nolzurs' marvelous pigments", 500, 3000, NO_CLASS_RESTRICTIONS, generate_nolzurs_marvelous_pigments },
+    {  46 - 44, "pearl of power", 200, 2000, MAGIC_USERS, generate_pearl_of_power },
+    {  48 - 46, "pearl of wisdom", 500, 5000, CLERICS },
+    {  50 - 48, "periapt of foul rotting", 0, 1000 },
+    {  53 - 50, "periapt of health", 1000, 10000 },
+    {  60 - 53, "periapt of proof against poison", 1500, 12500 },
+    {  64 - 60, "periapt of wound closure", 1000, 10000 },
+    {  70 - 64, "phylactery of faithfulness", 1000, 7500, CLERICS },
+    {  74 - 70, "phylactery of long years", 3000, 25000, CLERICS },
+    {  76 - 74, "phylactery of monstrous attention", 0, 2000, CLERICS },
+    {  84 - 76, "pipes of the sewers", 1750, 8500 },
+    {  85 - 84, "portable hole", 5000, 50000 },
+    { 100 - 85, "Quaal's feather token", 500, 2000, NO_CLASS_RESTRICTIONS, generate_quaals_feather_token },
+};
+
+
+static struct misc_magic_item const misc_magic_items_table5[] = {
+    {   1 -  0, "robe of the archmagi", 6000, 65000, MAGIC_USERS },
+    {   8 -  1, "robe of blending", 3500, 35000 },
+    {   9 -  8, "robe of eyes", 4500, 50000, MAGIC_USERS },
+    {  10 -  9, "robe of powerlessness", 0, 1000 },
+    {  11 - 10, "robe of scintillating colors", 2750, 25000, CLERICS | MAGIC_USERS },
+    {  19 - 11, "robe of useful items", 1500, 15000, MAGIC_USERS },
+    {  25 - 19, "rope of climbing", 1000, 10000 },
+    {  27 - 25, "rope of construction", 0, 1000 },
+    {  31 - 27, "rope of entanglement", 1250, 12000 },
+    {  32 - 31, "rug of smothering", 0, 1500 },
+    {  33 - 32, "rug of welcome", 6500, 45000, MAGIC_USERS },
+    {  34 - 33, "saw of mighty cutting", 1750, 12500, FIGHTERS },
+    {  35 - 34, "scarab of death", 0, 2500 },
+    {  38 - 35, "scarab of enraging enemies", 1000, 8000 },
+    {  40 - 38, "scarab of insanity", 1500, 11000 },
+    {  46 - 40, "scarab of protection", 2500, 25000 },
+    {  47 - 46, "spade of colossal excavation", 1000, 6500, FIGHTERS },
+    {  48 - 47, "sphere of annihilation", 3750, 30000, MAGIC_USERS },
+    {  50 - 48, "stone of controlling earth elementals", 1500, 12500 },
+    {  52 - 50, "stone of good luck (luckstone)", 3000, 25000 },
+    {  54 - 52, "stone of weight (loadstone)", 0, 1000 },
+    {  57 - 54, "talisman of pure good", 3500, 27500, CLERICS },
+    {  58 - 57, "talisman of the sphere", 100, 10000, MAGIC_USERS },
+    {  60 - 58, "talisman of ultimate evil", 3500, 32500, CLERICS },
+    {  66 - 60, "talisman of Zagy", 1000, 10000 },
+    {  67 - 66, "tome of clear thought", 8000, 48000 },
+    {  68 - 67, "tome of leadership and influence", 7500, 40000 },
+    {  69 - 68, "tome of understanding", 8000, 43500 },
+    {  76 - 69, "trident of fish command", 500, 4000, CLERICS | FIGHTERS | THIEVES },
+    {  78 - 76, "trident of submission", 1250, 12500, FIGHTERS },
+    {  83 - 78, "trident of warning", 1000, 10000, CLERICS | FIGHTERS | THIEVES },
+    {  85 - 83, "trident of yearning", 0, 1000 },
+    {  87 - 85, "vacuous grimoire", 0, 1000 },
+    {  90 - 87, "well of many worlds", 6000, 12000 },
+    { 100 - 90, "wings of flying", 750, 7500 }
+};
+
+
+static struct {
+    struct misc_magic_item const *items;
+    int count;
+} const misc_magic_items_tables[] = {
+    { misc_magic_items_table1, ARRAY_COUNT(misc_magic_items_table1) },
+    { misc_magic_items_table2, ARRAY_COUNT(misc_magic_items_table2) },
+    { misc_magic_items_table3, ARRAY_COUNT(misc_magic_items_table3) },
+    { misc_magic_items_table4, ARRAY_COUNT(misc_magic_items_table4) },
+    { misc_magic_items_table5, ARRAY_COUNT(misc_magic_items_table5) }
+};
+enum {
+    misc_magic_items_tables_count = ARRAY_COUNT(misc_magic_items_tables),
+    misc_magic_items_count = ARRAY_COUNT(misc_magic_items_table1)
+                           + ARRAY_COUNT(misc_magic_items_table2)
+                           + ARRAY_COUNT(misc_magic_items_table3)
+                           + ARRAY_COUNT(misc_magic_items_table4)
+                           + ARRAY_COUNT(misc_magic_items_table5),
+};
+
+
+static struct weighted_table misc_magic_items_weighted_tables[misc_magic_items_tables_count];
+static int misc_magic_items_cumulative_weights[misc_magic_items_count];
+static pthread_once_t misc_magic_items_weighted_tables_once = PTHREAD_ONCE_INIT;
+
+
 static void
-generate_misc_magic_item_table1(struct magic_item *magic_item, struct rnd *rnd)
+initialize_misc_magic_items_weighted_tables(void)
 {
-    static struct misc_magic_item const misc_magic_items_table[] = {
-        {   2 -  0, "alchemy jug", 3000, 12000 },
-        {   4 -  2, "amulet of inescapable location", 0, 1000 },
-        {   5 -  4, "amulet of life protection", 5000, 20000 },
-        {   7 -  5, "amulet of the planes", 6000, 30000 },
-        {  11 -  7, "amulet of proof against detection and location", 4000, 15000 },
-        {  13 - 11, "apparatus of kwalish", 8000, 35000 },
-        {  16 - 13, "arrow of direction", 2500, 17500 },
-        {  17 - 16, "artifact or relic", 0, 0, NO_CLASS_RESTRICTIONS, generate_artifact_or_relic },
-        {  20 - 17, "bag of beans", 1000, 5000 },
-        {  21 - 20, "bag of devouring", 0, 1500 },
-        {  26 - 21, "bag of holding", 5000, 25000 },
-        {  27 - 26, "bag of transmuting", 0, 500 },
-        {  29 - 27, "bag of tricks", 2500, 15000 },
-        {  31 - 29, "beaker of plentiful potions", 1500, 12500 },
-        {  32 - 31, "folding boat", 10000, 25000 },
-        {  33 - 32, "book of exalted deeds", 8000, 40000, CLERICS },
-        {  34 - 33, "book of infinite spells", 9000, 50000 },
-        {  35 - 34, "book of vile darkness", 8000, 40000, CLERICS },
-        {  36 - 35, "boots of dancing", 0, 5000 },
-        {  42 - 36, "boots of elvenkind", 1000, 5000 },
-        {  47 - 42, "boots of levitation", 2000, 15000 },
-        {  51 - 47, "boots of speed", 2500, 20000 },
-        {  55 - 51, "boots of striding and springing", 2500, 20000 },
-        {  58 - 55, "bowl commanding water elementals", 4000, 25000, MAGIC_USERS },
-        {  59 - 58, "bowl of watery death", 0, 1000 },
-        {  79 - 59, "bracers of defense", 500, 3000, NO_CLASS_RESTRICTIONS, generate_bracers_of_defense },
-        {  81 - 79, "bracers of defenselessness", 0, 2000 },
-        {  84 - 81, "brazier commanding fire elementals", 4000, 25000, MAGIC_USERS },
-        {  85 - 84, "brazier of sleep smoke", 0, 1000, MAGIC_USERS },
-        {  92 - 85, "brooch of shielding", 1000, 10000 },
-        {  93 - 92, "broom of animated attack", 0, 3000 },
-        {  98 - 93, "broom of flying", 2000, 10000 },
-        { 100 - 98, "Bucknards everfull purse", 1500, 15000, NO_CLASS_RESTRICTIONS, generate_bucknards_everfull_purse }
-    };
-    size_t const misc_magic_items_table_count = ARRAY_COUNT(misc_magic_items_table);
-    
-    int score = roll("1d100", rnd);
-    int range = 0;
-    struct misc_magic_item const *misc_magic_item = NULL;
-    for (int i = 0; i < misc_magic_items_table_count; ++i) {
-        range += misc_magic_items_table[i].percent;
-        if (score <= range) {
-            misc_magic_item = &misc_magic_items_table[i];
-            break;
+    int *cumulative_weights = misc_magic_items_cumulative_weights;
+    for (int i = 0; i < misc_magic_items_tables_count; ++i) {
+        struct misc_magic_item const *items = misc_magic_items_tables[i].items;
+        int count = misc_magic_items_tables[i].count;
+        int weights[count];
+        for (int j = 0; j < count; ++j) {
+            weights[j] = items[j].percent;
         }
+        cumulative_weights += weighted_table_initialize(&misc_magic_items_weighted_tables[i],
+                                                        weights,
+                                                        count,
+                                                        cumulative_weights);
     }
-    assert(misc_magic_item);
+}
+
+
+static void
+generate_misc_magic_item(struct magic_item *magic_item,
+                         struct rnd *rnd,
+                         int table_index)
+{
+    pthread_once(&misc_magic_items_weighted_tables_once,
+                 initialize_misc_magic_items_weighted_tables);
+    int index = weighted_table_roll(&misc_magic_items_weighted_tables[table_index], rnd);
+    struct misc_magic_item const *misc_magic_item
+            = &misc_magic_items_tables[table_index].items[index];
     
     if (misc_magic_item->generate) {
         misc_magic_item->generate(magic_item, rnd);
@@ -802,321 +1022,114 @@ generate_misc_magic_item_table1(struct magic_item *magic_item, struct rnd *rnd)
 }
 
 
+static void
+generate_misc_magic_item_table1(struct magic_item *magic_item, struct rnd *rnd)
+{
+    generate_misc_magic_item(magic_item, rnd, 0);
+}
+
+
 static void
 generate_misc_magic_item_table2(struct magic_item *magic_item, struct rnd *rnd)
 {
-    static struct misc_magic_item const misc_magic_items_table[] = {
-        {   6 -  0, "candle of invocation", 1000, 5000, CLERICS },
-        {   8 -  6, "carpet of flying", 7500, 25000 },
-        {  10 -  8, "censer controlling air elementals", 4000, 25000, MAGIC_USERS },
-        {  11 - 10, "censer of summoning hostile air elementals", 0, 1000, MAGIC_USERS },
-        {  13 - 11, "chime of opening", 3500, 20000 },
-        {  14 - 13, "chime of hunger", 0, 0 },
-        {  18 - 14, "cloak of displacement", 3000, 17500 },
-        {  27 - 18, "cloak of elvenkind", 1000, 6000 },
-        {  30 - 27, "cloak of manta ray", 2000, 12500 },
-        {  32 - 30, "cloak of poisonousness", 0, 2500 },
-        {  55 - 32, "cloak of protection", 1000, 10000, NO_CLASS_RESTRICTIONS, generate_cloak_of_protection },
-        {  60 - 55, "crystal ball", 1000, 5000, MAGIC_USERS, generate_crystal_ball },
-        {  61 - 60, "crystal hypnosis ball", 0, 3000, MAGIC_USERS },
-        {  63 - 61, "cube of force", 3000, 20000 },
-        {  65 - 63, "cube of frost resistance", 2000, 14000 },
-        {  67 - 65, "cubic gate", 5000, 17500 },
-        {  69 - 67, "Daern's instant fortress", 7000, 27500 },
-        {  72 - 69, "decanter of endless water", 1000, 3000 },
-        {  76 - 72, "deck of many things", 0, 10000 },
-        {  77 - 76, "drums of deafening", 0, 500 },
-        {  79 - 77, "drums of panic", 6500, 35000 },
-        {  85 - 79, "dust of appearance", 1000, 4000 },
-        {  91 - 85, "dust of disappearance", 2000, 8000 },
-        {  92 - 91, "dust of sneezing and choking", 0, 1000 },
-        {  93 - 92, "efreeti bottle", 9000, 45000 },
-        {  94 - 93, "eversmoking bottle", 500, 2500 },
-        {  95 - 94, "eyes of charming", 4000, 24000, MAGIC_USERS },
-        {  97 - 95, "eyes of the eagle", 3500, 18000 },
-        {  99 - 97, "eyes of minute seeing", 2000, 12500 },
-        { 100 - 99, "eyes of petrification", 0, 0, NO_CLASS_RESTRICTIONS, generate_eyes_of_petrification }
-    };
-    size_t const misc_magic_items_table_count = ARRAY_COUNT(misc_magic_items_table);
-    
-    int score = roll("1d100", rnd);
-    int range = 0;
-    struct misc_magic_item const *misc_magic_item = NULL;
-    for (int i = 0; i < misc_magic_items_table_count; ++i) {
-        range += misc_magic_items_table[i].percent;
-        if (score <= range) {
-            misc_magic_item = &misc_magic_items_table[i];
-            break;
-        }
-    }
-    assert(misc_magic_item);
-    
-    if (misc_magic_item->generate) {
-        misc_magic_item->generate(magic_item, rnd);
-    } else {
-        magic_item->experience_points = misc_magic_item->experience_points;
-        magic_item->true_value_in_cp = gp_to_cp(misc_magic_item->sale_value_in_gp);
-        magic_item->true_description = str_alloc_formatted("%s",
-                                                           misc_magic_item->name);
-    }
+    generate_misc_magic_item(magic_item, rnd, 1);
 }
 
 
 static void
 generate_misc_magic_item_table3(struct magic_item *magic_item, struct rnd *rnd)
 {
-    static struct misc_magic_item const misc_magic_items_table[] = {
-        {  15 -  0, "figurine of wondrous power", 100, 1000, NO_CLASS_RESTRICTIONS, generate_figurine_of_wondrous_power },
-        {  16 - 15, "flask of curses", 0, 1000 },
-        {  18 - 16, "gauntlets of dexterity", 1000, 10000 },
-        {  20 - 18, "gauntlets of fumbling", 0, 1000 },
-        {  22 - 20, "gauntlets of ogre power", 1000, 15000, CLERICS | FIGHTERS | THIEVES },
-        {  25 - 22, "gauntlets of swimming and climbing", 1000, 10000, CLERICS | FIGHTERS | THIEVES },
-        {  26 - 25, "gem of brightness", 2000, 17500 },
-        {  27 - 26, "gem of seeing", 2000, 25000 },
-        {  28 - 27, "girdle of femininity/masculinity", 0, 1000, CLERICS | FIGHTERS | THIEVES },
-        {  29 - 28, "girdle of giant strength", 200, 2500, CLERICS | FIGHTERS | THIEVES, generate_girdle_of_giant_strength },
-        {  30 - 29, "helm of brilliance", 2500, 60000 },
-        {  35 - 30, "helm of comprehending languages & reading magic", 1000, 12500 },
-        {  37 - 35, "helm of opposite alignment", 0, 1000 },
-        {  39 - 37, "helm of telepathy", 3000, 35000 },
-        {  40 - 39, "helm of teleportation", 2500, 30000 },
-        {  45 - 40, "helm of underwater action", 1000, 10000 },
-        {  46 - 45, "horn of blasting", 5000, 55000 },
-        {  48 - 46, "horn of bubbles", 0, 0 },
-        {  49 - 48, "horn of collapsing", 1500, 25000 },
-        {  53 - 49, "horn of the tritons", 2000, 17500, CLERICS | FIGHTERS },
-        {  60 - 53, "horn of Valhalla", 1000, 15000, NO_CLASS_RESTRICTIONS, generate_horn_of_valhalla },
-        {  63 - 60, "horseshoes of speed", 2000, 10000 },
-        {  65 - 63, "horseshoes of a zephyr", 1500, 7500 },
-        {  70 - 65, "incense of meditation", 500, 7500, CLERICS },
-        {  71 - 70, "incense of obsession", 0, 500, CLERICS },
-        {  72 - 71, "ioun stones", 300, 5000, NO_CLASS_RESTRICTIONS, generate_ioun_stones },
-        {  78 - 72, "instrument of the bards", 1000, 5000, NO_CLASS_RESTRICTIONS, generate_instrument_of_the_bards },
-        {  80 - 78, "iron flask", 0, 0 },
-        {  85 - 80, "javelin of lightning", 250, 3000, FIGHTERS },
-        {  90 - 85, "javelin of piercing", 250, 3000, FIGHTERS },
-        {  91 - 90, "jewel of attacks", 0, 1000 },
-        {  92 - 91, "jewel of flawlessness", 0, 1000, NO_CLASS_RESTRICTIONS, generate_jewel_of_flawlessness },
-        { 100 - 92, "Keoghtom's ointment", 500, 10000 }
-    };
-    size_t const misc_magic_items_table_count = ARRAY_COUNT(misc_magic_items_table);
-    
-    int score = roll("1d100", rnd);
-    int range = 0;
-    struct misc_magic_item const *misc_magic_item = NULL;
-    for (int i = 0; i < misc_magic_items_table_count; ++i) {
-        range += misc_magic_items_table[i].percent;
-        if (score <= range) {
-            misc_magic_item = &misc_magic_items_table[i];
-            break;
-        }
-    }
-    assert(misc_magic_item);
-    
-    if (misc_magic_item->generate) {
-        misc_magic_item->generate(magic_item, rnd);
-    } else {
-        magic_item->experience_points = misc_magic_item->experience_points;
-        magic_item->true_value_in_cp = gp_to_cp(misc_magic_item->sale_value_in_gp);
-        magic_item->true_description = str_alloc_formatted("%s",
-                                                           misc_magic_item->name);
-    }
+    generate_misc_magic_item(magic_item, rnd, 2);
 }
 
 
 static void
 generate_misc_magic_item_table4(struct magic_item *magic_item, struct rnd *rnd)
 {
-    static struct misc_magic_item const misc_magic_items_table[] = {
-        {   1 -  0, "libram of gainful conjuration", 8000, 40000, MAGIC_USERS },
-        {   2 -  1, "libram of ineffable damnation", 8000, 40000, MAGIC_USERS },
-        {   3 -  2, "libram of silver magic", 8000, 40000, MAGIC_USERS },
-        {   4 -  3, "lyre of building", 5000, 30000 },
-        {   5 -  4, "manual of bodily health", 5000, 50000 },
-        {   6 -  5, "manual of gainful exercise", 5000, 50000 },
-        {   7 -  6, "manual of golems", 3000, 30000, CLERICS | MAGIC_USERS },
-        {   8 -  7, "manual of puissant skill at arms", 8000, 40000, FIGHTERS },
-        {   9 -  8, "manual of quickness of action", 5000, 50000 },
-        {  10 -  9, "manual of stealthy pilfering", 8000, 40000, THIEVES },
-        {  11 - 10, "mattock of the titans", 3500, 7000, FIGHTERS },
-        {  12 - 11, "maul of the titans", 4000, 12000 },
-        {  15 - 12, "medallion of ESP", 1000, 10000, NO_CLASS_RESTRICTIONS, generate_medallion_of_ESP },
-        {  17 - 15, "medallion of thought projection", 0, 1000 },
-        {  18 - 17, "mirror of life trapping", 2500, 25000, MAGIC_USERS },
-        {  19 - 18, "mirror of mental prowess", 5000, 50000 },
-        {  20 - 19, "mirror of opposition", 0, 2000 },
-        {  23 - 20, "necklace of adaptation", 1000, 10000 },
-        {  27 - 23, "necklace of missiles", 50, 200, NO_CLASS_RESTRICTIONS, generate_necklace_of_missiles },
-        {  33 - 27, "necklace of prayer beads", 500, 3000, CLERICS, generate_necklace_of_prayer_beads },
-        {  35 - 33, "necklace of strangulation", 0, 1000 },
-        {  38 - 35, "net of entrapment", 1000, 7500, CLERICS | FIGHTERS | THIEVES },
-        {  42 - 38, "net of snaring", 1000, 6000, CLERICS | FIGHTERS | THIEVES },
-        {  44 - 42, "Nolzurs' marvelous pigments", 500, 3000, NO_CLASS_RESTRICTIONS, generate_nolzurs_marvelous_pigments },
-        {  46 - 44, "pearl of power", 200, 2000, MAGIC_USERS, generate_pearl_of_power },
-        {  48 - 46, "pearl of wisdom", 500, 5000, CLERICS },
-        {  50 - 48, "periapt of foul rotting", 0, 1000 },
-        {  53 - 50, "periapt of health", 1000, 10000 },
-        {  60 - 53, "periapt of proof against poison", 1500, 12500 },
-        {  64 - 60, "periapt of wound closure", 1000, 10000 },
-        {  70 - 64, "phylactery of faithfulness", 1000, 7500, CLERICS },
-        {  74 - 70, "phylactery of long years", 3000, 25000, CLERICS },
-        {  76 - 74, "phylactery of monstrous attention", 0, 2000, CLERICS },
-        {  84 - 76, "pipes of the sewers", 1750, 8500 },
-        {  85 - 84, "portable hole", 5000, 50000 },
-        { 100 - 85, "Quaal's feather token", 500, 2000, NO_CLASS_RESTRICTIONS, generate_quaals_feather_token },
-    };
-    size_t const misc_magic_items_table_count = ARRAY_COUNT(misc_magic_items_table);
-    
-    int score = roll("1d100", rnd);
-    int range = 0;
-    struct misc_magic_item const *misc_magic_item = NULL;
-    for (int i = 0; i < misc_magic_items_table_count; ++i) {
-        range += misc_magic_items_table[i].percent;
-        if (score <= range) {
-            misc_magic_item = &misc_magic_items_table[i];
-            break;
-        }
-    }
-    assert(misc_magic_item);
-    
-    if (misc_magic_item->generate) {
-        misc_magic_item->generate(magic_item, rnd);
-    } else {
-        magic_item->experience_points = misc_magic_item->experience_points;
-        magic_item->true_value_in_cp = gp_to_cp(misc_magic_item->sale_value_in_gp);
-        magic_item->true_description = str_alloc_formatted("%s",
-                                                           misc_magic_item->name);
-    }
+    generate_misc_magic_item(magic_item, rnd, 3);
 }
 
 
 static void
 generate_misc_magic_item_table5(struct magic_item *magic_item, struct rnd *rnd)
 {
-    static struct misc_magic_item const misc_magic_items_table[] = {
-        {   1 -  0, "robe of the archmagi", 6000, 65000, MAGIC_USERS },
-        {   8 -  1, "robe of blending", 3500, 35000 },
-        {   9 -  8, "robe of eyes", 4500, 50000, MAGIC_USERS },
-        {  10 -  9, "robe of powerlessness", 0, 1000 },
-        {  11 - 10, "robe of scintillating colors", 2750, 25000, CLERICS | MAGIC_USERS },
-        {  19 - 11, "robe of useful items", 1500, 15000, MAGIC_USERS },
-        {  25 - 19, "rope of climbing", 1000, 10000 },
-        {  27 - 25, "rope of construction", 0, 1000 },
-        {  31 - 27, "rope of entanglement", 1250, 12000 },
-        {  32 - 31, "rug of smothering", 0, 1500 },
-        {  33 - 32, "rug of welcome", 6500, 45000, MAGIC_USERS },
-        {  34 - 33, "saw of mighty cutting", 1750, 12500, FIGHTERS },
-        {  35 - 34, "scarab of death", 0, 2500 },
-        {  38 - 35, "scarab of enraging enemies", 1000, 8000 },
-        {  40 - 38, "scarab of insanity", 1500, 11000 },
-        {  46 - 40, "scarab of protection", 2500, 25000 },
-        {  47 - 46, "spade of colossal excavation", 1000, 6500, FIGHTERS },
-        {  48 - 47, "sphere of annihilation", 3750, 30000, MAGIC_USERS },
-        {  50 - 48, "stone of controlling earth elementals", 1500, 12500 },
-        {  52 - 50, "stone of good luck (luckstone)", 3000, 25000 },
-        {  54 - 52, "stone of weight (loadstone)", 0, 1000 },
-        {  57 - 54, "talisman of pure good", 3500, 27500, CLERICS },
-        {  58 - 57, "talisman of the sphere", 100, 10000, MAGIC_USERS },
-        {  60 - 58, "talisman of ultimate evil", 3500, 32500, CLERICS },
-        {  66 - 60, "talisman of Zagy", 1000, 10000 },
-        {  67 - 66, "tome of clear thought", 8000, 48000 },
-        {  68 - 67, "tome of leadership and influence", 7500, 40000 },
-        {  69 - 68, "tome of understanding", 8000, 43500 },
-        {  76 - 69, "trident of fish command", 500, 4000, CLERICS | FIGHTERS | THIEVES },
-        {  78 - 76, "trident of submission", 1250, 12500, FIGHTERS },
-        {  83 - 78, "trident of warning", 1000, 10000, CLERICS | FIGHTERS | THIEVES },
-        {  85 - 83, "trident of yearning", 0, 1000 },
-        {  87 - 85, "vacuous grimoire", 0, 1000 },
-        {  90 - 87, "well of many worlds", 6000, 12000 },
-        { 100 - 90, "wings of flying", 750, 7500 }
-    };
-    size_t const misc_magic_items_table_count = ARRAY_COUNT(misc_magic_items_table);
-    
-    int score = roll("1d100", rnd);
-    int range = 0;
-    struct misc_magic_item const *misc_magic_item = NULL;
-    for (int i = 0; i < misc_magic_items_table_count; ++i) {
-        range += misc_magic_items_table[i].percent;
-        if (score <= range) {
-            misc_magic_item = &misc_magic_items_table[i];
-            break;
-        }
-    }
-    assert(misc_magic_item);
-    
-    if (misc_magic_item->generate) {
-        misc_magic_item->generate(magic_item, rnd);
-    } else {
-        magic_item->experience_points = misc_magic_item->experience_points;
-        magic_item->true_value_in_cp = gp_to_cp(misc_magic_item->sale_value_in_gp);
-        magic_item->true_description = str_alloc_formatted("%s",
-                                                           misc_magic_item->name);
-    }
+    generate_misc_magic_item(magic_item, rnd, 4);
 }
 
 
+static struct misc_weapon {
+    int percent;
+    char const *name;
+    char const *quantity;
+    int experience_points;
+    int sale_value_in_gp;
+} const misc_weapons_table[] = {
+    {   8 -  0, "arrow +1", "2d12", 20, 120 },
+    {  12 -  8, "arrow +2", "2d8", 50, 300 },
+    {  14 - 12, "arrow +3", "2d6", 75, 450 },
+    {  15 - 14, "arrow of slaying", "1", 250, 2500 },
+    {  20 - 15, "axe +1", "1", 300, 1750 },
+    {  22 - 20, "axe +2", "1", 600, 3750 },
+    {  23 - 22, "axe +2, throwing", "1", 750, 4500 },
+    {  24 - 23, "axe +3", "1", 1000, 7000 },
+    {  27 - 24, "battle axe +1", "1", 400, 2500 },
+    {  32 - 27, "bolt +2", "2d10", 50, 300 },
+    {  35 - 32, "bow +1", "1", 500, 3500 },
+    {  36 - 35, "crossbow of accuracy +3", "1", 2000, 12000 },
+    {  37 - 36, "crossbow of distance", "1", 1500, 7500 },
+    {  38 - 37, "crossbow of speed", "1", 1500, 7500 },
+    {  46 - 38, "dagger +1, +2 vs creatures smaller than man-sized", "1", 100, 750 },
+    {  50 - 46, "dagger +2, +3 vs creatures larger than man-sized", "1", 250, 2000 },
+    {  51 - 50, "dagger of venom", "1", 350, 3000 },
+    {  56 - 51, "flail +1", "1", 450, 4000 },
+    {  60 - 56, "hammer +1", "1", 300, 2500 },
+    {  62 - 60, "hammer +2", "1", 650, 6000 },
+    {  63 - 62, "hammer +3, dwarven thrower", "1", 1500, 15000 },
+    {  64 - 63, "hammer of thunderbolts", "1", 2500, 25000 },
+    {  67 - 64, "javelin +2", "1", 750, 5000 },
+    {  72 - 67, "mace +1", "1", 350, 3000 },
+    {  75 - 72, "mace +2", "1", 700, 4500 },
+    {  76 - 75, "mace of disruption", "1", 1750, 17500 },
+    {  77 - 76, "mace +4", "1", 1500, 15000 },
+    {  80 - 77, "military pick +1", "1", 350, 2500 },
+    {  83 - 80, "morning star +1", "1", 400, 3000 },
+    {  88 - 83, "scimitar +2", "1", 750, 6000 },
+    {  89 - 88, "sling of seeking +2", "1", 700, 7000 },
+    {  94 - 89, "spear +1", "1", 500, 3000 },
+    {  96 - 94, "spear +2", "1", 1000, 6500 },
+    {  97 - 96, "spear +3", "1", 1750, 15000 },
+    {  99 - 97, "spear, cursed backbiter", "1", 0, 1000 },
+    { 100 - 99, "trident (military fork) +3", "1", 1500, 12500 }
+};
+enum { misc_weapons_table_count = ARRAY_COUNT(misc_weapons_table) };
+
+
+static struct weighted_table misc_weapons_weighted_table;
+static int misc_weapons_cumulative_weights[misc_weapons_table_count];
+static pthread_once_t misc_weapons_weighted_table_once = PTHREAD_ONCE_INIT;
+
+
 static void
-generate_misc_weapon(struct magic_item *magic_item, struct rnd *rnd)
+initialize_misc_weapons_weighted_table(void)
 {
-    
-    static struct misc_weapon {
-        int percent;
-        char const *name;
-        char const *quantity;
-        int experience_points;
-        int sale_value_in_gp;
-    } const misc_weapons_table[] = {
-        {   8 -  0, "arrow +1", "2d12", 20, 120 },
-        {  12 -  8, "arrow +2", "2d8", 50, 300 },
-        {  14 - 12, "arrow +3", "2d6", 75, 450 },
-        {  15 - 14, "arrow of slaying", "1", 250, 2500 },
-        {  20 - 15, "axe +1", "1", 300, 1750 },
-        {  22 - 20, "axe +2", "1", 600, 3750 },
-        {  23 - 22, "axe +2, throwing", "1", 750, 4500 },
-        {  24 - 23, "axe +3", "1", 1000, 7000 },
-        {  27 - 24, "battle axe +1", "1", 400, 2500 },
-        {  32 - 27, "bolt +2", "2d10", 50, 300 },
-        {  35 - 32, "bow +1", "1", 500, 3500 },
-        {  36 - 35, "crossbow of accuracy +3", "1", 2000, 12000 },
-        {  37 - 36, "crossbow of distance", "1", 1500, 7500 },
-        {  38 - 37, "crossbow of speed", "1", 1500, 7500 },
-        {  46 - 38, "dagger +1, +2 vs creatures smaller than man-sized", "1", 100, 750 },
-        {  50 - 46, "dagger +2, +3 vs creatures larger than man-sized", "1", 250, 2000 },
-        {  51 - 50, "dagger of venom", "1", 350, 3000 },
-        {  56 - 51, "flail +1", "1", 450, 4000 },
-        {  60 - 56, "hammer +1", "1", 300, 2500 },
-        {  62 - 60, "hammer +2", "1", 650, 6000 },
-        {  63 - 62, "hammer +3, dwarven thrower", "1", 1500, 15000 },
-        {  64 - 63, "hammer of thunderbolts", "1", 2500, 25000 },
-        {  67 - 64, "javelin +2", "1", 750, 5000 },
-        {  72 - 67, "mace +1", "1", 350, 3000 },
-        {  75 - 72, "mace +2", "1", 700, 4500 },
-        {  76 - 75, "mace of disruption", "1", 1750, 17500 },
-        {  77 - 76, "mace +4", "1", 1500, 15000 },
-        {  80 - 77, "military pick +1", "1", 350, 2500 },
-        {  83 - 80, "morning star +1", "1", 400, 3000 },
-        {  88 - 83, "scimitar +2", "1", 750, 6000 },
-        {  89 - 88, "sling of seeking +2", "1", 700, 7000 },
-        {  94 - 89, "spear +1", "1", 500, 3000 },
-        {  96 - 94, "spear +2", "1", 1000, 6500 },
-        {  97 - 96, "spear +3", "1", 1750, 15000 },
-        {  99 - 97, "spear, cursed backbiter", "1", 0, 1000 },
-        { 100 - 99, "trident (military fork) +3", "1", 1500, 12500 }
-    };
-    size_t const misc_weapons_table_count = ARRAY_COUNT(misc_weapons_table);
-    
-    int score = roll("1d100", rnd);
-    int range = 0;
-    struct misc_weapon const *misc_weapon = NULL;
+    int weights[misc_weapons_table_count];
     for (int i = 0; i < misc_weapons_table_count; ++i) {
-        range += misc_weapons_table[i].percent;
-        if (score <= range) {
-            misc_weapon = &misc_weapons_table[i];
-            break;
-        }
+        weights[i] = misc_weapons_table[i].percent;
     }
-    assert(misc_weapon);
+    weighted_table_initialize(&misc_weapons_weighted_table,
+                              weights,
+                              misc_weapons_table_count,
+                              misc_weapons_cumulative_weights);
+}
+
+
+static void
+generate_misc_weapon(struct magic_item *magic_item, struct rnd *rnd)
+{
+    pthread_once(&misc_weapons_weighted_table_once,
+                 initialize_misc_weapons_weighted_table);
+    int index = weighted_table_roll(&misc_weapons_weighted_table, rnd);
+    struct misc_weapon const *misc_weapon = &misc_weapons_table[index];
     
     int quantity = roll(misc_weapon->quantity, rnd);
     magic_item->experience_points = misc_weapon->experience_points * quantity;
@@ -2422,6 +2435,63 @@ magic_item_initialize(struct magic_item *magic_item)
 }
 
 
+void
+magic_item_initialize_from_binary_reader(struct magic_item *magic_item,
+                                         struct binary_reader *reader)
+{
+    magic_item_initialize(magic_item);
+
+    magic_item->experience_points = binary_reader_int(reader);
+    char const *true_description = binary_reader_string_ref(reader);
+    if (true_description) magic_item->true_description = strdup_or_die(true_description);
+
+    int true_details_count = binary_reader_count(reader);
+    if (true_details_count) {
+        magic_item->true_details = calloc_or_die(true_details_count + 1, sizeof(char *));
+        int i = 0;
+        for (int j = 0; j < true_details_count; ++j) {
+            char const *true_detail = binary_reader_string_ref(reader);
+            if (true_detail) magic_item->true_details[i++] = strdup_or_die(true_detail);
+        }
+    }
+
+    magic_item->true_value_in_cp = binary_reader_int(reader);
+    unsigned type = binary_reader_uint(reader);
+    magic_item->type = type < magic_item_type_names_count ? magic_item_type_unknown + (int)type : magic_item_type_unknown;
+}
+
+
+enum magic_item_key {
+    magic_item_key_struct,
+    magic_item_key_experience_points,
+    magic_item_key_true_description,
+    magic_item_key_true_details,
+    magic_item_key_true_value_in_cp,
+    magic_item_key_type,
+};
+
+static char const *const magic_item_key_names[] = {
+    "struct",
+    "experience_points",
+    "true_description",
+    "true_details",
+    "true_value_in_cp",
+    "type",
+};
+
+static struct json_key_index magic_item_keys;
+static pthread_once_t magic_item_keys_once = PTHREAD_ONCE_INIT;
+
+
+static void
+initialize_magic_item_keys(void)
+{
+    json_key_index_initialize(&magic_item_keys,
+                              magic_item_key_names,
+                              ARRAY_COUNT(magic_item_key_names));
+}
+
+
 void
 magic_item_initialize_from_json_object(struct magic_item *magic_item,
                                        struct cJSON *json_object)
@@ -2431,22 +2501,103 @@ magic_item_initialize_from_json_object(struct magic_item *magic_item,
     if ( ! cJSON_IsObject(json_object)) return;
     if ( ! json_object_has_struct_member(json_object, "magic_item")) return;
 
-    magic_item->experience_points = json_object_get_int_value(json_object, "experience_points", 0);
-    magic_item->true_description = json_object_alloc_string_value(json_object, "true_description", NULL);
+    pthread_once(&magic_item_keys_once, initialize_magic_item_keys);
+    uint32_t seen = 0;
+    struct cJSON *item;
+    cJSON_ArrayForEach(item, json_object) {
+        switch (json_key_index_find_first(&magic_item_keys, item->string, &seen)) {
+            case magic_item_key_experience_points:
+                magic_item->experience_points = json_item_get_int_value(item, 0);
+                break;
+            case magic_item_key_true_description:
+                magic_item->true_description = json_item_alloc_string_value(item, NULL);
+                break;
+            case magic_item_key_true_details:
+                if (cJSON_IsArray(item) && cJSON_GetArraySize(item)) {
+                    int count = cJSON_GetArraySize(item);
+                    magic_item->true_details = calloc_or_die(count + 1, sizeof(char *));
+                    int i = 0;
+                    struct cJSON *detail;
+                    cJSON_ArrayForEach(detail, item) {
+                        char *true_detail = json_item_alloc_string_value(detail, NULL);
+                        if (true_detail) magic_item->true_details[i++] = true_detail;
+                    }
+                }
+                break;
+            case magic_item_key_true_value_in_cp:
+                magic_item->true_value_in_cp = json_item_get_int_value(item, 0);
+                break;
+            case magic_item_key_type:
+                magic_item->type = json_item_get_string_enum_value(item, magic_item_type_for_name, magic_item_type_unknown);
+                break;
+            default:
+                break;
+        }
+    }
+}
 
-    struct cJSON *true_details = cJSON_GetObjectItem(json_object, "true_details");
-    if (cJSON_IsArray(true_details)) {
-        int count = cJSON_GetArraySize(true_details);
-        if (count) {
-            magic_item->true_details = calloc_or_die(count + 1, sizeof(char *));
-            for (int i = 0; i < count; ++i) {
-                magic_item->true_details[i] = json_array_alloc_string_value(true_details, i, NULL);
-            }
+
+void
+magic_item_initialize_from_json_reader(struct magic_item *magic_item,
+                                       struct json_reader *reader)
+{
+    magic_item_initialize(magic_item);
+
+    if (json_token_begin_object != reader->token) {
+        json_reader_skip_value(reader);
+        return;
+    }
+
+    pthread_once(&magic_item_keys_once, initialize_magic_item_keys);
+    bool is_magic_item = false;
+    uint32_t seen = 0;
+    while (json_reader_next_member(reader)) {
+        switch (json_key_index_find_first(&magic_item_keys, reader->key, &seen)) {
+            case magic_item_key_struct:
+                is_magic_item = str_eq("magic_item", json_reader_get_string_value(reader, ""));
+                break;
+            case magic_item_key_experience_points:
+                magic_item->experience_points = json_reader_get_int_value(reader, 0);
+                break;
+            case magic_item_key_true_description:
+                magic_item->true_description = json_reader_alloc_string_value(reader, NULL);
+                break;
+            case magic_item_key_true_details:
+                if (json_token_begin_array == reader->token) {
+                    int count = 0;
+                    int capacity = 0;
+                    while (json_reader_next_element(reader)) {
+                        char *true_detail = json_reader_alloc_string_value(reader, NULL);
+                        if ( ! true_detail) continue;
+                        if (count + 1 >= capacity) {
+                            capacity = capacity ? capacity * 2 : 4;
+                            magic_item->true_details = reallocarray_or_die(magic_item->true_details,
+                                                                           capacity,
+                                                                           sizeof(char *));
+                        }
+                        magic_item->true_details[count++] = true_detail;
+                        magic_item->true_details[count] = NULL;
+                    }
+                } else {
+                    json_reader_skip_value(reader);
+                }
+                break;
+            case magic_item_key_true_value_in_cp:
+                magic_item->true_value_in_cp = json_reader_get_int_value(reader, 0);
+                break;
+            case magic_item_key_type:
+                magic_item->type = json_reader_get_string_enum_value(reader, magic_item_type_for_name, magic_item_type_unknown);
+                break;
+            default:
+                json_reader_skip_value(reader);
+                break;
         }
     }
 
-    magic_item->true_value_in_cp = json_object_get_int_value(json_object, "true_value_in_cp", 0);
-    magic_item->type = json_object_get_string_enum_value(json_object, "type", magic_item_type_for_name, magic_item_type_unknown);
+    if ( ! is_magic_item) {
+        magic_item_finalize(magic_item);
+        magic_item_initialize(magic_item);
+    }
 }
 
 
@@ -2468,3 +2619,49 @@ magic_item_type_name(struct magic_item *magic_item)
     int index = magic_item->type - magic_item_type_unknown;
     return magic_item_type_names[index];
 }
+
+
+void
+magic_item_write_binary(struct magic_item *magic_item,
+                        struct binary_writer *writer)
+{
+    binary_writer_int(writer, magic_item->experience_points);
+    binary_writer_string_ref(writer, magic_item->true_description);
+
+    int true_details_count = 0;
+    if (magic_item->true_details) {
+        while (magic_item->true_details[true_details_count]) ++true_details_count;
+    }
+    binary_writer_uint(writer, (unsigned)true_details_count);
+    for (int i = 0; i < true_details_count; ++i) {
+        binary_writer_string_ref(writer, magic_item->true_details[i]);
+    }
+
+    binary_writer_int(writer, magic_item->true_value_in_cp);
+    binary_writer_uint(writer, (unsigned)(magic_item->type - magic_item_type_unknown));
+}
+
+
+void
+magic_item_write_json(struct magic_item *magic_item,
+                      struct json_writer *writer)
+{
+    json_writer_begin_object(writer);
+    json_writer_member_string(writer, "struct", "magic_item");
+    json_writer_member_int(writer, "rev", 0);
+    json_writer_member_int(writer, "experience_points", magic_item->experience_points);
+    json_writer_member_string(writer, "true_description", magic_item->true_description);
+
+    json_writer_key(writer, "true_details");
+    json_writer_begin_array(writer);
+    if (magic_item->true_details) {
+        for (int i = 0; magic_item->true_details[i]; ++i) {
+            json_writer_string(writer, magic_item->true_details[i]);
+        }
+    }
+    json_writer_end_array(writer);
+
+    json_writer_member_int(writer, "true_value_in_cp", magic_item->true_value_in_cp);
+    json_writer_member_string(writer, "type", magic_item_type_name(magic_item));
+    json_writer_end_object(writer);
+}
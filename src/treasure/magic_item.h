@@ -36,7 +36,11 @@ typedef uint32_t class_restrictions_t;
 typedef uint32_t possible_magic_items_t;
 
 
+struct binary_reader;
+struct binary_writer;
 struct cJSON;
+struct json_reader;
+struct json_writer;
 struct rnd;
 
 
@@ -76,9 +80,25 @@ magic_item_generate(struct magic_item *magic_item,
 void
 magic_item_initialize(struct magic_item *magic_item);
 
+void
+magic_item_initialize_from_binary_reader(struct magic_item *magic_item,
+                                         struct binary_reader *reader);
+
 void
 magic_item_initialize_from_json_object(struct magic_item *magic_item,
                                        struct cJSON *json_object);
 
+void
+magic_item_initialize_from_json_reader(struct magic_item *magic_item,
+                                       struct json_reader *reader);
+
+void
+magic_item_write_binary(struct magic_item *magic_item,
+                        struct binary_writer *writer);
+
+void
+magic_item_write_json(struct magic_item *magic_item,
+                      struct json_writer *writer);
+
 
 #endif
@@ -190,6 +190,38 @@ magic_item_initialize_from_json_object_for_complete_object_with_true_details_tes
 }
 
 
+static void
+magic_item_initialize_from_json_reader_with_true_details_test(void)
+{
+    char const *json_string = "{\n"
+                              "  \"true_details\": [\n"
+                              "    \"intelligence 12 (semi-empathy)\",\n"
+                              "    null,\n"
+                              "    \"neutral good alignment\"\n"
+                              "  ],\n"
+                              "  \"type\": \"sword\",\n"
+                              "  \"unknown\": {\"struct\": \"magic_item\"},\n"
+                              "  \"struct\": \"magic_item\"\n"
+                              "}";
+    struct json_reader *reader = json_reader_alloc(json_string, strlen(json_string));
+    json_reader_next(reader);
+    struct magic_item magic_item;
+    magic_item_initialize_from_json_reader(&magic_item, reader);
+    assert(json_reader_finish(reader));
+    json_reader_free(reader);
+
+    assert(0 == magic_item.experience_points);
+    assert(NULL == magic_item.true_description);
+    assert(magic_item.true_details);
+    assert(str_eq("intelligence 12 (semi-empathy)", magic_item.true_details[0]));
+    assert(str_eq("neutral good alignment", magic_item.true_details[1]));
+    assert(NULL == magic_item.true_details[2]);
+    assert(magic_item_type_sword == magic_item.type);
+
+    magic_item_finalize(&magic_item);
+}
+
+
 static void
 magic_item_generate_for_any_with_fake_min_test(void)
 {
@@ -332,6 +364,7 @@ magic_item_test(void)
     magic_item_initialize_from_json_object_for_empty_array_test();
     magic_item_initialize_from_json_object_for_complete_object_test();
     magic_item_initialize_from_json_object_for_complete_object_with_true_details_test();
+    magic_item_initialize_from_json_reader_with_true_details_test();
 
     magic_item_generate_for_any_with_fake_min_test();
     magic_item_generate_for_any_with_fake_max_test();
@@ -1,5 +1,7 @@
 #include "treasure.h"
 
+#include <assert.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -14,6 +16,121 @@
 #include "treasure_type.h"
 
 
+enum treasure_key {
+    treasure_key_struct,
+    treasure_key_type,
+    treasure_key_coins,
+    treasure_key_gems,
+    treasure_key_jewelry,
+    treasure_key_maps,
+    treasure_key_magic_items,
+};
+
+static char const *const treasure_key_names[] = {
+    "struct",
+    "type",
+    "coins",
+    "gems",
+    "jewelry",
+    "maps",
+    "magic_items",
+};
+
+static struct json_key_index treasure_keys;
+static pthread_once_t treasure_keys_once = PTHREAD_ONCE_INIT;
+
+static int const initial_items_capacity = 8;
+
+static uint8_t const treasure_binary_magic[] = { 'F', 'N', 'F', 'T' };
+static unsigned const treasure_binary_version = 1;
+
+
+static void
+initialize_treasure_keys(void);
+
+static void
+finalize_items(struct treasure *treasure);
+
+static void *
+reserve_items(void *items, int count, int *capacity, size_t item_size);
+
+static struct treasure_type *
+treasure_type_for_json_value(char const *type);
+
+
+static void
+initialize_treasure_keys(void)
+{
+    json_key_index_initialize(&treasure_keys,
+                              treasure_key_names,
+                              ARRAY_COUNT(treasure_key_names));
+}
+
+
+static void
+finalize_items(struct treasure *treasure)
+{
+    for (int i = 0; i < treasure->gems_count; ++i) {
+        gem_finalize(&treasure->gems[i]);
+    }
+    for (int i = 0; i < treasure->jewelry_count; ++i) {
+        jewelry_finalize(&treasure->jewelry[i]);
+    }
+    for (int i = 0; i < treasure->maps_count; ++i) {
+        treasure_map_finalize(&treasure->maps[i]);
+    }
+    for (int i = 0; i < treasure->magic_items_count; ++i) {
+        magic_item_finalize(&treasure->magic_items[i]);
+    }
+}
+
+
+// Makes room for `count' items in all.
+static void *
+reserve_items(void *items, int count, int *capacity, size_t item_size)
+{
+    if (count <= *capacity) return items;
+    *capacity = max(count, *capacity ? *capacity * 2 : initial_items_capacity);
+    return reallocarray_or_die(items, *capacity, item_size);
+}
+
+
+static struct treasure_type *
+treasure_type_for_json_value(char const *type)
+{
+    if (type && type[0] >= 'A' && type[0] <= 'Z') {
+        return treasure_type_by_letter(type[0]);
+    }
+    return NULL;
+}
+
+
+struct gem *
+treasure_add_gems(struct treasure *treasure, int count)
+{
+    treasure->gems = reserve_items(treasure->gems,
+                                   treasure->gems_count + count,
+                                   &treasure->gems_capacity,
+                                   sizeof(struct gem));
+    struct gem *gems = &treasure->gems[treasure->gems_count];
+    treasure->gems_count += count;
+    return gems;
+}
+
+
+struct jewelry *
+treasure_add_jewelry(struct treasure *treasure, int count)
+{
+    treasure->jewelry = reserve_items(treasure->jewelry,
+                                      treasure->jewelry_count + count,
+                                      &treasure->jewelry_capacity,
+                                      sizeof(struct jewelry));
+    struct jewelry *jewelry = &treasure->jewelry[treasure->jewelry_count];
+    treasure->jewelry_count += count;
+    return jewelry;
+}
+
+
 char *
 treasure_alloc_description(struct treasure *treasure)
 {
@@ -191,27 +308,26 @@ treasure_create_json_object(struct treasure *treasure)
 }
 
 
+void
+treasure_clear(struct treasure *treasure)
+{
+    finalize_items(treasure);
+    treasure->type = NULL;
+    treasure->coins = coins_make(0, 0, 0, 0, 0);
+    treasure->gems_count = 0;
+    treasure->jewelry_count = 0;
+    treasure->maps_count = 0;
+    treasure->magic_items_count = 0;
+}
+
+
 void
 treasure_finalize(struct treasure *treasure)
 {
-    for (int i = 0; i < treasure->gems_count; ++i) {
-        gem_finalize(&treasure->gems[i]);
-    }
+    finalize_items(treasure);
     free_or_die(treasure->gems);
-
-    for (int i = 0; i < treasure->jewelry_count; ++i) {
-        jewelry_finalize(&treasure->jewelry[i]);
-    }
     free_or_die(treasure->jewelry);
-
-    for (int i = 0; i < treasure->maps_count; ++i) {
-        treasure_map_finalize(&treasure->maps[i]);
-    }
     free_or_die(treasure->maps);
-
-    for (int i = 0; i < treasure->magic_items_count; ++i) {
-        magic_item_finalize(&treasure->magic_items[i]);
-    }
     free_or_die(treasure->magic_items);
 }
 
@@ -222,9 +338,10 @@ treasure_generate_magic_items(struct treasure *treasure,
                               int count,
                               possible_magic_items_t possible_magic_items)
 {
-    treasure->magic_items = reallocarray_or_die(treasure->magic_items,
-                                                treasure->magic_items_count + count,
-                                                sizeof(struct magic_item));
+    treasure->magic_items = reserve_items(treasure->magic_items,
+                                          treasure->magic_items_count + count,
+                                          &treasure->magic_items_capacity,
+                                          sizeof(struct magic_item));
     for (int i = 0; i < count; ++i) {
         int j = treasure->magic_items_count + i;
         magic_item_initialize(&treasure->magic_items[j]);
@@ -237,9 +354,10 @@ treasure_generate_magic_items(struct treasure *treasure,
 void
 treasure_generate_maps(struct treasure *treasure, struct rnd *rnd, int count)
 {
-    treasure->maps = reallocarray_or_die(treasure->maps,
-                                         treasure->maps_count + count,
-                                         sizeof(struct treasure_map));
+    treasure->maps = reserve_items(treasure->maps,
+                                   treasure->maps_count + count,
+                                   &treasure->maps_capacity,
+                                   sizeof(struct treasure_map));
     for (int i = 0; i < count; ++i) {
         int j = treasure->maps_count + i;
         treasure_map_initialize(&treasure->maps[j]);
@@ -256,74 +374,243 @@ treasure_initialize(struct treasure *treasure)
 }
 
 
+bool
+treasure_initialize_from_binary_record(struct treasure *treasure,
+                                       uint8_t const *bytes,
+                                       size_t length)
+{
+    treasure_initialize(treasure);
+
+    size_t magic_size = sizeof treasure_binary_magic;
+    if (length < magic_size) return false;
+    if (memcmp(bytes, treasure_binary_magic, magic_size)) return false;
+
+    struct binary_reader reader;
+    binary_reader_initialize(&reader, bytes, length);
+    reader.offset = magic_size;
+    unsigned version = binary_reader_uint(&reader);
+    uint32_t string_table_offset = binary_reader_fixed32(&reader);
+    bool is_valid = treasure_binary_version == version
+                 && binary_reader_read_string_table(&reader, string_table_offset);
+    if (is_valid) {
+        treasure_initialize_from_binary_reader(treasure, &reader);
+        is_valid = ! reader.has_error && string_table_offset == reader.offset;
+    }
+    binary_reader_finalize(&reader);
+
+    if ( ! is_valid) {
+        treasure_finalize(treasure);
+        treasure_initialize(treasure);
+    }
+    return is_valid;
+}
+
+
 void
-treasure_initialize_from_json_object(struct treasure *treasure,
-                                     struct cJSON *json_object)
+treasure_initialize_from_binary_reader(struct treasure *treasure,
+                                       struct binary_reader *reader)
 {
     treasure_initialize(treasure);
+    if ( ! binary_reader_begin_nested(reader)) return;
 
-    if ( ! cJSON_IsObject(json_object)) return;
-    if ( ! json_object_has_struct_member(json_object, "treasure")) return;
+    unsigned type = binary_reader_uint(reader);
+    if (type >= 1 && type <= 26) treasure->type = treasure_type_by_letter('A' + type - 1);
 
-    char const *type = json_object_get_string_value(json_object, "type", NULL);
-    if (type && type[0] >= 'A' && type[0] <= 'Z') {
-        treasure->type = treasure_type_by_letter(type[0]);
+    treasure->coins = coins_make_from_binary_reader(reader);
+
+    treasure->gems_count = binary_reader_count(reader);
+    if (treasure->gems_count) {
+        treasure->gems = calloc_or_die(treasure->gems_count, sizeof(struct gem));
+        treasure->gems_capacity = treasure->gems_count;
+        for (int i = 0; i < treasure->gems_count; ++i) {
+            gem_initialize_from_binary_reader(&treasure->gems[i], reader);
+        }
     }
 
-    struct cJSON *coins = cJSON_GetObjectItemCaseSensitive(json_object, "coins");
-    treasure->coins = coins_make_from_json_object(coins);
+    treasure->jewelry_count = binary_reader_count(reader);
+    if (treasure->jewelry_count) {
+        treasure->jewelry = calloc_or_die(treasure->jewelry_count, sizeof(struct jewelry));
+        treasure->jewelry_capacity = treasure->jewelry_count;
+        for (int i = 0; i < treasure->jewelry_count; ++i) {
+            jewelry_initialize_from_binary_reader(&treasure->jewelry[i], reader);
+        }
+    }
 
-    struct cJSON *gems = cJSON_GetObjectItemCaseSensitive(json_object, "gems");
-    if (cJSON_IsArray(gems)) {
-        treasure->gems_count = cJSON_GetArraySize(gems);
-        if (treasure->gems_count) {
-            treasure->gems = calloc_or_die(treasure->gems_count,
-                                           sizeof(struct gem));
-            for (int i = 0; i < treasure->gems_count; ++i) {
-                struct cJSON *gem = cJSON_GetArrayItem(gems, i);
-                gem_initialize_from_json_object(&treasure->gems[i], gem);
-            }
+    treasure->maps_count = binary_reader_count(reader);
+    if (treasure->maps_count) {
+        treasure->maps = calloc_or_die(treasure->maps_count, sizeof(struct treasure_map));
+        treasure->maps_capacity = treasure->maps_count;
+        for (int i = 0; i < treasure->maps_count; ++i) {
+            treasure_map_initialize_from_binary_reader(&treasure->maps[i], reader);
         }
     }
 
-    struct cJSON *jewelry = cJSON_GetObjectItemCaseSensitive(json_object, "jewelry");
-    if (cJSON_IsArray(jewelry)) {
-        treasure->jewelry_count = cJSON_GetArraySize(jewelry);
-        if (treasure->jewelry_count) {
-            treasure->jewelry = calloc_or_die(treasure->jewelry_count,
-                                              sizeof(struct jewelry));
-            for (int i = 0; i < treasure->jewelry_count; ++i) {
-                struct cJSON *jewelry_item = cJSON_GetArrayItem(jewelry, i);
-                jewelry_initialize_from_json_object(&treasure->jewelry[i], jewelry_item);
-            }
+    treasure->magic_items_count = binary_reader_count(reader);
+    if (treasure->magic_items_count) {
+        treasure->magic_items = calloc_or_die(treasure->magic_items_count, sizeof(struct magic_item));
+        treasure->magic_items_capacity = treasure->magic_items_count;
+        for (int i = 0; i < treasure->magic_items_count; ++i) {
+            magic_item_initialize_from_binary_reader(&treasure->magic_items[i], reader);
         }
     }
 
-    struct cJSON *maps = cJSON_GetObjectItemCaseSensitive(json_object, "maps");
-    if (cJSON_IsArray(maps)) {
-        treasure->maps_count = cJSON_GetArraySize(maps);
-        if (treasure->maps_count) {
-            treasure->maps = calloc_or_die(treasure->maps_count,
-                                           sizeof(struct treasure_map));
-            for (int i = 0; i < treasure->maps_count; ++i) {
-                struct cJSON *map = cJSON_GetArrayItem(maps, i);
-                treasure_map_initialize_from_json_object(&treasure->maps[i], map);
-            }
+    binary_reader_end_nested(reader);
+}
+
+
+bool
+treasure_initialize_from_json_bytes(struct treasure *treasure,
+                                    char const *bytes,
+                                    size_t length)
+{
+    struct json_reader *reader = json_reader_alloc(bytes, length);
+    json_reader_next(reader);
+    treasure_initialize_from_json_reader(treasure, reader);
+    bool is_valid = json_reader_finish(reader);
+    json_reader_free(reader);
+    if ( ! is_valid) {
+        treasure_finalize(treasure);
+        treasure_initialize(treasure);
+    }
+    return is_valid;
+}
+
+
+void
+treasure_initialize_from_json_object(struct treasure *treasure,
+                                     struct cJSON *json_object)
+{
+    treasure_initialize(treasure);
+
+    if ( ! cJSON_IsObject(json_object)) return;
+    if ( ! json_object_has_struct_member(json_object, "treasure")) return;
+
+    pthread_once(&treasure_keys_once, initialize_treasure_keys);
+    uint32_t seen = 0;
+    struct cJSON *item;
+    struct cJSON *element;
+    int i;
+    cJSON_ArrayForEach(item, json_object) {
+        switch (json_key_index_find_first(&treasure_keys, item->string, &seen)) {
+            case treasure_key_type:
+                treasure->type = treasure_type_for_json_value(json_item_get_string_value(item, NULL));
+                break;
+            case treasure_key_coins:
+                treasure->coins = coins_make_from_json_object(item);
+                break;
+            case treasure_key_gems:
+                if ( ! cJSON_IsArray(item)) break;
+                treasure->gems_count = cJSON_GetArraySize(item);
+                if ( ! treasure->gems_count) break;
+                treasure->gems = calloc_or_die(treasure->gems_count, sizeof(struct gem));
+                treasure->gems_capacity = treasure->gems_count;
+                i = 0;
+                cJSON_ArrayForEach(element, item) {
+                    gem_initialize_from_json_object(&treasure->gems[i++], element);
+                }
+                break;
+            case treasure_key_jewelry:
+                if ( ! cJSON_IsArray(item)) break;
+                treasure->jewelry_count = cJSON_GetArraySize(item);
+                if ( ! treasure->jewelry_count) break;
+                treasure->jewelry = calloc_or_die(treasure->jewelry_count, sizeof(struct jewelry));
+                treasure->jewelry_capacity = treasure->jewelry_count;
+                i = 0;
+                cJSON_ArrayForEach(element, item) {
+                    jewelry_initialize_from_json_object(&treasure->jewelry[i++], element);
+                }
+                break;
+            case treasure_key_maps:
+                if ( ! cJSON_IsArray(item)) break;
+                treasure->maps_count = cJSON_GetArraySize(item);
+                if ( ! treasure->maps_count) break;
+                treasure->maps = calloc_or_die(treasure->maps_count, sizeof(struct treasure_map));
+                treasure->maps_capacity = treasure->maps_count;
+                i = 0;
+                cJSON_ArrayForEach(element, item) {
+                    treasure_map_initialize_from_json_object(&treasure->maps[i++], element);
+                }
+                break;
+            case treasure_key_magic_items:
+                if ( ! cJSON_IsArray(item)) break;
+                treasure->magic_items_count = cJSON_GetArraySize(item);
+                if ( ! treasure->magic_items_count) break;
+                treasure->magic_items = calloc_or_die(treasure->magic_items_count, sizeof(struct magic_item));
+                treasure->magic_items_capacity = treasure->magic_items_count;
+                i = 0;
+                cJSON_ArrayForEach(element, item) {
+                    magic_item_initialize_from_json_object(&treasure->magic_items[i++], element);
+                }
+                break;
+            default:
+                break;
         }
     }
+}
 
-    struct cJSON *magic_items = cJSON_GetObjectItemCaseSensitive(json_object, "magic_items");
-    if (cJSON_IsArray(magic_items)) {
-        treasure->magic_items_count = cJSON_GetArraySize(magic_items);
-        if (treasure->magic_items_count) {
-            treasure->magic_items = calloc_or_die(treasure->magic_items_count,
-                                                  sizeof(struct magic_item));
-            for (int i = 0; i < treasure->magic_items_count; ++i) {
-                struct cJSON *magic_item = cJSON_GetArrayItem(magic_items, i);
-                magic_item_initialize_from_json_object(&treasure->magic_items[i], magic_item);
-            }
+
+void
+treasure_initialize_from_json_reader(struct treasure *treasure,
+                                     struct json_reader *reader)
+{
+    treasure_initialize(treasure);
+
+    if (json_token_begin_object != reader->token) {
+        json_reader_skip_value(reader);
+        return;
+    }
+
+    pthread_once(&treasure_keys_once, initialize_treasure_keys);
+    bool is_treasure = false;
+    uint32_t seen = 0;
+    while (json_reader_next_member(reader)) {
+        int key = json_key_index_find_first(&treasure_keys, reader->key, &seen);
+        // the members after coins are all arrays
+        if (key > treasure_key_coins && json_token_begin_array != reader->token) {
+            key = -1;
+        }
+        switch (key) {
+            case treasure_key_struct:
+                is_treasure = str_eq("treasure", json_reader_get_string_value(reader, ""));
+                break;
+            case treasure_key_type:
+                treasure->type = treasure_type_for_json_value(json_reader_get_string_value(reader, NULL));
+                break;
+            case treasure_key_coins:
+                treasure->coins = coins_make_from_json_reader(reader);
+                break;
+            case treasure_key_gems:
+                while (json_reader_next_element(reader)) {
+                    gem_initialize_from_json_reader(treasure_add_gems(treasure, 1), reader);
+                }
+                break;
+            case treasure_key_jewelry:
+                while (json_reader_next_element(reader)) {
+                    jewelry_initialize_from_json_reader(treasure_add_jewelry(treasure, 1), reader);
+                }
+                break;
+            case treasure_key_maps:
+                while (json_reader_next_element(reader)) {
+                    treasure->maps = reserve_items(treasure->maps, treasure->maps_count + 1, &treasure->maps_capacity, sizeof(struct treasure_map));
+                    treasure_map_initialize_from_json_reader(&treasure->maps[treasure->maps_count++], reader);
+                }
+                break;
+            case treasure_key_magic_items:
+                while (json_reader_next_element(reader)) {
+                    treasure->magic_items = reserve_items(treasure->magic_items, treasure->magic_items_count + 1, &treasure->magic_items_capacity, sizeof(struct magic_item));
+                    magic_item_initialize_from_json_reader(&treasure->magic_items[treasure->magic_items_count++], reader);
+                }
+                break;
+            default:
+                json_reader_skip_value(reader);
+                break;
         }
     }
+
+    if ( ! is_treasure) {
+        treasure_finalize(treasure);
+        treasure_initialize(treasure);
+    }
 }
 
 
@@ -342,3 +629,103 @@ treasure_value_in_cp(struct treasure *treasure)
 
     return value_in_cp;
 }
+
+
+void
+treasure_write_binary(struct treasure *treasure, struct binary_writer *writer)
+{
+    unsigned type = treasure->type ? treasure_type_letter(treasure->type) - 'A' + 1 : 0;
+    binary_writer_uint(writer, type);
+
+    coins_write_binary(&treasure->coins, writer);
+
+    binary_writer_uint(writer, (unsigned)treasure->gems_count);
+    for (int i = 0; i < treasure->gems_count; ++i) {
+        gem_write_binary(&treasure->gems[i], writer);
+    }
+
+    binary_writer_uint(writer, (unsigned)treasure->jewelry_count);
+    for (int i = 0; i < treasure->jewelry_count; ++i) {
+        jewelry_write_binary(&treasure->jewelry[i], writer);
+    }
+
+    binary_writer_uint(writer, (unsigned)treasure->maps_count);
+    for (int i = 0; i < treasure->maps_count; ++i) {
+        treasure_map_write_binary(&treasure->maps[i], writer);
+    }
+
+    binary_writer_uint(writer, (unsigned)treasure->magic_items_count);
+    for (int i = 0; i < treasure->magic_items_count; ++i) {
+        magic_item_write_binary(&treasure->magic_items[i], writer);
+    }
+}
+
+
+void
+treasure_write_binary_record(struct treasure *treasure,
+                             struct binary_writer *writer)
+{
+    size_t start = writer->length;
+    binary_writer_bytes(writer, treasure_binary_magic, sizeof treasure_binary_magic);
+    binary_writer_uint(writer, treasure_binary_version);
+    size_t string_table_offset_position = writer->length;
+    binary_writer_fixed32(writer, 0);
+
+    treasure_write_binary(treasure, writer);
+
+    size_t string_table_offset = writer->length - start;
+    assert(string_table_offset <= UINT32_MAX);
+    binary_writer_set_fixed32(writer,
+                              string_table_offset_position,
+                              (uint32_t)string_table_offset);
+    binary_writer_string_table(writer);
+}
+
+
+void
+treasure_write_json(struct treasure *treasure, struct json_writer *writer)
+{
+    json_writer_begin_object(writer);
+    json_writer_member_string(writer, "struct", "treasure");
+    json_writer_member_int(writer, "rev", 0);
+
+    if (treasure->type) {
+        char type[] = { treasure_type_letter(treasure->type), '\0' };
+        json_writer_member_string(writer, "type", type);
+    } else {
+        json_writer_member_null(writer, "type");
+    }
+
+    json_writer_key(writer, "coins");
+    coins_write_json(&treasure->coins, writer);
+
+    json_writer_key(writer, "gems");
+    json_writer_begin_array(writer);
+    for (int i = 0; i < treasure->gems_count; ++i) {
+        gem_write_json(&treasure->gems[i], writer);
+    }
+    json_writer_end_array(writer);
+
+    json_writer_key(writer, "jewelry");
+    json_writer_begin_array(writer);
+    for (int i = 0; i < treasure->jewelry_count; ++i) {
+        jewelry_write_json(&treasure->jewelry[i], writer);
+    }
+    json_writer_end_array(writer);
+
+    json_writer_key(writer, "maps");
+    json_writer_begin_array(writer);
+    for (int i = 0; i < treasure->maps_count; ++i) {
+        treasure_map_write_json(&treasure->maps[i], writer);
+    }
+    json_writer_end_array(writer);
+
+    json_writer_key(writer, "magic_items");
+    json_writer_begin_array(writer);
+    for (int i = 0; i < treasure->magic_items_count; ++i) {
+        magic_item_write_json(&treasure->magic_items[i], writer);
+    }
+    json_writer_end_array(writer);
+
+    json_writer_end_object(writer);
+}
@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <background/background.h>
+#include <base/base.h>
+#include <json/json.h>
+#include <treasure/treasure.h>
+
+
+static void
+encode(int treasures_count, FILE *out)
+{
+    unsigned short seed[3] = { 0x1234, 0x5678, 0x9abc };
+    struct rnd *rnd = rnd_alloc_jrand48(seed);
+    int count = treasures_count * 26;
+    struct treasure *treasures = calloc_or_die(count, sizeof(struct treasure));
+    for (int i = 0; i < count; ++i) {
+        treasure_type_generate(treasure_type_by_letter('A' + i % 26), rnd, &treasures[i]);
+    }
+    size_t *json_offsets = calloc_or_die(count + 1, sizeof(size_t));
+    size_t *binary_offsets = calloc_or_die(count + 1, sizeof(size_t));
+
+    struct json_writer *json_writer = json_writer_alloc(false);
+    clock_t start = clock();
+    for (int i = 0; i < count; ++i) {
+        treasure_write_json(&treasures[i], json_writer);
+        json_offsets[i + 1] = json_writer->length;
+    }
+    double json_write_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    struct binary_writer *binary_writer = binary_writer_alloc();
+    start = clock();
+    for (int i = 0; i < count; ++i) {
+        treasure_write_binary_record(&treasures[i], binary_writer);
+        binary_offsets[i + 1] = binary_writer->length;
+    }
+    double binary_write_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int i = 0; i < count; ++i) {
+        struct treasure treasure;
+        treasure_initialize_from_json_bytes(&treasure,
+                                            json_writer->buffer + json_offsets[i],
+                                            json_offsets[i + 1] - json_offsets[i]);
+        treasure_finalize(&treasure);
+    }
+    double json_read_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int i = 0; i < count; ++i) {
+        struct treasure treasure;
+        treasure_initialize_from_binary_record(&treasure,
+                                               binary_writer->bytes + binary_offsets[i],
+                                               binary_offsets[i + 1] - binary_offsets[i]);
+        treasure_finalize(&treasure);
+    }
+    double binary_read_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    fprintf(out, "Treasure encoding (%i treasures)\n", count);
+    fprintf(out, "  format     bytes/treasure  write seconds  read seconds\n");
+    fprintf(out, "  JSON     %16.1f  %13.3f  %12.3f\n",
+            (double)json_writer->length / count,
+            json_write_seconds, json_read_seconds);
+    fprintf(out, "  binary   %16.1f  %13.3f  %12.3f\n",
+            (double)binary_writer->length / count,
+            binary_write_seconds, binary_read_seconds);
+
+    binary_writer_free(binary_writer);
+    json_writer_free(json_writer);
+    free_or_die(binary_offsets);
+    free_or_die(json_offsets);
+    for (int i = 0; i < count; ++i) treasure_finalize(&treasures[i]);
+    free_or_die(treasures);
+    rnd_free(rnd);
+}
+
+
+static void
+generate(char letter, int treasures_count, FILE *out)
+{
+    unsigned short seed[3] = { 0x1234, 0x5678, 0x9abc };
+    struct rnd *rnd = rnd_alloc_jrand48(seed);
+    struct treasure_type *treasure_type = treasure_type_by_letter(letter);
+
+    struct alloc_or_die_counts start_counts = alloc_or_die_counts();
+    long value_in_cp = 0;
+    clock_t start = clock();
+    for (int i = 0; i < treasures_count; ++i) {
+        struct treasure treasure;
+        treasure_initialize(&treasure);
+        treasure_type_generate(treasure_type, rnd, &treasure);
+        value_in_cp += treasure_value_in_cp(&treasure);
+        treasure_finalize(&treasure);
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    long alloc_count = alloc_or_die_counts().total_count - start_counts.total_count;
+
+    fprintf(out, "     %c  %9.3f  %12.2f  %16.1f  %16.0f\n",
+            letter, seconds,
+            seconds * 1e6 / treasures_count,
+            (double)alloc_count / treasures_count,
+            (double)value_in_cp / gp_to_cp(1) / treasures_count);
+
+    rnd_free(rnd);
+}
+
+
+static void
+load_json(int treasures_count, FILE *out)
+{
+    unsigned short seed[3] = { 0x1234, 0x5678, 0x9abc };
+    struct rnd *rnd = rnd_alloc_jrand48(seed);
+    int count = treasures_count * 26;
+    char **json_strings = calloc_or_die(count, sizeof(char *));
+    size_t bytes_count = 0;
+    struct json_writer *writer = json_writer_alloc(false);
+    for (int i = 0; i < count; ++i) {
+        struct treasure treasure;
+        treasure_initialize(&treasure);
+        treasure_type_generate(treasure_type_by_letter('A' + i % 26), rnd, &treasure);
+        json_writer_clear(writer);
+        treasure_write_json(&treasure, writer);
+        json_strings[i] = strdup_or_die(writer->buffer);
+        bytes_count += writer->length;
+        treasure_finalize(&treasure);
+    }
+    json_writer_free(writer);
+
+    clock_t start = clock();
+    for (int i = 0; i < count; ++i) {
+        struct treasure treasure;
+        struct cJSON *json_object = cJSON_Parse(json_strings[i]);
+        treasure_initialize_from_json_object(&treasure, json_object);
+        cJSON_Delete(json_object);
+        treasure_finalize(&treasure);
+    }
+    double cjson_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int i = 0; i < count; ++i) {
+        struct treasure treasure;
+        treasure_initialize_from_json_bytes(&treasure, json_strings[i], strlen(json_strings[i]));
+        treasure_finalize(&treasure);
+    }
+    double reader_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    double megabytes = bytes_count / 1e6;
+    fprintf(out, "Treasure JSON loading (%i treasures, %.2f MB)\n", count, megabytes);
+    fprintf(out, "  loader    seconds    MB/second\n");
+    fprintf(out, "  cJSON   %9.3f  %11.1f\n", cjson_seconds, megabytes / cjson_seconds);
+    fprintf(out, "  reader  %9.3f  %11.1f\n", reader_seconds, megabytes / reader_seconds);
+
+    for (int i = 0; i < count; ++i) free_or_die(json_strings[i]);
+    free_or_die(json_strings);
+    rnd_free(rnd);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    int treasures_count = 1000;
+    if (argc > 1) treasures_count = max(1, atoi(argv[1]));
+
+    FILE *out = stdout;
+    fprintf(out, "Treasure generation (%i per type)\n", treasures_count);
+    fprintf(out, "  type    seconds  us/treasure  allocs/treasure  mean value (gp)\n");
+    clock_t start = clock();
+    for (char letter = 'A'; letter <= 'Z'; ++letter) {
+        generate(letter, treasures_count, out);
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    fprintf(out, "  total %9.3f\n", seconds);
+
+    fprintf(out, "\n");
+    load_json(treasures_count, out);
+
+    fprintf(out, "\n");
+    encode(treasures_count, out);
+
+    alloc_count_is_zero_or_die();
+    return EXIT_SUCCESS;
+}
@@ -1,5 +1,6 @@
 #include "treasure_map.h"
 
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 #include <background/background.h>
@@ -27,6 +28,24 @@ static char const *treasure_map_types[] = {
 };
 
 
+enum treasure_map_key {
+    treasure_map_key_struct,
+    treasure_map_key_is_false,
+    treasure_map_key_treasure,
+    treasure_map_key_true_description,
+};
+
+static char const *const treasure_map_key_names[] = {
+    "struct",
+    "is_false",
+    "treasure",
+    "true_description",
+};
+
+static struct json_key_index treasure_map_keys;
+static pthread_once_t treasure_map_keys_once = PTHREAD_ONCE_INIT;
+
+
 static void
 generate_combined_hoard(struct treasure *treasure, struct rnd *rnd);
 
@@ -88,6 +107,9 @@ static void
 generate_monetary_treasure_16_to_17_jewelry(struct treasure *treasure,
                                             struct rnd *rnd);
 
+static void
+initialize_treasure_map_keys(void);
+
 
 void
 treasure_map_finalize(struct treasure_map *treasure_map)
@@ -326,15 +348,11 @@ generate_monetary_treasure_13_to_15_gems(struct treasure *treasure,
                                          struct rnd *rnd)
 {
     int count = roll("1d10", rnd) * 10;
-    treasure->gems = reallocarray_or_die(treasure->gems,
-                                         treasure->gems_count + count,
-                                         sizeof(struct gem));
+    struct gem *gems = treasure_add_gems(treasure, count);
     for (int i = 0; i < count; ++i) {
-        int j = treasure->gems_count + i;
-        gem_initialize(&treasure->gems[j]);
-        gem_generate(&treasure->gems[j], rnd);
+        gem_initialize(&gems[i]);
+        gem_generate(&gems[i], rnd);
     }
-    treasure->gems_count += count;
 }
 
 
@@ -343,15 +361,11 @@ generate_monetary_treasure_16_to_17_jewelry(struct treasure *treasure,
                                             struct rnd *rnd)
 {
     int count = roll("5d10", rnd);
-    treasure->jewelry = reallocarray_or_die(treasure->jewelry,
-                                            treasure->jewelry_count + count,
-                                            sizeof(struct jewelry));
+    struct jewelry *jewelry = treasure_add_jewelry(treasure, count);
     for (int i = 0; i < count; ++i) {
-        int j = treasure->jewelry_count + i;
-        jewelry_initialize(&treasure->jewelry[j]);
-        jewelry_generate(&treasure->jewelry[j], rnd);
+        jewelry_initialize(&jewelry[i]);
+        jewelry_generate(&jewelry[i], rnd);
     }
-    treasure->jewelry_count += count;
 }
 
 
@@ -443,6 +457,15 @@ treasure_map_generate(struct treasure_map *treasure_map, struct rnd *rnd)
 }
 
 
+static void
+initialize_treasure_map_keys(void)
+{
+    json_key_index_initialize(&treasure_map_keys,
+                              treasure_map_key_names,
+                              ARRAY_COUNT(treasure_map_key_names));
+}
+
+
 void
 treasure_map_initialize(struct treasure_map *treasure_map)
 {
@@ -450,6 +473,19 @@ treasure_map_initialize(struct treasure_map *treasure_map)
 }
 
 
+void
+treasure_map_initialize_from_binary_reader(struct treasure_map *treasure_map,
+                                           struct binary_reader *reader)
+{
+    treasure_map_initialize(treasure_map);
+
+    treasure_map->is_false = binary_reader_bool(reader);
+    treasure_initialize_from_binary_reader(&treasure_map->treasure, reader);
+    char const *true_description = binary_reader_string_ref(reader);
+    if (true_description) treasure_map->true_description = strdup_or_die(true_description);
+}
+
+
 void
 treasure_map_initialize_from_json_object(struct treasure_map *treasure_map,
                                          struct cJSON *json_object)
@@ -459,10 +495,88 @@ treasure_map_initialize_from_json_object(struct treasure_map *treasure_map,
     if ( ! cJSON_IsObject(json_object)) return;
     if ( ! json_object_has_struct_member(json_object, "treasure_map")) return;
 
-    treasure_map->is_false = json_object_get_bool_value(json_object, "is_false", false);
+    pthread_once(&treasure_map_keys_once, initialize_treasure_map_keys);
+    uint32_t seen = 0;
+    struct cJSON *item;
+    cJSON_ArrayForEach(item, json_object) {
+        switch (json_key_index_find_first(&treasure_map_keys, item->string, &seen)) {
+            case treasure_map_key_is_false:
+                treasure_map->is_false = json_item_get_bool_value(item, false);
+                break;
+            case treasure_map_key_treasure:
+                treasure_initialize_from_json_object(&treasure_map->treasure, item);
+                break;
+            case treasure_map_key_true_description:
+                treasure_map->true_description = json_item_alloc_string_value(item, NULL);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+
+void
+treasure_map_initialize_from_json_reader(struct treasure_map *treasure_map,
+                                         struct json_reader *reader)
+{
+    treasure_map_initialize(treasure_map);
+
+    if (json_token_begin_object != reader->token) {
+        json_reader_skip_value(reader);
+        return;
+    }
+
+    pthread_once(&treasure_map_keys_once, initialize_treasure_map_keys);
+    bool is_treasure_map = false;
+    uint32_t seen = 0;
+    while (json_reader_next_member(reader)) {
+        switch (json_key_index_find_first(&treasure_map_keys, reader->key, &seen)) {
+            case treasure_map_key_struct:
+                is_treasure_map = str_eq("treasure_map", json_reader_get_string_value(reader, ""));
+                break;
+            case treasure_map_key_is_false:
+                treasure_map->is_false = json_reader_get_bool_value(reader, false);
+                break;
+            case treasure_map_key_treasure:
+                treasure_initialize_from_json_reader(&treasure_map->treasure, reader);
+                break;
+            case treasure_map_key_true_description:
+                treasure_map->true_description = json_reader_alloc_string_value(reader, NULL);
+                break;
+            default:
+                json_reader_skip_value(reader);
+                break;
+        }
+    }
+
+    if ( ! is_treasure_map) {
+        treasure_map_finalize(treasure_map);
+        treasure_map_initialize(treasure_map);
+    }
+}
 
-    struct cJSON *treasure = cJSON_GetObjectItemCaseSensitive(json_object, "treasure");
-    treasure_initialize_from_json_object(&treasure_map->treasure, treasure);
 
-    treasure_map->true_description = json_object_alloc_string_value(json_object, "true_description", NULL);
+void
+treasure_map_write_binary(struct treasure_map *treasure_map,
+                          struct binary_writer *writer)
+{
+    binary_writer_bool(writer, treasure_map->is_false);
+    treasure_write_binary(&treasure_map->treasure, writer);
+    binary_writer_string_ref(writer, treasure_map->true_description);
+}
+
+
+void
+treasure_map_write_json(struct treasure_map *treasure_map,
+                        struct json_writer *writer)
+{
+    json_writer_begin_object(writer);
+    json_writer_member_string(writer, "struct", "treasure_map");
+    json_writer_member_int(writer, "rev", 0);
+    json_writer_member_bool(writer, "is_false", treasure_map->is_false);
+    json_writer_key(writer, "treasure");
+    treasure_write_json(&treasure_map->treasure, writer);
+    json_writer_member_string(writer, "true_description", treasure_map->true_description);
+    json_writer_end_object(writer);
 }
@@ -7,7 +7,11 @@
 #include <treasure/treasure_struct.h>
 
 
+struct binary_reader;
+struct binary_writer;
 struct cJSON;
+struct json_reader;
+struct json_writer;
 struct rnd;
 
 
@@ -30,8 +34,25 @@ treasure_map_generate(struct treasure_map *treasure_map, struct rnd *rnd);
 void
 treasure_map_initialize(struct treasure_map *treasure_map);
 
+void
+treasure_map_initialize_from_binary_reader(struct treasure_map *treasure_map,
+                                           struct binary_reader *reader);
+
 void
 treasure_map_initialize_from_json_object(struct treasure_map *treasure_map,
                                          struct cJSON *json_object);
 
+void
+treasure_map_initialize_from_json_reader(struct treasure_map *treasure_map,
+                                         struct json_reader *reader);
+
+void
+treasure_map_write_binary(struct treasure_map *treasure_map,
+                          struct binary_writer *writer);
+
+void
+treasure_map_write_json(struct treasure_map *treasure_map,
+                        struct json_writer *writer);
+
+
 #endif
@@ -2,11 +2,18 @@
 #define FNF_TREASURE_STRUCT_H_INCLUDED
 
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <treasure/coins.h>
 #include <treasure/magic_item.h>
 
 
+struct binary_reader;
+struct binary_writer;
 struct cJSON;
+struct json_reader;
+struct json_writer;
 struct gem;
 struct jewelry;
 struct magic_item;
@@ -21,18 +28,36 @@ struct treasure {
     struct coins coins;
     struct gem *gems;
     int gems_count;
+    int gems_capacity;
     struct jewelry *jewelry;
     int jewelry_count;
+    int jewelry_capacity;
     struct treasure_map *maps;
     int maps_count;
+    int maps_capacity;
     struct magic_item *magic_items;
     int magic_items_count;
+    int magic_items_capacity;
 };
 
 
+// Returns the first of `count' new gems at the end of `treasure->gems' for
+// the caller to initialize.
+struct gem *
+treasure_add_gems(struct treasure *treasure, int count);
+
+// Like treasure_add_gems() for jewelry.
+struct jewelry *
+treasure_add_jewelry(struct treasure *treasure, int count);
+
 char *
 treasure_alloc_description(struct treasure *treasure);
 
+// Finalizes the items of `treasure' and empties it but keeps its arrays,
+// so a treasure generated into it again reuses them.
+void
+treasure_clear(struct treasure *treasure);
+
 struct ptr_array *
 treasure_alloc_details(struct treasure *treasure);
 
@@ -54,12 +79,47 @@ treasure_generate_maps(struct treasure *treasure, struct rnd *rnd, int count);
 void
 treasure_initialize(struct treasure *treasure);
 
+// Reads a record written by treasure_write_binary_record().  Returns false
+// and leaves `treasure' empty when the record is truncated, malformed or
+// has a different version.
+bool
+treasure_initialize_from_binary_record(struct treasure *treasure,
+                                       uint8_t const *bytes,
+                                       size_t length);
+
+void
+treasure_initialize_from_binary_reader(struct treasure *treasure,
+                                       struct binary_reader *reader);
+
+// Reads a treasure from JSON text without building a cJSON tree.  Returns
+// false and leaves `treasure' empty when the text isn't valid JSON.
+bool
+treasure_initialize_from_json_bytes(struct treasure *treasure,
+                                    char const *bytes,
+                                    size_t length);
+
 void
 treasure_initialize_from_json_object(struct treasure *treasure,
                                      struct cJSON *json_object);
 
+void
+treasure_initialize_from_json_reader(struct treasure *treasure,
+                                     struct json_reader *reader);
+
 int
 treasure_value_in_cp(struct treasure *treasure);
 
+void
+treasure_write_binary(struct treasure *treasure, struct binary_writer *writer);
+
+// Writes a self-contained record: a magic number, the format version, the
+// offset of the string table, the treasure and the string table.
+void
+treasure_write_binary_record(struct treasure *treasure,
+                             struct binary_writer *writer);
+
+void
+treasure_write_json(struct treasure *treasure, struct json_writer *writer);
+
 
 #endif
@@ -131,6 +131,50 @@ treasure_create_json_object_for_type_A_test(void)
 }
 
 
+static void
+treasure_clear_test(void)
+{
+    struct rnd *rnd = rnd_alloc_splitmix64(23);
+    struct rnd *reused_rnd = rnd_alloc_splitmix64(23);
+    struct json_writer *json_writer = json_writer_alloc(false);
+    struct json_writer *reused_json_writer = json_writer_alloc(false);
+    struct treasure reused;
+    treasure_initialize(&reused);
+
+    for (char letter = 'A'; letter <= 'Z'; ++letter) {
+        struct treasure treasure;
+        treasure_initialize(&treasure);
+        treasure_type_generate(treasure_type_by_letter(letter), rnd, &treasure);
+        json_writer_clear(json_writer);
+        treasure_write_json(&treasure, json_writer);
+        treasure_finalize(&treasure);
+
+        treasure_type_generate(treasure_type_by_letter(letter), reused_rnd, &reused);
+        json_writer_clear(reused_json_writer);
+        treasure_write_json(&reused, reused_json_writer);
+        assert(str_eq(json_writer->buffer, reused_json_writer->buffer));
+
+        struct gem *gems = reused.gems;
+        int gems_capacity = reused.gems_capacity;
+        treasure_clear(&reused);
+        assert(NULL == reused.type);
+        assert(coins_is_zero(reused.coins));
+        assert(0 == reused.gems_count);
+        assert(0 == reused.jewelry_count);
+        assert(0 == reused.maps_count);
+        assert(0 == reused.magic_items_count);
+        assert(gems == reused.gems);
+        assert(gems_capacity == reused.gems_capacity);
+    }
+
+    treasure_finalize(&reused);
+    json_writer_free(reused_json_writer);
+    json_writer_free(json_writer);
+    rnd_free(reused_rnd);
+    rnd_free(rnd);
+}
+
+
 static void
 treasure_initialize_test(void)
 {
@@ -152,6 +196,177 @@ treasure_initialize_test(void)
 }
 
 
+static void
+treasure_initialize_from_binary_record_test(void)
+{
+    struct rnd *rnd = rnd_alloc_splitmix64(23);
+    struct json_writer *json_writer = json_writer_alloc(false);
+    struct json_writer *binary_json_writer = json_writer_alloc(false);
+    struct binary_writer *binary_writer = binary_writer_alloc();
+
+    for (char letter = 'A'; letter <= 'Z'; ++letter) {
+        for (int i = 0; i < 4; ++i) {
+            struct treasure treasure;
+            treasure_initialize(&treasure);
+            treasure_type_generate(treasure_type_by_letter(letter), rnd, &treasure);
+            json_writer_clear(json_writer);
+            treasure_write_json(&treasure, json_writer);
+            binary_writer_clear(binary_writer);
+            treasure_write_binary_record(&treasure, binary_writer);
+            treasure_finalize(&treasure);
+
+            assert(binary_writer->length < json_writer->length);
+
+            bool is_valid = treasure_initialize_from_binary_record(&treasure,
+                                                                   binary_writer->bytes,
+                                                                   binary_writer->length);
+            assert(is_valid);
+            json_writer_clear(binary_json_writer);
+            treasure_write_json(&treasure, binary_json_writer);
+            treasure_finalize(&treasure);
+
+            assert(str_eq(json_writer->buffer, binary_json_writer->buffer));
+        }
+    }
+
+    binary_writer_free(binary_writer);
+    json_writer_free(binary_json_writer);
+    json_writer_free(json_writer);
+    rnd_free(rnd);
+}
+
+
+static void
+treasure_initialize_from_binary_record_for_invalid_record_test(void)
+{
+    struct rnd *rnd = rnd_alloc_splitmix64(23);
+    struct treasure treasure;
+    treasure_initialize(&treasure);
+    treasure_type_generate(treasure_type_by_letter('H'), rnd, &treasure);
+    struct binary_writer *writer = binary_writer_alloc();
+    treasure_write_binary_record(&treasure, writer);
+    treasure_finalize(&treasure);
+
+    for (size_t length = 0; length < writer->length; ++length) {
+        bool is_valid = treasure_initialize_from_binary_record(&treasure,
+                                                               writer->bytes,
+                                                               length);
+        assert( ! is_valid);
+        assert(0 == treasure.gems_count);
+        assert(NULL == treasure.magic_items);
+        treasure_finalize(&treasure);
+    }
+
+    writer->bytes[4] = 2;
+    assert( ! treasure_initialize_from_binary_record(&treasure,
+                                                     writer->bytes,
+                                                     writer->length));
+    treasure_finalize(&treasure);
+
+    writer->bytes[4] = 1;
+    writer->bytes[0] = '{';
+    assert( ! treasure_initialize_from_binary_record(&treasure,
+                                                     writer->bytes,
+                                                     writer->length));
+    treasure_finalize(&treasure);
+
+    binary_writer_free(writer);
+    rnd_free(rnd);
+}
+
+
+static void
+treasure_initialize_from_json_bytes_test(void)
+{
+    struct rnd *rnd = rnd_alloc_splitmix64(22);
+    struct json_writer *writer = json_writer_alloc(false);
+    struct json_writer *dom_writer = json_writer_alloc(false);
+    struct json_writer *reader_writer = json_writer_alloc(false);
+
+    for (char letter = 'A'; letter <= 'Z'; ++letter) {
+        for (int i = 0; i < 4; ++i) {
+            struct treasure treasure;
+            treasure_initialize(&treasure);
+            treasure_type_generate(treasure_type_by_letter(letter), rnd, &treasure);
+            json_writer_clear(writer);
+            treasure_write_json(&treasure, writer);
+            treasure_finalize(&treasure);
+
+            struct cJSON *json_object = cJSON_Parse(writer->buffer);
+            treasure_initialize_from_json_object(&treasure, json_object);
+            json_writer_clear(dom_writer);
+            treasure_write_json(&treasure, dom_writer);
+            treasure_finalize(&treasure);
+            cJSON_Delete(json_object);
+
+            bool is_valid = treasure_initialize_from_json_bytes(&treasure,
+                                                                writer->buffer,
+                                                                writer->length);
+            assert(is_valid);
+            assert(letter == treasure_type_letter(treasure.type));
+            json_writer_clear(reader_writer);
+            treasure_write_json(&treasure, reader_writer);
+            treasure_finalize(&treasure);
+
+            assert(str_eq(writer->buffer, dom_writer->buffer));
+            assert(str_eq(writer->buffer, reader_writer->buffer));
+        }
+    }
+
+    json_writer_free(reader_writer);
+    json_writer_free(dom_writer);
+    json_writer_free(writer);
+    rnd_free(rnd);
+}
+
+
+static void
+treasure_initialize_from_json_bytes_for_invalid_json_test(void)
+{
+    char const *json_string = "{\"struct\":\"treasure\",\"gems\":[{\"struct\":\"gem\"}";
+    struct treasure treasure;
+    bool is_valid = treasure_initialize_from_json_bytes(&treasure,
+                                                        json_string,
+                                                        strlen(json_string));
+    assert( ! is_valid);
+    assert(NULL == treasure.gems);
+    assert(0 == treasure.gems_count);
+    treasure_finalize(&treasure);
+
+    json_string = "{\"struct\":\"treasure\"} []";
+    is_valid = treasure_initialize_from_json_bytes(&treasure,
+                                                   json_string,
+                                                   strlen(json_string));
+    assert( ! is_valid);
+    treasure_finalize(&treasure);
+}
+
+
+static void
+treasure_initialize_from_json_bytes_for_other_struct_test(void)
+{
+    char const *json_string = "{"
+                              "\"struct\":\"treasure_map\","
+                              "\"type\":\"A\","
+                              "\"coins\":{\"struct\":\"coins\",\"gp\":10},"
+                              "\"gems\":[{\"struct\":\"gem\"}],"
+                              "\"magic_items\":[{\"struct\":\"magic_item\",\"true_details\":[\"one\",2,\"three\"]}]"
+                              "}";
+    struct treasure treasure;
+    bool is_valid = treasure_initialize_from_json_bytes(&treasure,
+                                                        json_string,
+                                                        strlen(json_string));
+    assert(is_valid);
+    assert(NULL == treasure.type);
+    assert(coins_is_zero(treasure.coins));
+    assert(NULL == treasure.gems);
+    assert(0 == treasure.gems_count);
+    assert(NULL == treasure.magic_items);
+    assert(0 == treasure.magic_items_count);
+    treasure_finalize(&treasure);
+}
+
+
 static void
 treasure_initialize_from_json_object_for_empty_object_test(void)
 {
@@ -594,13 +809,107 @@ treasure_generate_magic_items_test(void)
 }
 
 
+static void
+treasure_write_binary_record_test(void)
+{
+    struct treasure treasure;
+    treasure_initialize(&treasure);
+    struct binary_writer *writer = binary_writer_alloc();
+    treasure_write_binary_record(&treasure, writer);
+
+    uint8_t const expected[] = {
+        'F', 'N', 'F', 'T',
+        0x01,
+        0x13, 0x00, 0x00, 0x00,
+        0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00,
+    };
+    assert(sizeof expected == writer->length);
+    assert(0 == memcmp(expected, writer->bytes, sizeof expected));
+
+    binary_writer_free(writer);
+    treasure_finalize(&treasure);
+}
+
+
+static void
+treasure_write_json_test(void)
+{
+    struct rnd *rnd = rnd_alloc_splitmix64(20);
+    struct json_writer *compact_writer = json_writer_alloc(false);
+    struct json_writer *pretty_writer = json_writer_alloc(true);
+
+    for (char letter = 'A'; letter <= 'Z'; ++letter) {
+        for (int i = 0; i < 4; ++i) {
+            struct treasure treasure;
+            treasure_initialize(&treasure);
+            treasure_type_generate(treasure_type_by_letter(letter), rnd, &treasure);
+
+            struct cJSON *json_object = treasure_create_json_object(&treasure);
+            char *compact = cJSON_PrintUnformatted(json_object);
+            char *pretty = cJSON_Print(json_object);
+
+            json_writer_clear(compact_writer);
+            treasure_write_json(&treasure, compact_writer);
+            assert(str_eq(compact, compact_writer->buffer));
+
+            json_writer_clear(pretty_writer);
+            treasure_write_json(&treasure, pretty_writer);
+            assert(str_eq(pretty, pretty_writer->buffer));
+
+            free(pretty);
+            free(compact);
+            cJSON_Delete(json_object);
+            treasure_finalize(&treasure);
+        }
+    }
+
+    struct treasure treasure;
+    treasure_initialize(&treasure);
+    json_writer_clear(compact_writer);
+    treasure_write_json(&treasure, compact_writer);
+    char const *expected = "{"
+                           "\"struct\":\"treasure\","
+                           "\"rev\":0,"
+                           "\"type\":null,"
+                           "\"coins\":{"
+                           "\"struct\":\"coins\","
+                           "\"rev\":0,"
+                           "\"pp\":0,"
+                           "\"gp\":0,"
+                           "\"ep\":0,"
+                           "\"sp\":0,"
+                           "\"cp\":0"
+                           "},"
+                           "\"gems\":[],"
+                           "\"jewelry\":[],"
+                           "\"maps\":[],"
+                           "\"magic_items\":[]"
+                           "}";
+    assert(str_eq(expected, compact_writer->buffer));
+    treasure_finalize(&treasure);
+
+    json_writer_free(pretty_writer);
+    json_writer_free(compact_writer);
+    rnd_free(rnd);
+}
+
+
 void
 treasure_test(void)
 {
     treasure_create_json_object_test();
     treasure_create_json_object_for_type_A_test();
 
+    treasure_clear_test();
     treasure_initialize_test();
+    treasure_initialize_from_binary_record_test();
+    treasure_initialize_from_binary_record_for_invalid_record_test();
+    treasure_initialize_from_json_bytes_test();
+    treasure_initialize_from_json_bytes_for_invalid_json_test();
+    treasure_initialize_from_json_bytes_for_other_struct_test();
     treasure_initialize_from_json_object_for_empty_object_test();
     treasure_initialize_from_json_object_for_empty_array_test();
 
@@ -609,4 +918,7 @@ treasure_test(void)
     treasure_initialize_from_json_object_with_magic_items_test();
 
     treasure_generate_magic_items_test();
+
+    treasure_write_binary_record_test();
+    treasure_write_json_test();
 }
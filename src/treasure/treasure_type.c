@@ -12,14 +12,14 @@
 
 
 struct coins_gems_or_jewelry {
-    char const *amount;
+    struct dice amount;
     int percent_chance;
     bool is_per_individual;
 };
 
 
 struct maps_or_magic_type {
-    char const *amount;
+    struct dice amount;
     bool is_map_possible;
     possible_magic_items_t possible_magic_items;
 };
@@ -49,38 +49,38 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='A',
         .copper={
-            .amount="1d6x1000",
+            .amount=DICE_PLUS_TIMES(1, 6, 0, 1000),
             .percent_chance=25,
         },
         .silver={
-            .amount="1d6x1000",
+            .amount=DICE_PLUS_TIMES(1, 6, 0, 1000),
             .percent_chance=30,
         },
         .electrum={
-            .amount="1d6x1000",
+            .amount=DICE_PLUS_TIMES(1, 6, 0, 1000),
             .percent_chance=35,
         },
         .gold={
-            .amount="1d10x1000",
+            .amount=DICE_PLUS_TIMES(1, 10, 0, 1000),
             .percent_chance=40,
         },
         .platinum={
-            .amount="1d4x100",
+            .amount=DICE_PLUS_TIMES(1, 4, 0, 100),
             .percent_chance=25,
         },
         .gems={
-            .amount="4d10",
+            .amount=DICE(4, 10),
             .percent_chance=60,
         },
         .jewelry={
-            .amount="3d10",
+            .amount=DICE(3, 10),
             .percent_chance=50,
         },
         .maps_or_magic={
             .percent_chance=30,
             .types={
                 {
-                    .amount="3",
+                    .amount=DICE(3, 1),
                     .is_map_possible=true,
                     .possible_magic_items=ANY_MAGIC_ITEM
                 }
@@ -91,38 +91,37 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='B',
         .copper={
-            .amount="1d8x1000",
+            .amount=DICE_PLUS_TIMES(1, 8, 0, 1000),
             .percent_chance=50
         },
         .silver={
-            .amount="1d6x1000",
+            .amount=DICE_PLUS_TIMES(1, 6, 0, 1000),
             .percent_chance=25
         },
         .electrum={
-            .amount="1d4x1000",
+            .amount=DICE_PLUS_TIMES(1, 4, 0, 1000),
             .percent_chance=25
         },
         .gold={
-            .amount="1d3x1000",
+            .amount=DICE_PLUS_TIMES(1, 3, 0, 1000),
             .percent_chance=25
         },
         .platinum={
-            .amount="",
             .percent_chance=0
         },
         .gems={
-            .amount="1d8",
+            .amount=DICE(1, 8),
             .percent_chance=30
         },
         .jewelry={
-            .amount="1d4",
+            .amount=DICE(1, 4),
             .percent_chance=20
         },
         .maps_or_magic={
             .percent_chance=10,
             .types={
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=MAGIC_WEAPON_OR_ARMOR
                 }
             },
@@ -132,30 +131,30 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='C',
         .copper={
-            .amount="1d12x1000",
+            .amount=DICE_PLUS_TIMES(1, 12, 0, 1000),
             .percent_chance=20
         },
         .silver={
-            .amount="1d6x1000",
+            .amount=DICE_PLUS_TIMES(1, 6, 0, 1000),
             .percent_chance=30
         },
         .electrum={
-            .amount="1d4x1000",
+            .amount=DICE_PLUS_TIMES(1, 4, 0, 1000),
             .percent_chance=10
         },
         .gems={
-            .amount="1d6",
+            .amount=DICE(1, 6),
             .percent_chance=25
         },
         .jewelry={
-            .amount="1d3",
+            .amount=DICE(1, 3),
             .percent_chance=20
         },
         .maps_or_magic={
             .percent_chance=10,
             .types={
                 {
-                    .amount="2",
+                    .amount=DICE(2, 1),
                     .is_map_possible=true,
                     .possible_magic_items=ANY_MAGIC_ITEM
                 }
@@ -166,39 +165,39 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='D',
         .copper={
-            .amount="1d8x1000",
+            .amount=DICE_PLUS_TIMES(1, 8, 0, 1000),
             .percent_chance=10
         },
         .silver={
-            .amount="1d12x1000",
+            .amount=DICE_PLUS_TIMES(1, 12, 0, 1000),
             .percent_chance=15
         },
         .electrum={
-            .amount="1d8x1000",
+            .amount=DICE_PLUS_TIMES(1, 8, 0, 1000),
             .percent_chance=15
         },
         .gold={
-            .amount="1d6x1000",
+            .amount=DICE_PLUS_TIMES(1, 6, 0, 1000),
             .percent_chance=50
         },
         .gems={
-            .amount="1d10",
+            .amount=DICE(1, 10),
             .percent_chance=30
         },
         .jewelry={
-            .amount="1d6",
+            .amount=DICE(1, 6),
             .percent_chance=25
         },
         .maps_or_magic={
             .percent_chance=15,
             .types={
                 {
-                    .amount="2",
+                    .amount=DICE(2, 1),
                     .is_map_possible=true,
                     .possible_magic_items=ANY_MAGIC_ITEM
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=POTION
                 }
             },
@@ -208,39 +207,39 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='E',
         .copper={
-            .amount="1d10x1000",
+            .amount=DICE_PLUS_TIMES(1, 10, 0, 1000),
             .percent_chance=5
         },
         .silver={
-            .amount="1d12x1000",
+            .amount=DICE_PLUS_TIMES(1, 12, 0, 1000),
             .percent_chance=25
         },
         .electrum={
-            .amount="1d6x1000",
+            .amount=DICE_PLUS_TIMES(1, 6, 0, 1000),
             .percent_chance=25
         },
         .gold={
-            .amount="1d8x1000",
+            .amount=DICE_PLUS_TIMES(1, 8, 0, 1000),
             .percent_chance=25
         },
         .gems={
-            .amount="1d12",
+            .amount=DICE(1, 12),
             .percent_chance=15
         },
         .jewelry={
-            .amount="1d8",
+            .amount=DICE(1, 8),
             .percent_chance=10
         },
         .maps_or_magic={
             .percent_chance=25,
             .types={
                 {
-                    .amount="3",
+                    .amount=DICE(3, 1),
                     .is_map_possible=true,
                     .possible_magic_items=ANY_MAGIC_ITEM
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=SCROLL
                 }
             },
@@ -250,43 +249,43 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='F',
         .silver={
-            .amount="1d20x1000",
+            .amount=DICE_PLUS_TIMES(1, 20, 0, 1000),
             .percent_chance=10
         },
         .electrum={
-            .amount="1d12x1000",
+            .amount=DICE_PLUS_TIMES(1, 12, 0, 1000),
             .percent_chance=15
         },
         .gold={
-            .amount="1d10x1000",
+            .amount=DICE_PLUS_TIMES(1, 10, 0, 1000),
             .percent_chance=40
         },
         .platinum={
-            .amount="1d8x100",
+            .amount=DICE_PLUS_TIMES(1, 8, 0, 100),
             .percent_chance=35
         },
         .gems={
-            .amount="3d10",
+            .amount=DICE(3, 10),
             .percent_chance=20
         },
         .jewelry={
-            .amount="1d10",
+            .amount=DICE(1, 10),
             .percent_chance=10
         },
         .maps_or_magic={
             .percent_chance=30,
             .types={
                 {
-                    .amount="3",
+                    .amount=DICE(3, 1),
                     .is_map_possible=true,
                     .possible_magic_items=NON_WEAPON_MAGIC
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=POTION
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=SCROLL
                 }
             },
@@ -296,31 +295,31 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='G',
         .gold={
-            .amount="10d4x1000",
+            .amount=DICE_PLUS_TIMES(10, 4, 0, 1000),
             .percent_chance=50
         },
         .platinum={
-            .amount="1d20x100",
+            .amount=DICE_PLUS_TIMES(1, 20, 0, 100),
             .percent_chance=50
         },
         .gems={
-            .amount="5d4",
+            .amount=DICE(5, 4),
             .percent_chance=30
         },
         .jewelry={
-            .amount="1d10",
+            .amount=DICE(1, 10),
             .percent_chance=25
         },
         .maps_or_magic={
             .percent_chance=35,
             .types={
                 {
-                    .amount="4",
+                    .amount=DICE(4, 1),
                     .is_map_possible=true,
                     .possible_magic_items=ANY_MAGIC_ITEM
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=SCROLL
                 }
             },
@@ -330,47 +329,47 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='H',
         .copper={
-            .amount="5d6x1000",
+            .amount=DICE_PLUS_TIMES(5, 6, 0, 1000),
             .percent_chance=25
         },
         .silver={
-            .amount="1d100x1000",
+            .amount=DICE_PLUS_TIMES(1, 100, 0, 1000),
             .percent_chance=40
         },
         .electrum={
-            .amount="10d4x1000",
+            .amount=DICE_PLUS_TIMES(10, 4, 0, 1000),
             .percent_chance=40
         },
         .gold={
-            .amount="10d6x1000",
+            .amount=DICE_PLUS_TIMES(10, 6, 0, 1000),
             .percent_chance=55
         },
         .platinum={
-            .amount="5d10x100",
+            .amount=DICE_PLUS_TIMES(5, 10, 0, 100),
             .percent_chance=25
         },
         .gems={
-            .amount="1d100",
+            .amount=DICE(1, 100),
             .percent_chance=50
         },
         .jewelry={
-            .amount="10d4",
+            .amount=DICE(10, 4),
             .percent_chance=50
         },
         .maps_or_magic={
             .percent_chance=15,
             .types={
                 {
-                    .amount="4",
+                    .amount=DICE(4, 1),
                     .is_map_possible=true,
                     .possible_magic_items=ANY_MAGIC_ITEM
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=POTION
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=SCROLL
                 }
             },
@@ -380,22 +379,22 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='I',
         .platinum={
-            .amount="3d6x100",
+            .amount=DICE_PLUS_TIMES(3, 6, 0, 100),
             .percent_chance=30
         },
         .gems={
-            .amount="2d10",
+            .amount=DICE(2, 10),
             .percent_chance=55
         },
         .jewelry={
-            .amount="1d12",
+            .amount=DICE(1, 12),
             .percent_chance=50
         },
         .maps_or_magic={
             .percent_chance=15,
             .types={
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .is_map_possible=true,
                     .possible_magic_items=ANY_MAGIC_ITEM
                 }
@@ -406,7 +405,7 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='J',
         .copper={
-            .amount="3d8",
+            .amount=DICE(3, 8),
             .percent_chance=100,
             .is_per_individual=true
         },
@@ -414,7 +413,7 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='K',
         .silver={
-            .amount="3d6",
+            .amount=DICE(3, 6),
             .percent_chance=100,
             .is_per_individual=true
         },
@@ -422,7 +421,7 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='L',
         .electrum={
-            .amount="2d6",
+            .amount=DICE(2, 6),
             .percent_chance=100,
             .is_per_individual=true
         },
@@ -430,7 +429,7 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='M',
         .gold={
-            .amount="2d4",
+            .amount=DICE(2, 4),
             .percent_chance=100,
             .is_per_individual=true
         },
@@ -438,7 +437,7 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='N',
         .platinum={
-            .amount="1d6",
+            .amount=DICE(1, 6),
             .percent_chance=100,
             .is_per_individual=true
         },
@@ -446,48 +445,48 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='O',
         .copper={
-            .amount="1d4x1000",
+            .amount=DICE_PLUS_TIMES(1, 4, 0, 1000),
             .percent_chance=25
         },
         .silver={
-            .amount="1d3x1000",
+            .amount=DICE_PLUS_TIMES(1, 3, 0, 1000),
             .percent_chance=20
         },
     },
     {
         .letter='P',
         .silver={
-            .amount="1d6x1000",
+            .amount=DICE_PLUS_TIMES(1, 6, 0, 1000),
             .percent_chance=30
         },
         .electrum={
-            .amount="1d2x1000",
+            .amount=DICE_PLUS_TIMES(1, 2, 0, 1000),
             .percent_chance=25
         },
     },
     {
         .letter='Q',
         .gems={
-            .amount="1d4",
+            .amount=DICE(1, 4),
             .percent_chance=50
         },
     },
     {
         .letter='R',
         .gold={
-            .amount="2d4x1000",
+            .amount=DICE_PLUS_TIMES(2, 4, 0, 1000),
             .percent_chance=40
         },
         .platinum={
-            .amount="10d6x100",
+            .amount=DICE_PLUS_TIMES(10, 6, 0, 100),
             .percent_chance=50
         },
         .gems={
-            .amount="4d8",
+            .amount=DICE(4, 8),
             .percent_chance=55
         },
         .jewelry={
-            .amount="1d12",
+            .amount=DICE(1, 12),
             .percent_chance=45
         },
     },
@@ -497,7 +496,7 @@ static struct treasure_type treasure_types[] = {
             .percent_chance=40,
             .types={
                 {
-                    .amount="2D4",
+                    .amount=DICE(2, 4),
                     .possible_magic_items=POTION
                 }
             },
@@ -510,7 +509,7 @@ static struct treasure_type treasure_types[] = {
             .percent_chance=50,
             .types={
                 {
-                    .amount="1D4",
+                    .amount=DICE(1, 4),
                     .possible_magic_items=SCROLL
                 }
             },
@@ -520,38 +519,38 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='U',
         .gems={
-            .amount="10d8",
+            .amount=DICE(10, 8),
             .percent_chance=90
         },
         .jewelry={
-            .amount="5d6",
+            .amount=DICE(5, 6),
             .percent_chance=80
         },
         .maps_or_magic={
             .percent_chance=70,
             .types={
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=RING
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=ROD_STAFF_WAND
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=MISC_MAGIC
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=ARMOR_SHIELD
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=SWORD
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=MISC_WEAPON
                 }
             },
@@ -564,27 +563,27 @@ static struct treasure_type treasure_types[] = {
             .percent_chance=85,
             .types={
                 {
-                    .amount="2",
+                    .amount=DICE(2, 1),
                     .possible_magic_items=RING
                 },
                 {
-                    .amount="2",
+                    .amount=DICE(2, 1),
                     .possible_magic_items=ROD_STAFF_WAND
                 },
                 {
-                    .amount="2",
+                    .amount=DICE(2, 1),
                     .possible_magic_items=MISC_MAGIC
                 },
                 {
-                    .amount="2",
+                    .amount=DICE(2, 1),
                     .possible_magic_items=ARMOR_SHIELD
                 },
                 {
-                    .amount="2",
+                    .amount=DICE(2, 1),
                     .possible_magic_items=SWORD
                 },
                 {
-                    .amount="2",
+                    .amount=DICE(2, 1),
                     .possible_magic_items=MISC_WEAPON
                 }
             },
@@ -594,26 +593,26 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='W',
         .gold={
-            .amount="5d6x1000",
+            .amount=DICE_PLUS_TIMES(5, 6, 0, 1000),
             .percent_chance=60
         },
         .platinum={
-            .amount="1d8x100",
+            .amount=DICE_PLUS_TIMES(1, 8, 0, 100),
             .percent_chance=15
         },
         .gems={
-            .amount="10d8",
+            .amount=DICE(10, 8),
             .percent_chance=60
         },
         .jewelry={
-            .amount="5d8",
+            .amount=DICE(5, 8),
             .percent_chance=50
         },
         .maps_or_magic={
             .percent_chance=55,
             .types={
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .is_map_possible=true,
                     .possible_magic_items=NO_MAGIC_ITEM
                 }
@@ -627,11 +626,11 @@ static struct treasure_type treasure_types[] = {
             .percent_chance=60,
             .types={
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=MISC_MAGIC
                 },
                 {
-                    .amount="1",
+                    .amount=DICE(1, 1),
                     .possible_magic_items=POTION
                 }
             },
@@ -641,45 +640,45 @@ static struct treasure_type treasure_types[] = {
     {
         .letter='Y',
         .gold={
-            .amount="2d6x1000",
+            .amount=DICE_PLUS_TIMES(2, 6, 0, 1000),
             .percent_chance=70
         },
     },
     {
         .letter='Z',
         .copper={
-            .amount="1d3x1000",
+            .amount=DICE_PLUS_TIMES(1, 3, 0, 1000),
             .percent_chance=20
         },
         .silver={
-            .amount="1d4x1000",
+            .amount=DICE_PLUS_TIMES(1, 4, 0, 1000),
             .percent_chance=25
         },
         .electrum={
-            .amount="1d4x1000",
+            .amount=DICE_PLUS_TIMES(1, 4, 0, 1000),
             .percent_chance=25
         },
         .gold={
-            .amount="1d4x1000",
+            .amount=DICE_PLUS_TIMES(1, 4, 0, 1000),
             .percent_chance=30
         },
         .platinum={
-            .amount="1d6x100",
+            .amount=DICE_PLUS_TIMES(1, 6, 0, 100),
             .percent_chance=30
         },
         .gems={
-            .amount="10d6",
+            .amount=DICE(10, 6),
             .percent_chance=55
         },
         .jewelry={
-            .amount="5d6",
+            .amount=DICE(5, 6),
             .percent_chance=50
         },
         .maps_or_magic={
             .percent_chance=50,
             .types={
                 {
-                    .amount="3",
+                    .amount=DICE(3, 1),
                     .possible_magic_items=ANY_MAGIC_ITEM
                 }
             },
@@ -781,15 +780,13 @@ describe_coins_gems_or_jewelry(struct coins_gems_or_jewelry *coins_gems_or_jewel
     if (!coins_gems_or_jewelry->percent_chance) return strdup_or_die("   nil   ");
 
     if (coins_gems_or_jewelry->is_per_individual) {
-        struct dice amount = dice_parse(coins_gems_or_jewelry->amount);
-        char *range = dice_alloc_base_range_description(amount);
+        char *range = dice_alloc_base_range_description(coins_gems_or_jewelry->amount);
         char *description = str_alloc_centered_and_formatted(9, "%s per",
                                                              range);
         free_or_die(range);
         return description;
     } else {
-        struct dice amount = dice_parse(coins_gems_or_jewelry->amount);
-        char *range = dice_alloc_base_range_description(amount);
+        char *range = dice_alloc_base_range_description(coins_gems_or_jewelry->amount);
         char *description = str_alloc_centered_and_formatted(9, "%s:%2i%%",
                                                              range,
                                                              coins_gems_or_jewelry->percent_chance);
@@ -809,7 +806,7 @@ describe_maps_or_magic(struct maps_or_magic *maps_or_magic)
         struct maps_or_magic_type *type = &maps_or_magic->types[i];
         char const *type_name = possible_maps_or_magic_name(type->is_map_possible,
                                                             type->possible_magic_items);
-        struct dice amount = dice_parse(type->amount);
+        struct dice amount = type->amount;
         char *range = dice_alloc_range_description(amount);
         if (!dice_has_constant_score(amount)) {
             type_descriptions[i] = str_alloc_formatted("%s %ss",
@@ -870,11 +867,11 @@ generate_coins(int *coins,
     *coins = 0;
     if (!coins_type->percent_chance) return;
     if (coins_type->is_per_individual) {
-        *coins += roll(coins_type->amount, rnd);
+        *coins += dice_roll(coins_type->amount, rnd, NULL);
     } else {
         int percent_score = roll("1d100", rnd);
         if (percent_score <= coins_type->percent_chance) {
-            *coins = roll(coins_type->amount, rnd);
+            *coins = dice_roll(coins_type->amount, rnd, NULL);
         }
     }
 }
@@ -883,16 +880,14 @@ generate_coins(int *coins,
 static void
 generate_gems(struct treasure *treasure, struct rnd *rnd)
 {
-    treasure->gems = NULL;
-    treasure->gems_count = 0;
     if (!treasure->type->gems.percent_chance) return;
     int percent_score = roll("1d100", rnd);
     if (percent_score <= treasure->type->gems.percent_chance) {
-        treasure->gems_count = roll(treasure->type->gems.amount, rnd);
-        treasure->gems = calloc_or_die(treasure->gems_count, sizeof(struct gem));
-        for (int i = 0; i < treasure->gems_count; ++i) {
-            gem_initialize(&treasure->gems[i]);
-            gem_generate(&treasure->gems[i], rnd);
+        int count = dice_roll(treasure->type->gems.amount, rnd, NULL);
+        struct gem *gems = treasure_add_gems(treasure, count);
+        for (int i = 0; i < count; ++i) {
+            gem_initialize(&gems[i]);
+            gem_generate(&gems[i], rnd);
         }
     }
 }
@@ -901,17 +896,14 @@ generate_gems(struct treasure *treasure, struct rnd *rnd)
 static void
 generate_jewelry(struct treasure *treasure, struct rnd *rnd)
 {
-    treasure->jewelry = NULL;
-    treasure->jewelry_count = 0;
     if (!treasure->type->jewelry.percent_chance) return;
     int percent_score = roll("1d100", rnd);
     if (percent_score <= treasure->type->jewelry.percent_chance) {
-        treasure->jewelry_count = roll(treasure->type->jewelry.amount, rnd);
-        treasure->jewelry = calloc_or_die(treasure->jewelry_count,
-                                          sizeof(struct jewelry));
-        for (int i = 0; i < treasure->jewelry_count; ++i) {
-            jewelry_initialize(&treasure->jewelry[i]);
-            jewelry_generate(&treasure->jewelry[i], rnd);
+        int count = dice_roll(treasure->type->jewelry.amount, rnd, NULL);
+        struct jewelry *jewelry = treasure_add_jewelry(treasure, count);
+        for (int i = 0; i < count; ++i) {
+            jewelry_initialize(&jewelry[i]);
+            jewelry_generate(&jewelry[i], rnd);
         }
     }
 }
@@ -936,7 +928,7 @@ generate_maps_or_magic_items(struct maps_or_magic_type *type,
                              struct treasure *treasure,
                              struct rnd *rnd)
 {
-    int amount = roll(type->amount, rnd);
+    int amount = dice_roll(type->amount, rnd, NULL);
     int magic_items_count = 0;
     int maps_count = 0;
     for (int i = 0; i < amount; ++i) {
@@ -1002,3 +994,10 @@ treasure_type_by_letter(char letter)
     assert(letter >= 'A' && letter <= 'Z');
     return &treasure_types[letter - 'A'];
 }
+
+
+char
+treasure_type_letter(struct treasure_type *treasure_type)
+{
+    return treasure_type->letter;
+}
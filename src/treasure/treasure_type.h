@@ -26,5 +26,8 @@ treasure_type_generate(struct treasure_type *treasure_type,
 struct treasure_type *
 treasure_type_by_letter(char letter);
 
+char
+treasure_type_letter(struct treasure_type *treasure_type);
+
 
 #endif